@@ -29,4 +29,6 @@ FOUNDATION_EXPORT const unsigned char DLABridgingVersionString[];
 #import <DLABridging/DLABTimecodeSetting.h>
 #import <DLABridging/DLABProfileAttributes.h>
 #import <DLABridging/DLABFrameMetadata.h>
+#import <DLABridging/DLABAncillaryPacketBatch.h>
 #import <DLABridging/DLABDeckControl.h>
+#import <DLABridging/DLABCaptureGroup.h>
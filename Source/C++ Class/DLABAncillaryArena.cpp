@@ -0,0 +1,72 @@
+//
+//  DLABAncillaryArena.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABAncillaryArena.h"
+
+#include <string.h>
+
+static const size_t kInitialBytes = 4096;   // a few dense ANC packets per frame
+static const size_t kInitialEntries = 16;
+
+/* =================================================================================== */
+// MARK: - DLABAncillaryArena
+/* =================================================================================== */
+
+void DLABAncillaryArena::Append(uint8_t did, uint8_t sdid, uint32_t lineNumber, uint8_t dataStreamIndex,
+                                const void* data, uint32_t length)
+{
+    Entry entry = {did, sdid, dataStreamIndex, lineNumber, (uint32_t)bytes.size(), length};
+    if (length && data) {
+        const uint8_t* src = (const uint8_t*)data;
+        bytes.insert(bytes.end(), src, src + length);
+    } else {
+        entry.length = 0;
+    }
+    entries.push_back(entry);
+}
+
+/* =================================================================================== */
+// MARK: - DLABAncillaryArenaPool
+/* =================================================================================== */
+
+DLABAncillaryArenaPool::DLABAncillaryArenaPool(uint32_t capacity)
+: DLABRecyclingPool(capacity, DisposeArena)
+{
+    // Pre-allocate all arenas
+    for (uint32_t i = 0; i < Capacity(); i++) {
+        DLABAncillaryArena* arena = new DLABAncillaryArena();
+        arena->Reserve(kInitialBytes, kInitialEntries);
+        if (!AddIdle(arena)) {
+            delete arena;
+            break;
+        }
+    }
+}
+
+void DLABAncillaryArenaPool::DisposeArena(void* item, void* /*context*/)
+{
+    delete (DLABAncillaryArena*)item;
+}
+
+DLABAncillaryArena* DLABAncillaryArenaPool::Reserve()
+{
+    DLABAncillaryArena* arena = (DLABAncillaryArena*)ReserveIdle();
+    if (!arena) {
+        arena = new DLABAncillaryArena(); // transient arena
+    }
+    return arena;
+}
+
+void DLABAncillaryArenaPool::Recycle(DLABAncillaryArena* arena)
+{
+    if (!arena) return;
+    arena->Reset();
+    DLABRecyclingPool::Recycle(arena);
+}
@@ -0,0 +1,89 @@
+//
+//  DLABAncillaryArena.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABAncillaryArena_h
+#define DLABAncillaryArena_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "DLABRecyclingPool.h"
+
+/*
+ * Internal use only
+ * Contiguous storage of all ancillary packets of one video frame (plain C++, no Apple framework dependency)
+ *
+ * Packet payloads are appended back to back in single byte buffer, with
+ * index entry of (DID, SDID, line, stream, offset, length) per packet.
+ * Arena keeps its capacity across Reset(), so recycled arena does not
+ * allocate in steady state.
+ */
+
+class DLABAncillaryArenaPool;
+
+class DLABAncillaryArena
+{
+public:
+    struct Entry {
+        uint8_t did;
+        uint8_t sdid;
+        uint8_t dataStreamIndex;
+        uint32_t lineNumber;
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    DLABAncillaryArena() {}
+
+    void Reserve(size_t byteCapacity, size_t entryCapacity) {
+        bytes.reserve(byteCapacity);
+        entries.reserve(entryCapacity);
+    }
+    void Reset() { bytes.clear(); entries.clear(); }
+    void Append(uint8_t did, uint8_t sdid, uint32_t lineNumber, uint8_t dataStreamIndex,
+                const void* data, uint32_t length);
+
+    size_t Count() const { return entries.size(); }
+    const Entry* Entries() const { return entries.data(); }
+    const uint8_t* Bytes() const { return bytes.data(); }
+    size_t Length() const { return bytes.size(); }
+
+private:
+    DLABAncillaryArena(const DLABAncillaryArena&) = delete;
+    DLABAncillaryArena& operator=(const DLABAncillaryArena&) = delete;
+
+    std::vector<uint8_t> bytes;
+    std::vector<Entry> entries;
+};
+
+/*
+ * Internal use only
+ * Recycling pool of DLABAncillaryArena.
+ *
+ * See DLABRecyclingPool for reference counting and transient arena.
+ */
+
+class DLABAncillaryArenaPool : public DLABRecyclingPool
+{
+public:
+    explicit DLABAncillaryArenaPool(uint32_t capacity);
+
+    // Take empty arena (retains pool until Recycle)
+    DLABAncillaryArena* Reserve();
+    // Return arena taken by Reserve (releases pool)
+    void Recycle(DLABAncillaryArena* arena);
+
+private:
+    ~DLABAncillaryArenaPool() {}
+
+    static void DisposeArena(void* item, void* context);
+};
+
+#endif /* DLABAncillaryArena_h */
@@ -0,0 +1,355 @@
+//
+//  DLABAncillaryKernel.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABAncillaryKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define DLAB_KERNEL_X86 1
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DLAB_KERNEL_NEON 1
+#endif
+
+/*
+ Word stream
+
+ Line is unpacked into 16bit msb aligned words in component order (Cb Y Cr Y ...),
+ using v210 => v216 kernel for 10bit line. So ADF search is performed on single
+ array for both HD streams; luma is odd index, chroma is even index (stride 2).
+ SD multiplexed stream uses every index (stride 1).
+
+ For 8bit line, each byte is taken as lower 8 bits of the word.
+ */
+
+static const size_t kV210BlockBytes = 16;
+static const size_t kV210BlockPixels = 6;
+static const size_t kV210BlockComponents = 12;
+static const size_t kHeaderWords = 6;       // ADF x3, DID, SDID, DC
+static const uint16_t kMask10 = 0xFFC0;
+static const uint16_t kMask8 = 0xFF00;
+
+static inline bool isSD(DLABAncLineFormat format)
+{
+    return (format == DLABAncLineFormatV210SD || format == DLABAncLineFormat2vuySD);
+}
+
+static inline bool is10bit(DLABAncLineFormat format)
+{
+    return (format == DLABAncLineFormatV210 || format == DLABAncLineFormatV210SD);
+}
+
+static inline size_t v210RowBytesFor(size_t width)
+{
+    return ((width + kV210BlockPixels - 1) / kV210BlockPixels) * kV210BlockBytes;
+}
+
+/* =================================================================================== */
+// MARK: - word helper
+/* =================================================================================== */
+
+static inline uint16_t parityWord(uint8_t value)
+{
+    uint16_t b8 = (uint16_t)(__builtin_popcount(value) & 1);
+    return (uint16_t)(value | (b8 << 8) | ((b8 ^ 1) << 9));
+}
+
+static inline bool parityValid(uint16_t word)
+{
+    uint16_t b8 = (uint16_t)((word >> 8) & 1);
+    uint16_t b9 = (uint16_t)((word >> 9) & 1);
+    return (b8 == (uint16_t)(__builtin_popcount(word & 0xFF) & 1)) && (b9 != b8);
+}
+
+static inline void setV210Component(uint8_t* line, size_t index, uint16_t value)
+{
+    size_t block = index / kV210BlockComponents;
+    size_t j = index % kV210BlockComponents;
+    uint8_t* ptr = line + block * kV210BlockBytes + (j / 3) * 4;
+    uint32_t shift = (uint32_t)(j % 3) * 10;
+    uint32_t word;
+    memcpy(&word, ptr, 4);
+    word = (word & ~(0x3FFu << shift)) | ((uint32_t)(value & 0x3FF) << shift);
+    memcpy(ptr, &word, 4);
+}
+
+/* =================================================================================== */
+// MARK: - ADF search
+/* =================================================================================== */
+
+// Collect candidate index k where words[k], words[k+s], words[k+2s] form ADF
+static size_t scanScalar(const uint16_t* words, size_t count, size_t stride, uint16_t mask,
+                         size_t start, uint32_t* found, size_t maxFound)
+{
+    size_t n = 0;
+    for (size_t k = start; k + 2 * stride < count && n < maxFound; k++) {
+        if ((words[k] & mask) == 0 &&
+            (words[k + stride] & mask) == mask &&
+            (words[k + 2 * stride] & mask) == mask) {
+            found[n++] = (uint32_t)k;
+        }
+    }
+    return n;
+}
+
+#if DLAB_KERNEL_X86
+
+static size_t scanSSE2(const uint16_t* words, size_t count, size_t stride, uint16_t mask,
+                       uint32_t* found, size_t maxFound, size_t* scanned)
+{
+    const __m128i vmask = _mm_set1_epi16((short)mask);
+    const __m128i vzero = _mm_setzero_si128();
+    size_t n = 0;
+    size_t k = 0;
+    for (; k + 2 * stride + 8 <= count && n < maxFound; k += 8) {
+        __m128i a = _mm_and_si128(_mm_loadu_si128((const __m128i*)(words + k)), vmask);
+        __m128i b = _mm_and_si128(_mm_loadu_si128((const __m128i*)(words + k + stride)), vmask);
+        __m128i c = _mm_and_si128(_mm_loadu_si128((const __m128i*)(words + k + 2 * stride)), vmask);
+        __m128i hit = _mm_and_si128(_mm_cmpeq_epi16(a, vzero),
+                                    _mm_and_si128(_mm_cmpeq_epi16(b, vmask), _mm_cmpeq_epi16(c, vmask)));
+        uint32_t bits = (uint32_t)_mm_movemask_epi8(hit);     // 2 bits per word
+        while (bits && n < maxFound) {
+            uint32_t lane = (uint32_t)__builtin_ctz(bits) / 2;
+            found[n++] = (uint32_t)(k + lane);
+            bits &= ~(3u << (lane * 2));
+        }
+    }
+    *scanned = k;
+    return n;
+}
+
+#endif
+
+#if DLAB_KERNEL_NEON
+
+static size_t scanNEON(const uint16_t* words, size_t count, size_t stride, uint16_t mask,
+                       uint32_t* found, size_t maxFound, size_t* scanned)
+{
+    const uint16x8_t vmask = vdupq_n_u16(mask);
+    size_t n = 0;
+    size_t k = 0;
+    for (; k + 2 * stride + 8 <= count && n < maxFound; k += 8) {
+        uint16x8_t a = vandq_u16(vld1q_u16(words + k), vmask);
+        uint16x8_t b = vandq_u16(vld1q_u16(words + k + stride), vmask);
+        uint16x8_t c = vandq_u16(vld1q_u16(words + k + 2 * stride), vmask);
+        uint16x8_t hit = vandq_u16(vceqzq_u16(a), vandq_u16(vceqq_u16(b, vmask), vceqq_u16(c, vmask)));
+        uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(hit, 4)), 0);    // 4 bits per word
+        while (bits && n < maxFound) {
+            uint32_t lane = (uint32_t)__builtin_ctzll(bits) / 4;
+            found[n++] = (uint32_t)(k + lane);
+            bits &= ~(0xFull << (lane * 4));
+        }
+    }
+    *scanned = k;
+    return n;
+}
+
+#endif
+
+static size_t scanADF(const uint16_t* words, size_t count, size_t stride, uint16_t mask,
+                      uint32_t* found, size_t maxFound)
+{
+    size_t n = 0;
+    size_t scanned = 0;
+    switch (DLABKernelGetBackend()) {
+#if DLAB_KERNEL_X86
+        case DLABKernelBackendSSE41:
+        case DLABKernelBackendAVX2:
+            n = scanSSE2(words, count, stride, mask, found, maxFound, &scanned);
+            break;
+#endif
+#if DLAB_KERNEL_NEON
+        case DLABKernelBackendNEON:
+            n = scanNEON(words, count, stride, mask, found, maxFound, &scanned);
+            break;
+#endif
+        default:
+            break;
+    }
+    if (n < maxFound) {
+        n += scanScalar(words, count, stride, mask, scanned, found + n, maxFound - n);
+    }
+    return n;
+}
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+size_t DLABAncEncodePacket(uint8_t did, uint8_t sdid,
+                           const uint8_t* udw, size_t count,
+                           uint16_t* words)
+{
+    if (!words || count > DLABAncMaxUserDataCount || (count && !udw)) return 0;
+
+    size_t n = 0;
+    words[n++] = 0x000;
+    words[n++] = 0x3FF;
+    words[n++] = 0x3FF;
+    words[n++] = parityWord(did);
+    words[n++] = parityWord(sdid);
+    words[n++] = parityWord((uint8_t)count);
+    for (size_t i = 0; i < count; i++) {
+        words[n++] = parityWord(udw[i]);
+    }
+
+    // Checksum: 9bit sum of DID ... UDW, b9 = not b8
+    uint16_t sum = 0;
+    for (size_t i = 3; i < n; i++) {
+        sum = (uint16_t)((sum + (words[i] & 0x1FF)) & 0x1FF);
+    }
+    words[n++] = (uint16_t)(sum | ((((sum >> 8) & 1) ^ 1) << 9));
+    return n;
+}
+
+size_t DLABAncLineParse(const void* line, size_t width, DLABAncLineFormat format,
+                        DLABAncPacketInfo* packets, size_t maxPackets,
+                        uint8_t* payload, size_t payloadCapacity)
+{
+    if (!line || !width || (width & 1) || !packets || !maxPackets) return 0;
+
+    // Unpack line into msb aligned words; scratch is kept per thread
+    static thread_local std::vector<uint16_t> scratch;
+    static thread_local std::vector<uint32_t> candidates;
+    size_t count = width * 2;
+    if (scratch.size() < count) scratch.resize(count);
+    uint16_t* words = scratch.data();
+
+    bool tenBit = is10bit(format);
+    if (tenBit) {
+        if (!DLABKernelV210ToV216(line, v210RowBytesFor(width), words, count * 2, width, 1)) return 0;
+    } else {
+        const uint8_t* src = (const uint8_t*)line;
+        for (size_t i = 0; i < count; i++) {
+            words[i] = (uint16_t)(src[i] << 8);
+        }
+    }
+
+    uint16_t mask = tenBit ? kMask10 : kMask8;
+    unsigned valueShift = tenBit ? 6 : 8;
+    size_t stride = isSD(format) ? 1 : 2;
+
+    // Every packet needs at least header and checksum
+    size_t maxFound = count / (kHeaderWords + 1) + 1;
+    if (candidates.size() < maxFound) candidates.resize(maxFound);
+    size_t found = scanADF(words, count, stride, mask, candidates.data(), maxFound);
+
+    size_t nextIndex[2] = {0, 0};     // per stream (index parity for HD)
+    size_t packetCount = 0;
+    size_t payloadLength = 0;
+    for (size_t i = 0; i < found && packetCount < maxPackets; i++) {
+        size_t k = candidates[i];
+        size_t lane = (stride == 2) ? (k & 1) : 0;
+        if (k < nextIndex[lane]) continue;   // inside previous packet
+
+        // Header
+        if (k + (kHeaderWords - 1) * stride >= count) continue;
+        uint16_t didWord = (uint16_t)(words[k + 3 * stride] >> valueShift);
+        uint16_t sdidWord = (uint16_t)(words[k + 4 * stride] >> valueShift);
+        uint16_t dcWord = (uint16_t)(words[k + 5 * stride] >> valueShift);
+        size_t dc = dcWord & 0xFF;
+        size_t csIndex = k + (kHeaderWords + dc) * stride;
+        if (csIndex >= count) continue;
+
+        // Validate
+        bool parityOK = true;
+        uint16_t sum = (uint16_t)(didWord + sdidWord + dcWord);
+        if (tenBit) {
+            parityOK = parityValid(didWord) && parityValid(sdidWord) && parityValid(dcWord);
+            sum = (uint16_t)((didWord & 0x1FF) + (sdidWord & 0x1FF) + (dcWord & 0x1FF));
+        }
+        if (payloadLength + dc > payloadCapacity || (dc && !payload)) break;
+        for (size_t u = 0; u < dc; u++) {
+            uint16_t value = (uint16_t)(words[k + (kHeaderWords + u) * stride] >> valueShift);
+            sum = (uint16_t)(sum + (tenBit ? (value & 0x1FF) : value));
+            payload[payloadLength + u] = (uint8_t)(value & 0xFF);
+        }
+        uint16_t csWord = (uint16_t)(words[csIndex] >> valueShift);
+        bool checksumOK;
+        if (tenBit) {
+            sum &= 0x1FF;
+            checksumOK = ((csWord & 0x1FF) == sum) && (((csWord >> 9) & 1) != ((csWord >> 8) & 1));
+        } else {
+            checksumOK = ((csWord & 0xFF) == (sum & 0xFF));
+        }
+
+        DLABAncPacketInfo* info = &packets[packetCount++];
+        info->did = (uint8_t)(didWord & 0xFF);
+        info->sdid = (uint8_t)(sdidWord & 0xFF);
+        info->dataCount = (uint8_t)dc;
+        info->stream = (uint8_t)((stride == 2 && !(k & 1)) ? DLABAncStreamChroma : DLABAncStreamLuma);
+        info->position = (uint32_t)(k / stride);
+        info->payloadOffset = (uint32_t)payloadLength;
+        info->parityValid = parityOK;
+        info->checksumValid = checksumOK;
+
+        payloadLength += dc;
+        nextIndex[lane] = csIndex + stride;
+    }
+    return packetCount;
+}
+
+bool DLABAncLineClear(void* line, size_t width, DLABAncLineFormat format)
+{
+    if (!line || !width || (width & 1)) return false;
+
+    if (is10bit(format)) {
+        // Cb Y Cr | Y Cb Y pattern repeats every two words
+        const uint32_t even = 0x200u | (0x040u << 10) | (0x200u << 20);
+        const uint32_t odd = 0x040u | (0x200u << 10) | (0x040u << 20);
+        uint8_t* dst = (uint8_t*)line;
+        size_t wordCount = v210RowBytesFor(width) / 4;
+        for (size_t i = 0; i < wordCount; i++) {
+            uint32_t word = (i & 1) ? odd : even;
+            memcpy(dst + i * 4, &word, 4);
+        }
+    } else {
+        uint8_t* dst = (uint8_t*)line;
+        for (size_t i = 0; i < width * 2; i += 2) {
+            dst[i] = 0x80;
+            dst[i + 1] = 0x10;
+        }
+    }
+    return true;
+}
+
+size_t DLABAncLineWritePacket(void* line, size_t width, DLABAncLineFormat format,
+                              DLABAncStream stream, size_t position,
+                              uint8_t did, uint8_t sdid,
+                              const uint8_t* udw, size_t count)
+{
+    if (!line || !width || (width & 1)) return 0;
+    if (isSD(format) && stream != DLABAncStreamLuma) return 0; // single stream only
+
+    uint16_t words[DLABAncMaxUserDataCount + kHeaderWords + 1];
+    size_t length = DLABAncEncodePacket(did, sdid, udw, count, words);
+    if (!length) return 0;
+
+    // Map stream position into component index
+    size_t stride = isSD(format) ? 1 : 2;
+    size_t offset = (stride == 2 && stream == DLABAncStreamLuma) ? 1 : 0;
+    size_t streamLength = (width * 2) / stride;
+    if (position + length > streamLength) return 0;
+
+    uint8_t* dst = (uint8_t*)line;
+    for (size_t i = 0; i < length; i++) {
+        size_t index = (position + i) * stride + offset;
+        if (is10bit(format)) {
+            setV210Component(dst, index, words[i]);
+        } else {
+            dst[index] = (uint8_t)(words[i] & 0xFF);
+        }
+    }
+    return position + length;
+}
@@ -0,0 +1,98 @@
+//
+//  DLABAncillaryKernel.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABAncillaryKernel_h
+#define DLABAncillaryKernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Internal use only
+ * SMPTE ST 291 ancillary packet parser/serializer for raw VANC line (plain C++, no Apple framework dependency)
+ *
+ * Line is either v210 (10bit) or 2vuy (8bit), as returned from
+ * IDeckLinkVideoFrameAncillary::GetBufferForVerticalBlankingLine.
+ *
+ * - HD line carries two independent streams; chroma (Cb/Cr) and luma (Y).
+ * - SD line carries single multiplexed stream (Cb Y Cr Y ...).
+ *
+ * Parser looks for ADF (000h 3FFh 3FFh), then validates parity of DID/SDID/DC
+ * and checksum. For 8bit line, each byte is taken as b7-b0 of the word; ADF is
+ * 00h FFh FFh, parity is not available, and checksum is validated on 8 bits only.
+ * ADF search is vectorized (SSE2 / NEON); backend follows DLABKernelGetBackend().
+ *
+ * Serializer writes Type 2 packet (DID/SDID) with parity and checksum.
+ */
+
+/// Maximum number of UDW in one packet
+#define DLABAncMaxUserDataCount 255
+
+typedef enum {
+    DLABAncLineFormatV210   = 0,    // 10bit HD : luma/chroma streams
+    DLABAncLineFormatV210SD = 1,    // 10bit SD : multiplexed stream
+    DLABAncLineFormat2vuy   = 2,    // 8bit HD  : luma/chroma streams
+    DLABAncLineFormat2vuySD = 3,    // 8bit SD  : multiplexed stream
+} DLABAncLineFormat;
+
+typedef enum {
+    DLABAncStreamLuma       = 0,    // Y of HD line, or multiplexed stream of SD line
+    DLABAncStreamChroma     = 1,    // Cb/Cr of HD line
+} DLABAncStream;
+
+typedef struct {
+    uint8_t did;                    // Data ID
+    uint8_t sdid;                   // Secondary Data ID (or Data Block Number)
+    uint8_t dataCount;              // Number of UDW
+    uint8_t stream;                 // DLABAncStream
+    uint32_t position;              // ADF position in stream (in words)
+    uint32_t payloadOffset;         // UDW offset in payload buffer (lower 8 bits of each word)
+    bool parityValid;               // DID/SDID/DC parity (always true for 8bit line)
+    bool checksumValid;             // Checksum word
+} DLABAncPacketInfo;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Encode one packet into 10bit words (ADF DID SDID DC UDW... CS).
+/// @param words buffer of at least (count + 7) words
+/// @return number of words written, or 0 if failed
+size_t DLABAncEncodePacket(uint8_t did, uint8_t sdid,
+                           const uint8_t* udw, size_t count,
+                           uint16_t* words);
+
+/// Parse every packet in raw VANC line.
+/// @param width number of pixels in line
+/// @param packets array to receive packet info
+/// @param payload buffer to receive UDW of all packets back to back
+/// @return number of packets found. Packets beyond maxPackets or payloadCapacity are ignored.
+size_t DLABAncLineParse(const void* line, size_t width, DLABAncLineFormat format,
+                        DLABAncPacketInfo* packets, size_t maxPackets,
+                        uint8_t* payload, size_t payloadCapacity);
+
+/// Fill raw VANC line with blanking level (Y 040h, C 200h).
+bool DLABAncLineClear(void* line, size_t width, DLABAncLineFormat format);
+
+/// Write one packet into raw VANC line.
+/// @param stream DLABAncStreamLuma for SD line (multiplexed stream)
+/// @param position word position in stream to start ADF
+/// @return word position next to the packet, or 0 if the packet does not fit
+size_t DLABAncLineWritePacket(void* line, size_t width, DLABAncLineFormat format,
+                              DLABAncStream stream, size_t position,
+                              uint8_t did, uint8_t sdid,
+                              const uint8_t* udw, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLABAncillaryKernel_h */
@@ -10,22 +10,35 @@
 
 #import <Foundation/Foundation.h>
 #import <DeckLinkAPI.h>
+#import <DLABRecyclingPool.h>
 #import <atomic>
-#import <vector>
 
 /*
  * Internal use only
  * This is C++ subclass from
  * IDeckLinkAncillaryPacket
+ *
+ * Payload (UDW) is kept in fixed inline storage of kMaxPayloadLength bytes.
  */
 
+class DLABAncillaryPacketPool;
+
 class DLABAncillaryPacket : public IDeckLinkAncillaryPacket
 {
 public:
+    static const uint32_t kMaxPayloadLength = 255;  // SMPTE ST 291 max UDW count
+    
     DLABAncillaryPacket(void);
+    DLABAncillaryPacket(DLABAncillaryPacketPool* pool);
     
     // Utility
     HRESULT Update(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex, NSData* data);
+    HRESULT Update(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex,
+                   const void* bytes, uint32_t length);
+    
+    // Direct write: fill MutableBytes() then commit header and payload length
+    uint8_t* MutableBytes(void) { return vbuf; }
+    HRESULT Commit(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex, uint32_t length);
     
     // IDeckLinkAncillaryPacket
     HRESULT GetBytes(BMDAncillaryPacketFormat format, const void** data, uint32_t* size);
@@ -40,10 +53,40 @@ public:
     ULONG Release();
     
 private:
+    friend class DLABAncillaryPacketPool;
+    
+    DLABAncillaryPacketPool* _pool;     // weak; valid while packet is outstanding
     uint8_t _did;
     uint8_t _sdid;
     uint32_t _line;
     uint8_t _dataStreamIndex;
-    std::vector<char> vbuf;
+    uint32_t _length;
+    uint8_t vbuf[kMaxPayloadLength];
     std::atomic<ULONG> refCount;
 };
+
+/*
+ * Internal use only
+ * Recycling pool of DLABAncillaryPacket for output ANC insertion.
+ *
+ * Reserved packet returns to pool when its reference count reaches zero,
+ * i.e. when both caller and video frame have released it.
+ * See DLABRecyclingPool for reference counting and transient packet.
+ */
+
+class DLABAncillaryPacketPool : public DLABRecyclingPool
+{
+public:
+    explicit DLABAncillaryPacketPool(uint32_t capacity);
+    
+    // Take packet with reference count of 1
+    DLABAncillaryPacket* Reserve();
+    
+private:
+    friend class DLABAncillaryPacket;
+    
+    ~DLABAncillaryPacketPool() {}
+    
+    static void DisposePacket(void* item, void* context);
+    void Recycle(DLABAncillaryPacket* packet) { DLABRecyclingPool::Recycle(packet); }
+};
@@ -11,7 +11,12 @@
 #import <DLABAncillaryPacket.h>
 
 DLABAncillaryPacket::DLABAncillaryPacket(void)
-: refCount(1), _did(0), _sdid(0), _line(0), _dataStreamIndex(0)
+: _pool(NULL), _did(0), _sdid(0), _line(0), _dataStreamIndex(0), _length(0), refCount(1)
+{
+}
+
+DLABAncillaryPacket::DLABAncillaryPacket(DLABAncillaryPacketPool* pool)
+: _pool(pool), _did(0), _sdid(0), _line(0), _dataStreamIndex(0), _length(0), refCount(1)
 {
 }
 
@@ -20,24 +25,38 @@ DLABAncillaryPacket::DLABAncillaryPacket(void)
 HRESULT DLABAncillaryPacket::Update(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex, NSData* data)
 {
     if (data) {
-        char* ptr = (char*) data.bytes;
-        size_t length = (size_t) data.length;
-        vbuf.resize(length);
-        vbuf.shrink_to_fit();
-        if (ptr && length) {
-            memcpy(&vbuf[0], ptr, length);
-        }
-        
-        _did = did;
-        _sdid = sdid;
-        _line = line;
-        _dataStreamIndex = dataStreamIndex;
-        
-        return S_OK;
+        return Update(did, sdid, line, dataStreamIndex, data.bytes, (uint32_t)data.length);
     }
     return E_INVALIDARG;
 }
 
+HRESULT DLABAncillaryPacket::Update(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex,
+                                    const void* bytes, uint32_t length)
+{
+    if (length > kMaxPayloadLength || (length && !bytes)) {
+        return E_INVALIDARG;
+    }
+    if (length) {
+        memcpy(vbuf, bytes, length);
+    }
+    return Commit(did, sdid, line, dataStreamIndex, length);
+}
+
+HRESULT DLABAncillaryPacket::Commit(uint8_t did, uint8_t sdid, uint32_t line, uint8_t dataStreamIndex, uint32_t length)
+{
+    if (length > kMaxPayloadLength) {
+        return E_INVALIDARG;
+    }
+    
+    _did = did;
+    _sdid = sdid;
+    _line = line;
+    _dataStreamIndex = dataStreamIndex;
+    _length = length;
+    
+    return S_OK;
+}
+
 // IDeckLinkAncillaryPacket
 
 HRESULT DLABAncillaryPacket::GetBytes(BMDAncillaryPacketFormat format, const void** data, uint32_t* size)
@@ -46,9 +65,9 @@ HRESULT DLABAncillaryPacket::GetBytes(BMDAncillaryPacketFormat format, const voi
         return E_NOTIMPL;
     }
     if (size)
-        *size = (uint32_t)vbuf.size();
+        *size = _length;
     if (data)
-        *data = vbuf.data();
+        *data = vbuf;
     return S_OK;
 }
 
@@ -100,8 +119,46 @@ ULONG DLABAncillaryPacket::Release()
 {
     ULONG newRefValue = --refCount;
     if (newRefValue == 0) {
-        delete this;
+        if (_pool) {
+            _pool->Recycle(this);
+        } else {
+            delete this;
+        }
         return 0;
     }
     return newRefValue;
 }
+
+/* =================================================================================== */
+// MARK: - DLABAncillaryPacketPool
+/* =================================================================================== */
+
+DLABAncillaryPacketPool::DLABAncillaryPacketPool(uint32_t capacity)
+: DLABRecyclingPool(capacity, DisposePacket)
+{
+    // Pre-allocate all packets
+    for (uint32_t i = 0; i < Capacity(); i++) {
+        DLABAncillaryPacket* packet = new DLABAncillaryPacket(this);
+        if (!AddIdle(packet)) {
+            delete packet;
+            break;
+        }
+    }
+}
+
+void DLABAncillaryPacketPool::DisposePacket(void* item, void* /*context*/)
+{
+    delete (DLABAncillaryPacket*)item;
+}
+
+DLABAncillaryPacket* DLABAncillaryPacketPool::Reserve()
+{
+    DLABAncillaryPacket* packet = (DLABAncillaryPacket*)ReserveIdle();
+    if (packet) {
+        packet->refCount.store(1, std::memory_order_relaxed);
+        packet->_length = 0;
+    } else {
+        packet = new DLABAncillaryPacket(this); // transient packet
+    }
+    return packet;
+}
@@ -0,0 +1,45 @@
+//
+//  DLABAudioBlockPool.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <DLABRecyclingPool.h>
+
+/*
+ * Internal use only
+ * Recycling pool of fixed size memory blocks for captured audio CMBlockBuffer.
+ *
+ * Each CMBlockBuffer refers pooled block via CMBlockBufferCustomBlockSource.
+ * Block returns to pool when CMBlockBuffer is released by consumer, so pool
+ * can be replaced while consumer still holds sample buffers.
+ * See DLABRecyclingPool for reference counting and transient block.
+ *
+ * Requested length which exceeds block size is served by transient block too.
+ */
+
+class DLABAudioBlockPool : public DLABRecyclingPool
+{
+public:
+    DLABAudioBlockPool(size_t blockSize, uint32_t capacity);
+
+    // Create CMBlockBuffer of dataLength bytes, backed by pooled block
+    OSStatus CreateBlockBuffer(size_t dataLength, CMBlockBufferRef* blockBufferOut);
+
+    // Utility
+    size_t BlockSize() const { return blockSize; }
+
+private:
+    ~DLABAudioBlockPool() {}
+
+    static void DisposeBlock(void* item, void* context);
+    static void FreeBlock(void* refCon, void* doomedMemoryBlock, size_t sizeInBytes);
+
+    size_t blockSize;
+};
@@ -0,0 +1,76 @@
+//
+//  DLABAudioBlockPool.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABAudioBlockPool.h>
+
+static const size_t kBlockAlignment = 64;
+
+/* =================================================================================== */
+// MARK: - DLABAudioBlockPool
+/* =================================================================================== */
+
+DLABAudioBlockPool::DLABAudioBlockPool(size_t blockSize, uint32_t capacity)
+: DLABRecyclingPool(capacity, DisposeBlock), blockSize(blockSize)
+{
+    // Pre-allocate all blocks
+    for (uint32_t i = 0; i < Capacity(); i++) {
+        void* block = NULL;
+        if (posix_memalign(&block, kBlockAlignment, blockSize) != 0 || !block) break;
+        if (!AddIdle(block)) {
+            free(block);
+            break;
+        }
+    }
+}
+
+void DLABAudioBlockPool::DisposeBlock(void* item, void* /*context*/)
+{
+    free(item);
+}
+
+OSStatus DLABAudioBlockPool::CreateBlockBuffer(size_t dataLength, CMBlockBufferRef* blockBufferOut)
+{
+    if (!blockBufferOut || !dataLength) return kCMBlockBufferBadLengthParameterErr;
+    *blockBufferOut = NULL;
+    
+    // Take idle block, or allocate transient one
+    size_t blockLength = blockSize;
+    void* block = ReserveIdle(dataLength <= blockSize);
+    if (!block) {
+        blockLength = (dataLength > blockSize ? dataLength : blockSize);
+        if (posix_memalign(&block, kBlockAlignment, blockLength) != 0 || !block) {
+            Release(); // retained by ReserveIdle
+            return kCMBlockBufferMemoryErr;
+        }
+    }
+    
+    CMBlockBufferCustomBlockSource source = {
+        kCMBlockBufferCustomBlockSourceVersion, NULL, FreeBlock, this
+    };
+    OSStatus err = CMBlockBufferCreateWithMemoryBlock(NULL,
+                                                      block,
+                                                      blockLength,
+                                                      NULL,
+                                                      &source,
+                                                      0,
+                                                      dataLength,
+                                                      0,
+                                                      blockBufferOut);
+    if (err) {
+        FreeBlock(this, block, blockLength);
+    }
+    return err;
+}
+
+void DLABAudioBlockPool::FreeBlock(void* refCon, void* doomedMemoryBlock, size_t /*sizeInBytes*/)
+{
+    DLABAudioBlockPool* pool = (DLABAudioBlockPool*)refCon;
+    pool->Recycle(doomedMemoryBlock);
+}
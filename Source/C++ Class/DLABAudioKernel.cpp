@@ -0,0 +1,245 @@
+//
+//  DLABAudioKernel.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABAudioKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DLAB_KERNEL_X86 1
+#define DLAB_TARGET_SSE41 __attribute__((target("sse4.1")))
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DLAB_KERNEL_NEON 1
+#endif
+
+/*
+ Byte index table
+
+ Each destination byte is described by its byte offset in source sample frame.
+ So channel map and sample size are resolved once per call, and every backend
+ works as plain byte gather.
+
+ Vector path stores whole 16 byte chunks. Bytes spilled over the end of
+ destination sample frame are overwritten by next frame, and the last few
+ frames which would spill over the end of buffer are left to scalar path.
+ */
+
+static const size_t kMaxFrameBytes = 64;    // 4 vectors
+static const size_t kChunkBytes = 16;
+
+/* =================================================================================== */
+// MARK: - scalar
+/* =================================================================================== */
+
+static void extractScalar(const uint8_t* map, size_t bytesPerSample,
+                          size_t srcFrameBytes, size_t dstChannels,
+                          const uint8_t* src, uint8_t* dst, size_t frameCount)
+{
+    size_t dstFrameBytes = dstChannels * bytesPerSample;
+    if (bytesPerSample == 2) {
+        for (size_t f = 0; f < frameCount; f++) {
+            for (size_t ch = 0; ch < dstChannels; ch++) {
+                uint16_t value;
+                memcpy(&value, src + map[ch] * 2, 2);
+                memcpy(dst + ch * 2, &value, 2);
+            }
+            src += srcFrameBytes;
+            dst += dstFrameBytes;
+        }
+    } else {
+        for (size_t f = 0; f < frameCount; f++) {
+            for (size_t ch = 0; ch < dstChannels; ch++) {
+                uint32_t value;
+                memcpy(&value, src + map[ch] * 4, 4);
+                memcpy(dst + ch * 4, &value, 4);
+            }
+            src += srcFrameBytes;
+            dst += dstFrameBytes;
+        }
+    }
+}
+
+/* =================================================================================== */
+// MARK: - vector helper
+/* =================================================================================== */
+
+static size_t vectorFrameCount(size_t dstFrameBytes, size_t frameCount)
+{
+    // Number of leading frames whose chunk stores stay inside destination buffer
+    size_t outChunks = (dstFrameBytes + kChunkBytes - 1) / kChunkBytes;
+    size_t spill = outChunks * kChunkBytes - dstFrameBytes;
+    size_t spillFrames = (spill + dstFrameBytes - 1) / dstFrameBytes;
+    return (frameCount > spillFrames) ? frameCount - spillFrames : 0;
+}
+
+/* =================================================================================== */
+// MARK: - x86 (SSE4.1)
+/* =================================================================================== */
+
+#if DLAB_KERNEL_X86
+
+DLAB_TARGET_SSE41
+static size_t extractSSE41(const uint8_t* byteIndex, size_t srcFrameBytes, size_t dstFrameBytes,
+                           const uint8_t* src, uint8_t* dst, size_t frameCount)
+{
+    size_t inChunks = srcFrameBytes / kChunkBytes;
+    size_t outChunks = (dstFrameBytes + kChunkBytes - 1) / kChunkBytes;
+    size_t count = vectorFrameCount(dstFrameBytes, frameCount);
+
+    // pshufb mask per (output chunk, input chunk); 0x80 clears the byte
+    __m128i mask[4][4];
+    for (size_t k = 0; k < outChunks; k++) {
+        for (size_t j = 0; j < inChunks; j++) {
+            uint8_t bytes[16];
+            for (size_t b = 0; b < kChunkBytes; b++) {
+                size_t o = k * kChunkBytes + b;
+                bytes[b] = 0x80;
+                if (o < dstFrameBytes && byteIndex[o] / kChunkBytes == j) {
+                    bytes[b] = (uint8_t)(byteIndex[o] % kChunkBytes);
+                }
+            }
+            mask[k][j] = _mm_loadu_si128((const __m128i*)bytes);
+        }
+    }
+
+    for (size_t f = 0; f < count; f++) {
+        __m128i in[4];
+        for (size_t j = 0; j < inChunks; j++) {
+            in[j] = _mm_loadu_si128((const __m128i*)(src + j * kChunkBytes));
+        }
+        for (size_t k = 0; k < outChunks; k++) {
+            __m128i out = _mm_shuffle_epi8(in[0], mask[k][0]);
+            for (size_t j = 1; j < inChunks; j++) {
+                out = _mm_or_si128(out, _mm_shuffle_epi8(in[j], mask[k][j]));
+            }
+            _mm_storeu_si128((__m128i*)(dst + k * kChunkBytes), out);
+        }
+        src += srcFrameBytes;
+        dst += dstFrameBytes;
+    }
+    return count;
+}
+
+#endif
+
+/* =================================================================================== */
+// MARK: - arm64 (NEON)
+/* =================================================================================== */
+
+#if DLAB_KERNEL_NEON
+
+static size_t extractNEON(const uint8_t* byteIndex, size_t srcFrameBytes, size_t dstFrameBytes,
+                          const uint8_t* src, uint8_t* dst, size_t frameCount)
+{
+    size_t inChunks = srcFrameBytes / kChunkBytes;
+    size_t outChunks = (dstFrameBytes + kChunkBytes - 1) / kChunkBytes;
+    size_t count = vectorFrameCount(dstFrameBytes, frameCount);
+
+    // tbl index per output chunk; out of range index clears the byte
+    uint8x16_t index[4];
+    for (size_t k = 0; k < outChunks; k++) {
+        uint8_t bytes[16];
+        for (size_t b = 0; b < kChunkBytes; b++) {
+            size_t o = k * kChunkBytes + b;
+            bytes[b] = (o < dstFrameBytes) ? byteIndex[o] : 0xFF;
+        }
+        index[k] = vld1q_u8(bytes);
+    }
+
+    for (size_t f = 0; f < count; f++) {
+        for (size_t k = 0; k < outChunks; k++) {
+            uint8x16_t out;
+            switch (inChunks) {
+                case 1:
+                    out = vqtbl1q_u8(vld1q_u8(src), index[k]);
+                    break;
+                case 2:
+                    out = vqtbl2q_u8(vld1q_u8_x2(src), index[k]);
+                    break;
+                case 3:
+                    out = vqtbl3q_u8(vld1q_u8_x3(src), index[k]);
+                    break;
+                default:
+                    out = vqtbl4q_u8(vld1q_u8_x4(src), index[k]);
+                    break;
+            }
+            vst1q_u8(dst + k * kChunkBytes, out);
+        }
+        src += srcFrameBytes;
+        dst += dstFrameBytes;
+    }
+    return count;
+}
+
+#endif
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+bool DLABKernelAudioExtract(const void* src, size_t srcChannels,
+                            void* dst, size_t dstChannels,
+                            const uint8_t* channelMap,
+                            size_t bytesPerSample, size_t frameCount)
+{
+    if (!src || !dst || !srcChannels || !dstChannels) return false;
+    if (bytesPerSample != 2 && bytesPerSample != 4) return false;
+    if (srcChannels > DLABKernelAudioMaxChannels || dstChannels > DLABKernelAudioMaxChannels) return false;
+
+    uint8_t map[DLABKernelAudioMaxChannels];
+    for (size_t ch = 0; ch < dstChannels; ch++) {
+        map[ch] = (channelMap ? channelMap[ch] : (uint8_t)ch);
+        if (map[ch] >= srcChannels) return false;
+    }
+
+    const uint8_t* srcPtr = (const uint8_t*)src;
+    uint8_t* dstPtr = (uint8_t*)dst;
+    size_t srcFrameBytes = srcChannels * bytesPerSample;
+    size_t dstFrameBytes = dstChannels * bytesPerSample;
+
+    size_t done = 0;
+    bool vectorOK = (srcFrameBytes % kChunkBytes == 0 && srcFrameBytes <= kMaxFrameBytes &&
+                     dstFrameBytes <= kMaxFrameBytes);
+    if (vectorOK) {
+        uint8_t byteIndex[kMaxFrameBytes];
+        for (size_t ch = 0; ch < dstChannels; ch++) {
+            for (size_t b = 0; b < bytesPerSample; b++) {
+                byteIndex[ch * bytesPerSample + b] = (uint8_t)(map[ch] * bytesPerSample + b);
+            }
+        }
+        switch (DLABKernelGetBackend()) {
+#if DLAB_KERNEL_X86
+            case DLABKernelBackendAVX2:
+            case DLABKernelBackendSSE41:
+                done = extractSSE41(byteIndex, srcFrameBytes, dstFrameBytes,
+                                    srcPtr, dstPtr, frameCount);
+                break;
+#endif
+#if DLAB_KERNEL_NEON
+            case DLABKernelBackendNEON:
+                done = extractNEON(byteIndex, srcFrameBytes, dstFrameBytes,
+                                   srcPtr, dstPtr, frameCount);
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+
+    if (done < frameCount) {
+        extractScalar(map, bytesPerSample, srcFrameBytes, dstChannels,
+                      srcPtr + done * srcFrameBytes, dstPtr + done * dstFrameBytes,
+                      frameCount - done);
+    }
+    return true;
+}
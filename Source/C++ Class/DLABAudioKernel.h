@@ -0,0 +1,48 @@
+//
+//  DLABAudioKernel.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABAudioKernel_h
+#define DLABAudioKernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Internal use only
+ * Interleaved audio channel subset extraction (plain C++, no Apple framework dependency)
+ *
+ * Copies selected channels of each sample frame into packed destination in
+ * single pass. Byte shuffle (SSSE3 pshufb / NEON tbl) is used when source
+ * sample frame is 16, 32, 48 or 64 bytes; e.g. 16bit 8ch/16ch, 32bit 4ch/8ch/16ch.
+ *
+ * Backend follows DLABKernelGetBackend() in DLABV210Kernel.h.
+ */
+
+/// Maximum number of channels in source/destination sample frame
+#define DLABKernelAudioMaxChannels 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Extract channels from interleaved audio samples.
+/// @param bytesPerSample 2 for 16bit, 4 for 32bit
+/// @param channelMap source channel index for each destination channel, or NULL for first dstChannels channels
+bool DLABKernelAudioExtract(const void* src, size_t srcChannels,
+                            void* dst, size_t dstChannels,
+                            const uint8_t* channelMap,
+                            size_t bytesPerSample, size_t frameCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLABAudioKernel_h */
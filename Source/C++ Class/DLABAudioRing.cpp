@@ -0,0 +1,155 @@
+//
+//  DLABAudioRing.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABAudioRing.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t roundUpPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value && result < 0x80000000) result <<= 1;
+    return result;
+}
+
+DLABAudioRing::DLABAudioRing(uint32_t capacityFrames, uint32_t bytesPerFrame)
+: capacity(roundUpPowerOfTwo(capacityFrames ? capacityFrames : 1)),
+  mask(0), bytesPerFrame(bytesPerFrame ? bytesPerFrame : 1), buffer(NULL),
+  writeIndex(0), readIndex(0),
+  peakFill(0), overflowCount(0), underrunCount(0), refCount(1)
+{
+    mask = capacity - 1;
+    buffer = (uint8_t*)calloc(capacity, this->bytesPerFrame);
+    if (!buffer) {
+        capacity = 0;
+        mask = 0;
+    }
+}
+
+DLABAudioRing::~DLABAudioRing()
+{
+    free(buffer);
+}
+
+/* =================================================================================== */
+// MARK: - producer
+/* =================================================================================== */
+
+uint32_t DLABAudioRing::Write(const void* data, uint32_t frameCount)
+{
+    if (!data || !frameCount) return 0;
+
+    uint64_t wIndex = writeIndex.load(std::memory_order_relaxed);
+    uint64_t rIndex = readIndex.load(std::memory_order_acquire);
+    uint32_t freeCount = capacity - (uint32_t)(wIndex - rIndex);
+    uint32_t count = (frameCount < freeCount ? frameCount : freeCount);
+
+    if (count) {
+        uint32_t offset = (uint32_t)(wIndex & mask);
+        uint32_t first = capacity - offset;
+        if (first > count) first = count;
+        const uint8_t* src = (const uint8_t*)data;
+        memcpy(buffer + (size_t)offset * bytesPerFrame, src, (size_t)first * bytesPerFrame);
+        if (count > first) {
+            memcpy(buffer, src + (size_t)first * bytesPerFrame, (size_t)(count - first) * bytesPerFrame);
+        }
+        writeIndex.store(wIndex + count, std::memory_order_release);
+
+        // Peak fill level as seen by producer
+        uint32_t fill = (uint32_t)(wIndex + count - rIndex);
+        uint32_t peak = peakFill.load(std::memory_order_relaxed);
+        while (fill > peak && !peakFill.compare_exchange_weak(peak, fill, std::memory_order_relaxed)) {
+        }
+    }
+    if (count < frameCount) {
+        overflowCount.fetch_add(frameCount - count, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+/* =================================================================================== */
+// MARK: - consumer
+/* =================================================================================== */
+
+uint32_t DLABAudioRing::Peek(const void** data1, uint32_t* count1, const void** data2, uint32_t* count2) const
+{
+    uint64_t rIndex = readIndex.load(std::memory_order_relaxed);
+    uint64_t wIndex = writeIndex.load(std::memory_order_acquire);
+    uint32_t count = (uint32_t)(wIndex - rIndex);
+
+    uint32_t offset = (uint32_t)(rIndex & mask);
+    uint32_t first = capacity - offset;
+    if (first > count) first = count;
+
+    if (data1) *data1 = buffer + (size_t)offset * bytesPerFrame;
+    if (count1) *count1 = first;
+    if (data2) *data2 = buffer;
+    if (count2) *count2 = count - first;
+    return count;
+}
+
+void DLABAudioRing::Consume(uint32_t frameCount)
+{
+    uint64_t rIndex = readIndex.load(std::memory_order_relaxed);
+    uint64_t wIndex = writeIndex.load(std::memory_order_acquire);
+    uint32_t count = (uint32_t)(wIndex - rIndex);
+    if (frameCount > count) frameCount = count;
+    readIndex.store(rIndex + frameCount, std::memory_order_release);
+}
+
+void DLABAudioRing::Discard()
+{
+    readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void DLABAudioRing::Reset()
+{
+    writeIndex.store(0, std::memory_order_relaxed);
+    readIndex.store(0, std::memory_order_relaxed);
+    ResetStatistics();
+}
+
+/* =================================================================================== */
+// MARK: - statistics
+/* =================================================================================== */
+
+uint32_t DLABAudioRing::FillLevel() const
+{
+    uint64_t rIndex = readIndex.load(std::memory_order_acquire);
+    uint64_t wIndex = writeIndex.load(std::memory_order_acquire);
+    return (wIndex > rIndex ? (uint32_t)(wIndex - rIndex) : 0);
+}
+
+void DLABAudioRing::ResetStatistics()
+{
+    peakFill.store(0, std::memory_order_relaxed);
+    overflowCount.store(0, std::memory_order_relaxed);
+    underrunCount.store(0, std::memory_order_relaxed);
+}
+
+/* =================================================================================== */
+// MARK: - reference counting
+/* =================================================================================== */
+
+uint32_t DLABAudioRing::AddRef()
+{
+    return ++refCount;
+}
+
+uint32_t DLABAudioRing::Release()
+{
+    uint32_t newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
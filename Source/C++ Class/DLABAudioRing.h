@@ -0,0 +1,87 @@
+//
+//  DLABAudioRing.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABAudioRing_h
+#define DLABAudioRing_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/*
+ * Internal use only
+ * Lock-free SPSC ring of interleaved PCM sample frames (plain C++, no Apple framework dependency)
+ *
+ * Capacity is rounded up to power of two in sample frames. Indices are monotonic
+ * frame counters; producer owns writeIndex, consumer owns readIndex.
+ *
+ * - Write is producer side; one producer at a time (any thread).
+ * - Peek/Consume/Discard are consumer side; one consumer at a time.
+ * - Reset requires quiescent state.
+ * - Statistics are safe to query from any thread.
+ * - Reference counted; producer/consumer retain ring while they access it.
+ */
+
+class DLABAudioRing
+{
+public:
+    DLABAudioRing(uint32_t capacityFrames, uint32_t bytesPerFrame);
+
+    uint32_t Capacity() const { return capacity; }
+    uint32_t BytesPerFrame() const { return bytesPerFrame; }
+
+    // Producer: copy frames into ring. Returns frames accepted; the rest are counted as overflow.
+    uint32_t Write(const void* data, uint32_t frameCount);
+
+    // Consumer: readable regions (second one is wrapped part). Returns total readable frames.
+    uint32_t Peek(const void** data1, uint32_t* count1, const void** data2, uint32_t* count2) const;
+    // Consumer: release frames read by Peek
+    void Consume(uint32_t frameCount);
+    // Consumer: discard every readable frame
+    void Discard();
+
+    // Quiescent only
+    void Reset();
+
+    // Statistics
+    uint32_t FillLevel() const;
+    uint32_t PeakFillLevel() const { return peakFill.load(std::memory_order_relaxed); }
+    uint64_t WrittenCount() const { return writeIndex.load(std::memory_order_relaxed); }
+    uint64_t ConsumedCount() const { return readIndex.load(std::memory_order_relaxed); }
+    uint64_t OverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+    uint64_t UnderrunCount() const { return underrunCount.load(std::memory_order_relaxed); }
+    void CountUnderrun() { underrunCount.fetch_add(1, std::memory_order_relaxed); }
+    void ResetStatistics();
+
+    // Reference counting
+    uint32_t AddRef();
+    uint32_t Release();
+    uint32_t RefCount() const { return refCount.load(std::memory_order_acquire); }
+
+private:
+    ~DLABAudioRing();
+    DLABAudioRing(const DLABAudioRing&) = delete;
+    DLABAudioRing& operator=(const DLABAudioRing&) = delete;
+
+    uint32_t capacity;                      // power of two
+    uint32_t mask;
+    uint32_t bytesPerFrame;
+    uint8_t* buffer;
+
+    alignas(64) std::atomic<uint64_t> writeIndex;
+    alignas(64) std::atomic<uint64_t> readIndex;
+
+    alignas(64) std::atomic<uint32_t> peakFill;
+    std::atomic<uint64_t> overflowCount;    // in frames
+    std::atomic<uint64_t> underrunCount;    // in events
+    std::atomic<uint32_t> refCount;
+};
+
+#endif /* DLABAudioRing_h */
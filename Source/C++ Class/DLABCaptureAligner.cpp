@@ -0,0 +1,200 @@
+//
+//  DLABCaptureAligner.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABCaptureAligner.h"
+
+#include <string.h>
+
+static const int64_t kDefaultMaxWait = 20000000; // 20 mSec
+
+DLABCaptureAligner::DLABCaptureAligner(uint32_t memberCount, DeliverFunc deliver, DropFunc drop, void* context)
+: memberCount(memberCount < kMaxMemberCount ? memberCount : kMaxMemberCount),
+  deliver(deliver), drop(drop), context(context),
+  maxWait(kDefaultMaxWait), latePolicy(LatePolicyDrop),
+  pendingCount(0), hasDelivered(false), lastInstant(0),
+  completeCount(0), partialCount(0), lateCount(0), dropCount(0),
+  stats(StatsStageCount)
+{
+    memset(pending, 0, sizeof(pending));
+}
+
+DLABCaptureAligner::~DLABCaptureAligner()
+{
+    // Drop every pending item
+    for (uint32_t i = 0; i < pendingCount; i++) {
+        for (uint32_t m = 0; m < memberCount; m++) {
+            if (pending[i].items[m]) drop(pending[i].items[m], context);
+        }
+    }
+    pendingCount = 0;
+}
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+void DLABCaptureAligner::Submit(uint32_t member, int64_t time, int64_t duration, void* item, int64_t now)
+{
+    if (!item) return;
+    if (member >= memberCount || duration <= 0) {
+        DropItem(item);
+        return;
+    }
+
+    // Quantize into instant (round to nearest frame)
+    int64_t instant = (time + duration / 2) / duration;
+
+    // Late frame; its instant is already delivered
+    Bundle* bundle = NULL;
+    if (!hasDelivered || instant > lastInstant) {
+        bundle = PendingBundleOf(instant, now);
+    }
+    if (!bundle) {
+        SubmitLate(member, instant, time, item, now);
+        return;
+    }
+
+    if (bundle->items[member]) {
+        // Duplicate member in same instant; newer one wins
+        DropItem(bundle->items[member]);
+        bundle->presentCount--;
+    }
+    bundle->items[member] = item;
+    bundle->times[member] = time;
+    bundle->presentCount++;
+
+    if (bundle->presentCount == memberCount) {
+        // Every member has passed this instant; no more frame will come for older ones
+        uint32_t index = (uint32_t)(bundle - pending);
+        DeliverFront(index + 1, now);
+    }
+}
+
+int64_t DLABCaptureAligner::Poll(int64_t now)
+{
+    while (pendingCount && pending[0].firstArrival + maxWait <= now) {
+        DeliverFront(1, now);
+    }
+    return (pendingCount ? pending[0].firstArrival + maxWait : 0);
+}
+
+void DLABCaptureAligner::Flush(int64_t now)
+{
+    DeliverFront(pendingCount, now);
+}
+
+void DLABCaptureAligner::Reset()
+{
+    for (uint32_t i = 0; i < pendingCount; i++) {
+        for (uint32_t m = 0; m < memberCount; m++) {
+            if (pending[i].items[m]) DropItem(pending[i].items[m]);
+        }
+    }
+    pendingCount = 0;
+    hasDelivered = false;
+    lastInstant = 0;
+}
+
+void DLABCaptureAligner::ResetStatistics()
+{
+    completeCount.store(0, std::memory_order_relaxed);
+    partialCount.store(0, std::memory_order_relaxed);
+    lateCount.store(0, std::memory_order_relaxed);
+    dropCount.store(0, std::memory_order_relaxed);
+    stats.Reset();
+}
+
+/* =================================================================================== */
+// MARK: - private
+/* =================================================================================== */
+
+DLABCaptureAligner::Bundle* DLABCaptureAligner::PendingBundleOf(int64_t instant, int64_t now)
+{
+    // Find existing bundle, or insertion point (sorted by instant)
+    uint32_t index = 0;
+    for (; index < pendingCount; index++) {
+        if (pending[index].instant == instant) return &pending[index];
+        if (pending[index].instant > instant) break;
+    }
+
+    // Make room by delivering oldest bundle
+    if (pendingCount == kMaxPendingCount) {
+        if (index == 0) return NULL; // older than every pending bundle
+        DeliverFront(1, now);
+        index--;
+    }
+
+    memmove(&pending[index + 1], &pending[index], sizeof(Bundle) * (pendingCount - index));
+    pendingCount++;
+
+    Bundle* bundle = &pending[index];
+    memset(bundle, 0, sizeof(Bundle));
+    bundle->instant = instant;
+    bundle->firstArrival = now;
+    return bundle;
+}
+
+void DLABCaptureAligner::DeliverFront(uint32_t count, int64_t now)
+{
+    if (count > pendingCount) count = pendingCount;
+    for (uint32_t i = 0; i < count; i++) {
+        const Bundle& bundle = pending[i];
+
+        // Skew among present members
+        int64_t minTime = INT64_MAX;
+        int64_t maxTime = INT64_MIN;
+        for (uint32_t m = 0; m < memberCount; m++) {
+            if (!bundle.items[m]) continue;
+            if (bundle.times[m] < minTime) minTime = bundle.times[m];
+            if (bundle.times[m] > maxTime) maxTime = bundle.times[m];
+        }
+        if (bundle.presentCount > 1) {
+            stats.Record(StatsStageSkew, (uint64_t)(maxTime - minTime));
+        }
+        stats.Record(StatsStageWait, (uint64_t)(now > bundle.firstArrival ? now - bundle.firstArrival : 0));
+
+        if (bundle.presentCount == memberCount) {
+            completeCount.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            partialCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        hasDelivered = true;
+        lastInstant = bundle.instant;
+
+        deliver(bundle, context);
+    }
+
+    memmove(&pending[0], &pending[count], sizeof(Bundle) * (pendingCount - count));
+    pendingCount -= count;
+}
+
+void DLABCaptureAligner::SubmitLate(uint32_t member, int64_t instant, int64_t time, void* item, int64_t now)
+{
+    lateCount.fetch_add(1, std::memory_order_relaxed);
+    if (latePolicy == LatePolicyDeliver) {
+        Bundle bundle;
+        memset(&bundle, 0, sizeof(bundle));
+        bundle.instant = instant;
+        bundle.firstArrival = now;
+        bundle.presentCount = 1;
+        bundle.late = true;
+        bundle.items[member] = item;
+        bundle.times[member] = time;
+        deliver(bundle, context);
+    } else {
+        DropItem(item);
+    }
+}
+
+void DLABCaptureAligner::DropItem(void* item)
+{
+    dropCount.fetch_add(1, std::memory_order_relaxed);
+    drop(item, context);
+}
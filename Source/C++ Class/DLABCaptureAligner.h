@@ -0,0 +1,121 @@
+//
+//  DLABCaptureAligner.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABCaptureAligner_h
+#define DLABCaptureAligner_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "DLABLatencyStats.h"
+
+/*
+ * Internal use only
+ * Align frames of multiple capture devices into bundles per instant
+ * (plain C++, no Apple framework dependency)
+ *
+ * Each member submits opaque item with its time on shared timeline (nanoseconds).
+ * Time is quantized by frame duration into instant. Bundle is delivered when
+ * every member is present, or when maxWait has elapsed since its first arrival.
+ * Delivering a bundle also delivers every older pending bundle first, so bundles
+ * are always delivered in instant order.
+ *
+ * A frame for an instant which is already delivered is late; it is either dropped
+ * or delivered alone, according to LatePolicy.
+ *
+ * Not thread safe; caller should serialize Submit/Poll/Flush on one queue.
+ * Statistics are safe to query from any thread.
+ */
+
+class DLABCaptureAligner
+{
+public:
+    static const uint32_t kMaxMemberCount = 16;
+    static const uint32_t kMaxPendingCount = 8;
+
+    typedef enum {
+        LatePolicyDrop = 0,
+        LatePolicyDeliver = 1,
+    } LatePolicy;
+
+    typedef enum {
+        StatsStageSkew = 0,     // max - min of member times in bundle
+        StatsStageWait = 1,     // first arrival => delivery
+        StatsStageCount
+    } StatsStage;
+
+    struct Bundle {
+        int64_t instant;                    // time / duration (rounded)
+        int64_t firstArrival;               // host time of first member arrival
+        uint32_t presentCount;
+        bool late;
+        void* items[kMaxMemberCount];       // NULL if missing
+        int64_t times[kMaxMemberCount];
+    };
+
+    // Ownership of items moves into deliver/drop callback
+    typedef void (*DeliverFunc)(const Bundle& bundle, void* context);
+    typedef void (*DropFunc)(void* item, void* context);
+
+    DLABCaptureAligner(uint32_t memberCount, DeliverFunc deliver, DropFunc drop, void* context);
+    ~DLABCaptureAligner();
+
+    // Configuration
+    void SetMaxWait(int64_t nanoseconds) { maxWait = nanoseconds; }
+    void SetLatePolicy(LatePolicy policy) { latePolicy = policy; }
+    uint32_t MemberCount() const { return memberCount; }
+
+    // Submit one item of member; may deliver bundles synchronously
+    void Submit(uint32_t member, int64_t time, int64_t duration, void* item, int64_t now);
+    // Deliver bundles whose wait has expired; returns next deadline, or 0 if no pending bundle
+    int64_t Poll(int64_t now);
+    // Deliver every pending bundle
+    void Flush(int64_t now);
+    // Drop every pending item, and forget last delivered instant; for restart after Flush
+    void Reset();
+
+    // Statistics
+    uint64_t CompleteCount() const { return completeCount.load(std::memory_order_relaxed); }
+    uint64_t PartialCount() const { return partialCount.load(std::memory_order_relaxed); }
+    uint64_t LateCount() const { return lateCount.load(std::memory_order_relaxed); }
+    uint64_t DropCount() const { return dropCount.load(std::memory_order_relaxed); }
+    DLABLatencyStats::Snapshot GetSnapshot(StatsStage stage) const { return stats.GetSnapshot(stage); }
+    void ResetStatistics();
+
+private:
+    DLABCaptureAligner(const DLABCaptureAligner&) = delete;
+    DLABCaptureAligner& operator=(const DLABCaptureAligner&) = delete;
+
+    Bundle* PendingBundleOf(int64_t instant, int64_t now);
+    void DeliverFront(uint32_t count, int64_t now);
+    void SubmitLate(uint32_t member, int64_t instant, int64_t time, void* item, int64_t now);
+    void DropItem(void* item);
+
+    uint32_t memberCount;
+    DeliverFunc deliver;
+    DropFunc drop;
+    void* context;
+
+    int64_t maxWait;
+    LatePolicy latePolicy;
+
+    Bundle pending[kMaxPendingCount];   // sorted by instant
+    uint32_t pendingCount;
+    bool hasDelivered;
+    int64_t lastInstant;
+
+    std::atomic<uint64_t> completeCount;
+    std::atomic<uint64_t> partialCount;
+    std::atomic<uint64_t> lateCount;
+    std::atomic<uint64_t> dropCount;
+    DLABLatencyStats stats;
+};
+
+#endif /* DLABCaptureAligner_h */
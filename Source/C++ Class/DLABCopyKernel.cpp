@@ -0,0 +1,233 @@
+//
+//  DLABCopyKernel.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABCopyKernel.h"
+
+#include <string.h>
+#include <atomic>
+
+/* =================================================================================== */
+// MARK: - blit
+/* =================================================================================== */
+
+static const size_t kCacheLineBytes = 64;
+static const size_t kPrefetchRows = 2;
+static const size_t kStreamPrefetchBytes = 8 * kCacheLineBytes;
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_nontemporal_store)
+#define DLAB_HAS_NONTEMPORAL_STORE 1
+#endif
+#endif
+
+// Compilers without the builtin (e.g. gcc) still have SSE2 intrinsic on x86
+#if !DLAB_HAS_NONTEMPORAL_STORE && defined(__SSE2__)
+#include <emmintrin.h>
+#define DLAB_HAS_NONTEMPORAL_STORE 1
+#define DLAB_NONTEMPORAL_STORE_SSE2 1
+#endif
+
+#if DLAB_HAS_NONTEMPORAL_STORE
+typedef uint64_t DLABBlitVector __attribute__((vector_size(16)));
+
+// Non-temporal copy of one span; head/tail outside 16 bytes alignment use memcpy.
+// Lowered to movntdq (x86) or stnp (arm64) by the compiler.
+static void streamSpan(uint8_t* dst, const uint8_t* src, size_t length)
+{
+    size_t head = (16 - ((uintptr_t)dst & 15)) & 15;
+    if (head > length) head = length;
+    if (head) {
+        memcpy(dst, src, head);
+        dst += head; src += head; length -= head;
+    }
+
+    DLABBlitVector* dstVector = (DLABBlitVector*)dst;
+    size_t count = length / sizeof(DLABBlitVector);
+    for (size_t i = 0; i < count; i++) {
+        // Source is read once; prefetch a few cache lines ahead without polluting cache
+        if ((i % (kCacheLineBytes / sizeof(DLABBlitVector))) == 0) {
+            __builtin_prefetch(src + i * sizeof(DLABBlitVector) + kStreamPrefetchBytes, 0, 0);
+        }
+        DLABBlitVector value;
+        memcpy(&value, src + i * sizeof(DLABBlitVector), sizeof(value)); // unaligned load
+#if DLAB_NONTEMPORAL_STORE_SSE2
+        _mm_stream_si128((__m128i*)(dstVector + i), (__m128i)value);
+#else
+        __builtin_nontemporal_store(value, dstVector + i);
+#endif
+    }
+
+    size_t done = count * sizeof(DLABBlitVector);
+    if (length > done) {
+        memcpy(dst + done, src + done, length - done);
+    }
+}
+
+// Non-temporal stores are weakly ordered; publish them before returning
+static inline void streamFence()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+}
+#endif
+
+static inline void prefetchSpan(const uint8_t* src, size_t length)
+{
+    for (size_t offset = 0; offset < length; offset += kCacheLineBytes) {
+        __builtin_prefetch(src + offset, 0, 0);
+    }
+}
+
+bool DLABBlit2D(const void* src, size_t srcRowBytes,
+                void* dst, size_t dstRowBytes,
+                size_t rowLength, size_t height, DLABBlitMode mode)
+{
+    if (!src || !dst || !rowLength || !height) return false;
+    if (height > 1 && (rowLength > srcRowBytes || rowLength > dstRowBytes)) return false;
+
+    const uint8_t* srcLine = (const uint8_t*)src;
+    uint8_t* dstLine = (uint8_t*)dst;
+
+    // Same stride; copy as one span (row padding included, except after last row)
+    size_t rowCount = height;
+    size_t spanLength = rowLength;
+    if (srcRowBytes == dstRowBytes) {
+        spanLength = srcRowBytes * (height - 1) + rowLength;
+        rowCount = 1;
+    }
+
+#if DLAB_HAS_NONTEMPORAL_STORE
+    if (mode == DLABBlitModeStreaming) {
+        for (size_t line = 0; line < rowCount; line++) {
+            streamSpan(dstLine, srcLine, spanLength);
+            srcLine += srcRowBytes;
+            dstLine += dstRowBytes;
+        }
+        streamFence();
+        return true;
+    }
+#endif
+
+    if (mode == DLABBlitModePrefetch && rowCount > 1) {
+        // Hardware prefetcher stalls at each stride gap; request rows ahead explicitly
+        for (size_t line = 0; line < kPrefetchRows && line < rowCount; line++) {
+            prefetchSpan(srcLine + srcRowBytes * line, spanLength);
+        }
+        for (size_t line = 0; line < rowCount; line++) {
+            if (line + kPrefetchRows < rowCount) {
+                prefetchSpan(srcLine + srcRowBytes * kPrefetchRows, spanLength);
+            }
+            memcpy(dstLine, srcLine, spanLength);
+            srcLine += srcRowBytes;
+            dstLine += dstRowBytes;
+        }
+        return true;
+    }
+
+    for (size_t line = 0; line < rowCount; line++) {
+        memcpy(dstLine, srcLine, spanLength);
+        srcLine += srcRowBytes;
+        dstLine += dstRowBytes;
+    }
+    return true;
+}
+
+DLABBlitMode DLABBlitModeForSize(size_t bytes)
+{
+    return (bytes >= DLABBlitLargeFrameBytes ? DLABBlitModePrefetch : DLABBlitModeCached);
+}
+
+DLABBlitMode DLABBlitModeSelect(bool streaming, size_t bytes)
+{
+    return (streaming ? DLABBlitModeStreaming : DLABBlitModeForSize(bytes));
+}
+
+/* =================================================================================== */
+// MARK: - kernels
+/* =================================================================================== */
+
+// Bytes of one packed row; BlockBytes for every BlockPixels pixels
+template <size_t BlockBytes, size_t BlockPixels>
+static inline size_t packedRowBytes(size_t width)
+{
+    return ((width + BlockPixels - 1) / BlockPixels) * BlockBytes;
+}
+
+template <size_t BlockBytes, size_t BlockPixels, bool StrideEqual>
+static bool copyPlane(const void* src, size_t srcRowBytes,
+                      void* dst, size_t dstRowBytes,
+                      size_t width, size_t height, DLABBlitMode mode)
+{
+    if (!src || !dst || !width || !height) return false;
+
+    size_t rowLength = packedRowBytes<BlockBytes, BlockPixels>(width);
+    if (srcRowBytes < rowLength) return false;
+    if (StrideEqual) {
+        // bulk copy including row padding
+        return DLABBlit2D(src, srcRowBytes, dst, srcRowBytes, srcRowBytes, height, mode);
+    } else {
+        // line copy with different stride
+        if (dstRowBytes < rowLength) return false;
+        return DLABBlit2D(src, srcRowBytes, dst, dstRowBytes, rowLength, height, mode);
+    }
+}
+
+/* =================================================================================== */
+// MARK: - table
+/* =================================================================================== */
+
+typedef struct {
+    uint32_t dlFormat;
+    uint32_t cvFormat;
+    size_t pixelSize;
+    DLABCopyKernelFunc copyStrideEqual;
+    DLABCopyKernelFunc copyStrideDiffer;
+} DLABCopyKernelEntry;
+
+#define DLAB_COPY_ENTRY(dl, cv, blockBytes, blockPixels) \
+    { dl, cv, (blockBytes + blockPixels - 1) / blockPixels, \
+      copyPlane<blockBytes, blockPixels, true>, \
+      copyPlane<blockBytes, blockPixels, false> }
+
+static const DLABCopyKernelEntry kCopyKernelTable[] = {
+    DLAB_COPY_ENTRY(0x32767579, 0x32767579,   4,  2),   // '2vuy' : 4 bytes 2 pixels block
+    DLAB_COPY_ENTRY(0x76323130, 0x76323130, 128, 48),   // 'v210' : 128 bytes 48 pixels row unit
+    DLAB_COPY_ENTRY(0x00000020, 0x00000020,   4,  1),   // ARGB   : 4 bytes 1 pixel block
+    DLAB_COPY_ENTRY(0x42475241, 0x42475241,   4,  1),   // 'BGRA' : 4 bytes 1 pixel block
+    DLAB_COPY_ENTRY(0x72323130, 0x72323130,   4,  1),   // 'r210' : 4 bytes 1 pixel block
+    DLAB_COPY_ENTRY(0x52313242, 0x52313242,  36,  8),   // 'R12B' : 36 bytes 8 pixels block
+    DLAB_COPY_ENTRY(0x5231324C, 0x5231324C,  36,  8),   // 'R12L' : 36 bytes 8 pixels block
+    DLAB_COPY_ENTRY(0x5231306C, 0x5231306C,   4,  1),   // 'R10l' : 4 bytes 1 pixel block
+    DLAB_COPY_ENTRY(0x52313062, 0x52313062,   4,  1),   // 'R10b' : 4 bytes 1 pixel block
+};
+
+#undef DLAB_COPY_ENTRY
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+DLABCopyKernel DLABCopyKernelResolve(uint32_t dlFormat, uint32_t cvFormat, bool strideEqual)
+{
+    DLABCopyKernel kernel = {NULL, 0, dlFormat, cvFormat, strideEqual};
+    size_t count = sizeof(kCopyKernelTable) / sizeof(kCopyKernelTable[0]);
+    for (size_t i = 0; i < count; i++) {
+        const DLABCopyKernelEntry& entry = kCopyKernelTable[i];
+        if (entry.dlFormat == dlFormat && entry.cvFormat == cvFormat) {
+            kernel.copy = (strideEqual ? entry.copyStrideEqual : entry.copyStrideDiffer);
+            kernel.pixelSize = entry.pixelSize;
+            break;
+        }
+    }
+    return kernel;
+}
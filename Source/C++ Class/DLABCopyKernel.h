@@ -0,0 +1,93 @@
+//
+//  DLABCopyKernel.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABCopyKernel_h
+#define DLABCopyKernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Internal use only
+ * Specialized plane copy kernels per (DeckLink format, CoreVideo format, stride-equal)
+ * (plain C++, no Apple framework dependency)
+ *
+ * Each kernel is a template instance with block size of the pixel format and
+ * stride equality fixed at compile time. Caller resolves kernel once when the
+ * pixel buffer pool is (re)built, then the per-frame copy is a single indirect call.
+ *
+ * Only identical format pairs are listed; any other pair requires conversion
+ * and is resolved to NULL.
+ *
+ * DLABBlit2D() is the row copy primitive shared by every kernel and plane copy.
+ * DLABBlitModeStreaming suits destination which is consumed by hardware (encoder,
+ * disk I/O) without CPU access; it avoids evicting working set of other threads.
+ */
+
+/// Row store strategy of DLABBlit2D
+typedef enum {
+    DLABBlitModeCached = 0,             // memcpy per row
+    DLABBlitModePrefetch = 1,           // memcpy per row, prefetching source rows ahead
+    DLABBlitModeStreaming = 2,          // non-temporal stores with source prefetch; destination bypasses cache
+} DLABBlitMode;
+
+/// Frames of this size or larger are copied with DLABBlitModePrefetch by DLABBlitModeForSize()
+#define DLABBlitLargeFrameBytes (1024 * 1024)
+
+/// Plane copy kernel. Returns false if parameters are invalid.
+typedef bool (*DLABCopyKernelFunc)(const void* src, size_t srcRowBytes,
+                                   void* dst, size_t dstRowBytes,
+                                   size_t width, size_t height, DLABBlitMode mode);
+
+typedef struct {
+    DLABCopyKernelFunc copy;            // NULL if no specialized kernel is available
+    size_t pixelSize;                   // bytes per pixel (rounded up) for vImageCopyBuffer
+    uint32_t dlFormat;                  // format pair the kernel is resolved for
+    uint32_t cvFormat;
+    bool strideEqual;                   // stride equality the kernel is resolved for
+} DLABCopyKernel;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Resolve specialized copy kernel for the format pair.
+/// @param dlFormat BMDPixelFormat of DeckLink video frame
+/// @param cvFormat OSType of CVPixelBuffer
+/// @param strideEqual true if both rowBytes are same
+/// @return kernel; copy is NULL if the pair is not supported
+DLABCopyKernel DLABCopyKernelResolve(uint32_t dlFormat, uint32_t cvFormat, bool strideEqual);
+
+/// Copy rowLength bytes of each row between buffers of independent stride.
+/// When both strides are same, rows are copied as one contiguous span.
+/// @param src source base address
+/// @param srcRowBytes source stride
+/// @param dst destination base address
+/// @param dstRowBytes destination stride
+/// @param rowLength bytes to copy per row; should not exceed either stride
+/// @param height number of rows
+/// @param mode row store strategy
+/// @return false if parameters are invalid
+bool DLABBlit2D(const void* src, size_t srcRowBytes,
+                void* dst, size_t dstRowBytes,
+                size_t rowLength, size_t height, DLABBlitMode mode);
+
+/// Default DLABBlitMode for copy of specified bytes
+DLABBlitMode DLABBlitModeForSize(size_t bytes);
+
+/// DLABBlitMode for copy of specified bytes; streaming if requested, otherwise default
+DLABBlitMode DLABBlitModeSelect(bool streaming, size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLABCopyKernel_h */
@@ -0,0 +1,73 @@
+//
+//  DLABDelegateQueueGate.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <atomic>
+#import <deque>
+#import <mutex>
+
+/*
+ * Internal use only
+ * Bounded admission control for captured samples on delegate queue.
+ *
+ * Each sample passed to delegate queue is wrapped by Ticket. Gate owns the
+ * sample until Take() is called on delegate queue. Video ticket can be
+ * dropped either at admission (drop newest) or while pending (drop oldest);
+ * dropped sample is released immediately, so its CVPixelBuffer returns to
+ * the pool without waiting for delegate queue. Audio is never dropped.
+ *
+ * Gate is reference counted; each pending ticket retains gate.
+ */
+
+class DLABDelegateQueueGate
+{
+public:
+    typedef enum {
+        PolicyNone = 0,         // Unlimited
+        PolicyDropOldest = 1,   // Drop oldest pending video
+        PolicyDropNewest = 2,   // Drop incoming video
+    } Policy;
+
+    struct Ticket;
+
+    DLABDelegateQueueGate();
+
+    // Check before creating video sample. Returns true (and counts drop) if incoming video should be dropped.
+    bool ShouldDropNewest(Policy policy, size_t limit);
+
+    // Admission. Ownership of sample is transferred to gate.
+    Ticket* EnqueueVideo(CFTypeRef sample, Policy policy, size_t limit);
+    Ticket* EnqueueAudio(CFTypeRef sample);
+
+    // Called on delegate queue. Returns sample (caller should release) or NULL if dropped.
+    CFTypeRef Take(Ticket* ticket);
+
+    // Counters
+    uint64_t PendingVideoCount();
+    uint64_t PendingAudioCount() const { return pendingAudio.load(std::memory_order_relaxed); }
+    uint64_t QueuedVideoCount() const { return queuedVideo.load(std::memory_order_relaxed); }
+    uint64_t QueuedAudioCount() const { return queuedAudio.load(std::memory_order_relaxed); }
+    uint64_t DroppedVideoCount() const { return droppedVideo.load(std::memory_order_relaxed); }
+
+    // Reference counting
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABDelegateQueueGate();
+
+    std::mutex mutex;
+    std::deque<Ticket*> pendingVideo;   // oldest first
+    std::atomic<uint64_t> pendingAudio;
+    std::atomic<uint64_t> queuedVideo;
+    std::atomic<uint64_t> queuedAudio;
+    std::atomic<uint64_t> droppedVideo;
+    std::atomic<ULONG> refCount;
+};
@@ -0,0 +1,130 @@
+//
+//  DLABDelegateQueueGate.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABDelegateQueueGate.h>
+#import <algorithm>
+
+struct DLABDelegateQueueGate::Ticket {
+    CFTypeRef sample;   // NULL if dropped
+    bool video;
+};
+
+/* =================================================================================== */
+// MARK: - DLABDelegateQueueGate
+/* =================================================================================== */
+
+DLABDelegateQueueGate::DLABDelegateQueueGate()
+: pendingAudio(0), queuedVideo(0), queuedAudio(0), droppedVideo(0), refCount(1)
+{
+}
+
+DLABDelegateQueueGate::~DLABDelegateQueueGate()
+{
+    // No pending ticket here; each ticket retains gate
+}
+
+bool DLABDelegateQueueGate::ShouldDropNewest(Policy policy, size_t limit)
+{
+    if (policy != PolicyDropNewest || limit == 0) return false;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pendingVideo.size() < limit) return false;
+    droppedVideo.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+DLABDelegateQueueGate::Ticket* DLABDelegateQueueGate::EnqueueVideo(CFTypeRef sample, Policy policy, size_t limit)
+{
+    if (!sample) return NULL;
+    
+    CFTypeRef doomedSample = NULL;
+    Ticket* ticket = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (policy != PolicyNone && limit > 0 && pendingVideo.size() >= limit) {
+            if (policy == PolicyDropNewest) {
+                doomedSample = sample;
+            } else {
+                // Drop oldest pending one; its ticket remains until Take()
+                Ticket* oldest = pendingVideo.front();
+                pendingVideo.pop_front();
+                doomedSample = oldest->sample;
+                oldest->sample = NULL;
+            }
+            droppedVideo.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (doomedSample != sample) {
+            ticket = new Ticket{sample, true};
+            pendingVideo.push_back(ticket);
+            queuedVideo.fetch_add(1, std::memory_order_relaxed);
+            AddRef();
+        }
+    }
+    
+    // Release outside of lock
+    if (doomedSample) CFRelease(doomedSample);
+    return ticket;
+}
+
+DLABDelegateQueueGate::Ticket* DLABDelegateQueueGate::EnqueueAudio(CFTypeRef sample)
+{
+    if (!sample) return NULL;
+    
+    Ticket* ticket = new Ticket{sample, false};
+    pendingAudio.fetch_add(1, std::memory_order_relaxed);
+    queuedAudio.fetch_add(1, std::memory_order_relaxed);
+    AddRef();
+    return ticket;
+}
+
+CFTypeRef DLABDelegateQueueGate::Take(Ticket* ticket)
+{
+    if (!ticket) return NULL;
+    
+    CFTypeRef sample = NULL;
+    if (ticket->video) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sample = ticket->sample;
+        if (sample) {
+            // Delegate queue is serial; ticket is usually at front
+            auto it = std::find(pendingVideo.begin(), pendingVideo.end(), ticket);
+            if (it != pendingVideo.end()) pendingVideo.erase(it);
+        }
+    } else {
+        sample = ticket->sample;
+        pendingAudio.fetch_sub(1, std::memory_order_relaxed);
+    }
+    delete ticket;
+    Release();
+    return sample;
+}
+
+uint64_t DLABDelegateQueueGate::PendingVideoCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (uint64_t)pendingVideo.size();
+}
+
+// Reference counting
+
+ULONG DLABDelegateQueueGate::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABDelegateQueueGate::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
@@ -0,0 +1,135 @@
+//
+//  DLABFramePool.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABFramePool.h"
+
+/* =================================================================================== */
+// MARK: - lifecycle
+/* =================================================================================== */
+
+DLABFramePool::DLABFramePool(uint32_t newCapacity)
+: capacity(newCapacity < kMaxCapacity ? newCapacity : kMaxCapacity),
+  head((uint64_t)kNil), count(0), idleCount(0)
+{
+    for (uint32_t i = 0; i < kMaxCapacity; i++) {
+        slots[i].item.store(NULL, std::memory_order_relaxed);
+        slots[i].state.store(kSlotEmpty, std::memory_order_relaxed);
+        slots[i].next.store(kNil, std::memory_order_relaxed);
+    }
+}
+
+DLABFramePool::~DLABFramePool()
+{
+    // Items are owned by caller. Call RemoveAll() before delete.
+}
+
+/* =================================================================================== */
+// MARK: - idle stack (tagged index)
+/* =================================================================================== */
+
+void DLABFramePool::PushIdle(uint32_t index)
+{
+    uint64_t oldHead = head.load(std::memory_order_acquire);
+    uint64_t newHead = 0;
+    do {
+        slots[index].next.store((uint32_t)oldHead, std::memory_order_relaxed);
+        uint64_t tag = (oldHead >> 32) + 1;
+        newHead = (tag << 32) | index;
+    } while (!head.compare_exchange_weak(oldHead, newHead,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire));
+    idleCount.fetch_add(1, std::memory_order_acq_rel);
+}
+
+uint32_t DLABFramePool::PopIdle()
+{
+    uint64_t oldHead = head.load(std::memory_order_acquire);
+    uint64_t newHead = 0;
+    uint32_t index = kNil;
+    do {
+        index = (uint32_t)oldHead;
+        if (index == kNil) return kNil;
+        uint32_t next = slots[index].next.load(std::memory_order_relaxed);
+        uint64_t tag = (oldHead >> 32) + 1;
+        newHead = (tag << 32) | next;
+    } while (!head.compare_exchange_weak(oldHead, newHead,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire));
+    idleCount.fetch_sub(1, std::memory_order_acq_rel);
+    return index;
+}
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+bool DLABFramePool::Add(void* item)
+{
+    if (!item) return false;
+    for (uint32_t i = 0; i < capacity; i++) {
+        uint32_t expected = kSlotEmpty;
+        if (slots[i].state.compare_exchange_strong(expected, kSlotClaimed,
+                                                   std::memory_order_acq_rel)) {
+            slots[i].item.store(item, std::memory_order_release);
+            slots[i].state.store(kSlotIdle, std::memory_order_release);
+            count.fetch_add(1, std::memory_order_acq_rel);
+            PushIdle(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void* DLABFramePool::Reserve()
+{
+    uint32_t index = PopIdle();
+    if (index == kNil) return NULL;
+    slots[index].state.store(kSlotBusy, std::memory_order_release);
+    return slots[index].item.load(std::memory_order_acquire);
+}
+
+bool DLABFramePool::Release(void* item)
+{
+    if (!item) return false;
+    for (uint32_t i = 0; i < capacity; i++) {
+        if (slots[i].item.load(std::memory_order_acquire) != item) continue;
+        uint32_t expected = kSlotBusy;
+        if (slots[i].state.compare_exchange_strong(expected, kSlotIdle,
+                                                   std::memory_order_acq_rel)) {
+            PushIdle(i);
+            return true;
+        }
+        return false;   // registered but not reserved
+    }
+    return false;
+}
+
+void* DLABFramePool::Shrink()
+{
+    uint32_t index = PopIdle();
+    if (index == kNil) return NULL;
+    void* item = slots[index].item.exchange(NULL, std::memory_order_acq_rel);
+    slots[index].state.store(kSlotEmpty, std::memory_order_release);
+    count.fetch_sub(1, std::memory_order_acq_rel);
+    return item;
+}
+
+void DLABFramePool::RemoveAll(ItemHandler handler, void* context)
+{
+    for (uint32_t i = 0; i < capacity; i++) {
+        void* item = slots[i].item.exchange(NULL, std::memory_order_acq_rel);
+        slots[i].state.store(kSlotEmpty, std::memory_order_release);
+        slots[i].next.store(kNil, std::memory_order_relaxed);
+        if (item && handler) handler(item, context);
+    }
+    head.store((uint64_t)kNil, std::memory_order_release);
+    count.store(0, std::memory_order_release);
+    idleCount.store(0, std::memory_order_release);
+}
@@ -0,0 +1,83 @@
+//
+//  DLABFramePool.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABFramePool_h
+#define DLABFramePool_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/*
+ * Internal use only
+ * Fixed capacity, allocation free MPMC free-list (plain C++, no Apple framework dependency)
+ *
+ * Each registered item occupies one slot. Idle slots are linked in lock-free
+ * stack with tagged head (ABA safe). Item is opaque pointer; pool never
+ * retains/releases it, so owner is responsible for lifetime.
+ *
+ * - Reserve/Release are lock-free and safe from any thread.
+ * - Release of unknown or already idle item is rejected.
+ * - Add/Shrink are lock-free too, but RemoveAll requires quiescent state.
+ */
+
+class DLABFramePool
+{
+public:
+    typedef void (*ItemHandler)(void* item, void* context);
+
+    static const uint32_t kMaxCapacity = 64;
+
+    explicit DLABFramePool(uint32_t capacity);
+    ~DLABFramePool();
+
+    // Register new item as idle. Returns false if pool is full.
+    bool Add(void* item);
+
+    // Take idle item out of pool. Returns NULL if no idle item.
+    void* Reserve();
+
+    // Return reserved item to pool. Returns false if item is not reserved one.
+    bool Release(void* item);
+
+    // Unregister one idle item and return it. Returns NULL if no idle item.
+    void* Shrink();
+
+    // Unregister all items (either idle or reserved). Handler is called per item.
+    void RemoveAll(ItemHandler handler, void* context);
+
+    uint32_t Capacity() const { return capacity; }
+    uint32_t Count() const { return count.load(std::memory_order_acquire); }
+    uint32_t IdleCount() const { return idleCount.load(std::memory_order_acquire); }
+
+private:
+    DLABFramePool(const DLABFramePool&) = delete;
+    DLABFramePool& operator=(const DLABFramePool&) = delete;
+
+    enum : uint32_t { kSlotEmpty = 0, kSlotIdle = 1, kSlotBusy = 2, kSlotClaimed = 3 };
+    static const uint32_t kNil = 0xFFFFFFFF;
+
+    struct Slot {
+        std::atomic<void*> item;
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> next;
+    };
+
+    void PushIdle(uint32_t index);
+    uint32_t PopIdle();
+
+    uint32_t capacity;
+    Slot slots[kMaxCapacity];
+    std::atomic<uint64_t> head;     // (tag << 32) | index
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> idleCount;
+};
+
+#endif /* DLABFramePool_h */
@@ -0,0 +1,130 @@
+//
+//  DLABLatencyStats.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABLatencyStats.h"
+
+#include <chrono>
+
+/* =================================================================================== */
+// MARK: - lifecycle
+/* =================================================================================== */
+
+DLABLatencyStats::DLABLatencyStats(uint32_t newStageCount)
+: stageCount(newStageCount < kMaxStageCount ? newStageCount : kMaxStageCount),
+  histograms(new Histogram[stageCount])
+{
+    Reset();
+}
+
+DLABLatencyStats::~DLABLatencyStats()
+{
+    delete[] histograms;
+}
+
+uint64_t DLABLatencyStats::Now()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+/* =================================================================================== */
+// MARK: - bucket
+/* =================================================================================== */
+
+uint32_t DLABLatencyStats::BucketOf(uint64_t value)
+{
+    // bucket 0..15 : linear (0..15 nSec)
+    // bucket 16..  : 16 sub-buckets per power of two
+    if (value < kSubBucketCount) return (uint32_t)value;
+    uint32_t exponent = 63 - (uint32_t)__builtin_clzll(value);
+    if (exponent > kMaxExponent) return kBucketCount - 1;
+    uint32_t sub = (uint32_t)(value >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBucketCount + sub;
+}
+
+uint64_t DLABLatencyStats::ValueOf(uint32_t bucket)
+{
+    // Middle value of the bucket
+    if (bucket < kSubBucketCount) return bucket;
+    uint32_t exponent = bucket / kSubBucketCount + kSubBucketBits - 1;
+    uint64_t sub = bucket % kSubBucketCount;
+    uint64_t width = 1ULL << (exponent - kSubBucketBits);
+    return (kSubBucketCount + sub) * width + width / 2;
+}
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+void DLABLatencyStats::Record(uint32_t stage, uint64_t nanoseconds)
+{
+    if (stage >= stageCount) return;
+    Histogram& histogram = histograms[stage];
+    histogram.buckets[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    histogram.count.fetch_add(1, std::memory_order_relaxed);
+    histogram.sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+    
+    uint64_t current = histogram.max.load(std::memory_order_relaxed);
+    while (nanoseconds > current &&
+           !histogram.max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+DLABLatencyStats::Snapshot DLABLatencyStats::GetSnapshot(uint32_t stage) const
+{
+    Snapshot snapshot = {};
+    if (stage >= stageCount) return snapshot;
+    const Histogram& histogram = histograms[stage];
+    
+    // Use sum of buckets as total, since count may run ahead during Record()
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < kBucketCount; i++) {
+        total += histogram.buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) return snapshot;
+    
+    uint64_t p50Target = (total * 50 + 99) / 100;
+    uint64_t p99Target = (total * 99 + 99) / 100;
+    uint64_t cumulative = 0;
+    bool p50Found = false;              // p50 may be 0 (bucket 0)
+    for (uint32_t i = 0; i < kBucketCount; i++) {
+        uint64_t bucketCount = histogram.buckets[i].load(std::memory_order_relaxed);
+        if (!bucketCount) continue;
+        cumulative += bucketCount;
+        if (!p50Found && cumulative >= p50Target) {
+            snapshot.p50 = ValueOf(i);
+            p50Found = true;
+        }
+        if (cumulative >= p99Target) {
+            snapshot.p99 = ValueOf(i);
+            break;
+        }
+    }
+    
+    snapshot.count = total;
+    snapshot.max = histogram.max.load(std::memory_order_relaxed);
+    snapshot.mean = histogram.sum.load(std::memory_order_relaxed) / total;
+    if (snapshot.p50 > snapshot.max) snapshot.p50 = snapshot.max;
+    if (snapshot.p99 > snapshot.max) snapshot.p99 = snapshot.max;
+    return snapshot;
+}
+
+void DLABLatencyStats::Reset()
+{
+    for (uint32_t stage = 0; stage < stageCount; stage++) {
+        Histogram& histogram = histograms[stage];
+        for (uint32_t i = 0; i < kBucketCount; i++) {
+            histogram.buckets[i].store(0, std::memory_order_relaxed);
+        }
+        histogram.count.store(0, std::memory_order_relaxed);
+        histogram.sum.store(0, std::memory_order_relaxed);
+        histogram.max.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,78 @@
+//
+//  DLABLatencyStats.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABLatencyStats_h
+#define DLABLatencyStats_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/*
+ * Internal use only
+ * Lock-free latency histograms per pipeline stage (plain C++, no Apple framework dependency)
+ *
+ * Values are nanoseconds. Buckets are log-linear (HDR style); each power of two
+ * is split into 16 sub-buckets, so relative error is within 1/32 (~3%).
+ * Record() is wait-free except max update, and safe from any thread.
+ * Snapshot() is not atomic across buckets; it is good enough for monitoring.
+ */
+
+class DLABLatencyStats
+{
+public:
+    static const uint32_t kMaxStageCount = 16;
+
+    typedef struct {
+        uint64_t count;
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t max;
+        uint64_t mean;
+    } Snapshot;
+
+    explicit DLABLatencyStats(uint32_t stageCount);
+    ~DLABLatencyStats();
+
+    // Monotonic clock in nanoseconds
+    static uint64_t Now();
+
+    // Record one sample of stage
+    void Record(uint32_t stage, uint64_t nanoseconds);
+    void RecordSince(uint32_t stage, uint64_t startTime) { Record(stage, Now() - startTime); }
+
+    // Query/Reset
+    Snapshot GetSnapshot(uint32_t stage) const;
+    void Reset();
+
+private:
+    DLABLatencyStats(const DLABLatencyStats&) = delete;
+    DLABLatencyStats& operator=(const DLABLatencyStats&) = delete;
+
+    static const uint32_t kSubBucketBits = 4;
+    static const uint32_t kSubBucketCount = 1 << kSubBucketBits;
+    static const uint32_t kMaxExponent = 40;    // ~18 minutes
+    static const uint32_t kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+    static uint32_t BucketOf(uint64_t value);
+    static uint64_t ValueOf(uint32_t bucket);
+
+    struct Histogram {
+        std::atomic<uint64_t> buckets[kBucketCount];
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+
+    uint32_t stageCount;
+    Histogram* histograms;
+};
+
+#endif /* DLABLatencyStats_h */
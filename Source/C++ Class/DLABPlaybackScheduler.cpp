@@ -0,0 +1,173 @@
+//
+//  DLABPlaybackScheduler.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABPlaybackScheduler.h"
+
+#include <string.h>
+
+static const uint32_t kDefaultTargetDepth = 3;
+
+DLABPlaybackScheduler::DLABPlaybackScheduler(ItemFunc retain, ItemFunc release)
+: retain(retain), release(release),
+  queueHead(0), lastItem(NULL), frameDuration(0), frameIndex(0),
+  targetDepth(kDefaultTargetDepth), queuedCount(0),
+  repeatedCount(0), skippedCount(0), rejectedCount(0)
+{
+    memset(queue, 0, sizeof(queue));
+    for (uint32_t i = 0; i < CompletionCount; i++) {
+        completionCount[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+DLABPlaybackScheduler::~DLABPlaybackScheduler()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ReleaseAllLocked();
+}
+
+/* =================================================================================== */
+// MARK: - control
+/* =================================================================================== */
+
+void DLABPlaybackScheduler::Start(int64_t frameDuration, uint32_t depth, int64_t startFrame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    this->frameDuration = (frameDuration > 0 ? frameDuration : 1);
+    this->frameIndex = (startFrame > 0 ? startFrame : 0);
+    SetTargetDepth(depth);
+}
+
+void DLABPlaybackScheduler::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ReleaseAllLocked();
+}
+
+void DLABPlaybackScheduler::SetTargetDepth(uint32_t depth)
+{
+    if (depth < 1) depth = 1;
+    targetDepth.store(depth, std::memory_order_relaxed);
+}
+
+int64_t DLABPlaybackScheduler::FrameIndex() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return frameIndex;
+}
+
+/* =================================================================================== */
+// MARK: - producer/consumer
+/* =================================================================================== */
+
+bool DLABPlaybackScheduler::Enqueue(void* item)
+{
+    if (!item) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t count = queuedCount.load(std::memory_order_relaxed);
+    if (count >= kQueueCapacity) {
+        rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queue[(queueHead + count) % kQueueCapacity] = item;
+    queuedCount.store(count + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void* DLABPlaybackScheduler::Next(int64_t* displayTime, bool* repeated)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool isRepeated = false;
+    uint32_t count = queuedCount.load(std::memory_order_relaxed);
+    if (count) {
+        // Fresh item replaces last item
+        void* item = queue[queueHead];
+        queue[queueHead] = NULL;
+        queueHead = (queueHead + 1) % kQueueCapacity;
+        queuedCount.store(count - 1, std::memory_order_relaxed);
+
+        if (lastItem) release(lastItem);
+        lastItem = item;
+    } else if (lastItem) {
+        // Starved; repeat last item
+        isRepeated = true;
+        repeatedCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        return NULL; // Nothing to schedule yet
+    }
+
+    if (displayTime) *displayTime = frameIndex * frameDuration;
+    if (repeated) *repeated = isRepeated;
+    frameIndex++;
+
+    retain(lastItem);
+    return lastItem;
+}
+
+uint32_t DLABPlaybackScheduler::CatchUp(int64_t streamTime)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frameDuration <= 0 || streamTime < 0) return 0;
+
+    // Next display time should be later than the frame currently on air
+    int64_t minIndex = streamTime / frameDuration + 1;
+    if (frameIndex >= minIndex) return 0;
+
+    uint32_t skipped = (uint32_t)(minIndex - frameIndex);
+    frameIndex = minIndex;
+    skippedCount.fetch_add(skipped, std::memory_order_relaxed);
+    return skipped;
+}
+
+/* =================================================================================== */
+// MARK: - statistics
+/* =================================================================================== */
+
+void DLABPlaybackScheduler::RecordCompletion(Completion completion)
+{
+    if (completion >= CompletionCount) return;
+    completionCount[completion].fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t DLABPlaybackScheduler::CompletionCountOf(Completion completion) const
+{
+    if (completion >= CompletionCount) return 0;
+    return completionCount[completion].load(std::memory_order_relaxed);
+}
+
+void DLABPlaybackScheduler::ResetStatistics()
+{
+    for (uint32_t i = 0; i < CompletionCount; i++) {
+        completionCount[i].store(0, std::memory_order_relaxed);
+    }
+    repeatedCount.store(0, std::memory_order_relaxed);
+    skippedCount.store(0, std::memory_order_relaxed);
+    rejectedCount.store(0, std::memory_order_relaxed);
+}
+
+/* =================================================================================== */
+// MARK: - private
+/* =================================================================================== */
+
+void DLABPlaybackScheduler::ReleaseAllLocked()
+{
+    uint32_t count = queuedCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t index = (queueHead + i) % kQueueCapacity;
+        if (queue[index]) release(queue[index]);
+        queue[index] = NULL;
+    }
+    queueHead = 0;
+    queuedCount.store(0, std::memory_order_relaxed);
+
+    if (lastItem) release(lastItem);
+    lastItem = NULL;
+}
@@ -0,0 +1,102 @@
+//
+//  DLABPlaybackScheduler.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABPlaybackScheduler_h
+#define DLABPlaybackScheduler_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+
+/*
+ * Internal use only
+ * Frame pacing state of scheduled playback (plain C++, no Apple framework dependency)
+ *
+ * Producer enqueues opaque items (ownership moves into scheduler). Consumer takes
+ * next item with its display time, computed from monotonic frame counter as
+ * (frameIndex * frameDuration). When queue is starved, last item is repeated so
+ * the timeline never has hole. When display time falls behind stream time,
+ * CatchUp skips frame counter ahead.
+ *
+ * Thread safe; every method may be called from any thread.
+ */
+
+class DLABPlaybackScheduler
+{
+public:
+    static const uint32_t kQueueCapacity = 8;
+
+    typedef void (*ItemFunc)(void* item);
+
+    typedef enum {
+        CompletionCompleted = 0,
+        CompletionLate = 1,
+        CompletionDropped = 2,
+        CompletionFlushed = 3,
+        CompletionCount
+    } Completion;
+
+    DLABPlaybackScheduler(ItemFunc retain, ItemFunc release);
+    ~DLABPlaybackScheduler();
+
+    // Reset frame counter and start timeline at startFrame
+    void Start(int64_t frameDuration, uint32_t targetDepth, int64_t startFrame);
+    // Release every queued item and last item
+    void Stop();
+
+    // Producer: take ownership of item. Returns false if queue is full (item is not consumed).
+    bool Enqueue(void* item);
+
+    // Consumer: returns retained item and its display time, or NULL if no item is available.
+    void* Next(int64_t* displayTime, bool* repeated);
+    // Consumer: skip frame counter ahead of streamTime. Returns number of skipped frames.
+    uint32_t CatchUp(int64_t streamTime);
+
+    void RecordCompletion(Completion completion);
+
+    // Configuration/State
+    uint32_t TargetDepth() const { return targetDepth.load(std::memory_order_relaxed); }
+    void SetTargetDepth(uint32_t depth);
+    uint32_t QueuedCount() const { return queuedCount.load(std::memory_order_relaxed); }
+    int64_t FrameIndex() const;
+
+    // Statistics
+    uint64_t CompletionCountOf(Completion completion) const;
+    uint64_t RepeatedCount() const { return repeatedCount.load(std::memory_order_relaxed); }
+    uint64_t SkippedCount() const { return skippedCount.load(std::memory_order_relaxed); }
+    uint64_t RejectedCount() const { return rejectedCount.load(std::memory_order_relaxed); }
+    void ResetStatistics();
+
+private:
+    DLABPlaybackScheduler(const DLABPlaybackScheduler&) = delete;
+    DLABPlaybackScheduler& operator=(const DLABPlaybackScheduler&) = delete;
+
+    void ReleaseAllLocked();
+
+    ItemFunc retain;
+    ItemFunc release;
+
+    mutable std::mutex mutex;
+    void* queue[kQueueCapacity];        // ring of items
+    uint32_t queueHead;
+    void* lastItem;                     // retained; repeated on starvation
+    int64_t frameDuration;
+    int64_t frameIndex;
+
+    std::atomic<uint32_t> targetDepth;
+    std::atomic<uint32_t> queuedCount;
+    std::atomic<uint64_t> completionCount[CompletionCount];
+    std::atomic<uint64_t> repeatedCount;
+    std::atomic<uint64_t> skippedCount;
+    std::atomic<uint64_t> rejectedCount;
+};
+
+#endif /* DLABPlaybackScheduler_h */
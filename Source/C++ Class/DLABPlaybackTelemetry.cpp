@@ -0,0 +1,139 @@
+//
+//  DLABPlaybackTelemetry.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABPlaybackTelemetry.h"
+
+static const int64_t kNanoSecondTimeScale = 1000000000;
+
+static int64_t nanosecondsOf(int64_t time, int64_t timeScale)
+{
+    if (timeScale <= 0) return 0;
+    return (int64_t)((__int128)time * kNanoSecondTimeScale / timeScale);
+}
+
+DLABPlaybackTelemetry::DLABPlaybackTelemetry()
+: hasAnchor(false), anchorCompletion(0), anchorDisplay(0), lastCompletion(0), lastDisplay(0),
+  stats(StatsStageCount)
+{
+    for (uint32_t i = 0; i < kMaxFrameCount; i++) {
+        slots[i].frame.store(NULL, std::memory_order_relaxed);
+    }
+    for (uint32_t i = 0; i < ResultCount; i++) {
+        resultCount[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+DLABPlaybackTelemetry::~DLABPlaybackTelemetry()
+{
+}
+
+/* =================================================================================== */
+// MARK: - schedule side
+/* =================================================================================== */
+
+void DLABPlaybackTelemetry::RecordScheduled(const void* frame, int64_t displayTime, int64_t frameDuration,
+                                            int64_t timeScale, int64_t scheduleTime)
+{
+    if (!frame) return;
+
+    // Same frame may be rescheduled after failure; reuse its slot
+    Slot* slot = NULL;
+    for (uint32_t i = 0; i < kMaxFrameCount && !slot; i++) {
+        if (slots[i].frame.load(std::memory_order_acquire) == frame) slot = &slots[i];
+    }
+    for (uint32_t i = 0; i < kMaxFrameCount && !slot; i++) {
+        const void* expected = NULL;
+        if (slots[i].frame.compare_exchange_strong(expected, frame, std::memory_order_acq_rel)) {
+            slot = &slots[i];
+        }
+    }
+    if (!slot) return; // Too many frames in flight; not measured
+
+    slot->displayTime.store(displayTime, std::memory_order_relaxed);
+    slot->frameDuration.store(frameDuration, std::memory_order_relaxed);
+    slot->timeScale.store(timeScale, std::memory_order_relaxed);
+    slot->scheduleTime.store(scheduleTime, std::memory_order_release);
+}
+
+/* =================================================================================== */
+// MARK: - completion side
+/* =================================================================================== */
+
+bool DLABPlaybackTelemetry::Complete(const void* frame, Result result, int64_t completionTime,
+                                     Completion* completion)
+{
+    if (result < ResultCount) {
+        resultCount[result].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Completion info = {};
+    info.result = result;
+    info.completionTime = completionTime;
+
+    Slot* slot = NULL;
+    for (uint32_t i = 0; i < kMaxFrameCount && frame && !slot; i++) {
+        if (slots[i].frame.load(std::memory_order_acquire) == frame) slot = &slots[i];
+    }
+    if (slot) {
+        int64_t scheduleTime = slot->scheduleTime.load(std::memory_order_acquire);
+        info.displayTime = slot->displayTime.load(std::memory_order_relaxed);
+        info.frameDuration = slot->frameDuration.load(std::memory_order_relaxed);
+        info.timeScale = slot->timeScale.load(std::memory_order_relaxed);
+        slot->frame.store(NULL, std::memory_order_release);
+
+        // Only frames which reached the air have meaningful completion timestamp
+        bool onAir = (result == ResultCompleted || result == ResultDisplayedLate);
+        if (onAir && completionTime > 0) {
+            if (scheduleTime > 0 && completionTime >= scheduleTime) {
+                info.scheduleToAir = completionTime - scheduleTime;
+                stats.Record(StatsStageScheduleToAir, (uint64_t)info.scheduleToAir);
+            }
+
+            int64_t display = nanosecondsOf(info.displayTime, info.timeScale);
+            if (!hasAnchor || display <= lastDisplay) {
+                // Start (or restart) of timeline
+                hasAnchor = true;
+                anchorCompletion = completionTime;
+                anchorDisplay = display;
+            } else {
+                int64_t expected = anchorCompletion + (display - anchorDisplay);
+                info.timingError = completionTime - expected;
+                uint64_t magnitude = (uint64_t)(info.timingError < 0 ? -info.timingError : info.timingError);
+                stats.Record(StatsStageTimingError, magnitude);
+                if (completionTime >= lastCompletion) {
+                    stats.Record(StatsStageInterval, (uint64_t)(completionTime - lastCompletion));
+                }
+            }
+            lastCompletion = completionTime;
+            lastDisplay = display;
+        }
+    }
+
+    if (completion) *completion = info;
+    return (slot != NULL);
+}
+
+/* =================================================================================== */
+// MARK: - statistics
+/* =================================================================================== */
+
+uint64_t DLABPlaybackTelemetry::ResultCountOf(Result result) const
+{
+    if (result >= ResultCount) return 0;
+    return resultCount[result].load(std::memory_order_relaxed);
+}
+
+void DLABPlaybackTelemetry::Reset()
+{
+    for (uint32_t i = 0; i < ResultCount; i++) {
+        resultCount[i].store(0, std::memory_order_relaxed);
+    }
+    stats.Reset();
+}
@@ -0,0 +1,106 @@
+//
+//  DLABPlaybackTelemetry.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABPlaybackTelemetry_h
+#define DLABPlaybackTelemetry_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "DLABLatencyStats.h"
+
+/*
+ * Internal use only
+ * Output frame completion telemetry (plain C++, no Apple framework dependency)
+ *
+ * Schedule side records hardware reference clock and display time per frame.
+ * Completion side matches the frame, and measures:
+ * - ScheduleToAir : completion timestamp - hardware clock at schedule
+ * - TimingError   : |completion timestamp - expected timestamp|, where expected
+ *                   one is extrapolated from the first completed frame using
+ *                   display time. Anchor is reset when display time goes back.
+ * - Interval      : completion timestamp - previous completion timestamp
+ * All times are nanoseconds of hardware reference clock.
+ *
+ * - RecordScheduled is lock-free and safe from any thread.
+ * - Complete should be called from one thread at a time (completion callback).
+ */
+
+class DLABPlaybackTelemetry
+{
+public:
+    static const uint32_t kMaxFrameCount = 16;
+
+    typedef enum {
+        StatsStageScheduleToAir = 0,
+        StatsStageTimingError = 1,
+        StatsStageInterval = 2,
+        StatsStageCount
+    } StatsStage;
+
+    typedef enum {
+        ResultCompleted = 0,
+        ResultDisplayedLate = 1,
+        ResultDropped = 2,
+        ResultFlushed = 3,
+        ResultCount
+    } Result;
+
+    struct Completion {
+        Result result;
+        int64_t displayTime;        // in timeScale; 0 if frame is not recorded
+        int64_t frameDuration;
+        int64_t timeScale;
+        int64_t completionTime;     // 0 if unavailable
+        int64_t scheduleToAir;      // 0 if unavailable
+        int64_t timingError;        // signed; 0 if unavailable
+    };
+
+    DLABPlaybackTelemetry();
+    ~DLABPlaybackTelemetry();
+
+    // Schedule side
+    void RecordScheduled(const void* frame, int64_t displayTime, int64_t frameDuration,
+                         int64_t timeScale, int64_t scheduleTime);
+
+    // Completion side; completionTime is 0 if unavailable. Returns false if frame is not recorded.
+    bool Complete(const void* frame, Result result, int64_t completionTime, Completion* completion);
+
+    // Statistics
+    uint64_t ResultCountOf(Result result) const;
+    DLABLatencyStats::Snapshot GetSnapshot(StatsStage stage) const { return stats.GetSnapshot(stage); }
+    void Reset();
+
+private:
+    DLABPlaybackTelemetry(const DLABPlaybackTelemetry&) = delete;
+    DLABPlaybackTelemetry& operator=(const DLABPlaybackTelemetry&) = delete;
+
+    struct Slot {
+        std::atomic<const void*> frame;
+        std::atomic<int64_t> displayTime;
+        std::atomic<int64_t> frameDuration;
+        std::atomic<int64_t> timeScale;
+        std::atomic<int64_t> scheduleTime;
+    };
+
+    Slot slots[kMaxFrameCount];
+
+    // Completion side only
+    bool hasAnchor;
+    int64_t anchorCompletion;
+    int64_t anchorDisplay;          // nanoseconds
+    int64_t lastCompletion;
+    int64_t lastDisplay;            // nanoseconds
+
+    std::atomic<uint64_t> resultCount[ResultCount];
+    DLABLatencyStats stats;
+};
+
+#endif /* DLABPlaybackTelemetry_h */
@@ -0,0 +1,460 @@
+//
+//  DLABRGBKernel.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABRGBKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DLAB_KERNEL_X86 1
+#define DLAB_TARGET_SSE41 __attribute__((target("sse4.1")))
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DLAB_KERNEL_NEON 1
+#endif
+
+/*
+ Fixed point scaling (computed once per call)
+
+ unpack : out = ((v - rangeMin) * mul + 2^11) >> 12     mul = outMax * 2^12 / (rangeMax - rangeMin)
+ pack   : out = rangeMin + ((v * mul + 2^15) >> 16)     mul = (rangeMax - rangeMin) * 2^16 / inMax
+                clamped to rangeMin..rangeMax
+
+ outMax/inMax is 4096 for ARGB16Q12, 65535 for ARGB16U.
+ */
+
+typedef struct {
+    int32_t rangeMin;
+    int32_t rangeMax;
+    int32_t mul;
+    int32_t alpha;
+    bool is16U;
+    int rShift, gShift, bShift; // 10bit component position in host endian word
+} DLABRGBParam;
+
+static DLABRGBParam makeParam(uint32_t format, int32_t rangeMin, int32_t rangeMax,
+                              bool is16U, bool unpack)
+{
+    DLABRGBParam param = {};
+    double range = (double)(rangeMax - rangeMin);
+    double full = (is16U ? 65535.0 : 4096.0);
+    param.rangeMin = rangeMin;
+    param.rangeMax = rangeMax;
+    param.mul = (unpack ? (int32_t)(full * 4096.0 / range + 0.5)
+                        : (int32_t)(range * 65536.0 / full + 0.5));
+    param.alpha = (int32_t)full;
+    param.is16U = is16U;
+    if (format == DLABKernelRGBFormat10BitRGBX) {
+        param.rShift = 22; param.gShift = 12; param.bShift = 2;
+    } else {
+        param.rShift = 20; param.gShift = 10; param.bShift = 0;
+    }
+    return param;
+}
+
+/* =================================================================================== */
+// MARK: - scalar
+/* =================================================================================== */
+
+static inline uint32_t loadBE32(const uint8_t* src)
+{
+    uint32_t word = 0;
+    memcpy(&word, src, sizeof(word));
+    return __builtin_bswap32(word);
+}
+
+static inline void storeBE32(uint8_t* dst, uint32_t word)
+{
+    word = __builtin_bswap32(word);
+    memcpy(dst, &word, sizeof(word));
+}
+
+static inline uint16_t unpackValue(const DLABRGBParam& param, int32_t v)
+{
+    int32_t out = ((v - param.rangeMin) * param.mul + 2048) >> 12;
+    if (param.is16U) {
+        out = (out < 0 ? 0 : (out > 65535 ? 65535 : out));
+    } else {
+        out = (out < -32768 ? -32768 : (out > 32767 ? 32767 : out));
+    }
+    return (uint16_t)out;
+}
+
+static inline int32_t packValue(const DLABRGBParam& param, uint16_t v)
+{
+    int32_t in = (param.is16U ? (int32_t)v : (int32_t)(int16_t)v);
+    int32_t out = param.rangeMin + ((in * param.mul + 32768) >> 16);
+    return (out < param.rangeMin ? param.rangeMin : (out > param.rangeMax ? param.rangeMax : out));
+}
+
+static void unpack10Scalar(const DLABRGBParam& param, const uint8_t* src, uint16_t* dst, size_t count)
+{
+    for (size_t x = 0; x < count; x++) {
+        uint32_t word = loadBE32(src + x * 4);
+        dst[x * 4 + 0] = (uint16_t)param.alpha;
+        dst[x * 4 + 1] = unpackValue(param, (int32_t)((word >> param.rShift) & 0x3FF));
+        dst[x * 4 + 2] = unpackValue(param, (int32_t)((word >> param.gShift) & 0x3FF));
+        dst[x * 4 + 3] = unpackValue(param, (int32_t)((word >> param.bShift) & 0x3FF));
+    }
+}
+
+static void pack10Scalar(const DLABRGBParam& param, const uint16_t* src, uint8_t* dst, size_t count)
+{
+    for (size_t x = 0; x < count; x++) {
+        uint32_t word = ((uint32_t)packValue(param, src[x * 4 + 1]) << param.rShift |
+                         (uint32_t)packValue(param, src[x * 4 + 2]) << param.gShift |
+                         (uint32_t)packValue(param, src[x * 4 + 3]) << param.bShift);
+        storeBE32(dst + x * 4, word);
+    }
+}
+
+/*
+ R12B group : 9 x BigEndian uint32_t (36 bytes) = 8 pixels = 24 components
+ Once each word is swapped into host endian, the group is little endian bit stream
+ of 12bit components in R G B order (same as R12L).
+ */
+
+static const size_t k12BitGroupBytes = 36;
+static const size_t k12BitGroupPixels = 8;
+
+static void unpack12Group(const DLABRGBParam& param, const uint8_t* src, uint16_t* dst, size_t pixels)
+{
+    uint8_t le[k12BitGroupBytes];
+    for (size_t k = 0; k < 9; k++) {
+        uint32_t word = loadBE32(src + k * 4);
+        memcpy(le + k * 4, &word, sizeof(word));
+    }
+    for (size_t x = 0; x < pixels; x++) {
+        int32_t comp[3];
+        for (size_t c = 0; c < 3; c++) {
+            size_t index = x * 3 + c;
+            const uint8_t* p = le + (index / 2) * 3;
+            comp[c] = ((index & 1) ? (p[1] >> 4 | p[2] << 4) : (p[0] | (p[1] & 0x0F) << 8));
+        }
+        dst[x * 4 + 0] = (uint16_t)param.alpha;
+        dst[x * 4 + 1] = unpackValue(param, comp[0]);
+        dst[x * 4 + 2] = unpackValue(param, comp[1]);
+        dst[x * 4 + 3] = unpackValue(param, comp[2]);
+    }
+}
+
+static void pack12Group(const DLABRGBParam& param, const uint16_t* src, uint8_t* dst, size_t pixels)
+{
+    uint8_t le[k12BitGroupBytes] = {0};
+    for (size_t x = 0; x < pixels; x++) {
+        for (size_t c = 0; c < 3; c++) {
+            size_t index = x * 3 + c;
+            uint32_t v = (uint32_t)packValue(param, src[x * 4 + 1 + c]);
+            uint8_t* p = le + (index / 2) * 3;
+            if (index & 1) {
+                p[1] = (uint8_t)((p[1] & 0x0F) | (v & 0x0F) << 4);
+                p[2] = (uint8_t)(v >> 4);
+            } else {
+                p[0] = (uint8_t)(v & 0xFF);
+                p[1] = (uint8_t)((p[1] & 0xF0) | (v >> 8));
+            }
+        }
+    }
+    for (size_t k = 0; k < 9; k++) {
+        uint32_t word = 0;
+        memcpy(&word, le + k * 4, sizeof(word));
+        storeBE32(dst + k * 4, word);
+    }
+}
+
+/* =================================================================================== */
+// MARK: - SSE4.1
+/* =================================================================================== */
+
+#if DLAB_KERNEL_X86
+
+DLAB_TARGET_SSE41 static size_t unpack10SSE41(const DLABRGBParam& param, const uint8_t* src, uint16_t* dst, size_t count)
+{
+    const __m128i bswap = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+    const __m128i rangeMin = _mm_set1_epi32(param.rangeMin);
+    const __m128i mul = _mm_set1_epi32(param.mul);
+    const __m128i round = _mm_set1_epi32(2048);
+    const __m128i alpha = _mm_set1_epi32(param.alpha);
+    const __m128i rShift = _mm_cvtsi32_si128(param.rShift);
+    const __m128i gShift = _mm_cvtsi32_si128(param.gShift);
+    const __m128i bShift = _mm_cvtsi32_si128(param.bShift);
+    size_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m128i w = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(src + x * 4)), bswap);
+        __m128i r = _mm_and_si128(_mm_srl_epi32(w, rShift), mask);
+        __m128i g = _mm_and_si128(_mm_srl_epi32(w, gShift), mask);
+        __m128i b = _mm_and_si128(_mm_srl_epi32(w, bShift), mask);
+        r = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(r, rangeMin), mul), round), 12);
+        g = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(g, rangeMin), mul), round), 12);
+        b = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(_mm_sub_epi32(b, rangeMin), mul), round), 12);
+        __m128i rg, ab;
+        if (param.is16U) {
+            rg = _mm_packus_epi32(r, g);    // r0 r1 r2 r3 g0 g1 g2 g3
+            ab = _mm_packus_epi32(alpha, b);// a0 a1 a2 a3 b0 b1 b2 b3
+        } else {
+            rg = _mm_packs_epi32(r, g);
+            ab = _mm_packs_epi32(alpha, b);
+        }
+        __m128i ar = _mm_unpacklo_epi16(ab, rg);   // a0 r0 a1 r1 a2 r2 a3 r3
+        __m128i gb = _mm_unpackhi_epi16(rg, ab);   // g0 b0 g1 b1 g2 b2 g3 b3
+        _mm_storeu_si128((__m128i*)(dst + x * 4 + 0), _mm_unpacklo_epi32(ar, gb));
+        _mm_storeu_si128((__m128i*)(dst + x * 4 + 8), _mm_unpackhi_epi32(ar, gb));
+    }
+    return x;
+}
+
+DLAB_TARGET_SSE41 static size_t pack10SSE41(const DLABRGBParam& param, const uint16_t* src, uint8_t* dst, size_t count)
+{
+    const __m128i bswap = _mm_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+    const __m128i rangeMin = _mm_set1_epi32(param.rangeMin);
+    const __m128i rangeMax = _mm_set1_epi32(param.rangeMax);
+    const __m128i mul = _mm_set1_epi32(param.mul);
+    const __m128i round = _mm_set1_epi32(32768);
+    const __m128i rShift = _mm_cvtsi32_si128(param.rShift);
+    const __m128i gShift = _mm_cvtsi32_si128(param.gShift);
+    const __m128i bShift = _mm_cvtsi32_si128(param.bShift);
+    size_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(src + x * 4 + 0));
+        __m128i v1 = _mm_loadu_si128((const __m128i*)(src + x * 4 + 8));
+        __m128i t0 = _mm_unpacklo_epi16(v0, v1);   // a0 a2 r0 r2 g0 g2 b0 b2
+        __m128i t1 = _mm_unpackhi_epi16(v0, v1);   // a1 a3 r1 r3 g1 g3 b1 b3
+        __m128i ar = _mm_unpacklo_epi16(t0, t1);   // a0 a1 a2 a3 r0 r1 r2 r3
+        __m128i gb = _mm_unpackhi_epi16(t0, t1);   // g0 g1 g2 g3 b0 b1 b2 b3
+        __m128i r, g, b;
+        if (param.is16U) {
+            r = _mm_cvtepu16_epi32(_mm_srli_si128(ar, 8));
+            g = _mm_cvtepu16_epi32(gb);
+            b = _mm_cvtepu16_epi32(_mm_srli_si128(gb, 8));
+        } else {
+            r = _mm_cvtepi16_epi32(_mm_srli_si128(ar, 8));
+            g = _mm_cvtepi16_epi32(gb);
+            b = _mm_cvtepi16_epi32(_mm_srli_si128(gb, 8));
+        }
+        r = _mm_add_epi32(rangeMin, _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(r, mul), round), 16));
+        g = _mm_add_epi32(rangeMin, _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(g, mul), round), 16));
+        b = _mm_add_epi32(rangeMin, _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(b, mul), round), 16));
+        r = _mm_min_epi32(_mm_max_epi32(r, rangeMin), rangeMax);
+        g = _mm_min_epi32(_mm_max_epi32(g, rangeMin), rangeMax);
+        b = _mm_min_epi32(_mm_max_epi32(b, rangeMin), rangeMax);
+        __m128i w = _mm_or_si128(_mm_sll_epi32(r, rShift),
+                                 _mm_or_si128(_mm_sll_epi32(g, gShift), _mm_sll_epi32(b, bShift)));
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_shuffle_epi8(w, bswap));
+    }
+    return x;
+}
+
+#endif /* DLAB_KERNEL_X86 */
+
+/* =================================================================================== */
+// MARK: - NEON
+/* =================================================================================== */
+
+#if DLAB_KERNEL_NEON
+
+static size_t unpack10NEON(const DLABRGBParam& param, const uint8_t* src, uint16_t* dst, size_t count)
+{
+    const uint32x4_t mask = vdupq_n_u32(0x3FF);
+    const int32x4_t rangeMin = vdupq_n_s32(param.rangeMin);
+    const int32x4_t mul = vdupq_n_s32(param.mul);
+    const int32x4_t rShift = vdupq_n_s32(-param.rShift);
+    const int32x4_t gShift = vdupq_n_s32(-param.gShift);
+    const int32x4_t bShift = vdupq_n_s32(-param.bShift);
+    size_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        uint32x4_t w = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(src + x * 4)));
+        int32x4_t r = vreinterpretq_s32_u32(vandq_u32(vshlq_u32(w, rShift), mask));
+        int32x4_t g = vreinterpretq_s32_u32(vandq_u32(vshlq_u32(w, gShift), mask));
+        int32x4_t b = vreinterpretq_s32_u32(vandq_u32(vshlq_u32(w, bShift), mask));
+        r = vrshrq_n_s32(vmulq_s32(vsubq_s32(r, rangeMin), mul), 12);
+        g = vrshrq_n_s32(vmulq_s32(vsubq_s32(g, rangeMin), mul), 12);
+        b = vrshrq_n_s32(vmulq_s32(vsubq_s32(b, rangeMin), mul), 12);
+        if (param.is16U) {
+            uint16x4x4_t argb;
+            argb.val[0] = vdup_n_u16((uint16_t)param.alpha);
+            argb.val[1] = vqmovun_s32(r);
+            argb.val[2] = vqmovun_s32(g);
+            argb.val[3] = vqmovun_s32(b);
+            vst4_u16(dst + x * 4, argb);
+        } else {
+            int16x4x4_t argb;
+            argb.val[0] = vdup_n_s16((int16_t)param.alpha);
+            argb.val[1] = vqmovn_s32(r);
+            argb.val[2] = vqmovn_s32(g);
+            argb.val[3] = vqmovn_s32(b);
+            vst4_s16((int16_t*)(dst + x * 4), argb);
+        }
+    }
+    return x;
+}
+
+static size_t pack10NEON(const DLABRGBParam& param, const uint16_t* src, uint8_t* dst, size_t count)
+{
+    const int32x4_t rangeMin = vdupq_n_s32(param.rangeMin);
+    const int32x4_t rangeMax = vdupq_n_s32(param.rangeMax);
+    const int32x4_t mul = vdupq_n_s32(param.mul);
+    const int32x4_t rShift = vdupq_n_s32(param.rShift);
+    const int32x4_t gShift = vdupq_n_s32(param.gShift);
+    const int32x4_t bShift = vdupq_n_s32(param.bShift);
+    size_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        int32x4_t r, g, b;
+        if (param.is16U) {
+            uint16x4x4_t argb = vld4_u16(src + x * 4);
+            r = vreinterpretq_s32_u32(vmovl_u16(argb.val[1]));
+            g = vreinterpretq_s32_u32(vmovl_u16(argb.val[2]));
+            b = vreinterpretq_s32_u32(vmovl_u16(argb.val[3]));
+        } else {
+            int16x4x4_t argb = vld4_s16((const int16_t*)(src + x * 4));
+            r = vmovl_s16(argb.val[1]);
+            g = vmovl_s16(argb.val[2]);
+            b = vmovl_s16(argb.val[3]);
+        }
+        r = vaddq_s32(rangeMin, vrshrq_n_s32(vmulq_s32(r, mul), 16));
+        g = vaddq_s32(rangeMin, vrshrq_n_s32(vmulq_s32(g, mul), 16));
+        b = vaddq_s32(rangeMin, vrshrq_n_s32(vmulq_s32(b, mul), 16));
+        r = vminq_s32(vmaxq_s32(r, rangeMin), rangeMax);
+        g = vminq_s32(vmaxq_s32(g, rangeMin), rangeMax);
+        b = vminq_s32(vmaxq_s32(b, rangeMin), rangeMax);
+        uint32x4_t w = vorrq_u32(vshlq_u32(vreinterpretq_u32_s32(r), rShift),
+                                 vorrq_u32(vshlq_u32(vreinterpretq_u32_s32(g), gShift),
+                                           vshlq_u32(vreinterpretq_u32_s32(b), bShift)));
+        vst1q_u8(dst + x * 4, vrev32q_u8(vreinterpretq_u8_u32(w)));
+    }
+    return x;
+}
+
+#endif /* DLAB_KERNEL_NEON */
+
+/* =================================================================================== */
+// MARK: - dispatch
+/* =================================================================================== */
+
+static size_t unpack10Row(const DLABRGBParam& param, const uint8_t* src, uint16_t* dst, size_t width)
+{
+    size_t done = 0;
+    switch (DLABKernelGetBackend()) {
+#if DLAB_KERNEL_X86
+        case DLABKernelBackendSSE41:
+        case DLABKernelBackendAVX2:
+            done = unpack10SSE41(param, src, dst, width);
+            break;
+#endif
+#if DLAB_KERNEL_NEON
+        case DLABKernelBackendNEON:
+            done = unpack10NEON(param, src, dst, width);
+            break;
+#endif
+        default:
+            break;
+    }
+    unpack10Scalar(param, src + done * 4, dst + done * 4, width - done);
+    return width;
+}
+
+static size_t pack10Row(const DLABRGBParam& param, const uint16_t* src, uint8_t* dst, size_t width)
+{
+    size_t done = 0;
+    switch (DLABKernelGetBackend()) {
+#if DLAB_KERNEL_X86
+        case DLABKernelBackendSSE41:
+        case DLABKernelBackendAVX2:
+            done = pack10SSE41(param, src, dst, width);
+            break;
+#endif
+#if DLAB_KERNEL_NEON
+        case DLABKernelBackendNEON:
+            done = pack10NEON(param, src, dst, width);
+            break;
+#endif
+        default:
+            break;
+    }
+    pack10Scalar(param, src + done * 4, dst + done * 4, width - done);
+    return width;
+}
+
+static size_t rowBytesFor(uint32_t format, size_t width)
+{
+    if (format == DLABKernelRGBFormat12BitRGB) {
+        return ((width + k12BitGroupPixels - 1) / k12BitGroupPixels) * k12BitGroupBytes;
+    }
+    return width * 4;
+}
+
+bool DLABKernelRGBSupports(uint32_t format)
+{
+    return (format == DLABKernelRGBFormat10BitRGB ||
+            format == DLABKernelRGBFormat10BitRGBX ||
+            format == DLABKernelRGBFormat12BitRGB);
+}
+
+bool DLABKernelRGBUnpack(uint32_t format,
+                         const void* src, size_t srcRowBytes,
+                         void* dst, size_t dstRowBytes,
+                         size_t width, size_t height,
+                         int32_t rangeMin, int32_t rangeMax, bool to16U)
+{
+    if (!DLABKernelRGBSupports(format)) return false;
+    if (!src || !dst || !width || !height || rangeMax <= rangeMin) return false;
+    if (srcRowBytes < rowBytesFor(format, width) || dstRowBytes < width * 8) return false;
+
+    DLABRGBParam param = makeParam(format, rangeMin, rangeMax, to16U, true);
+    const uint8_t* srcRow = (const uint8_t*)src;
+    uint8_t* dstRow = (uint8_t*)dst;
+    for (size_t y = 0; y < height; y++) {
+        if (format == DLABKernelRGBFormat12BitRGB) {
+            for (size_t x = 0; x < width; x += k12BitGroupPixels) {
+                size_t pixels = (width - x < k12BitGroupPixels ? width - x : k12BitGroupPixels);
+                unpack12Group(param,
+                              srcRow + (x / k12BitGroupPixels) * k12BitGroupBytes,
+                              (uint16_t*)dstRow + x * 4, pixels);
+            }
+        } else {
+            unpack10Row(param, srcRow, (uint16_t*)dstRow, width);
+        }
+        srcRow += srcRowBytes;
+        dstRow += dstRowBytes;
+    }
+    return true;
+}
+
+bool DLABKernelRGBPack(uint32_t format,
+                       const void* src, size_t srcRowBytes,
+                       void* dst, size_t dstRowBytes,
+                       size_t width, size_t height,
+                       int32_t rangeMin, int32_t rangeMax, bool from16U)
+{
+    if (!DLABKernelRGBSupports(format)) return false;
+    if (!src || !dst || !width || !height || rangeMax <= rangeMin) return false;
+    if (srcRowBytes < width * 8 || dstRowBytes < rowBytesFor(format, width)) return false;
+
+    DLABRGBParam param = makeParam(format, rangeMin, rangeMax, from16U, false);
+    const uint8_t* srcRow = (const uint8_t*)src;
+    uint8_t* dstRow = (uint8_t*)dst;
+    for (size_t y = 0; y < height; y++) {
+        if (format == DLABKernelRGBFormat12BitRGB) {
+            for (size_t x = 0; x < width; x += k12BitGroupPixels) {
+                size_t pixels = (width - x < k12BitGroupPixels ? width - x : k12BitGroupPixels);
+                pack12Group(param,
+                            (const uint16_t*)srcRow + x * 4,
+                            dstRow + (x / k12BitGroupPixels) * k12BitGroupBytes, pixels);
+            }
+        } else {
+            pack10Row(param, (const uint16_t*)srcRow, dstRow, width);
+        }
+        srcRow += srcRowBytes;
+        dstRow += dstRowBytes;
+    }
+    return true;
+}
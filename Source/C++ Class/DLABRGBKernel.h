@@ -0,0 +1,67 @@
+//
+//  DLABRGBKernel.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABRGBKernel_h
+#define DLABRGBKernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Internal use only
+ * Fused byteswap + unpack/pack kernels for BigEndian DeckLink RGB formats
+ * (plain C++, no Apple framework dependency)
+ *
+ * Endian swap is performed in register, so no host endian copy of whole frame
+ * is required. Interim format is XRGB 16bit per component in host endian;
+ * either ARGB16Q12 (0..4096) or ARGB16U (0..65535), same as vImage.
+ *
+ * - r210 : 2101010 xRGB BigEndian, video range (rangeMin..rangeMax)
+ * - R10b : 1010102 RGBx BigEndian, video range (rangeMin..rangeMax)
+ * - R12B : 12bit RGB BigEndian, 8 pixels in 36 bytes, full range
+ *
+ * Backend follows DLABKernelGetBackend() in DLABV210Kernel.h.
+ */
+
+typedef enum {
+    DLABKernelRGBFormat10BitRGB  = 0x72323130,  // 'r210'
+    DLABKernelRGBFormat10BitRGBX = 0x52313062,  // 'R10b'
+    DLABKernelRGBFormat12BitRGB  = 0x52313242,  // 'R12B'
+} DLABKernelRGBFormat;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Check if format is supported by DLABRGBKernel
+bool DLABKernelRGBSupports(uint32_t format);
+
+/// Convert BigEndian DeckLink RGB image into XRGB16 image.
+/// @param to16U true for ARGB16U, false for ARGB16Q12
+bool DLABKernelRGBUnpack(uint32_t format,
+                         const void* src, size_t srcRowBytes,
+                         void* dst, size_t dstRowBytes,
+                         size_t width, size_t height,
+                         int32_t rangeMin, int32_t rangeMax, bool to16U);
+
+/// Convert XRGB16 image into BigEndian DeckLink RGB image.
+/// @param from16U true for ARGB16U, false for ARGB16Q12
+bool DLABKernelRGBPack(uint32_t format,
+                       const void* src, size_t srcRowBytes,
+                       void* dst, size_t dstRowBytes,
+                       size_t width, size_t height,
+                       int32_t rangeMin, int32_t rangeMax, bool from16U);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLABRGBKernel_h */
@@ -0,0 +1,344 @@
+//
+//  DLABRawRecorder.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABRawRecorder.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const size_t kMinSegmentBytes = 8 * 1024 * 1024;
+static const size_t kFramesPerSegment = 2;
+static const size_t kIndexReserveCount = 65536;
+
+DLABRawRecorder::DLABRawRecorder()
+: fd(-1), segmentBytes(0), current(NULL), appendOffset(0),
+  stopping(false), recording(false),
+  videoCount(0), audioFrameCount(0), droppedVideoCount(0), droppedAudioCount(0),
+  writtenBytes(0), lastError(0)
+{
+    memset(&header, 0, sizeof(header));
+}
+
+DLABRawRecorder::~DLABRawRecorder()
+{
+    Stop();
+}
+
+/* =================================================================================== */
+// MARK: - control
+/* =================================================================================== */
+
+int DLABRawRecorder::Start(const char* path, const VideoFormat& video, const AudioFormat& audio,
+                           uint32_t segmentCount)
+{
+    if (!path || !video.rowBytes || !video.height) return EINVAL;
+
+    std::lock_guard<std::mutex> lock(producerMutex);
+    if (recording.load(std::memory_order_acquire) || ioThread.joinable()) return EBUSY;
+
+    // Bypass unified buffer cache; payload is written once and never read back
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    int newFd = -1;
+#if defined(O_DIRECT)
+    newFd = open(path, flags | O_DIRECT, 0644);
+    if (newFd < 0 && errno == EINVAL) newFd = open(path, flags, 0644); // not supported by filesystem
+#else
+    newFd = open(path, flags, 0644);
+#endif
+    if (newFd < 0) return errno;
+#if defined(F_NOCACHE)
+    (void)fcntl(newFd, F_NOCACHE, 1);
+#endif
+
+    // Each segment holds a few video frames with interleaved audio packets
+    size_t videoChunk = RoundUp((size_t)video.rowBytes * video.height);
+    size_t bytes = videoChunk * kFramesPerSegment;
+    segmentBytes = RoundUp(bytes > kMinSegmentBytes ? bytes : kMinSegmentBytes);
+
+    uint32_t count = (segmentCount >= 2 ? segmentCount : 2);
+    segments.assign(count, Segment());
+    freeSegments.clear();
+    queuedSegments.clear();
+    for (uint32_t i = 0; i < count; i++) {
+        void* ptr = NULL;
+        if (posix_memalign(&ptr, kPageSize, segmentBytes) != 0 || !ptr) {
+            ReleaseSegments();
+            close(newFd);
+            return ENOMEM;
+        }
+        segments[i].data = (uint8_t*)ptr;
+        segments[i].entries.reserve(segmentBytes / kPageSize);
+        freeSegments.push_back(&segments[i]);
+    }
+
+    fd = newFd;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "DLABRAW1", 8);
+    header.version = kVersion;
+    header.pageSize = kPageSize;
+    header.video = video;
+    header.audio = audio;
+
+    index.clear();
+    index.reserve(kIndexReserveCount);
+    appendOffset = 0;
+    current = NULL;
+
+    videoCount.store(0, std::memory_order_relaxed);
+    audioFrameCount.store(0, std::memory_order_relaxed);
+    droppedVideoCount.store(0, std::memory_order_relaxed);
+    droppedAudioCount.store(0, std::memory_order_relaxed);
+    writtenBytes.store(0, std::memory_order_relaxed);
+    lastError.store(0, std::memory_order_relaxed);
+
+    // First page is FileHeader; it goes out with the first segment
+    AcquireSegmentLocked();
+    memset(current->data, 0, kPageSize);
+    memcpy(current->data, &header, sizeof(header));
+    current->used = kPageSize;
+
+    stopping = false;
+    ioThread = std::thread(&DLABRawRecorder::IOThreadMain, this);
+    recording.store(true, std::memory_order_release);
+    return 0;
+}
+
+int DLABRawRecorder::Stop()
+{
+    // Wait for in-progress Append, and keep Start out until teardown is done
+    std::lock_guard<std::mutex> lock(producerMutex);
+    if (!recording.exchange(false, std::memory_order_acq_rel)) return 0;
+
+    if (current && current->used) {
+        SubmitSegmentLocked();
+    }
+    {
+        std::lock_guard<std::mutex> ringLock(ringMutex);
+        stopping = true;
+    }
+    ringCondition.notify_all();
+    if (ioThread.joinable()) ioThread.join();
+
+    // Index trailer; Footer is placed at the end of last page
+    uint64_t indexOffset = appendOffset;
+    size_t indexBytes = index.size() * sizeof(IndexEntry);
+    size_t trailerBytes = RoundUp(indexBytes + sizeof(Footer));
+    void* trailer = NULL;
+    if (posix_memalign(&trailer, kPageSize, trailerBytes) == 0 && trailer) {
+        memset(trailer, 0, trailerBytes);
+        if (indexBytes) memcpy(trailer, index.data(), indexBytes);
+
+        Footer footer = {};
+        memcpy(footer.magic, "DLABIDX1", 8);
+        footer.indexOffset = indexOffset;
+        footer.indexCount = index.size();
+        footer.entrySize = sizeof(IndexEntry);
+        memcpy((uint8_t*)trailer + trailerBytes - sizeof(Footer), &footer, sizeof(Footer));
+
+        RecordError(WriteFully(trailer, trailerBytes, indexOffset));
+        free(trailer);
+    } else {
+        RecordError(ENOMEM);
+    }
+
+    // Rewrite FileHeader with index location
+    void* page = NULL;
+    if (posix_memalign(&page, kPageSize, kPageSize) == 0 && page) {
+        header.indexOffset = indexOffset;
+        header.indexCount = index.size();
+        header.videoCount = videoCount.load(std::memory_order_relaxed);
+        header.audioCount = 0;
+        for (const IndexEntry& entry : index) {
+            if (entry.type == ChunkAudio) header.audioCount++;
+        }
+        memset(page, 0, kPageSize);
+        memcpy(page, &header, sizeof(header));
+        RecordError(WriteFully(page, kPageSize, 0));
+        free(page);
+    } else {
+        RecordError(ENOMEM);
+    }
+
+    if (fsync(fd) != 0) RecordError(errno);
+    close(fd);
+    fd = -1;
+
+    current = NULL;
+    ReleaseSegments();
+    return lastError.load(std::memory_order_relaxed);
+}
+
+/* =================================================================================== */
+// MARK: - producer
+/* =================================================================================== */
+
+bool DLABRawRecorder::AppendVideo(const void* data, uint32_t rowBytes, uint32_t height,
+                                  int64_t time, int64_t duration, uint32_t timecode, uint32_t timecodeFlags)
+{
+    bool appended = Append(ChunkVideo, data, rowBytes, height, time, duration, timecode, timecodeFlags);
+    if (appended) {
+        videoCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        droppedVideoCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return appended;
+}
+
+bool DLABRawRecorder::AppendAudio(const void* data, uint32_t bytesPerFrame, uint32_t frameCount, int64_t time)
+{
+    bool appended = Append(ChunkAudio, data, bytesPerFrame, frameCount, time, frameCount, 0, 0);
+    if (appended) {
+        audioFrameCount.fetch_add(frameCount, std::memory_order_relaxed);
+    } else {
+        droppedAudioCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return appended;
+}
+
+bool DLABRawRecorder::Append(ChunkType type, const void* data, uint32_t unitBytes, uint32_t unitCount,
+                             int64_t time, int64_t duration, uint32_t timecode, uint32_t timecodeFlags)
+{
+    if (!data || !unitBytes || !unitCount) return false;
+    if (!recording.load(std::memory_order_acquire)) return false;
+
+    // Never wait for Start/Stop on capture thread
+    std::unique_lock<std::mutex> lock(producerMutex, std::try_to_lock);
+    if (!lock.owns_lock() || !recording.load(std::memory_order_relaxed)) return false;
+    if (lastError.load(std::memory_order_relaxed)) return false;
+
+    // Layout should match FileHeader
+    bool layoutOK = (type == ChunkVideo
+                     ? (unitBytes == header.video.rowBytes && unitCount == header.video.height)
+                     : (unitBytes == header.audio.bytesPerFrame));
+    if (!layoutOK) return false;
+
+    size_t size = (size_t)unitBytes * unitCount;
+    size_t chunk = RoundUp(size);
+    if (chunk > segmentBytes) return false;
+
+    if (!current || current->used + chunk > segmentBytes) {
+        if (current) SubmitSegmentLocked();
+        if (!AcquireSegmentLocked()) return false; // I/O is behind; drop
+    }
+
+    uint8_t* dst = current->data + current->used;
+    memcpy(dst, data, size);
+    if (chunk > size) memset(dst + size, 0, chunk - size);
+
+    IndexEntry entry = {};
+    entry.offset = current->fileOffset + current->used;
+    entry.size = (uint32_t)size;
+    entry.type = (uint16_t)type;
+    entry.time = time;
+    entry.duration = duration;
+    entry.timecode = timecode;
+    entry.timecodeFlags = timecodeFlags;
+    current->entries.push_back(entry);  // within reserved capacity
+
+    current->used += chunk;
+    return true;
+}
+
+/* =================================================================================== */
+// MARK: - segment ring
+/* =================================================================================== */
+
+bool DLABRawRecorder::AcquireSegmentLocked()
+{
+    Segment* segment = NULL;
+    {
+        std::lock_guard<std::mutex> ringLock(ringMutex);
+        if (freeSegments.empty()) return false;
+        segment = freeSegments.back();
+        freeSegments.pop_back();
+    }
+    segment->fileOffset = appendOffset;
+    segment->used = 0;
+    segment->entries.clear();
+    current = segment;
+    return true;
+}
+
+void DLABRawRecorder::SubmitSegmentLocked()
+{
+    Segment* segment = current;
+    current = NULL;
+    appendOffset += segment->used;
+    {
+        std::lock_guard<std::mutex> ringLock(ringMutex);
+        queuedSegments.push_back(segment);
+    }
+    ringCondition.notify_one();
+}
+
+void DLABRawRecorder::IOThreadMain()
+{
+    std::unique_lock<std::mutex> ringLock(ringMutex);
+    while (true) {
+        ringCondition.wait(ringLock, [this] { return stopping || !queuedSegments.empty(); });
+        if (queuedSegments.empty()) break; // stopping and drained
+
+        Segment* segment = queuedSegments.front();
+        queuedSegments.erase(queuedSegments.begin());
+        ringLock.unlock();
+
+        if (!lastError.load(std::memory_order_relaxed)) {
+            int error = WriteFully(segment->data, segment->used, segment->fileOffset);
+            RecordError(error);
+
+            // Index grows here, off the capture thread
+            if (!error) {
+                index.insert(index.end(), segment->entries.begin(), segment->entries.end());
+            }
+        }
+
+        ringLock.lock();
+        freeSegments.push_back(segment);
+    }
+}
+
+int DLABRawRecorder::WriteFully(const void* data, size_t size, uint64_t offset)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    while (size) {
+        ssize_t written = pwrite(fd, ptr, size, (off_t)offset);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return errno;
+        }
+        if (written == 0) return EIO;
+        ptr += written;
+        size -= (size_t)written;
+        offset += (uint64_t)written;
+        writtenBytes.fetch_add((uint64_t)written, std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+void DLABRawRecorder::RecordError(int error)
+{
+    if (!error) return;
+    int expected = 0;
+    lastError.compare_exchange_strong(expected, error, std::memory_order_relaxed);
+}
+
+void DLABRawRecorder::ReleaseSegments()
+{
+    for (Segment& segment : segments) {
+        free(segment.data);
+        segment.data = NULL;
+    }
+    segments.clear();
+    freeSegments.clear();
+    queuedSegments.clear();
+}
@@ -0,0 +1,175 @@
+//
+//  DLABRawRecorder.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABRawRecorder_h
+#define DLABRawRecorder_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Internal use only
+ * Raw frame recorder into page-aligned indexed container (plain C++, no Apple framework dependency)
+ *
+ * Container layout (native little-endian):
+ * - FileHeader  : first page. Rewritten with index location on Stop.
+ * - Chunks      : video frame / audio packet payload as is. Every chunk starts at
+ *                 page boundary and is zero padded up to page boundary.
+ * - Index       : IndexEntry array, followed by Footer at the end of last page.
+ *
+ * Producer copies payload into current segment of bounded segment ring. Filled
+ * segment is written by dedicated I/O thread using one large aligned pwrite().
+ * Index entries travel with their segment, and I/O thread appends them to index
+ * after write, so producer never grows the index on capture thread.
+ * File is opened with O_DIRECT or F_NOCACHE if available. When every segment is
+ * in flight, new chunk is dropped (never blocks producer).
+ *
+ * - Append* should be called from one thread at a time (capture callback).
+ * - Start/Stop may be called from any thread.
+ */
+
+class DLABRawRecorder
+{
+public:
+    static const uint32_t kPageSize = 4096;
+    static const uint32_t kDefaultSegmentCount = 8;
+    static const uint32_t kVersion = 1;
+
+    typedef enum {
+        ChunkVideo = 1,
+        ChunkAudio = 2,
+    } ChunkType;
+
+    struct VideoFormat {
+        uint32_t width;
+        uint32_t height;
+        uint32_t pixelFormat;       // BMDPixelFormat
+        uint32_t rowBytes;
+        int64_t timeScale;
+        int64_t frameDuration;
+    };
+
+    struct AudioFormat {
+        uint32_t sampleRate;        // 0 if no audio
+        uint32_t channelCount;
+        uint32_t bytesPerFrame;     // interleaved PCM
+        uint32_t bitsPerSample;
+    };
+
+    struct FileHeader {
+        char magic[8];              // "DLABRAW1"
+        uint32_t version;
+        uint32_t pageSize;
+        VideoFormat video;
+        AudioFormat audio;
+        uint64_t indexOffset;       // 0 until Stop
+        uint64_t indexCount;
+        uint64_t videoCount;
+        uint64_t audioCount;
+    };
+
+    struct IndexEntry {
+        uint64_t offset;            // page aligned
+        uint32_t size;              // payload size without padding
+        uint16_t type;              // ChunkType
+        uint16_t reserved;
+        int64_t time;               // video: in timeScale, audio: in sampleRate
+        int64_t duration;           // video: in timeScale, audio: sample frame count
+        uint32_t timecode;          // BCD (video only), 0 if unavailable
+        uint32_t timecodeFlags;
+    };
+
+    struct Footer {
+        char magic[8];              // "DLABIDX1"
+        uint64_t indexOffset;
+        uint64_t indexCount;
+        uint32_t entrySize;
+        uint32_t reserved;
+    };
+
+    DLABRawRecorder();
+    ~DLABRawRecorder();
+
+    // Returns 0 on success, or errno
+    int Start(const char* path, const VideoFormat& video, const AudioFormat& audio, uint32_t segmentCount);
+    // Flush pending segments, write index and close. Returns 0 on success, or first errno.
+    int Stop();
+    bool IsRecording() const { return recording.load(std::memory_order_acquire); }
+
+    // Producer; returns false if chunk is dropped
+    bool AppendVideo(const void* data, uint32_t rowBytes, uint32_t height,
+                     int64_t time, int64_t duration, uint32_t timecode, uint32_t timecodeFlags);
+    bool AppendAudio(const void* data, uint32_t bytesPerFrame, uint32_t frameCount, int64_t time);
+
+    // Statistics
+    uint64_t VideoCount() const { return videoCount.load(std::memory_order_relaxed); }
+    uint64_t AudioFrameCount() const { return audioFrameCount.load(std::memory_order_relaxed); }
+    uint64_t DroppedVideoCount() const { return droppedVideoCount.load(std::memory_order_relaxed); }
+    uint64_t DroppedAudioCount() const { return droppedAudioCount.load(std::memory_order_relaxed); }
+    uint64_t WrittenBytes() const { return writtenBytes.load(std::memory_order_relaxed); }
+    int LastError() const { return lastError.load(std::memory_order_relaxed); }
+
+private:
+    DLABRawRecorder(const DLABRawRecorder&) = delete;
+    DLABRawRecorder& operator=(const DLABRawRecorder&) = delete;
+
+    struct Segment {
+        uint8_t* data;
+        uint64_t fileOffset;
+        size_t used;
+        std::vector<IndexEntry> entries;    // reserved for one chunk per page
+    };
+
+    static size_t RoundUp(size_t size) { return (size + kPageSize - 1) & ~((size_t)kPageSize - 1); }
+
+    bool Append(ChunkType type, const void* data, uint32_t unitBytes, uint32_t unitCount,
+                int64_t time, int64_t duration, uint32_t timecode, uint32_t timecodeFlags);
+    bool AcquireSegmentLocked();
+    void SubmitSegmentLocked();
+    void IOThreadMain();
+    int WriteFully(const void* data, size_t size, uint64_t offset);
+    void RecordError(int error);
+    void ReleaseSegments();
+
+    // Producer side (guarded by producerMutex)
+    std::mutex producerMutex;
+    int fd;
+    FileHeader header;
+    size_t segmentBytes;
+    Segment* current;
+    uint64_t appendOffset;
+
+    // I/O thread while recording; Start/Stop otherwise
+    std::vector<IndexEntry> index;
+
+    // Segment ring (guarded by ringMutex)
+    std::mutex ringMutex;
+    std::condition_variable ringCondition;
+    std::vector<Segment> segments;
+    std::vector<Segment*> freeSegments;
+    std::vector<Segment*> queuedSegments;  // FIFO
+    bool stopping;
+    std::thread ioThread;
+
+    std::atomic<bool> recording;
+    std::atomic<uint64_t> videoCount;
+    std::atomic<uint64_t> audioFrameCount;
+    std::atomic<uint64_t> droppedVideoCount;
+    std::atomic<uint64_t> droppedAudioCount;
+    std::atomic<uint64_t> writtenBytes;
+    std::atomic<int> lastError;
+};
+
+#endif /* DLABRawRecorder_h */
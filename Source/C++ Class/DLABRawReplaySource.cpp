@@ -0,0 +1,199 @@
+//
+//  DLABRawReplaySource.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABRawReplaySource.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+
+DLABRawReplaySource::DLABRawReplaySource()
+: mapping(NULL), mappingLength(0), systemPageSize(0), adviseBegin(0), adviseEnd(0), refCount(1)
+{
+    memset(&header, 0, sizeof(header));
+    long pageSize = sysconf(_SC_PAGESIZE);
+    systemPageSize = (pageSize > 0 ? (size_t)pageSize : DLABRawRecorder::kPageSize);
+}
+
+DLABRawReplaySource::~DLABRawReplaySource()
+{
+    if (mapping) {
+        munmap(mapping, mappingLength);
+        mapping = NULL;
+    }
+}
+
+/* =================================================================================== */
+// MARK: - open
+/* =================================================================================== */
+
+int DLABRawReplaySource::Open(const char* path)
+{
+    if (!path) return EINVAL;
+    if (mapping) return EBUSY;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return errno;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        return err;
+    }
+    size_t length = (size_t)st.st_size;
+    if (length < (size_t)DLABRawRecorder::kPageSize + sizeof(DLABRawRecorder::Footer)) {
+        close(fd);
+        return EINVAL;
+    }
+
+    // Mapping stays valid after close()
+    void* ptr = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    int err = (ptr == MAP_FAILED ? errno : 0);
+    close(fd);
+    if (err) return err;
+
+    uint8_t* base = (uint8_t*)ptr;
+    memcpy(&header, base, sizeof(header));
+
+    DLABRawRecorder::Footer footer;
+    memcpy(&footer, base + length - sizeof(footer), sizeof(footer));
+
+    // Stopped recording only; index location is written on Stop
+    bool valid = (memcmp(header.magic, "DLABRAW1", 8) == 0 &&
+                  header.version == DLABRawRecorder::kVersion &&
+                  header.pageSize == DLABRawRecorder::kPageSize &&
+                  memcmp(footer.magic, "DLABIDX1", 8) == 0 &&
+                  footer.entrySize == sizeof(IndexEntry) &&
+                  footer.indexOffset == header.indexOffset &&
+                  footer.indexCount == header.indexCount &&
+                  footer.indexOffset <= length &&
+                  footer.indexCount <= (length - footer.indexOffset) / sizeof(IndexEntry));
+    if (!valid) {
+        munmap(ptr, length);
+        return EINVAL;
+    }
+
+    mapping = base;
+    mappingLength = length;
+
+    const IndexEntry* entries = (const IndexEntry*)(base + footer.indexOffset);
+    videoEntries.clear();
+    audioEntries.clear();
+    // Header counts are not validated; never reserve beyond index entries in file
+    videoEntries.reserve((size_t)std::min(header.videoCount, footer.indexCount));
+    audioEntries.reserve((size_t)std::min(header.audioCount, footer.indexCount));
+    for (uint64_t i = 0; i < footer.indexCount; i++) {
+        const IndexEntry& entry = entries[i];
+        if (!ValidEntry(entry)) continue;
+        if (entry.type == DLABRawRecorder::ChunkVideo) {
+            videoEntries.push_back(entry);
+        } else if (entry.type == DLABRawRecorder::ChunkAudio) {
+            audioEntries.push_back(entry);
+        }
+    }
+
+    // Payload is mostly read once in order
+    Advise(0, mappingLength, MADV_SEQUENTIAL);
+    return 0;
+}
+
+/* =================================================================================== */
+// MARK: - access
+/* =================================================================================== */
+
+const void* DLABRawReplaySource::VideoFrameAt(uint64_t index, uint32_t readAheadCount, IndexEntry* entry)
+{
+    if (!mapping || index >= videoEntries.size()) return NULL;
+    const IndexEntry& found = videoEntries[(size_t)index];
+    if (entry) *entry = found;
+
+    if (readAheadCount > kMaxReadAheadCount) readAheadCount = kMaxReadAheadCount;
+    uint64_t last = index + 1 + readAheadCount;
+    if (last > videoEntries.size()) last = videoEntries.size();
+
+    // Advise only frames which are not advised yet; restart window on seek
+    uint64_t first = index + 1;
+    {
+        std::lock_guard<std::mutex> lock(adviseMutex);
+        if (first < adviseBegin || first > adviseEnd) {
+            adviseBegin = first;
+            adviseEnd = first;
+        }
+        if (adviseEnd > first) first = adviseEnd;
+        if (last > adviseEnd) adviseEnd = last;
+    }
+    if (first < last) {
+        const IndexEntry& head = videoEntries[(size_t)first];
+        const IndexEntry& tail = videoEntries[(size_t)(last - 1)];
+        Advise(head.offset, tail.offset + tail.size - head.offset, MADV_WILLNEED);
+    }
+
+    return mapping + found.offset;
+}
+
+const void* DLABRawReplaySource::AudioChunkAt(uint64_t index, IndexEntry* entry) const
+{
+    if (!mapping || index >= audioEntries.size()) return NULL;
+    const IndexEntry& found = audioEntries[(size_t)index];
+    if (entry) *entry = found;
+    return mapping + found.offset;
+}
+
+/* =================================================================================== */
+// MARK: - reference counting
+/* =================================================================================== */
+
+uint32_t DLABRawReplaySource::AddRef()
+{
+    return ++refCount;
+}
+
+uint32_t DLABRawReplaySource::Release()
+{
+    uint32_t newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+    }
+    return newRefValue;
+}
+
+/* =================================================================================== */
+// MARK: - private
+/* =================================================================================== */
+
+bool DLABRawReplaySource::ValidEntry(const IndexEntry& entry) const
+{
+    if (entry.offset % DLABRawRecorder::kPageSize) return false;
+    if (entry.offset < DLABRawRecorder::kPageSize) return false;
+    if (entry.offset > header.indexOffset) return false;
+    if (entry.size > header.indexOffset - entry.offset) return false;
+    if (entry.type == DLABRawRecorder::ChunkVideo) {
+        return (entry.size == (uint64_t)header.video.rowBytes * header.video.height);
+    }
+    if (entry.type == DLABRawRecorder::ChunkAudio) {
+        return (header.audio.bytesPerFrame && entry.size % header.audio.bytesPerFrame == 0);
+    }
+    return false;
+}
+
+void DLABRawReplaySource::Advise(uint64_t offset, uint64_t length, int advice) const
+{
+    // madvise() requires system page alignment (may be larger than container page)
+    uint64_t begin = offset - (offset % systemPageSize);
+    uint64_t end = offset + length;
+    if (end > mappingLength) end = mappingLength;
+    if (begin >= end) return;
+    (void)madvise(mapping + begin, (size_t)(end - begin), advice);
+}
@@ -0,0 +1,83 @@
+//
+//  DLABRawReplaySource.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABRawReplaySource_h
+#define DLABRawReplaySource_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "DLABRawRecorder.h"
+
+/*
+ * Internal use only
+ * Memory mapped reader of DLABRawRecorder container (plain C++, no Apple framework dependency)
+ *
+ * Whole file is mapped read-only once on Open. Each chunk is returned as pointer
+ * into the mapping, so payload can be handed to device as is, or copied once.
+ * VideoFrameAt() advises kernel to read ahead next N video frames (MADV_WILLNEED),
+ * so page faults are taken off the playback thread.
+ *
+ * Source is reference counted; every consumer of mapped memory (e.g. video buffer
+ * wrapping a mapped frame) should retain source until it is done.
+ */
+
+class DLABRawReplaySource
+{
+public:
+    typedef DLABRawRecorder::FileHeader FileHeader;
+    typedef DLABRawRecorder::IndexEntry IndexEntry;
+
+    static const uint32_t kDefaultReadAheadCount = 4;
+    static const uint32_t kMaxReadAheadCount = 64;
+
+    DLABRawReplaySource();
+
+    // Returns 0 on success, or errno (EINVAL if file is not a complete container)
+    int Open(const char* path);
+
+    const FileHeader& Header() const { return header; }
+    uint64_t VideoFrameCount() const { return videoEntries.size(); }
+    uint64_t AudioChunkCount() const { return audioEntries.size(); }
+
+    // Returns NULL if out of range. Read ahead next readAheadCount frames.
+    const void* VideoFrameAt(uint64_t index, uint32_t readAheadCount, IndexEntry* entry);
+    const void* AudioChunkAt(uint64_t index, IndexEntry* entry) const;
+
+    // Reference counting
+    uint32_t AddRef();
+    uint32_t Release();
+
+private:
+    ~DLABRawReplaySource();
+    DLABRawReplaySource(const DLABRawReplaySource&) = delete;
+    DLABRawReplaySource& operator=(const DLABRawReplaySource&) = delete;
+
+    bool ValidEntry(const IndexEntry& entry) const;
+    void Advise(uint64_t offset, uint64_t length, int advice) const;
+
+    uint8_t* mapping;
+    size_t mappingLength;
+    size_t systemPageSize;
+    FileHeader header;
+    std::vector<IndexEntry> videoEntries;
+    std::vector<IndexEntry> audioEntries;
+
+    // Read ahead cursor; [adviseBegin, adviseEnd) video frames are already advised
+    std::mutex adviseMutex;
+    uint64_t adviseBegin;
+    uint64_t adviseEnd;
+
+    std::atomic<uint32_t> refCount;
+};
+
+#endif /* DLABRawReplaySource_h */
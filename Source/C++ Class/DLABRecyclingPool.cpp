@@ -0,0 +1,73 @@
+//
+//  DLABRecyclingPool.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABRecyclingPool.h"
+
+/* =================================================================================== */
+// MARK: - lifecycle
+/* =================================================================================== */
+
+DLABRecyclingPool::DLABRecyclingPool(uint32_t capacity, DLABFramePool::ItemHandler disposer)
+: idleItems(capacity), disposer(disposer), hitCount(0), missCount(0), refCount(1)
+{
+}
+
+DLABRecyclingPool::~DLABRecyclingPool()
+{
+    // No outstanding item here; dispose idle items
+    idleItems.RemoveAll(disposer, NULL);
+}
+
+/* =================================================================================== */
+// MARK: - recycling
+/* =================================================================================== */
+
+void* DLABRecyclingPool::ReserveIdle(bool eligible)
+{
+    void* item = (eligible ? idleItems.Reserve() : NULL);
+    if (item) {
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        missCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Each outstanding item retains pool until Recycle
+    AddRef();
+    return item;
+}
+
+void DLABRecyclingPool::Recycle(void* item)
+{
+    if (!item) return;
+    if (!idleItems.Release(item)) {
+        disposer(item, NULL); // transient item
+    }
+    Release();
+}
+
+/* =================================================================================== */
+// MARK: - reference counting
+/* =================================================================================== */
+
+uint32_t DLABRecyclingPool::AddRef()
+{
+    uint32_t newRefValue = ++refCount;
+    return newRefValue;
+}
+
+uint32_t DLABRecyclingPool::Release()
+{
+    uint32_t newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
@@ -0,0 +1,67 @@
+//
+//  DLABRecyclingPool.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABRecyclingPool_h
+#define DLABRecyclingPool_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "DLABFramePool.h"
+
+/*
+ * Internal use only
+ * Reference counted recycling pool over DLABFramePool (plain C++, no Apple framework dependency)
+ *
+ * Common base of DLABAncillaryArenaPool, DLABAncillaryPacketPool and
+ * DLABAudioBlockPool. Subclass allocates items, and passes disposer which
+ * frees one item.
+ *
+ * - Each outstanding item retains pool from ReserveIdle() until Recycle(),
+ *   so consumer may hold item after owner releases pool.
+ * - If no idle item is available, ReserveIdle() returns NULL (counted as
+ *   miss); subclass then creates transient item, which Recycle() disposes.
+ */
+
+class DLABRecyclingPool
+{
+public:
+    // Utility
+    uint64_t HitCount() const { return hitCount.load(std::memory_order_relaxed); }
+    uint64_t MissCount() const { return missCount.load(std::memory_order_relaxed); }
+
+    // Reference counting
+    uint32_t AddRef();
+    uint32_t Release();
+
+protected:
+    DLABRecyclingPool(uint32_t capacity, DLABFramePool::ItemHandler disposer);
+    virtual ~DLABRecyclingPool();
+
+    uint32_t Capacity() const { return idleItems.Capacity(); }
+    // Register pre-allocated item as idle; false if pool is full
+    bool AddIdle(void* item) { return idleItems.Add(item); }
+    // Take idle item (or NULL if miss or !eligible), and retain pool
+    void* ReserveIdle(bool eligible = true);
+    // Return item taken by ReserveIdle, or dispose transient item, then release pool
+    void Recycle(void* item);
+
+private:
+    DLABRecyclingPool(const DLABRecyclingPool&) = delete;
+    DLABRecyclingPool& operator=(const DLABRecyclingPool&) = delete;
+
+    DLABFramePool idleItems;
+    DLABFramePool::ItemHandler disposer;
+    std::atomic<uint64_t> hitCount;
+    std::atomic<uint64_t> missCount;
+    std::atomic<uint32_t> refCount;
+};
+
+#endif /* DLABRecyclingPool_h */
@@ -0,0 +1,42 @@
+//
+//  DLABSimulator.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <DeckLinkAPI.h>
+
+/*
+ * Internal use only
+ * Software DeckLink device for hardware-free testing and benchmarking
+ *
+ * Simulated device implements IDeckLink with IDeckLinkProfileAttributes,
+ * IDeckLinkConfiguration, IDeckLinkStatus, IDeckLinkNotification,
+ * IDeckLinkInput and IDeckLinkOutput. Every interface shares reference count
+ * of the device object.
+ *
+ * - Input generates 75% color bars, RP188/VITC timecode, AFD ancillary packet
+ *   and 1kHz tone on ch1/ch2, at the rate of enabled display mode.
+ * - Output consumes scheduled frames/audio at the rate of enabled display mode,
+ *   and reports completion via IDeckLinkVideoOutputCallback. CreateAncillaryData
+ *   provides zero-filled VANC line buffers of enabled display mode.
+ * - Supported pixel formats are 2vuy, v210, ARGB and BGRA.
+ * - Only current DeckLink API interfaces are provided (no _v14_2_1 etc.).
+ *   DLABDevice treats simulated device as BLACKMAGIC_DECKLINK_API_VERSION.
+ *
+ * Callbacks are issued from private serial queue of each device.
+ */
+
+/// Replacement of CreateDeckLinkIteratorInstance(). Enumerates deviceCount simulated devices.
+IDeckLinkIterator* DLABSimulatorCreateIteratorInstance(uint32_t deviceCount);
+
+/// Replacement of CreateDeckLinkDiscoveryInstance(). Simulated devices arrive on install.
+IDeckLinkDiscovery* DLABSimulatorCreateDiscoveryInstance(uint32_t deviceCount);
+
+/// Check if IDeckLink object is a simulated device.
+bool DLABSimulatorIsSimulatedDeckLink(IDeckLink* deckLink);
@@ -0,0 +1,2554 @@
+//
+//  DLABSimulator.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABSimulator.h>
+#import <DLABAncillaryPacket.h>
+#import <DLABVideoBufferAllocator.h>
+#import <atomic>
+#import <chrono>
+#import <deque>
+#import <map>
+#import <mutex>
+#import <vector>
+#import <math.h>
+#import <stdlib.h>
+
+// Private interface to identify simulated device
+// 444C4142-5349-4D00-8000-000000000001
+static const REFIID IID_DLABSimDeckLink = {
+    0x44,0x4C,0x41,0x42,0x53,0x49,0x4D,0x00,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x01
+};
+
+static const char* kSimulatorQueue = "DLABSimulator.deviceQueue";
+static char kSimulatorQueueKey;
+static const int64_t kSimPersistentIDBase = 0x444C4142;     // 'DLAB'
+static const int64_t kSimTopologicalIDBase = 0x53494D00;    // 'SIM\0'
+static const int64_t kSimMaxAudioChannels = 16;
+static const BMDTimeScale kSimAudioSampleRate = bmdAudioSampleRate48kHz;
+static const size_t kSimToneLength = 48;                    // 1kHz at 48kHz
+static const size_t kSimBufferAlignment = 64;
+static const size_t kSimMaxIdleBuffers = 8;
+static const size_t kSimMaxCompletionRecords = 64;
+
+/* =================================================================================== */
+// MARK: - utility
+/* =================================================================================== */
+
+static bool isIID(REFIID iid, REFIID target)
+{
+    return (memcmp(&iid, &target, sizeof(REFIID)) == 0);
+}
+
+static bool isIUnknown(REFIID iid)
+{
+    CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+    return (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0);
+}
+
+static int64_t rescaleTime(int64_t value, int64_t fromScale, int64_t toScale)
+{
+    if (fromScale == toScale || fromScale <= 0) return value;
+    int64_t q = value / fromScale;
+    int64_t r = value % fromScale;
+    return q * toScale + r * toScale / fromScale;
+}
+
+static int64_t hostTimeNanos(void)
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static void waitForDeviceQueue(dispatch_queue_t queue)
+{
+    // Cancelled timer does not interrupt running handler; wait unless called from the handler itself
+    if (dispatch_get_specific(&kSimulatorQueueKey) == (__bridge void*)queue) return;
+    dispatch_sync(queue, ^{});
+}
+
+/* =================================================================================== */
+// MARK: - display mode table
+/* =================================================================================== */
+
+typedef struct {
+    BMDDisplayMode mode;
+    const char* name;
+    long width;
+    long height;
+    BMDTimeValue frameDuration;
+    BMDTimeScale timeScale;
+    BMDFieldDominance fieldDominance;
+    BMDDisplayModeFlags flags;
+} DLABSimModeInfo;
+
+static const DLABSimModeInfo kSimModes[] = {
+    {bmdModeNTSC,           "NTSC",         720,  486, 1001, 30000, bmdLowerFieldFirst,  bmdDisplayModeColorspaceRec601},
+    {bmdModePAL,            "PAL",          720,  576, 1000, 25000, bmdUpperFieldFirst,  bmdDisplayModeColorspaceRec601},
+    {bmdModeHD720p50,       "720p50",      1280,  720, 1000, 50000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD720p5994,     "720p59.94",   1280,  720, 1001, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD720p60,       "720p60",      1280,  720, 1000, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080i50,      "1080i50",     1920, 1080, 1000, 25000, bmdUpperFieldFirst,  bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080i5994,    "1080i59.94",  1920, 1080, 1001, 30000, bmdUpperFieldFirst,  bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080i6000,    "1080i60",     1920, 1080, 1000, 30000, bmdUpperFieldFirst,  bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p2398,    "1080p23.98",  1920, 1080, 1001, 24000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p24,      "1080p24",     1920, 1080, 1000, 24000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p25,      "1080p25",     1920, 1080, 1000, 25000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p2997,    "1080p29.97",  1920, 1080, 1001, 30000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p30,      "1080p30",     1920, 1080, 1000, 30000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p50,      "1080p50",     1920, 1080, 1000, 50000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p5994,    "1080p59.94",  1920, 1080, 1001, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdModeHD1080p6000,    "1080p60",     1920, 1080, 1000, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p2398,    "2160p23.98",  3840, 2160, 1001, 24000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p24,      "2160p24",     3840, 2160, 1000, 24000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p25,      "2160p25",     3840, 2160, 1000, 25000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p2997,    "2160p29.97",  3840, 2160, 1001, 30000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p30,      "2160p30",     3840, 2160, 1000, 30000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p50,      "2160p50",     3840, 2160, 1000, 50000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p5994,    "2160p59.94",  3840, 2160, 1001, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+    {bmdMode4K2160p60,      "2160p60",     3840, 2160, 1000, 60000, bmdProgressiveFrame, bmdDisplayModeColorspaceRec709},
+};
+static const size_t kSimModeCount = sizeof(kSimModes) / sizeof(kSimModes[0]);
+
+static const DLABSimModeInfo* findMode(BMDDisplayMode mode)
+{
+    for (size_t i = 0; i < kSimModeCount; i++) {
+        if (kSimModes[i].mode == mode) return &kSimModes[i];
+    }
+    return NULL;
+}
+
+static int32_t rowBytesForPixelFormat(BMDPixelFormat pixelFormat, int32_t width)
+{
+    switch (pixelFormat) {
+        case bmdFormat8BitYUV:
+            return width * 2;
+        case bmdFormat10BitYUV:
+            return ((width + 47) / 48) * 128;
+        case bmdFormat8BitARGB:
+        case bmdFormat8BitBGRA:
+            return width * 4;
+        default:
+            return 0;
+    }
+}
+
+/* =================================================================================== */
+// MARK: - test signal
+/* =================================================================================== */
+
+// 75% color bars; white, yellow, cyan, green, magenta, red, blue, black
+static void renderColorBars(const DLABSimModeInfo* info, BMDPixelFormat pixelFormat,
+                            int32_t rowBytes, std::vector<uint8_t>& pattern)
+{
+    static const double bars[8][3] = {
+        {0.75, 0.75, 0.75}, {0.75, 0.75, 0.00}, {0.00, 0.75, 0.75}, {0.00, 0.75, 0.00},
+        {0.75, 0.00, 0.75}, {0.75, 0.00, 0.00}, {0.00, 0.00, 0.75}, {0.00, 0.00, 0.00},
+    };
+
+    size_t width = (size_t)info->width;
+    size_t height = (size_t)info->height;
+    pattern.assign((size_t)rowBytes * height, 0);
+
+    bool rec601 = (info->flags & bmdDisplayModeColorspaceRec601);
+    double kr = rec601 ? 0.299 : 0.2126;
+    double kb = rec601 ? 0.114 : 0.0722;
+
+    // 10bit video range YCbCr and 8bit full range RGB per pixel
+    std::vector<uint32_t> Y(width), Cb(width), Cr(width);
+    std::vector<uint8_t> R(width), G(width), B(width);
+    for (size_t x = 0; x < width; x++) {
+        const double* rgb = bars[x * 8 / width];
+        double y = kr * rgb[0] + (1.0 - kr - kb) * rgb[1] + kb * rgb[2];
+        double cb = (rgb[2] - y) / (2.0 * (1.0 - kb));
+        double cr = (rgb[0] - y) / (2.0 * (1.0 - kr));
+        Y[x] = (uint32_t)lround(64.0 + 876.0 * y);
+        Cb[x] = (uint32_t)lround(512.0 + 896.0 * cb);
+        Cr[x] = (uint32_t)lround(512.0 + 896.0 * cr);
+        R[x] = (uint8_t)lround(255.0 * rgb[0]);
+        G[x] = (uint8_t)lround(255.0 * rgb[1]);
+        B[x] = (uint8_t)lround(255.0 * rgb[2]);
+    }
+
+    // Render first line
+    uint8_t* row = pattern.data();
+    switch (pixelFormat) {
+        case bmdFormat8BitYUV:
+            for (size_t x = 0; x + 1 < width; x += 2) {
+                row[x * 2 + 0] = (uint8_t)(Cb[x] >> 2);
+                row[x * 2 + 1] = (uint8_t)(Y[x] >> 2);
+                row[x * 2 + 2] = (uint8_t)(Cr[x] >> 2);
+                row[x * 2 + 3] = (uint8_t)(Y[x + 1] >> 2);
+            }
+            break;
+        case bmdFormat10BitYUV:
+            for (size_t x = 0; x < width; x += 6) {
+                uint32_t y[6], cb[3], cr[3];
+                for (size_t i = 0; i < 6; i++) {
+                    y[i] = Y[MIN(x + i, width - 1)];
+                }
+                for (size_t i = 0; i < 3; i++) {
+                    cb[i] = Cb[MIN(x + i * 2, width - 1)];
+                    cr[i] = Cr[MIN(x + i * 2, width - 1)];
+                }
+                uint32_t words[4] = {
+                    cb[0] | (y[0] << 10) | (cr[0] << 20),
+                    y[1] | (cb[1] << 10) | (y[2] << 20),
+                    cr[1] | (y[3] << 10) | (cb[2] << 20),
+                    y[4] | (cr[2] << 10) | (y[5] << 20),
+                };
+                memcpy(row + (x / 6) * 16, words, sizeof(words));
+            }
+            break;
+        case bmdFormat8BitARGB:
+            for (size_t x = 0; x < width; x++) {
+                row[x * 4 + 0] = 255;
+                row[x * 4 + 1] = R[x];
+                row[x * 4 + 2] = G[x];
+                row[x * 4 + 3] = B[x];
+            }
+            break;
+        case bmdFormat8BitBGRA:
+            for (size_t x = 0; x < width; x++) {
+                row[x * 4 + 0] = B[x];
+                row[x * 4 + 1] = G[x];
+                row[x * 4 + 2] = R[x];
+                row[x * 4 + 3] = 255;
+            }
+            break;
+        default:
+            break;
+    }
+
+    // Replicate to all lines
+    for (size_t line = 1; line < height; line++) {
+        memcpy(row + line * (size_t)rowBytes, row, (size_t)rowBytes);
+    }
+}
+
+// -20dBFS 1kHz sine, one cycle at 48kHz
+static const int32_t* toneTable(void)
+{
+    static int32_t table[kSimToneLength];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (size_t i = 0; i < kSimToneLength; i++) {
+            double value = 0.1 * sin(2.0 * M_PI * (double)i / (double)kSimToneLength);
+            table[i] = (int32_t)lround(value * 2147483647.0);
+        }
+    });
+    return table;
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimDisplayMode
+/* =================================================================================== */
+
+class DLABSimDisplayMode : public IDeckLinkDisplayMode
+{
+public:
+    DLABSimDisplayMode(const DLABSimModeInfo* info) : info(info), refCount(1) {}
+
+    // IDeckLinkDisplayMode
+    HRESULT GetName(CFStringRef* name) {
+        if (!name) return E_INVALIDARG;
+        *name = CFStringCreateWithCString(NULL, info->name, kCFStringEncodingUTF8);
+        return S_OK;
+    }
+    BMDDisplayMode GetDisplayMode(void) { return info->mode; }
+    long GetWidth(void) { return info->width; }
+    long GetHeight(void) { return info->height; }
+    HRESULT GetFrameRate(BMDTimeValue* frameDuration, BMDTimeScale* timeScale) {
+        if (frameDuration) *frameDuration = info->frameDuration;
+        if (timeScale) *timeScale = info->timeScale;
+        return S_OK;
+    }
+    BMDFieldDominance GetFieldDominance(void) { return info->fieldDominance; }
+    BMDDisplayModeFlags GetFlags(void) { return info->flags; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkDisplayMode)) {
+            *ppv = (IDeckLinkDisplayMode *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimDisplayMode() {}
+
+    const DLABSimModeInfo* info;
+    std::atomic<ULONG> refCount;
+};
+
+class DLABSimDisplayModeIterator : public IDeckLinkDisplayModeIterator
+{
+public:
+    DLABSimDisplayModeIterator() : index(0), refCount(1) {}
+
+    // IDeckLinkDisplayModeIterator
+    HRESULT Next(IDeckLinkDisplayMode** deckLinkDisplayMode) {
+        if (!deckLinkDisplayMode) return E_INVALIDARG;
+        *deckLinkDisplayMode = NULL;
+        if (index >= kSimModeCount) return S_FALSE;
+        *deckLinkDisplayMode = new DLABSimDisplayMode(&kSimModes[index++]);
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkDisplayModeIterator)) {
+            *ppv = (IDeckLinkDisplayModeIterator *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimDisplayModeIterator() {}
+
+    size_t index;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimTimecode
+/* =================================================================================== */
+
+class DLABSimTimecode : public IDeckLinkTimecode
+{
+public:
+    DLABSimTimecode(uint8_t hours, uint8_t minutes, uint8_t seconds, uint8_t frames,
+                    BMDTimecodeFlags flags, BMDTimecodeUserBits userBits)
+    : hours(hours), minutes(minutes), seconds(seconds), frames(frames),
+    flags(flags), userBits(userBits), refCount(1) {}
+
+    // Timecode of frame number since stream start
+    static DLABSimTimecode* CreateForFrame(uint64_t frameNumber, const DLABSimModeInfo* info) {
+        uint32_t fps = (uint32_t)((info->timeScale + info->frameDuration - 1) / info->frameDuration);
+        bool highRate = (fps > 30);     // frame pair with field mark
+        uint32_t rate = highRate ? fps / 2 : fps;
+        uint64_t count = highRate ? frameNumber / 2 : frameNumber;
+
+        BMDTimecodeFlags flags = bmdTimecodeFlagDefault;
+        if (highRate && (frameNumber & 1)) {
+            flags |= bmdTimecodeFieldMark;
+        }
+        if (info->frameDuration == 1001 && rate == 30) {
+            flags |= bmdTimecodeIsDropFrame;
+            uint64_t d = count / 17982;
+            uint64_t m = count % 17982;
+            count += 18 * d + ((m > 1) ? 2 * ((m - 2) / 1798) : 0);
+        }
+
+        uint8_t ff = (uint8_t)(count % rate);
+        uint8_t ss = (uint8_t)((count / rate) % 60);
+        uint8_t mm = (uint8_t)((count / (rate * 60)) % 60);
+        uint8_t hh = (uint8_t)((count / (rate * 3600)) % 24);
+        return new DLABSimTimecode(hh, mm, ss, ff, flags, 0);
+    }
+
+    void SetUserBits(BMDTimecodeUserBits newUserBits) { userBits = newUserBits; }
+
+    // IDeckLinkTimecode
+    BMDTimecodeBCD GetBCD(void) {
+        return (toBCD(hours) << 24) | (toBCD(minutes) << 16) | (toBCD(seconds) << 8) | toBCD(frames);
+    }
+    HRESULT GetComponents(uint8_t* outHours, uint8_t* outMinutes, uint8_t* outSeconds, uint8_t* outFrames) {
+        if (outHours) *outHours = hours;
+        if (outMinutes) *outMinutes = minutes;
+        if (outSeconds) *outSeconds = seconds;
+        if (outFrames) *outFrames = frames;
+        return S_OK;
+    }
+    HRESULT GetString(CFStringRef* timecode) {
+        if (!timecode) return E_INVALIDARG;
+        char separator = (flags & bmdTimecodeIsDropFrame) ? ';' : ':';
+        *timecode = CFStringCreateWithFormat(NULL, NULL, CFSTR("%02d:%02d:%02d%c%02d"),
+                                             hours, minutes, seconds, separator, frames);
+        return S_OK;
+    }
+    BMDTimecodeFlags GetFlags(void) { return flags; }
+    HRESULT GetTimecodeUserBits(BMDTimecodeUserBits* outUserBits) {
+        if (!outUserBits) return E_INVALIDARG;
+        *outUserBits = userBits;
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkTimecode)) {
+            *ppv = (IDeckLinkTimecode *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimTimecode() {}
+
+    static uint32_t toBCD(uint8_t value) { return (uint32_t)(((value / 10) << 4) | (value % 10)); }
+
+    uint8_t hours, minutes, seconds, frames;
+    BMDTimecodeFlags flags;
+    BMDTimecodeUserBits userBits;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimBufferPool
+/* =================================================================================== */
+
+// Recycles frame memory of simulated input, as driver does with its DMA buffers
+class DLABSimBufferPool
+{
+public:
+    DLABSimBufferPool(size_t length) : length(length), refCount(1) {}
+
+    IDeckLinkVideoBuffer* CreateBuffer();
+    void Recycle(void* bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (idle.size() < kSimMaxIdleBuffers) {
+                idle.push_back(bytes);
+                return;
+            }
+        }
+        free(bytes);
+    }
+
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    ~DLABSimBufferPool() {
+        for (void* bytes : idle) free(bytes);
+    }
+
+    size_t length;
+    std::mutex mutex;
+    std::vector<void*> idle;
+    std::atomic<ULONG> refCount;
+};
+
+class DLABSimVideoBuffer : public IDeckLinkVideoBuffer
+{
+public:
+    DLABSimVideoBuffer(DLABSimBufferPool* pool, void* bytes) : pool(pool), bytes(bytes), refCount(1) {
+        pool->AddRef();
+    }
+
+    // IDeckLinkVideoBuffer
+    HRESULT GetBytes(void** buffer) {
+        if (!buffer) return E_INVALIDARG;
+        *buffer = bytes;
+        return S_OK;
+    }
+    HRESULT StartAccess(BMDBufferAccessFlags flags) { return S_OK; }
+    HRESULT EndAccess(BMDBufferAccessFlags flags) { return S_OK; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkVideoBuffer)) {
+            *ppv = (IDeckLinkVideoBuffer *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimVideoBuffer() {
+        pool->Recycle(bytes);
+        pool->Release();
+    }
+
+    DLABSimBufferPool* pool;
+    void* bytes;
+    std::atomic<ULONG> refCount;
+};
+
+IDeckLinkVideoBuffer* DLABSimBufferPool::CreateBuffer()
+{
+    void* bytes = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!idle.empty()) {
+            bytes = idle.back();
+            idle.pop_back();
+        }
+    }
+    if (!bytes && posix_memalign(&bytes, kSimBufferAlignment, length) != 0) {
+        return NULL;
+    }
+    return new DLABSimVideoBuffer(this, bytes);
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimAncillaryPacketIterator
+/* =================================================================================== */
+
+class DLABSimAncillaryPacketIterator : public IDeckLinkAncillaryPacketIterator
+{
+public:
+    DLABSimAncillaryPacketIterator(const std::vector<IDeckLinkAncillaryPacket*>& source)
+    : packets(source), index(0), refCount(1) {
+        for (IDeckLinkAncillaryPacket* packet : packets) packet->AddRef();
+    }
+
+    // IDeckLinkAncillaryPacketIterator
+    HRESULT Next(IDeckLinkAncillaryPacket** packet) {
+        if (!packet) return E_INVALIDARG;
+        *packet = NULL;
+        if (index >= packets.size()) return S_FALSE;
+        *packet = packets[index++];
+        (*packet)->AddRef();
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkAncillaryPacketIterator)) {
+            *ppv = (IDeckLinkAncillaryPacketIterator *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimAncillaryPacketIterator() {
+        for (IDeckLinkAncillaryPacket* packet : packets) packet->Release();
+    }
+
+    std::vector<IDeckLinkAncillaryPacket*> packets;
+    size_t index;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimFrameAncillary
+/* =================================================================================== */
+
+// VANC buffer of output frame; any line of the mode is accepted, zero-filled on first request
+class DLABSimFrameAncillary : public IDeckLinkVideoFrameAncillary
+{
+public:
+    DLABSimFrameAncillary(const DLABSimModeInfo* info, BMDPixelFormat pixelFormat, int32_t rowBytes)
+    : info(info), pixelFormat(pixelFormat), rowBytes(rowBytes), refCount(1) {}
+
+    // IDeckLinkVideoFrameAncillary
+    HRESULT GetBufferForVerticalBlankingLine(uint32_t lineNumber, void** buffer) {
+        if (!buffer) return E_INVALIDARG;
+        *buffer = NULL;
+        if (lineNumber < 1 || lineNumber > (uint32_t)info->height) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<uint8_t>& line = lines[lineNumber];
+        if (line.empty()) line.assign((size_t)rowBytes, 0);
+        *buffer = line.data();
+        return S_OK;
+    }
+    BMDPixelFormat GetPixelFormat(void) { return pixelFormat; }
+    BMDDisplayMode GetDisplayMode(void) { return info->mode; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkVideoFrameAncillary)) {
+            *ppv = (IDeckLinkVideoFrameAncillary *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimFrameAncillary() {}
+
+    const DLABSimModeInfo* info;
+    BMDPixelFormat pixelFormat;
+    int32_t rowBytes;
+    std::mutex mutex;
+    std::map<uint32_t, std::vector<uint8_t>> lines;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimVideoFrame
+/* =================================================================================== */
+
+class DLABSimVideoFrame : public IDeckLinkVideoInputFrame, public IDeckLinkMutableVideoFrame
+{
+public:
+    DLABSimVideoFrame(long width, long height, long rowBytes, BMDPixelFormat pixelFormat,
+                      BMDFrameFlags flags, IDeckLinkVideoBuffer* buffer);
+
+    // Utility
+    void SetStreamTime(BMDTimeValue time, BMDTimeValue duration, BMDTimeScale scale);
+    void SetHardwareTime(int64_t nanos) { hardwareTime = nanos; }
+    void AttachTimecode(BMDTimecodeFormat format, IDeckLinkTimecode* timecode);
+    void AppendPacket(IDeckLinkAncillaryPacket* packet);
+
+    // IDeckLinkVideoFrame
+    long GetWidth(void) { return width; }
+    long GetHeight(void) { return height; }
+    long GetRowBytes(void) { return rowBytes; }
+    BMDPixelFormat GetPixelFormat(void) { return pixelFormat; }
+    BMDFrameFlags GetFlags(void) { return flags; }
+    HRESULT GetTimecode(BMDTimecodeFormat format, IDeckLinkTimecode** timecode);
+    HRESULT GetAncillaryData(IDeckLinkVideoFrameAncillary** ancillary);
+
+    // IDeckLinkMutableVideoFrame
+    HRESULT SetFlags(BMDFrameFlags newFlags) { flags = newFlags; return S_OK; }
+    HRESULT SetTimecode(BMDTimecodeFormat format, IDeckLinkTimecode* timecode);
+    HRESULT SetTimecodeFromComponents(BMDTimecodeFormat format, uint8_t hours, uint8_t minutes,
+                                      uint8_t seconds, uint8_t frames, BMDTimecodeFlags flags);
+    HRESULT SetAncillaryData(IDeckLinkVideoFrameAncillary* ancillary);
+    HRESULT SetTimecodeUserBits(BMDTimecodeFormat format, BMDTimecodeUserBits userBits);
+    HRESULT SetInterfaceProvider(REFIID iid, IUnknown* iface) { return E_NOTIMPL; }
+
+    // IDeckLinkVideoInputFrame
+    HRESULT GetStreamTime(BMDTimeValue* frameTime, BMDTimeValue* frameDuration, BMDTimeScale timeScale);
+    HRESULT GetHardwareReferenceTimestamp(BMDTimeScale timeScale, BMDTimeValue* frameTime, BMDTimeValue* frameDuration);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABSimVideoFrame();
+
+    // IDeckLinkVideoFrameAncillaryPackets of this frame
+    class Packets : public IDeckLinkVideoFrameAncillaryPackets
+    {
+    public:
+        Packets(IUnknown* outer) : outer(outer) {}
+        virtual ~Packets() { DetachAllPackets(); }
+
+        void Append(IDeckLinkAncillaryPacket* packet);
+
+        // IDeckLinkVideoFrameAncillaryPackets
+        HRESULT GetPacketIterator(IDeckLinkAncillaryPacketIterator** iterator);
+        HRESULT GetFirstPacketByID(uint8_t DID, uint8_t SDID, IDeckLinkAncillaryPacket** packet);
+        HRESULT AttachPacket(IDeckLinkAncillaryPacket* packet);
+        HRESULT DetachPacket(IDeckLinkAncillaryPacket* packet);
+        HRESULT DetachAllPackets(void);
+
+        // IUnknown
+        HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return outer->QueryInterface(iid, ppv); }
+        ULONG AddRef() { return outer->AddRef(); }
+        ULONG Release() { return outer->Release(); }
+
+    private:
+        IUnknown* outer;
+        std::mutex mutex;
+        std::vector<IDeckLinkAncillaryPacket*> list;
+    };
+
+    long width;
+    long height;
+    long rowBytes;
+    BMDPixelFormat pixelFormat;
+    BMDFrameFlags flags;
+    IDeckLinkVideoBuffer* buffer;
+
+    BMDTimeValue streamTime;
+    BMDTimeValue streamDuration;
+    BMDTimeScale streamTimeScale;
+    int64_t hardwareTime;
+
+    std::mutex mutex;
+    std::map<BMDTimecodeFormat, IDeckLinkTimecode*> timecodes;
+    IDeckLinkVideoFrameAncillary* ancillaryData;
+    Packets packets;
+    std::atomic<ULONG> refCount;
+};
+
+DLABSimVideoFrame::DLABSimVideoFrame(long width, long height, long rowBytes, BMDPixelFormat pixelFormat,
+                                     BMDFrameFlags flags, IDeckLinkVideoBuffer* buffer)
+: width(width), height(height), rowBytes(rowBytes), pixelFormat(pixelFormat), flags(flags),
+buffer(buffer), streamTime(0), streamDuration(0), streamTimeScale(1), hardwareTime(0),
+ancillaryData(NULL), packets(static_cast<IDeckLinkVideoInputFrame*>(this)), refCount(1)
+{
+    if (buffer) buffer->AddRef();
+}
+
+DLABSimVideoFrame::~DLABSimVideoFrame()
+{
+    for (auto& entry : timecodes) {
+        entry.second->Release();
+    }
+    if (ancillaryData) {
+        ancillaryData->Release();
+    }
+    if (buffer) {
+        buffer->Release();
+    }
+}
+
+// Utility
+
+void DLABSimVideoFrame::SetStreamTime(BMDTimeValue time, BMDTimeValue duration, BMDTimeScale scale)
+{
+    streamTime = time;
+    streamDuration = duration;
+    streamTimeScale = scale;
+}
+
+void DLABSimVideoFrame::AttachTimecode(BMDTimecodeFormat format, IDeckLinkTimecode* timecode)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    timecode->AddRef();
+    auto it = timecodes.find(format);
+    if (it != timecodes.end()) {
+        it->second->Release();
+        it->second = timecode;
+    } else {
+        timecodes[format] = timecode;
+    }
+}
+
+void DLABSimVideoFrame::AppendPacket(IDeckLinkAncillaryPacket* packet)
+{
+    packets.Append(packet);
+}
+
+// IDeckLinkVideoFrame
+
+HRESULT DLABSimVideoFrame::GetTimecode(BMDTimecodeFormat format, IDeckLinkTimecode** timecode)
+{
+    if (!timecode) return E_INVALIDARG;
+    *timecode = NULL;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    IDeckLinkTimecode* found = NULL;
+    if (format == bmdTimecodeRP188Any) {
+        const BMDTimecodeFormat order[] = {bmdTimecodeRP188HighFrameRate, bmdTimecodeRP188VITC1,
+            bmdTimecodeRP188VITC2, bmdTimecodeRP188LTC};
+        for (BMDTimecodeFormat candidate : order) {
+            auto it = timecodes.find(candidate);
+            if (it != timecodes.end()) {
+                found = it->second;
+                break;
+            }
+        }
+    } else {
+        auto it = timecodes.find(format);
+        if (it != timecodes.end()) {
+            found = it->second;
+        }
+    }
+    if (!found) return S_FALSE;
+
+    found->AddRef();
+    *timecode = found;
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::GetAncillaryData(IDeckLinkVideoFrameAncillary** ancillary)
+{
+    if (!ancillary) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    *ancillary = ancillaryData;
+    if (!ancillaryData) return S_FALSE;
+    ancillaryData->AddRef();
+    return S_OK;
+}
+
+// IDeckLinkMutableVideoFrame
+
+HRESULT DLABSimVideoFrame::SetTimecode(BMDTimecodeFormat format, IDeckLinkTimecode* timecode)
+{
+    if (!timecode) return E_INVALIDARG;
+
+    // Keep own copy so that user bits can be updated later
+    uint8_t hh = 0, mm = 0, ss = 0, ff = 0;
+    BMDTimecodeUserBits userBits = 0;
+    HRESULT result = timecode->GetComponents(&hh, &mm, &ss, &ff);
+    if (result != S_OK) return result;
+    timecode->GetTimecodeUserBits(&userBits);
+
+    DLABSimTimecode* copy = new DLABSimTimecode(hh, mm, ss, ff, timecode->GetFlags(), userBits);
+    AttachTimecode(format, copy);
+    copy->Release();
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::SetTimecodeFromComponents(BMDTimecodeFormat format, uint8_t hours, uint8_t minutes,
+                                                     uint8_t seconds, uint8_t frames, BMDTimecodeFlags newFlags)
+{
+    DLABSimTimecode* timecode = new DLABSimTimecode(hours, minutes, seconds, frames, newFlags, 0);
+    AttachTimecode(format, timecode);
+    timecode->Release();
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::SetAncillaryData(IDeckLinkVideoFrameAncillary* ancillary)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ancillary) ancillary->AddRef();
+    if (ancillaryData) ancillaryData->Release();
+    ancillaryData = ancillary;
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::SetTimecodeUserBits(BMDTimecodeFormat format, BMDTimecodeUserBits userBits)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = timecodes.find(format);
+    if (it == timecodes.end()) return E_FAIL;
+
+    // Every stored timecode is DLABSimTimecode (see SetTimecode)
+    static_cast<DLABSimTimecode*>(it->second)->SetUserBits(userBits);
+    return S_OK;
+}
+
+// IDeckLinkVideoInputFrame
+
+HRESULT DLABSimVideoFrame::GetStreamTime(BMDTimeValue* frameTime, BMDTimeValue* frameDuration, BMDTimeScale timeScale)
+{
+    if (!frameTime || !frameDuration || timeScale <= 0) return E_INVALIDARG;
+    *frameTime = rescaleTime(streamTime, streamTimeScale, timeScale);
+    *frameDuration = rescaleTime(streamDuration, streamTimeScale, timeScale);
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::GetHardwareReferenceTimestamp(BMDTimeScale timeScale, BMDTimeValue* frameTime, BMDTimeValue* frameDuration)
+{
+    if (!frameTime || !frameDuration || timeScale <= 0) return E_INVALIDARG;
+    *frameTime = rescaleTime(hardwareTime, NSEC_PER_SEC, timeScale);
+    *frameDuration = rescaleTime(streamDuration, streamTimeScale, timeScale);
+    return S_OK;
+}
+
+// IUnknown
+
+HRESULT DLABSimVideoFrame::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkVideoFrame) || isIID(iid, IID_IDeckLinkVideoInputFrame)) {
+        *ppv = static_cast<IDeckLinkVideoInputFrame*>(this);
+        AddRef();
+        return S_OK;
+    }
+    if (isIID(iid, IID_IDeckLinkMutableVideoFrame)) {
+        *ppv = static_cast<IDeckLinkMutableVideoFrame*>(this);
+        AddRef();
+        return S_OK;
+    }
+    if (isIID(iid, IID_IDeckLinkVideoFrameAncillaryPackets)) {
+        *ppv = static_cast<IDeckLinkVideoFrameAncillaryPackets*>(&packets);
+        AddRef();
+        return S_OK;
+    }
+    if (isIID(iid, IID_IDeckLinkVideoBuffer) && buffer) {
+        return buffer->QueryInterface(iid, ppv);
+    }
+    return E_NOINTERFACE;
+}
+
+ULONG DLABSimVideoFrame::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABSimVideoFrame::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
+
+// Packets
+
+void DLABSimVideoFrame::Packets::Append(IDeckLinkAncillaryPacket* packet)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    packet->AddRef();
+    list.push_back(packet);
+}
+
+HRESULT DLABSimVideoFrame::Packets::GetPacketIterator(IDeckLinkAncillaryPacketIterator** iterator)
+{
+    if (!iterator) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    *iterator = new DLABSimAncillaryPacketIterator(list);
+    return S_OK;
+}
+
+HRESULT DLABSimVideoFrame::Packets::GetFirstPacketByID(uint8_t DID, uint8_t SDID, IDeckLinkAncillaryPacket** packet)
+{
+    if (!packet) return E_INVALIDARG;
+    *packet = NULL;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (IDeckLinkAncillaryPacket* item : list) {
+        if (item->GetDID() == DID && item->GetSDID() == SDID) {
+            item->AddRef();
+            *packet = item;
+            return S_OK;
+        }
+    }
+    return S_FALSE;
+}
+
+HRESULT DLABSimVideoFrame::Packets::AttachPacket(IDeckLinkAncillaryPacket* packet)
+{
+    if (!packet) return E_INVALIDARG;
+
+    // Caller may not keep the packet alive after attach; hold own copy
+    const void* data = NULL;
+    uint32_t size = 0;
+    HRESULT result = packet->GetBytes(bmdAncillaryPacketFormatUInt8, &data, &size);
+    if (result != S_OK || !data) return E_INVALIDARG;
+
+    DLABAncillaryPacket* copy = new DLABAncillaryPacket();
+    result = copy->Update(packet->GetDID(), packet->GetSDID(), packet->GetLineNumber(),
+                          packet->GetDataStreamIndex(), data, size);
+    if (result == S_OK) {
+        Append(copy);
+    }
+    copy->Release();
+    return result;
+}
+
+HRESULT DLABSimVideoFrame::Packets::DetachPacket(IDeckLinkAncillaryPacket* packet)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        if (*it == packet) {
+            (*it)->Release();
+            list.erase(it);
+            return S_OK;
+        }
+    }
+    return E_INVALIDARG;
+}
+
+HRESULT DLABSimVideoFrame::Packets::DetachAllPackets(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (IDeckLinkAncillaryPacket* item : list) {
+        item->Release();
+    }
+    list.clear();
+    return S_OK;
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimAudioPacket
+/* =================================================================================== */
+
+class DLABSimAudioPacket : public IDeckLinkAudioInputPacket
+{
+public:
+    DLABSimAudioPacket(long frameCount, size_t bytesPerFrame, BMDTimeValue packetTime)
+    : frameCount(frameCount), packetTime(packetTime), refCount(1) {
+        bytes = calloc((size_t)frameCount, bytesPerFrame);
+    }
+
+    void* Bytes() { return bytes; }
+
+    // IDeckLinkAudioInputPacket
+    long GetSampleFrameCount(void) { return frameCount; }
+    HRESULT GetBytes(void** buffer) {
+        if (!buffer) return E_INVALIDARG;
+        *buffer = bytes;
+        return (bytes != NULL) ? S_OK : E_FAIL;
+    }
+    HRESULT GetPacketTime(BMDTimeValue* outPacketTime, BMDTimeScale timeScale) {
+        if (!outPacketTime || timeScale <= 0) return E_INVALIDARG;
+        *outPacketTime = rescaleTime(packetTime, kSimAudioSampleRate, timeScale);
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkAudioInputPacket)) {
+            *ppv = (IDeckLinkAudioInputPacket *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimAudioPacket() {
+        if (bytes) free(bytes);
+    }
+
+    long frameCount;
+    BMDTimeValue packetTime;    // in kSimAudioSampleRate
+    void* bytes;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - hardware clock
+/* =================================================================================== */
+
+static HRESULT getHardwareReferenceClock(const DLABSimModeInfo* info, BMDTimeScale desiredTimeScale,
+                                         BMDTimeValue* hardwareTime, BMDTimeValue* timeInFrame,
+                                         BMDTimeValue* ticksPerFrame)
+{
+    if (!info || desiredTimeScale <= 0) return E_FAIL;
+    if (!hardwareTime || !timeInFrame || !ticksPerFrame) return E_INVALIDARG;
+
+    BMDTimeValue now = rescaleTime(hostTimeNanos(), NSEC_PER_SEC, desiredTimeScale);
+    BMDTimeValue ticks = rescaleTime(info->frameDuration, info->timeScale, desiredTimeScale);
+    *hardwareTime = now;
+    *ticksPerFrame = ticks;
+    *timeInFrame = (ticks > 0) ? (now % ticks) : 0;
+    return S_OK;
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimInput
+/* =================================================================================== */
+
+class DLABSimInput : public IDeckLinkInput
+{
+public:
+    DLABSimInput(IDeckLink* owner, dispatch_queue_t queue);
+    virtual ~DLABSimInput();
+
+    // Utility
+    BMDDisplayMode CurrentMode();
+    BMDPixelFormat CurrentPixelFormat();
+    bool IsStreaming();
+
+    // IDeckLinkInput
+    HRESULT DoesSupportVideoMode(BMDVideoConnection connection, BMDDisplayMode requestedMode,
+                                 BMDPixelFormat requestedPixelFormat, BMDVideoInputConversionMode conversionMode,
+                                 BMDSupportedVideoModeFlags flags, BMDDisplayMode* actualMode, bool* supported);
+    HRESULT GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode** resultDisplayMode);
+    HRESULT GetDisplayModeIterator(IDeckLinkDisplayModeIterator** iterator);
+    HRESULT SetScreenPreviewCallback(IDeckLinkScreenPreviewCallback* previewCallback) { return S_OK; }
+    HRESULT EnableVideoInput(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat, BMDVideoInputFlags flags);
+    HRESULT EnableVideoInputWithAllocatorProvider(BMDDisplayMode displayMode, BMDPixelFormat pixelFormat,
+                                                  BMDVideoInputFlags flags,
+                                                  IDeckLinkVideoBufferAllocatorProvider* allocatorProvider);
+    HRESULT DisableVideoInput(void);
+    HRESULT GetAvailableVideoFrameCount(uint32_t* availableFrameCount);
+    HRESULT EnableAudioInput(BMDAudioSampleRate sampleRate, BMDAudioSampleType sampleType, uint32_t channelCount);
+    HRESULT DisableAudioInput(void);
+    HRESULT GetAvailableAudioSampleFrameCount(uint32_t* availableSampleFrameCount);
+    HRESULT StartStreams(void);
+    HRESULT StopStreams(void);
+    HRESULT PauseStreams(void);
+    HRESULT FlushStreams(void) { return S_OK; }
+    HRESULT SetCallback(IDeckLinkInputCallback* theCallback);
+    HRESULT GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue* hardwareTime,
+                                      BMDTimeValue* timeInFrame, BMDTimeValue* ticksPerFrame);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    void Tick(uint64_t fires);
+    DLABSimVideoFrame* CreateVideoFrame(uint64_t frameNumber);          // requires lock
+    DLABSimAudioPacket* CreateAudioPacket(uint64_t frameNumber);        // requires lock
+    void ResetVideoInput();                                             // requires lock
+
+    IDeckLink* owner;
+    dispatch_queue_t queue;
+
+    std::mutex mutex;
+    const DLABSimModeInfo* mode;
+    BMDPixelFormat pixelFormat;
+    int32_t rowBytes;
+    bool videoEnabled;
+    bool audioEnabled;
+    BMDAudioSampleType sampleType;
+    uint32_t channelCount;
+    IDeckLinkInputCallback* callback;
+    IDeckLinkVideoBufferAllocator* allocator;
+    DLABSimBufferPool* bufferPool;
+    std::vector<uint8_t> pattern;
+    IDeckLinkAncillaryPacket* afdPacket;
+    dispatch_source_t timer;
+    bool paused;
+    uint64_t frameCount;
+};
+
+DLABSimInput::DLABSimInput(IDeckLink* owner, dispatch_queue_t queue)
+: owner(owner), queue(queue), mode(NULL), pixelFormat(0), rowBytes(0),
+videoEnabled(false), audioEnabled(false), sampleType(bmdAudioSampleType16bitInteger), channelCount(0),
+callback(NULL), allocator(NULL), bufferPool(NULL), afdPacket(NULL), timer(nil), paused(false), frameCount(0)
+{
+}
+
+DLABSimInput::~DLABSimInput()
+{
+    // Timer retains owner device, so it is already cancelled here
+    ResetVideoInput();
+    if (callback) {
+        callback->Release();
+        callback = NULL;
+    }
+}
+
+// Utility
+
+BMDDisplayMode DLABSimInput::CurrentMode()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (videoEnabled && mode) ? mode->mode : 0;
+}
+
+BMDPixelFormat DLABSimInput::CurrentPixelFormat()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return videoEnabled ? pixelFormat : 0;
+}
+
+bool DLABSimInput::IsStreaming()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (timer != nil);
+}
+
+void DLABSimInput::ResetVideoInput()
+{
+    videoEnabled = false;
+    mode = NULL;
+    pixelFormat = 0;
+    rowBytes = 0;
+    pattern.clear();
+    pattern.shrink_to_fit();
+    if (allocator) {
+        allocator->Release();
+        allocator = NULL;
+    }
+    if (bufferPool) {
+        bufferPool->Release();
+        bufferPool = NULL;
+    }
+    if (afdPacket) {
+        afdPacket->Release();
+        afdPacket = NULL;
+    }
+}
+
+// IDeckLinkInput
+
+HRESULT DLABSimInput::DoesSupportVideoMode(BMDVideoConnection connection, BMDDisplayMode requestedMode,
+                                           BMDPixelFormat requestedPixelFormat, BMDVideoInputConversionMode conversionMode,
+                                           BMDSupportedVideoModeFlags flags, BMDDisplayMode* actualMode, bool* supported)
+{
+    if (!supported) return E_INVALIDARG;
+    bool modeOK = (findMode(requestedMode) != NULL);
+    bool formatOK = (requestedPixelFormat == 0 || rowBytesForPixelFormat(requestedPixelFormat, 1920) > 0);
+    bool connectionOK = (connection == bmdVideoConnectionUnspecified || connection == bmdVideoConnectionSDI);
+    *supported = (modeOK && formatOK && connectionOK && conversionMode == bmdNoVideoInputConversion);
+    if (actualMode) *actualMode = (*supported ? requestedMode : bmdModeUnknown);
+    return S_OK;
+}
+
+HRESULT DLABSimInput::GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode** resultDisplayMode)
+{
+    if (!resultDisplayMode) return E_INVALIDARG;
+    *resultDisplayMode = NULL;
+    const DLABSimModeInfo* info = findMode(displayMode);
+    if (!info) return E_INVALIDARG;
+    *resultDisplayMode = new DLABSimDisplayMode(info);
+    return S_OK;
+}
+
+HRESULT DLABSimInput::GetDisplayModeIterator(IDeckLinkDisplayModeIterator** iterator)
+{
+    if (!iterator) return E_INVALIDARG;
+    *iterator = new DLABSimDisplayModeIterator();
+    return S_OK;
+}
+
+HRESULT DLABSimInput::EnableVideoInput(BMDDisplayMode displayMode, BMDPixelFormat newPixelFormat,
+                                       BMDVideoInputFlags flags)
+{
+    return EnableVideoInputWithAllocatorProvider(displayMode, newPixelFormat, flags, NULL);
+}
+
+HRESULT DLABSimInput::EnableVideoInputWithAllocatorProvider(BMDDisplayMode displayMode, BMDPixelFormat newPixelFormat,
+                                                            BMDVideoInputFlags flags,
+                                                            IDeckLinkVideoBufferAllocatorProvider* allocatorProvider)
+{
+    const DLABSimModeInfo* info = findMode(displayMode);
+    if (!info) return E_INVALIDARG;
+    int32_t newRowBytes = rowBytesForPixelFormat(newPixelFormat, (int32_t)info->width);
+    if (newRowBytes == 0) return E_INVALIDARG;
+    uint32_t bufferSize = (uint32_t)newRowBytes * (uint32_t)info->height;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer) return E_ACCESSDENIED;
+    ResetVideoInput();
+
+    if (allocatorProvider) {
+        allocatorProvider->GetVideoBufferAllocator(bufferSize, (uint32_t)info->width, (uint32_t)info->height,
+                                                   (uint32_t)newRowBytes, newPixelFormat, &allocator);
+    }
+    bufferPool = new DLABSimBufferPool(bufferSize);
+    renderColorBars(info, newPixelFormat, newRowBytes, pattern);
+
+    // AFD (SMPTE ST 2016-3); full frame, 16:9
+    uint8_t afd[8] = {0x44, 0, 0, 0, 0, 0, 0, 0};
+    DLABAncillaryPacket* packet = new DLABAncillaryPacket();
+    packet->Update(0x41, 0x05, 11, 0, [NSData dataWithBytes:afd length:sizeof(afd)]);
+    afdPacket = packet;
+
+    mode = info;
+    pixelFormat = newPixelFormat;
+    rowBytes = newRowBytes;
+    videoEnabled = true;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::DisableVideoInput(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer) return E_ACCESSDENIED;
+    ResetVideoInput();
+    return S_OK;
+}
+
+HRESULT DLABSimInput::GetAvailableVideoFrameCount(uint32_t* availableFrameCount)
+{
+    if (!availableFrameCount) return E_INVALIDARG;
+    *availableFrameCount = 0;   // every frame is delivered on arrival
+    return S_OK;
+}
+
+HRESULT DLABSimInput::EnableAudioInput(BMDAudioSampleRate sampleRate, BMDAudioSampleType newSampleType,
+                                       uint32_t newChannelCount)
+{
+    if (sampleRate != bmdAudioSampleRate48kHz) return E_INVALIDARG;
+    if (newSampleType != bmdAudioSampleType16bitInteger && newSampleType != bmdAudioSampleType32bitInteger)
+        return E_INVALIDARG;
+    if (newChannelCount == 0 || newChannelCount > kSimMaxAudioChannels) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer) return E_ACCESSDENIED;
+    sampleType = newSampleType;
+    channelCount = newChannelCount;
+    audioEnabled = true;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::DisableAudioInput(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer) return E_ACCESSDENIED;
+    audioEnabled = false;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::GetAvailableAudioSampleFrameCount(uint32_t* availableSampleFrameCount)
+{
+    if (!availableSampleFrameCount) return E_INVALIDARG;
+    *availableSampleFrameCount = 0;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::StartStreams(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!videoEnabled || !mode) return E_ACCESSDENIED;
+    if (timer) return E_ACCESSDENIED;
+
+    uint64_t interval = (uint64_t)(mode->frameDuration * (int64_t)NSEC_PER_SEC / mode->timeScale);
+    dispatch_source_t newTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0,
+                                                        DISPATCH_TIMER_STRICT, queue);
+    if (!newTimer) return E_FAIL;
+    dispatch_source_set_timer(newTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, 0);
+
+    // Running timer keeps device alive until cancelled
+    IDeckLink* device = owner;
+    DLABSimInput* input = this;
+    __unsafe_unretained dispatch_source_t source = newTimer;
+    device->AddRef();
+    dispatch_source_set_event_handler(newTimer, ^{
+        input->Tick(dispatch_source_get_data(source));
+    });
+    dispatch_source_set_cancel_handler(newTimer, ^{
+        device->Release();
+    });
+
+    frameCount = 0;
+    paused = false;
+    timer = newTimer;
+    dispatch_resume(newTimer);
+    return S_OK;
+}
+
+HRESULT DLABSimInput::StopStreams(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!timer) return E_ACCESSDENIED;
+
+        if (paused) {
+            dispatch_resume(timer);     // suspended source can not be cancelled
+            paused = false;
+        }
+        dispatch_source_cancel(timer);
+        timer = nil;
+    }
+
+    // No Tick runs after return
+    waitForDeviceQueue(queue);
+    return S_OK;
+}
+
+HRESULT DLABSimInput::PauseStreams(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!timer) return E_ACCESSDENIED;
+
+    if (paused) {
+        dispatch_resume(timer);
+    } else {
+        dispatch_suspend(timer);
+    }
+    paused = !paused;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::SetCallback(IDeckLinkInputCallback* theCallback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (theCallback) theCallback->AddRef();
+    if (callback) callback->Release();
+    callback = theCallback;
+    return S_OK;
+}
+
+HRESULT DLABSimInput::GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue* hardwareTime,
+                                                BMDTimeValue* timeInFrame, BMDTimeValue* ticksPerFrame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return getHardwareReferenceClock(mode, desiredTimeScale, hardwareTime, timeInFrame, ticksPerFrame);
+}
+
+// Frame generation
+
+void DLABSimInput::Tick(uint64_t fires)
+{
+    IDeckLinkInputCallback* currentCallback = NULL;
+    DLABSimVideoFrame* videoFrame = NULL;
+    DLABSimAudioPacket* audioPacket = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!timer || !videoEnabled || !callback) return;
+
+        // Coalesced timer fires are lost frames, as hardware drops them
+        if (fires > 1) frameCount += fires - 1;
+
+        videoFrame = CreateVideoFrame(frameCount);
+        if (audioEnabled) audioPacket = CreateAudioPacket(frameCount);
+        frameCount++;
+
+        currentCallback = callback;
+        currentCallback->AddRef();
+    }
+
+    currentCallback->VideoInputFrameArrived(videoFrame, audioPacket);
+    currentCallback->Release();
+
+    if (videoFrame) videoFrame->Release();
+    if (audioPacket) audioPacket->Release();
+}
+
+DLABSimVideoFrame* DLABSimInput::CreateVideoFrame(uint64_t frameNumber)
+{
+    IDeckLinkVideoBuffer* buffer = NULL;
+    if (allocator) {
+        allocator->AllocateVideoBuffer(&buffer);
+    }
+    if (!buffer && bufferPool) {
+        buffer = bufferPool->CreateBuffer();
+    }
+    if (!buffer) return NULL;
+
+    // Transfer test pattern as DMA does
+    void* bytes = NULL;
+    if (buffer->StartAccess(bmdBufferAccessWrite) == S_OK) {
+        if (buffer->GetBytes(&bytes) == S_OK && bytes) {
+            memcpy(bytes, pattern.data(), pattern.size());
+        }
+        buffer->EndAccess(bmdBufferAccessWrite);
+    }
+
+    DLABSimVideoFrame* frame = new DLABSimVideoFrame(mode->width, mode->height, rowBytes, pixelFormat,
+                                                     bmdFrameFlagDefault, buffer);
+    buffer->Release();
+
+    frame->SetStreamTime((BMDTimeValue)frameNumber * mode->frameDuration, mode->frameDuration, mode->timeScale);
+    frame->SetHardwareTime(hostTimeNanos());
+
+    DLABSimTimecode* timecode = DLABSimTimecode::CreateForFrame(frameNumber, mode);
+    frame->AttachTimecode(bmdTimecodeRP188VITC1, timecode);
+    frame->AttachTimecode(bmdTimecodeRP188LTC, timecode);
+    frame->AttachTimecode(bmdTimecodeVITC, timecode);
+    timecode->Release();
+
+    if (afdPacket) {
+        frame->AppendPacket(afdPacket);
+    }
+    return frame;
+}
+
+DLABSimAudioPacket* DLABSimInput::CreateAudioPacket(uint64_t frameNumber)
+{
+    BMDTimeValue start = rescaleTime((BMDTimeValue)frameNumber * mode->frameDuration,
+                                     mode->timeScale, kSimAudioSampleRate);
+    BMDTimeValue end = rescaleTime((BMDTimeValue)(frameNumber + 1) * mode->frameDuration,
+                                   mode->timeScale, kSimAudioSampleRate);
+    long sampleFrames = (long)(end - start);
+    size_t bytesPerSample = (sampleType == bmdAudioSampleType32bitInteger) ? 4 : 2;
+
+    DLABSimAudioPacket* packet = new DLABSimAudioPacket(sampleFrames, bytesPerSample * channelCount, start);
+    uint8_t* bytes = (uint8_t*)packet->Bytes();
+    if (!bytes) return packet;
+
+    // Tone on ch1/ch2, silence on others
+    const int32_t* tone = toneTable();
+    size_t toneChannels = MIN(channelCount, (uint32_t)2);
+    for (long i = 0; i < sampleFrames; i++) {
+        int32_t value = tone[(size_t)(start + i) % kSimToneLength];
+        uint8_t* frameBytes = bytes + (size_t)i * bytesPerSample * channelCount;
+        for (size_t ch = 0; ch < toneChannels; ch++) {
+            if (bytesPerSample == 4) {
+                memcpy(frameBytes + ch * 4, &value, 4);
+            } else {
+                int16_t value16 = (int16_t)(value >> 16);
+                memcpy(frameBytes + ch * 2, &value16, 2);
+            }
+        }
+    }
+    return packet;
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimOutput
+/* =================================================================================== */
+
+class DLABSimOutput : public IDeckLinkOutput
+{
+public:
+    DLABSimOutput(IDeckLink* owner, dispatch_queue_t queue);
+    virtual ~DLABSimOutput();
+
+    // Utility
+    BMDDisplayMode CurrentMode();
+    bool IsPlaying();
+
+    // IDeckLinkOutput
+    HRESULT DoesSupportVideoMode(BMDVideoConnection connection, BMDDisplayMode requestedMode,
+                                 BMDPixelFormat requestedPixelFormat, BMDVideoOutputConversionMode conversionMode,
+                                 BMDSupportedVideoModeFlags flags, BMDDisplayMode* actualMode, bool* supported);
+    HRESULT GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode** resultDisplayMode);
+    HRESULT GetDisplayModeIterator(IDeckLinkDisplayModeIterator** iterator);
+    HRESULT SetScreenPreviewCallback(IDeckLinkScreenPreviewCallback* previewCallback) { return S_OK; }
+    HRESULT EnableVideoOutput(BMDDisplayMode displayMode, BMDVideoOutputFlags flags);
+    HRESULT DisableVideoOutput(void);
+    HRESULT CreateVideoFrame(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat,
+                             BMDFrameFlags flags, IDeckLinkMutableVideoFrame** outFrame);
+    HRESULT CreateVideoFrameWithBuffer(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat,
+                                       BMDFrameFlags flags, IDeckLinkVideoBuffer* buffer,
+                                       IDeckLinkMutableVideoFrame** outFrame);
+    HRESULT RowBytesForPixelFormat(BMDPixelFormat pixelFormat, int32_t width, int32_t* rowBytes);
+    HRESULT CreateAncillaryData(BMDPixelFormat pixelFormat, IDeckLinkVideoFrameAncillary** outBuffer);
+    HRESULT DisplayVideoFrameSync(IDeckLinkVideoFrame* theFrame);
+    HRESULT ScheduleVideoFrame(IDeckLinkVideoFrame* theFrame, BMDTimeValue displayTime,
+                               BMDTimeValue displayDuration, BMDTimeScale timeScale);
+    HRESULT SetScheduledFrameCompletionCallback(IDeckLinkVideoOutputCallback* theCallback);
+    HRESULT GetBufferedVideoFrameCount(uint32_t* bufferedFrameCount);
+    HRESULT EnableAudioOutput(BMDAudioSampleRate sampleRate, BMDAudioSampleType sampleType,
+                              uint32_t channelCount, BMDAudioOutputStreamType streamType);
+    HRESULT DisableAudioOutput(void);
+    HRESULT WriteAudioSamplesSync(void* buffer, uint32_t sampleFrameCount, uint32_t* sampleFramesWritten);
+    HRESULT BeginAudioPreroll(void);
+    HRESULT EndAudioPreroll(void) { return S_OK; }
+    HRESULT ScheduleAudioSamples(void* buffer, uint32_t sampleFrameCount, BMDTimeValue streamTime,
+                                 BMDTimeScale timeScale, uint32_t* sampleFramesWritten);
+    HRESULT GetBufferedAudioSampleFrameCount(uint32_t* bufferedSampleFrameCount);
+    HRESULT FlushBufferedAudioSamples(void);
+    HRESULT SetAudioCallback(IDeckLinkAudioOutputCallback* theCallback);
+    HRESULT StartScheduledPlayback(BMDTimeValue playbackStartTime, BMDTimeScale timeScale, double playbackSpeed);
+    HRESULT StopScheduledPlayback(BMDTimeValue stopPlaybackAtTime, BMDTimeValue* actualStopTime, BMDTimeScale timeScale);
+    HRESULT IsScheduledPlaybackRunning(bool* active);
+    HRESULT GetScheduledStreamTime(BMDTimeScale desiredTimeScale, BMDTimeValue* streamTime, double* playbackSpeed);
+    HRESULT GetReferenceStatus(BMDReferenceStatus* referenceStatus);
+    HRESULT GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue* hardwareTime,
+                                      BMDTimeValue* timeInFrame, BMDTimeValue* ticksPerFrame);
+    HRESULT GetFrameCompletionReferenceTimestamp(IDeckLinkVideoFrame* theFrame, BMDTimeScale desiredTimeScale,
+                                                 BMDTimeValue* frameCompletionTimestamp);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    typedef struct {
+        IDeckLinkVideoFrame* frame;
+        BMDTimeValue displayTime;       // in mode timeScale
+        BMDTimeValue displayDuration;   // in mode timeScale
+        bool late;
+    } Scheduled;
+
+    void Tick(uint64_t fires);
+    void StopPlayback(bool notifyStopped);          // requires lock
+
+    IDeckLink* owner;
+    dispatch_queue_t queue;
+
+    std::mutex mutex;
+    const DLABSimModeInfo* mode;
+    bool videoEnabled;
+    bool audioEnabled;
+    uint32_t audioBytesPerFrame;
+    uint64_t bufferedAudioFrames;
+    IDeckLinkVideoOutputCallback* callback;
+    IDeckLinkAudioOutputCallback* audioCallback;
+    std::deque<Scheduled> scheduled;
+    std::deque<std::pair<IDeckLinkVideoFrame*, int64_t>> completions;
+    dispatch_source_t timer;
+    BMDTimeValue streamTime;            // in mode timeScale
+    double speed;
+};
+
+DLABSimOutput::DLABSimOutput(IDeckLink* owner, dispatch_queue_t queue)
+: owner(owner), queue(queue), mode(NULL), videoEnabled(false), audioEnabled(false),
+audioBytesPerFrame(0), bufferedAudioFrames(0), callback(NULL), audioCallback(NULL),
+timer(nil), streamTime(0), speed(0.0)
+{
+}
+
+DLABSimOutput::~DLABSimOutput()
+{
+    // Timer retains owner device, so it is already cancelled here
+    for (Scheduled& entry : scheduled) {
+        entry.frame->Release();
+    }
+    scheduled.clear();
+    if (callback) {
+        callback->Release();
+        callback = NULL;
+    }
+    if (audioCallback) {
+        audioCallback->Release();
+        audioCallback = NULL;
+    }
+}
+
+// Utility
+
+BMDDisplayMode DLABSimOutput::CurrentMode()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (videoEnabled && mode) ? mode->mode : 0;
+}
+
+bool DLABSimOutput::IsPlaying()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (timer != nil);
+}
+
+// IDeckLinkOutput
+
+HRESULT DLABSimOutput::DoesSupportVideoMode(BMDVideoConnection connection, BMDDisplayMode requestedMode,
+                                            BMDPixelFormat requestedPixelFormat, BMDVideoOutputConversionMode conversionMode,
+                                            BMDSupportedVideoModeFlags flags, BMDDisplayMode* actualMode, bool* supported)
+{
+    if (!supported) return E_INVALIDARG;
+    bool modeOK = (findMode(requestedMode) != NULL);
+    bool formatOK = (requestedPixelFormat == 0 || rowBytesForPixelFormat(requestedPixelFormat, 1920) > 0);
+    bool connectionOK = (connection == bmdVideoConnectionUnspecified || connection == bmdVideoConnectionSDI);
+    *supported = (modeOK && formatOK && connectionOK && conversionMode == bmdNoVideoOutputConversion);
+    if (actualMode) *actualMode = (*supported ? requestedMode : bmdModeUnknown);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetDisplayMode(BMDDisplayMode displayMode, IDeckLinkDisplayMode** resultDisplayMode)
+{
+    if (!resultDisplayMode) return E_INVALIDARG;
+    *resultDisplayMode = NULL;
+    const DLABSimModeInfo* info = findMode(displayMode);
+    if (!info) return E_INVALIDARG;
+    *resultDisplayMode = new DLABSimDisplayMode(info);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetDisplayModeIterator(IDeckLinkDisplayModeIterator** iterator)
+{
+    if (!iterator) return E_INVALIDARG;
+    *iterator = new DLABSimDisplayModeIterator();
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::EnableVideoOutput(BMDDisplayMode displayMode, BMDVideoOutputFlags flags)
+{
+    const DLABSimModeInfo* info = findMode(displayMode);
+    if (!info) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timer) return E_ACCESSDENIED;
+    mode = info;
+    videoEnabled = true;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::DisableVideoOutput(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        StopPlayback(false);
+        videoEnabled = false;
+        mode = NULL;
+    }
+
+    // No Tick runs after return
+    waitForDeviceQueue(queue);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::CreateVideoFrame(int32_t width, int32_t height, int32_t rowBytes, BMDPixelFormat pixelFormat,
+                                        BMDFrameFlags flags, IDeckLinkMutableVideoFrame** outFrame)
+{
+    if (!outFrame) return E_INVALIDARG;
+    *outFrame = NULL;
+    if (width <= 0 || height <= 0 || rowBytes < rowBytesForPixelFormat(pixelFormat, width)) return E_INVALIDARG;
+    if (rowBytesForPixelFormat(pixelFormat, width) == 0) return E_INVALIDARG;
+
+    size_t length = (size_t)rowBytes * (size_t)height;
+    void* bytes = NULL;
+    if (posix_memalign(&bytes, kSimBufferAlignment, length) != 0) return E_OUTOFMEMORY;
+    memset(bytes, 0, length);
+
+    DLABVideoBuffer* buffer = new DLABVideoBuffer(bytes, length);   // buffer frees bytes
+    HRESULT result = CreateVideoFrameWithBuffer(width, height, rowBytes, pixelFormat, flags,
+                                                (IDeckLinkVideoBuffer*)buffer, outFrame);
+    ((IDeckLinkVideoBuffer*)buffer)->Release();
+    return result;
+}
+
+HRESULT DLABSimOutput::CreateVideoFrameWithBuffer(int32_t width, int32_t height, int32_t rowBytes,
+                                                  BMDPixelFormat pixelFormat, BMDFrameFlags flags,
+                                                  IDeckLinkVideoBuffer* buffer, IDeckLinkMutableVideoFrame** outFrame)
+{
+    if (!outFrame || !buffer) return E_INVALIDARG;
+    DLABSimVideoFrame* frame = new DLABSimVideoFrame(width, height, rowBytes, pixelFormat, flags, buffer);
+    *outFrame = static_cast<IDeckLinkMutableVideoFrame*>(frame);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::RowBytesForPixelFormat(BMDPixelFormat pixelFormat, int32_t width, int32_t* rowBytes)
+{
+    if (!rowBytes) return E_INVALIDARG;
+    *rowBytes = rowBytesForPixelFormat(pixelFormat, width);
+    return (*rowBytes > 0) ? S_OK : E_INVALIDARG;
+}
+
+HRESULT DLABSimOutput::CreateAncillaryData(BMDPixelFormat pixelFormat, IDeckLinkVideoFrameAncillary** outBuffer)
+{
+    if (!outBuffer) return E_INVALIDARG;
+    *outBuffer = NULL;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!videoEnabled || !mode) return E_ACCESSDENIED;
+
+    // Above HD, VANC line is 1920 pixels wide (see IDeckLinkVideoFrameAncillary)
+    int32_t width = (int32_t)(mode->width > 1920 ? 1920 : mode->width);
+    int32_t rowBytes = rowBytesForPixelFormat(pixelFormat, width);
+    if (rowBytes <= 0) return E_INVALIDARG;
+    *outBuffer = new DLABSimFrameAncillary(mode, pixelFormat, rowBytes);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::DisplayVideoFrameSync(IDeckLinkVideoFrame* theFrame)
+{
+    if (!theFrame) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!videoEnabled) return E_ACCESSDENIED;
+    if (timer) return E_ACCESSDENIED;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::ScheduleVideoFrame(IDeckLinkVideoFrame* theFrame, BMDTimeValue displayTime,
+                                          BMDTimeValue displayDuration, BMDTimeScale timeScale)
+{
+    if (!theFrame || timeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!videoEnabled || !mode) return E_ACCESSDENIED;
+
+    Scheduled entry;
+    entry.frame = theFrame;
+    entry.displayTime = rescaleTime(displayTime, timeScale, mode->timeScale);
+    entry.displayDuration = rescaleTime(displayDuration, timeScale, mode->timeScale);
+    entry.late = (timer != nil && entry.displayTime < streamTime);
+    theFrame->AddRef();
+
+    // Keep display order
+    auto it = scheduled.end();
+    while (it != scheduled.begin() && (it - 1)->displayTime > entry.displayTime) {
+        --it;
+    }
+    scheduled.insert(it, entry);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::SetScheduledFrameCompletionCallback(IDeckLinkVideoOutputCallback* theCallback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (theCallback) theCallback->AddRef();
+    if (callback) callback->Release();
+    callback = theCallback;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetBufferedVideoFrameCount(uint32_t* bufferedFrameCount)
+{
+    if (!bufferedFrameCount) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    *bufferedFrameCount = (uint32_t)scheduled.size();
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::EnableAudioOutput(BMDAudioSampleRate sampleRate, BMDAudioSampleType sampleType,
+                                         uint32_t channelCount, BMDAudioOutputStreamType streamType)
+{
+    if (sampleRate != bmdAudioSampleRate48kHz) return E_INVALIDARG;
+    if (sampleType != bmdAudioSampleType16bitInteger && sampleType != bmdAudioSampleType32bitInteger)
+        return E_INVALIDARG;
+    if (channelCount == 0 || channelCount > kSimMaxAudioChannels) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    audioBytesPerFrame = (uint32_t)(sampleType / 8) * channelCount;
+    bufferedAudioFrames = 0;
+    audioEnabled = true;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::DisableAudioOutput(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    audioEnabled = false;
+    bufferedAudioFrames = 0;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::WriteAudioSamplesSync(void* buffer, uint32_t sampleFrameCount, uint32_t* sampleFramesWritten)
+{
+    if (!buffer || !sampleFramesWritten) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!audioEnabled) return E_ACCESSDENIED;
+    *sampleFramesWritten = sampleFrameCount;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::BeginAudioPreroll(void)
+{
+    IDeckLinkAudioOutputCallback* currentCallback = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!audioEnabled) return E_ACCESSDENIED;
+        currentCallback = audioCallback;
+        if (!currentCallback) return S_OK;
+        currentCallback->AddRef();
+    }
+
+    IDeckLink* device = owner;
+    device->AddRef();
+    dispatch_async(queue, ^{
+        currentCallback->RenderAudioSamples(true);
+        currentCallback->Release();
+        device->Release();
+    });
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::ScheduleAudioSamples(void* buffer, uint32_t sampleFrameCount, BMDTimeValue streamTime,
+                                            BMDTimeScale timeScale, uint32_t* sampleFramesWritten)
+{
+    if (!buffer) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!audioEnabled) return E_ACCESSDENIED;
+    bufferedAudioFrames += sampleFrameCount;
+    if (sampleFramesWritten) *sampleFramesWritten = sampleFrameCount;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetBufferedAudioSampleFrameCount(uint32_t* bufferedSampleFrameCount)
+{
+    if (!bufferedSampleFrameCount) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    *bufferedSampleFrameCount = (uint32_t)MIN(bufferedAudioFrames, (uint64_t)UINT32_MAX);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::FlushBufferedAudioSamples(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    bufferedAudioFrames = 0;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::SetAudioCallback(IDeckLinkAudioOutputCallback* theCallback)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (theCallback) theCallback->AddRef();
+    if (audioCallback) audioCallback->Release();
+    audioCallback = theCallback;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::StartScheduledPlayback(BMDTimeValue playbackStartTime, BMDTimeScale timeScale,
+                                              double playbackSpeed)
+{
+    if (timeScale <= 0) return E_INVALIDARG;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!videoEnabled || !mode) return E_ACCESSDENIED;
+    if (timer) return E_ACCESSDENIED;
+
+    uint64_t interval = (uint64_t)(mode->frameDuration * (int64_t)NSEC_PER_SEC / mode->timeScale);
+    dispatch_source_t newTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0,
+                                                        DISPATCH_TIMER_STRICT, queue);
+    if (!newTimer) return E_FAIL;
+    dispatch_source_set_timer(newTimer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)interval), interval, 0);
+
+    // Running timer keeps device alive until cancelled
+    IDeckLink* device = owner;
+    DLABSimOutput* output = this;
+    __unsafe_unretained dispatch_source_t source = newTimer;
+    device->AddRef();
+    dispatch_source_set_event_handler(newTimer, ^{
+        output->Tick(dispatch_source_get_data(source));
+    });
+    dispatch_source_set_cancel_handler(newTimer, ^{
+        device->Release();
+    });
+
+    streamTime = rescaleTime(playbackStartTime, timeScale, mode->timeScale);
+    speed = playbackSpeed;
+    timer = newTimer;
+    dispatch_resume(newTimer);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::StopScheduledPlayback(BMDTimeValue stopPlaybackAtTime, BMDTimeValue* actualStopTime,
+                                             BMDTimeScale timeScale)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (actualStopTime && mode && timeScale > 0) {
+            *actualStopTime = rescaleTime(streamTime, mode->timeScale, timeScale);
+        }
+        if (!timer) return S_OK;
+
+        // Simulated playback always stops immediately
+        StopPlayback(true);
+    }
+
+    // No Tick runs after return
+    waitForDeviceQueue(queue);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::IsScheduledPlaybackRunning(bool* active)
+{
+    if (!active) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    *active = (timer != nil);
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetScheduledStreamTime(BMDTimeScale desiredTimeScale, BMDTimeValue* outStreamTime,
+                                              double* playbackSpeed)
+{
+    if (!outStreamTime || !playbackSpeed || desiredTimeScale <= 0) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!mode) return E_ACCESSDENIED;
+    *outStreamTime = rescaleTime(streamTime, mode->timeScale, desiredTimeScale);
+    *playbackSpeed = (timer != nil) ? speed : 0.0;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetReferenceStatus(BMDReferenceStatus* referenceStatus)
+{
+    if (!referenceStatus) return E_INVALIDARG;
+    *referenceStatus = bmdReferenceNotSupportedByHardware;
+    return S_OK;
+}
+
+HRESULT DLABSimOutput::GetHardwareReferenceClock(BMDTimeScale desiredTimeScale, BMDTimeValue* hardwareTime,
+                                                 BMDTimeValue* timeInFrame, BMDTimeValue* ticksPerFrame)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return getHardwareReferenceClock(mode, desiredTimeScale, hardwareTime, timeInFrame, ticksPerFrame);
+}
+
+HRESULT DLABSimOutput::GetFrameCompletionReferenceTimestamp(IDeckLinkVideoFrame* theFrame, BMDTimeScale desiredTimeScale,
+                                                            BMDTimeValue* frameCompletionTimestamp)
+{
+    if (!theFrame || !frameCompletionTimestamp || desiredTimeScale <= 0) return E_INVALIDARG;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = completions.rbegin(); it != completions.rend(); ++it) {
+        if (it->first == theFrame) {
+            *frameCompletionTimestamp = rescaleTime(it->second, NSEC_PER_SEC, desiredTimeScale);
+            return S_OK;
+        }
+    }
+    return E_FAIL;
+}
+
+// Playback
+
+void DLABSimOutput::StopPlayback(bool notifyStopped)
+{
+    if (timer) {
+        dispatch_source_cancel(timer);
+        timer = nil;
+    }
+
+    // Flush remaining frames; notify on device queue like hardware does
+    std::deque<Scheduled> flushed;
+    flushed.swap(scheduled);
+    IDeckLinkVideoOutputCallback* currentCallback = callback;
+    if (!currentCallback && flushed.empty()) return;
+    if (currentCallback) currentCallback->AddRef();
+
+    IDeckLink* device = owner;
+    device->AddRef();
+    dispatch_async(queue, ^{
+        for (const Scheduled& entry : flushed) {
+            if (currentCallback) {
+                currentCallback->ScheduledFrameCompleted(entry.frame, bmdOutputFrameFlushed);
+            }
+            entry.frame->Release();
+        }
+        if (currentCallback) {
+            if (notifyStopped) currentCallback->ScheduledPlaybackHasStopped();
+            currentCallback->Release();
+        }
+        device->Release();
+    });
+}
+
+void DLABSimOutput::Tick(uint64_t fires)
+{
+    std::vector<Scheduled> completed;
+    IDeckLinkVideoOutputCallback* currentCallback = NULL;
+    IDeckLinkAudioOutputCallback* currentAudioCallback = NULL;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!timer || !mode) return;
+
+        BMDTimeValue lastTime = streamTime;
+        streamTime += (BMDTimeValue)((double)(mode->frameDuration * (int64_t)fires) * speed);
+
+        // Frame is completed once its display period has passed
+        int64_t now = hostTimeNanos();
+        while (!scheduled.empty()) {
+            Scheduled& entry = scheduled.front();
+            if (entry.displayTime + entry.displayDuration > streamTime) break;
+            completed.push_back(entry);
+            scheduled.pop_front();
+
+            completions.push_back(std::make_pair(entry.frame, now));
+            if (completions.size() > kSimMaxCompletionRecords) completions.pop_front();
+        }
+
+        // Consume audio at 48kHz
+        if (audioEnabled && streamTime > lastTime) {
+            uint64_t consumed = (uint64_t)(rescaleTime(streamTime, mode->timeScale, kSimAudioSampleRate) -
+                                           rescaleTime(lastTime, mode->timeScale, kSimAudioSampleRate));
+            bufferedAudioFrames -= MIN(bufferedAudioFrames, consumed);
+        }
+
+        currentCallback = callback;
+        if (currentCallback) currentCallback->AddRef();
+        currentAudioCallback = (audioEnabled ? audioCallback : NULL);
+        if (currentAudioCallback) currentAudioCallback->AddRef();
+    }
+
+    for (const Scheduled& entry : completed) {
+        if (currentCallback) {
+            BMDOutputFrameCompletionResult result = (entry.late ? bmdOutputFrameDisplayedLate
+                                                     : bmdOutputFrameCompleted);
+            currentCallback->ScheduledFrameCompleted(entry.frame, result);
+        }
+        entry.frame->Release();
+    }
+    if (currentCallback) currentCallback->Release();
+
+    if (currentAudioCallback) {
+        currentAudioCallback->RenderAudioSamples(false);
+        currentAudioCallback->Release();
+    }
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimAttributes
+/* =================================================================================== */
+
+class DLABSimAttributes : public IDeckLinkProfileAttributes
+{
+public:
+    DLABSimAttributes(IDeckLink* owner, uint32_t index) : owner(owner), index(index) {}
+    virtual ~DLABSimAttributes() {}
+
+    // IDeckLinkProfileAttributes
+    HRESULT GetFlag(BMDDeckLinkAttributeID cfgID, bool* value) {
+        if (!value) return E_INVALIDARG;
+        switch (cfgID) {
+            case BMDDeckLinkSupportsInternalKeying:
+            case BMDDeckLinkSupportsExternalKeying:
+            case BMDDeckLinkSupportsInputFormatDetection:
+            case BMDDeckLinkSupportsHDRMetadata:
+            case BMDDeckLinkHasReferenceInput:
+                *value = false;
+                return S_OK;
+            default:
+                return E_NOTIMPL;
+        }
+    }
+    HRESULT GetInt(BMDDeckLinkAttributeID cfgID, int64_t* value) {
+        if (!value) return E_INVALIDARG;
+        switch (cfgID) {
+            case BMDDeckLinkVideoIOSupport:
+                *value = (bmdDeviceSupportsCapture | bmdDeviceSupportsPlayback);
+                return S_OK;
+            case BMDDeckLinkPersistentID:
+            case BMDDeckLinkDeviceGroupID:
+                *value = kSimPersistentIDBase + index;
+                return S_OK;
+            case BMDDeckLinkTopologicalID:
+                *value = kSimTopologicalIDBase + index;
+                return S_OK;
+            case BMDDeckLinkNumberOfSubDevices:
+                *value = 1;
+                return S_OK;
+            case BMDDeckLinkSubDeviceIndex:
+                *value = 0;
+                return S_OK;
+            case BMDDeckLinkProfileID:
+                *value = bmdProfileOneSubDeviceFullDuplex;
+                return S_OK;
+            case BMDDeckLinkDuplex:
+                *value = bmdDuplexFull;
+                return S_OK;
+            case BMDDeckLinkMaximumAudioChannels:
+                *value = kSimMaxAudioChannels;
+                return S_OK;
+            case BMDDeckLinkVideoInputConnections:
+            case BMDDeckLinkVideoOutputConnections:
+                *value = bmdVideoConnectionSDI;
+                return S_OK;
+            default:
+                return E_NOTIMPL;
+        }
+    }
+    HRESULT GetFloat(BMDDeckLinkAttributeID cfgID, double* value) { return E_NOTIMPL; }
+    HRESULT GetString(BMDDeckLinkAttributeID cfgID, CFStringRef* value) { return E_NOTIMPL; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    IDeckLink* owner;
+    uint32_t index;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimConfiguration
+/* =================================================================================== */
+
+class DLABSimConfiguration : public IDeckLinkConfiguration
+{
+public:
+    DLABSimConfiguration(IDeckLink* owner) : owner(owner) {}
+    virtual ~DLABSimConfiguration() {
+        for (auto& entry : strings) CFRelease(entry.second);
+    }
+
+    // IDeckLinkConfiguration; keeps any value written
+    HRESULT SetFlag(BMDDeckLinkConfigurationID cfgID, bool value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        flags[cfgID] = value;
+        return S_OK;
+    }
+    HRESULT GetFlag(BMDDeckLinkConfigurationID cfgID, bool* value) {
+        if (!value) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = flags.find(cfgID);
+        if (it == flags.end()) return E_NOTIMPL;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT SetInt(BMDDeckLinkConfigurationID cfgID, int64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ints[cfgID] = value;
+        return S_OK;
+    }
+    HRESULT GetInt(BMDDeckLinkConfigurationID cfgID, int64_t* value) {
+        if (!value) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ints.find(cfgID);
+        if (it == ints.end()) return E_NOTIMPL;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT SetFloat(BMDDeckLinkConfigurationID cfgID, double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        floats[cfgID] = value;
+        return S_OK;
+    }
+    HRESULT GetFloat(BMDDeckLinkConfigurationID cfgID, double* value) {
+        if (!value) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = floats.find(cfgID);
+        if (it == floats.end()) return E_NOTIMPL;
+        *value = it->second;
+        return S_OK;
+    }
+    HRESULT SetString(BMDDeckLinkConfigurationID cfgID, CFStringRef value) {
+        if (!value) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        CFRetain(value);
+        auto it = strings.find(cfgID);
+        if (it != strings.end()) CFRelease(it->second);
+        strings[cfgID] = value;
+        return S_OK;
+    }
+    HRESULT GetString(BMDDeckLinkConfigurationID cfgID, CFStringRef* value) {
+        if (!value) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = strings.find(cfgID);
+        if (it == strings.end()) return E_NOTIMPL;
+        *value = (CFStringRef)CFRetain(it->second);
+        return S_OK;
+    }
+    HRESULT WriteConfigurationToPreferences(void) { return S_OK; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    IDeckLink* owner;
+    std::mutex mutex;
+    std::map<BMDDeckLinkConfigurationID, bool> flags;
+    std::map<BMDDeckLinkConfigurationID, int64_t> ints;
+    std::map<BMDDeckLinkConfigurationID, double> floats;
+    std::map<BMDDeckLinkConfigurationID, CFStringRef> strings;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimStatus
+/* =================================================================================== */
+
+class DLABSimStatus : public IDeckLinkStatus
+{
+public:
+    DLABSimStatus(IDeckLink* owner, DLABSimInput* input, DLABSimOutput* output)
+    : owner(owner), input(input), output(output) {}
+    virtual ~DLABSimStatus() {}
+
+    // IDeckLinkStatus
+    HRESULT GetFlag(BMDDeckLinkStatusID statusID, bool* value) {
+        if (!value) return E_INVALIDARG;
+        switch (statusID) {
+            case bmdDeckLinkStatusVideoInputSignalLocked:
+                *value = (input->CurrentMode() != 0);
+                return S_OK;
+            case bmdDeckLinkStatusReferenceSignalLocked:
+                *value = false;
+                return S_OK;
+            default:
+                return E_NOTIMPL;
+        }
+    }
+    HRESULT GetInt(BMDDeckLinkStatusID statusID, int64_t* value) {
+        if (!value) return E_INVALIDARG;
+        switch (statusID) {
+            case bmdDeckLinkStatusDetectedVideoInputMode:
+            case bmdDeckLinkStatusCurrentVideoInputMode:
+                *value = input->CurrentMode();
+                return S_OK;
+            case bmdDeckLinkStatusCurrentVideoInputPixelFormat:
+                *value = input->CurrentPixelFormat();
+                return S_OK;
+            case bmdDeckLinkStatusCurrentVideoOutputMode:
+                *value = output->CurrentMode();
+                return S_OK;
+            case bmdDeckLinkStatusBusy:
+                *value = ((input->IsStreaming() ? bmdDeviceCaptureBusy : 0) |
+                          (output->IsPlaying() ? bmdDevicePlaybackBusy : 0));
+                return S_OK;
+            default:
+                return E_NOTIMPL;
+        }
+    }
+    HRESULT GetFloat(BMDDeckLinkStatusID statusID, double* value) { return E_NOTIMPL; }
+    HRESULT GetString(BMDDeckLinkStatusID statusID, CFStringRef* value) { return E_NOTIMPL; }
+    HRESULT GetBytes(BMDDeckLinkStatusID statusID, void* buffer, uint32_t* bufferSize) { return E_NOTIMPL; }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    IDeckLink* owner;
+    DLABSimInput* input;
+    DLABSimOutput* output;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimNotification
+/* =================================================================================== */
+
+class DLABSimNotification : public IDeckLinkNotification
+{
+public:
+    DLABSimNotification(IDeckLink* owner) : owner(owner) {}
+    virtual ~DLABSimNotification() {
+        for (auto& entry : subscribers) entry.second->Release();
+    }
+
+    // IDeckLinkNotification; simulated device never changes status spontaneously
+    HRESULT Subscribe(BMDNotifications topic, IDeckLinkNotificationCallback* theCallback) {
+        if (!theCallback) return E_INVALIDARG;
+        std::lock_guard<std::mutex> lock(mutex);
+        theCallback->AddRef();
+        subscribers.push_back(std::make_pair(topic, theCallback));
+        return S_OK;
+    }
+    HRESULT Unsubscribe(BMDNotifications topic, IDeckLinkNotificationCallback* theCallback) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = subscribers.begin(); it != subscribers.end(); ++it) {
+            if (it->first == topic && it->second == theCallback) {
+                it->second->Release();
+                subscribers.erase(it);
+                return S_OK;
+            }
+        }
+        return E_INVALIDARG;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) { return owner->QueryInterface(iid, ppv); }
+    ULONG AddRef() { return owner->AddRef(); }
+    ULONG Release() { return owner->Release(); }
+
+private:
+    IDeckLink* owner;
+    std::mutex mutex;
+    std::vector<std::pair<BMDNotifications, IDeckLinkNotificationCallback*>> subscribers;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimDeckLink
+/* =================================================================================== */
+
+class DLABSimDeckLink : public IDeckLink
+{
+public:
+    DLABSimDeckLink(uint32_t index);
+
+    // IDeckLink
+    HRESULT GetModelName(CFStringRef* modelName);
+    HRESULT GetDisplayName(CFStringRef* displayName);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABSimDeckLink() {}
+
+    uint32_t index;
+    std::atomic<ULONG> refCount;
+    dispatch_queue_t queue;
+    DLABSimAttributes attributes;
+    DLABSimConfiguration configuration;
+    DLABSimInput input;
+    DLABSimOutput output;
+    DLABSimStatus status;
+    DLABSimNotification notification;
+};
+
+DLABSimDeckLink::DLABSimDeckLink(uint32_t index)
+: index(index), refCount(1),
+queue(dispatch_queue_create(kSimulatorQueue, DISPATCH_QUEUE_SERIAL)),
+attributes(this, index), configuration(this), input(this, queue), output(this, queue),
+status(this, &input, &output), notification(this)
+{
+    dispatch_queue_set_specific(queue, &kSimulatorQueueKey, (__bridge void*)queue, NULL);
+}
+
+// IDeckLink
+
+HRESULT DLABSimDeckLink::GetModelName(CFStringRef* modelName)
+{
+    if (!modelName) return E_INVALIDARG;
+    *modelName = CFSTR("DLABridging Simulator");
+    CFRetain(*modelName);
+    return S_OK;
+}
+
+HRESULT DLABSimDeckLink::GetDisplayName(CFStringRef* displayName)
+{
+    if (!displayName) return E_INVALIDARG;
+    *displayName = CFStringCreateWithFormat(NULL, NULL, CFSTR("DLABridging Simulator (%u)"), index + 1);
+    return S_OK;
+}
+
+// IUnknown
+
+HRESULT DLABSimDeckLink::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    if (isIUnknown(iid) || isIID(iid, IID_IDeckLink) || isIID(iid, IID_DLABSimDeckLink)) {
+        *ppv = (IDeckLink *)this;
+    } else if (isIID(iid, IID_IDeckLinkProfileAttributes)) {
+        *ppv = (IDeckLinkProfileAttributes *)&attributes;
+    } else if (isIID(iid, IID_IDeckLinkConfiguration)) {
+        *ppv = (IDeckLinkConfiguration *)&configuration;
+    } else if (isIID(iid, IID_IDeckLinkStatus)) {
+        *ppv = (IDeckLinkStatus *)&status;
+    } else if (isIID(iid, IID_IDeckLinkNotification)) {
+        *ppv = (IDeckLinkNotification *)&notification;
+    } else if (isIID(iid, IID_IDeckLinkInput)) {
+        *ppv = (IDeckLinkInput *)&input;
+    } else if (isIID(iid, IID_IDeckLinkOutput)) {
+        *ppv = (IDeckLinkOutput *)&output;
+    } else {
+        return E_NOINTERFACE;
+    }
+    AddRef();
+    return S_OK;
+}
+
+ULONG DLABSimDeckLink::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABSimDeckLink::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
+
+/* =================================================================================== */
+// MARK: - DLABSimIterator
+/* =================================================================================== */
+
+class DLABSimIterator : public IDeckLinkIterator
+{
+public:
+    DLABSimIterator(uint32_t deviceCount) : deviceCount(deviceCount), index(0), refCount(1) {}
+
+    // IDeckLinkIterator
+    HRESULT Next(IDeckLink** deckLinkInstance) {
+        if (!deckLinkInstance) return E_INVALIDARG;
+        *deckLinkInstance = NULL;
+        if (index >= deviceCount) return S_FALSE;
+        *deckLinkInstance = new DLABSimDeckLink(index++);
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkIterator)) {
+            *ppv = (IDeckLinkIterator *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimIterator() {}
+
+    uint32_t deviceCount;
+    uint32_t index;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - DLABSimDiscovery
+/* =================================================================================== */
+
+class DLABSimDiscovery : public IDeckLinkDiscovery
+{
+public:
+    DLABSimDiscovery(uint32_t deviceCount) : deviceCount(deviceCount), callback(NULL), refCount(1) {}
+
+    // IDeckLinkDiscovery
+    HRESULT InstallDeviceNotifications(IDeckLinkDeviceNotificationCallback* deviceNotificationCallback) {
+        if (!deviceNotificationCallback) return E_INVALIDARG;
+        if (callback) return E_FAIL;
+        callback = deviceNotificationCallback;
+        callback->AddRef();
+
+        // Every simulated device is already connected
+        for (uint32_t i = 0; i < deviceCount; i++) {
+            IDeckLink* deckLink = new DLABSimDeckLink(i);
+            devices.push_back(deckLink);
+            callback->DeckLinkDeviceArrived(deckLink);
+        }
+        return S_OK;
+    }
+    HRESULT UninstallDeviceNotifications(void) {
+        if (!callback) return E_FAIL;
+        for (IDeckLink* deckLink : devices) {
+            callback->DeckLinkDeviceRemoved(deckLink);
+            deckLink->Release();
+        }
+        devices.clear();
+        callback->Release();
+        callback = NULL;
+        return S_OK;
+    }
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv) {
+        *ppv = NULL;
+        if (isIUnknown(iid) || isIID(iid, IID_IDeckLinkDiscovery)) {
+            *ppv = (IDeckLinkDiscovery *)this;
+            AddRef();
+            return S_OK;
+        }
+        return E_NOINTERFACE;
+    }
+    ULONG AddRef() { return ++refCount; }
+    ULONG Release() {
+        ULONG newRefValue = --refCount;
+        if (newRefValue == 0) delete this;
+        return newRefValue;
+    }
+
+private:
+    virtual ~DLABSimDiscovery() {
+        UninstallDeviceNotifications();
+    }
+
+    uint32_t deviceCount;
+    IDeckLinkDeviceNotificationCallback* callback;
+    std::vector<IDeckLink*> devices;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+// MARK: - public
+/* =================================================================================== */
+
+IDeckLinkIterator* DLABSimulatorCreateIteratorInstance(uint32_t deviceCount)
+{
+    return new DLABSimIterator(deviceCount);
+}
+
+IDeckLinkDiscovery* DLABSimulatorCreateDiscoveryInstance(uint32_t deviceCount)
+{
+    return new DLABSimDiscovery(deviceCount);
+}
+
+bool DLABSimulatorIsSimulatedDeckLink(IDeckLink* deckLink)
+{
+    if (!deckLink) return false;
+    IDeckLink* simulated = NULL;
+    HRESULT result = deckLink->QueryInterface(IID_DLABSimDeckLink, (void**)&simulated);
+    if (result == S_OK && simulated) {
+        simulated->Release();
+        return true;
+    }
+    return false;
+}
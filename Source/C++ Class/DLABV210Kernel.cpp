@@ -0,0 +1,628 @@
+//
+//  DLABV210Kernel.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DLAB_KERNEL_X86 1
+#define DLAB_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define DLAB_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DLAB_KERNEL_NEON 1
+#endif
+
+/*
+ v210 block : 4 x uint32_t (16 bytes) = 6 pixels = 12 components
+
+ word0 : Cb0 | Y0 << 10 | Cr0 << 20
+ word1 : Y1  | Cb1 << 10 | Y2 << 20
+ word2 : Cr1 | Y3 << 10 | Cb2 << 20
+ word3 : Y4  | Cr2 << 10 | Y5 << 20
+
+ Component order (Cb Y0 Cr Y1 ...) is same as 2vuy/v216. So unpacking each word
+ into three components in order produces 2vuy/v216 layout directly.
+ */
+
+static const size_t kV210BlockBytes = 16;
+static const size_t kV210BlockPixels = 6;
+static const size_t kV210BlockComponents = 12;
+
+/* =================================================================================== */
+// MARK: - scalar
+/* =================================================================================== */
+
+static inline uint32_t loadWord(const uint8_t* src)
+{
+    uint32_t word = 0;
+    memcpy(&word, src, sizeof(word)); // little endian host
+    return word;
+}
+
+static inline void storeWord(uint8_t* dst, uint32_t word)
+{
+    memcpy(dst, &word, sizeof(word)); // little endian host
+}
+
+static inline void unpackBlock(const uint8_t* src, uint16_t* comp)
+{
+    for (size_t k = 0; k < 4; k++) {
+        uint32_t word = loadWord(src + k * 4);
+        comp[k * 3 + 0] = (uint16_t)((word      ) & 0x3FF);
+        comp[k * 3 + 1] = (uint16_t)((word >> 10) & 0x3FF);
+        comp[k * 3 + 2] = (uint16_t)((word >> 20) & 0x3FF);
+    }
+}
+
+static inline void packBlock(const uint16_t* comp, uint8_t* dst)
+{
+    for (size_t k = 0; k < 4; k++) {
+        uint32_t word = ((uint32_t)comp[k * 3 + 0]      |
+                         (uint32_t)comp[k * 3 + 1] << 10 |
+                         (uint32_t)comp[k * 3 + 2] << 20);
+        storeWord(dst + k * 4, word);
+    }
+}
+
+static inline uint8_t to8bit(uint16_t v10)
+{
+    uint16_t v = (uint16_t)((v10 + 2) >> 2);
+    return (uint8_t)(v > 255 ? 255 : v);
+}
+
+static inline uint16_t to16bit(uint16_t v10)
+{
+    return (uint16_t)(v10 << 6);
+}
+
+static inline uint16_t from8bit(uint8_t v8)
+{
+    return (uint16_t)(v8 << 2);
+}
+
+static inline uint16_t from16bit(uint16_t v16)
+{
+    uint32_t v = ((uint32_t)v16 + 32) >> 6;
+    return (uint16_t)(v > 1023 ? 1023 : v);
+}
+
+// Unpack/pack partial block. count is number of valid components (2 * pixels).
+
+static void v210To2vuyPartial(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    uint16_t comp[kV210BlockComponents];
+    unpackBlock(src, comp);
+    for (size_t i = 0; i < count; i++) dst[i] = to8bit(comp[i]);
+}
+
+static void v210ToV216Partial(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    uint16_t comp[kV210BlockComponents];
+    unpackBlock(src, comp);
+    uint16_t* out = (uint16_t*)dst;
+    for (size_t i = 0; i < count; i++) out[i] = to16bit(comp[i]);
+}
+
+static void fillRemainder(uint16_t* comp, size_t count)
+{
+    // Replicate last Cb Y Cr Y group into padding pixels
+    for (size_t i = count; i < kV210BlockComponents; i++) {
+        comp[i] = (count >= 4) ? comp[i - 4 * ((i - count) / 4 + 1)] : 0;
+    }
+}
+
+static void twoVuyToV210Partial(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    uint16_t comp[kV210BlockComponents] = {0};
+    for (size_t i = 0; i < count; i++) comp[i] = from8bit(src[i]);
+    fillRemainder(comp, count);
+    packBlock(comp, dst);
+}
+
+static void v216ToV210Partial(const uint8_t* src, uint8_t* dst, size_t count)
+{
+    uint16_t comp[kV210BlockComponents] = {0};
+    uint16_t in[kV210BlockComponents] = {0};
+    memcpy(in, src, count * sizeof(uint16_t));
+    for (size_t i = 0; i < count; i++) comp[i] = from16bit(in[i]);
+    fillRemainder(comp, count);
+    packBlock(comp, dst);
+}
+
+// Full block rows
+
+static void v210To2vuyScalar(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        v210To2vuyPartial(src, dst, kV210BlockComponents);
+        src += kV210BlockBytes;
+        dst += kV210BlockComponents;
+    }
+}
+
+static void v210ToV216Scalar(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        v210ToV216Partial(src, dst, kV210BlockComponents);
+        src += kV210BlockBytes;
+        dst += kV210BlockComponents * 2;
+    }
+}
+
+static void twoVuyToV210Scalar(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        twoVuyToV210Partial(src, dst, kV210BlockComponents);
+        src += kV210BlockComponents;
+        dst += kV210BlockBytes;
+    }
+}
+
+static void v216ToV210Scalar(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        v216ToV210Partial(src, dst, kV210BlockComponents);
+        src += kV210BlockComponents * 2;
+        dst += kV210BlockBytes;
+    }
+}
+
+/* =================================================================================== */
+// MARK: - SSE4.1 / AVX2
+/* =================================================================================== */
+
+#if DLAB_KERNEL_X86
+
+// Unpack one block into 12 x uint16_t; lo = comp[0..7], hi = comp[8..11] (lower half)
+DLAB_TARGET_SSE41 static inline void sseUnpack(const uint8_t* src, __m128i* lo, __m128i* hi)
+{
+    const __m128i mask = _mm_set1_epi32(0x3FF);
+    __m128i w = _mm_loadu_si128((const __m128i*)src);
+    __m128i a = _mm_and_si128(w, mask);
+    __m128i b = _mm_and_si128(_mm_srli_epi32(w, 10), mask);
+    __m128i c = _mm_and_si128(_mm_srli_epi32(w, 20), mask);
+    __m128i ab = _mm_or_si128(a, _mm_slli_epi32(b, 16));    // a0 b0 a1 b1 a2 b2 a3 b3
+    __m128i cc = _mm_packus_epi32(c, c);                     // c0 c1 c2 c3 c0 c1 c2 c3
+
+    const __m128i abLo = _mm_setr_epi8(0,1,2,3, -1,-1, 4,5,6,7, -1,-1, 8,9,10,11);
+    const __m128i ccLo = _mm_setr_epi8(-1,-1,-1,-1, 0,1, -1,-1,-1,-1, 2,3, -1,-1,-1,-1);
+    const __m128i abHi = _mm_setr_epi8(-1,-1, 12,13,14,15, -1,-1, -1,-1,-1,-1,-1,-1,-1,-1);
+    const __m128i ccHi = _mm_setr_epi8(4,5, -1,-1,-1,-1, 6,7, -1,-1,-1,-1,-1,-1,-1,-1);
+    *lo = _mm_or_si128(_mm_shuffle_epi8(ab, abLo), _mm_shuffle_epi8(cc, ccLo));
+    *hi = _mm_or_si128(_mm_shuffle_epi8(ab, abHi), _mm_shuffle_epi8(cc, ccHi));
+}
+
+// Pack 12 x uint16_t (10bit) into one block; lo = comp[0..7], hi = comp[8..11] (lower half)
+DLAB_TARGET_SSE41 static inline void ssePack(__m128i lo, __m128i hi, uint8_t* dst)
+{
+    const __m128i aLo = _mm_setr_epi8(0,1,-1,-1, 6,7,-1,-1, 12,13,-1,-1, -1,-1,-1,-1);
+    const __m128i aHi = _mm_setr_epi8(-1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, 2,3,-1,-1);
+    const __m128i bLo = _mm_setr_epi8(2,3,-1,-1, 8,9,-1,-1, 14,15,-1,-1, -1,-1,-1,-1);
+    const __m128i bHi = _mm_setr_epi8(-1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, 4,5,-1,-1);
+    const __m128i cLo = _mm_setr_epi8(4,5,-1,-1, 10,11,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1);
+    const __m128i cHi = _mm_setr_epi8(-1,-1,-1,-1, -1,-1,-1,-1, 0,1,-1,-1, 6,7,-1,-1);
+    __m128i a = _mm_or_si128(_mm_shuffle_epi8(lo, aLo), _mm_shuffle_epi8(hi, aHi));
+    __m128i b = _mm_or_si128(_mm_shuffle_epi8(lo, bLo), _mm_shuffle_epi8(hi, bHi));
+    __m128i c = _mm_or_si128(_mm_shuffle_epi8(lo, cLo), _mm_shuffle_epi8(hi, cHi));
+    __m128i w = _mm_or_si128(a, _mm_or_si128(_mm_slli_epi32(b, 10), _mm_slli_epi32(c, 20)));
+    _mm_storeu_si128((__m128i*)dst, w);
+}
+
+DLAB_TARGET_SSE41 static inline void sseStore2vuy(__m128i lo, __m128i hi, uint8_t* dst)
+{
+    const __m128i round = _mm_set1_epi16(2);
+    lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 2);
+    hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 2);
+    __m128i v8 = _mm_packus_epi16(lo, hi); // 12 bytes valid
+    _mm_storel_epi64((__m128i*)dst, v8);
+    uint32_t tail = (uint32_t)_mm_extract_epi32(v8, 2);
+    memcpy(dst + 8, &tail, sizeof(tail));
+}
+
+DLAB_TARGET_SSE41 static void v210To2vuySSE41(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        __m128i lo, hi;
+        sseUnpack(src, &lo, &hi);
+        sseStore2vuy(lo, hi, dst);
+        src += kV210BlockBytes;
+        dst += kV210BlockComponents;
+    }
+}
+
+DLAB_TARGET_SSE41 static void v210ToV216SSE41(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        __m128i lo, hi;
+        sseUnpack(src, &lo, &hi);
+        _mm_storeu_si128((__m128i*)dst, _mm_slli_epi16(lo, 6));
+        _mm_storel_epi64((__m128i*)(dst + 16), _mm_slli_epi16(hi, 6));
+        src += kV210BlockBytes;
+        dst += kV210BlockComponents * 2;
+    }
+}
+
+DLAB_TARGET_SSE41 static void twoVuyToV210SSE41(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    for (size_t n = 0; n < blocks; n++) {
+        uint32_t tail = 0;
+        memcpy(&tail, src + 8, sizeof(tail));
+        __m128i lo = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i*)src));
+        __m128i hi = _mm_cvtepu8_epi16(_mm_cvtsi32_si128((int)tail));
+        ssePack(_mm_slli_epi16(lo, 2), _mm_slli_epi16(hi, 2), dst);
+        src += kV210BlockComponents;
+        dst += kV210BlockBytes;
+    }
+}
+
+DLAB_TARGET_SSE41 static void v216ToV210SSE41(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    const __m128i round = _mm_set1_epi16(32);
+    for (size_t n = 0; n < blocks; n++) {
+        __m128i lo = _mm_loadu_si128((const __m128i*)src);
+        __m128i hi = _mm_loadl_epi64((const __m128i*)(src + 16));
+        lo = _mm_srli_epi16(_mm_adds_epu16(lo, round), 6);
+        hi = _mm_srli_epi16(_mm_adds_epu16(hi, round), 6);
+        ssePack(lo, hi, dst);
+        src += kV210BlockComponents * 2;
+        dst += kV210BlockBytes;
+    }
+}
+
+// AVX2: two blocks per iteration (each 128bit lane processes one block)
+DLAB_TARGET_AVX2 static inline void avxUnpack(const uint8_t* src, __m256i* lo, __m256i* hi)
+{
+    const __m256i mask = _mm256_set1_epi32(0x3FF);
+    __m256i w = _mm256_loadu_si256((const __m256i*)src);
+    __m256i a = _mm256_and_si256(w, mask);
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(w, 10), mask);
+    __m256i c = _mm256_and_si256(_mm256_srli_epi32(w, 20), mask);
+    __m256i ab = _mm256_or_si256(a, _mm256_slli_epi32(b, 16));
+    __m256i cc = _mm256_packus_epi32(c, c);
+
+    const __m256i abLo = _mm256_setr_epi8(0,1,2,3, -1,-1, 4,5,6,7, -1,-1, 8,9,10,11,
+                                          0,1,2,3, -1,-1, 4,5,6,7, -1,-1, 8,9,10,11);
+    const __m256i ccLo = _mm256_setr_epi8(-1,-1,-1,-1, 0,1, -1,-1,-1,-1, 2,3, -1,-1,-1,-1,
+                                          -1,-1,-1,-1, 0,1, -1,-1,-1,-1, 2,3, -1,-1,-1,-1);
+    const __m256i abHi = _mm256_setr_epi8(-1,-1, 12,13,14,15, -1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
+                                          -1,-1, 12,13,14,15, -1,-1, -1,-1,-1,-1,-1,-1,-1,-1);
+    const __m256i ccHi = _mm256_setr_epi8(4,5, -1,-1,-1,-1, 6,7, -1,-1,-1,-1,-1,-1,-1,-1,
+                                          4,5, -1,-1,-1,-1, 6,7, -1,-1,-1,-1,-1,-1,-1,-1);
+    *lo = _mm256_or_si256(_mm256_shuffle_epi8(ab, abLo), _mm256_shuffle_epi8(cc, ccLo));
+    *hi = _mm256_or_si256(_mm256_shuffle_epi8(ab, abHi), _mm256_shuffle_epi8(cc, ccHi));
+}
+
+DLAB_TARGET_AVX2 static void v210To2vuyAVX2(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    const __m256i round = _mm256_set1_epi16(2);
+    size_t n = 0;
+    for (; n + 2 <= blocks; n += 2) {
+        __m256i lo, hi;
+        avxUnpack(src, &lo, &hi);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, round), 2);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, round), 2);
+        __m256i v8 = _mm256_packus_epi16(lo, hi); // 12 bytes valid per lane
+        __m128i v0 = _mm256_castsi256_si128(v8);
+        __m128i v1 = _mm256_extracti128_si256(v8, 1);
+        uint32_t tail0 = (uint32_t)_mm_extract_epi32(v0, 2);
+        uint32_t tail1 = (uint32_t)_mm_extract_epi32(v1, 2);
+        _mm_storel_epi64((__m128i*)dst, v0);
+        memcpy(dst + 8, &tail0, sizeof(tail0));
+        _mm_storel_epi64((__m128i*)(dst + 12), v1);
+        memcpy(dst + 20, &tail1, sizeof(tail1));
+        src += kV210BlockBytes * 2;
+        dst += kV210BlockComponents * 2;
+    }
+    if (n < blocks) {
+        v210To2vuySSE41(src, dst, blocks - n);
+    }
+}
+
+DLAB_TARGET_AVX2 static void v210ToV216AVX2(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    size_t n = 0;
+    for (; n + 2 <= blocks; n += 2) {
+        __m256i lo, hi;
+        avxUnpack(src, &lo, &hi);
+        lo = _mm256_slli_epi16(lo, 6);
+        hi = _mm256_slli_epi16(hi, 6);
+        _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(lo));
+        _mm_storel_epi64((__m128i*)(dst + 16), _mm256_castsi256_si128(hi));
+        _mm_storeu_si128((__m128i*)(dst + 24), _mm256_extracti128_si256(lo, 1));
+        _mm_storel_epi64((__m128i*)(dst + 40), _mm256_extracti128_si256(hi, 1));
+        src += kV210BlockBytes * 2;
+        dst += kV210BlockComponents * 2 * 2;
+    }
+    if (n < blocks) {
+        v210ToV216SSE41(src, dst, blocks - n);
+    }
+}
+
+#endif /* DLAB_KERNEL_X86 */
+
+/* =================================================================================== */
+// MARK: - NEON
+/* =================================================================================== */
+
+#if DLAB_KERNEL_NEON
+
+static void v210To2vuyNEON(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    const uint32x4_t mask = vdupq_n_u32(0x3FF);
+    size_t n = 0;
+    for (; n + 2 <= blocks; n += 2) {
+        uint32x4_t w0 = vld1q_u32((const uint32_t*)src);
+        uint32x4_t w1 = vld1q_u32((const uint32_t*)(src + 16));
+        uint16x8_t a = vcombine_u16(vmovn_u32(vandq_u32(w0, mask)),
+                                    vmovn_u32(vandq_u32(w1, mask)));
+        uint16x8_t b = vcombine_u16(vmovn_u32(vandq_u32(vshrq_n_u32(w0, 10), mask)),
+                                    vmovn_u32(vandq_u32(vshrq_n_u32(w1, 10), mask)));
+        uint16x8_t c = vcombine_u16(vmovn_u32(vandq_u32(vshrq_n_u32(w0, 20), mask)),
+                                    vmovn_u32(vandq_u32(vshrq_n_u32(w1, 20), mask)));
+        uint8x8x3_t v8;
+        v8.val[0] = vqrshrn_n_u16(a, 2);
+        v8.val[1] = vqrshrn_n_u16(b, 2);
+        v8.val[2] = vqrshrn_n_u16(c, 2);
+        vst3_u8(dst, v8); // 24 bytes = 2 blocks
+        src += kV210BlockBytes * 2;
+        dst += kV210BlockComponents * 2;
+    }
+    if (n < blocks) {
+        v210To2vuyScalar(src, dst, blocks - n);
+    }
+}
+
+static void v210ToV216NEON(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    const uint32x4_t mask = vdupq_n_u32(0x3FF);
+    for (size_t n = 0; n < blocks; n++) {
+        uint32x4_t w = vld1q_u32((const uint32_t*)src);
+        uint16x4x3_t v16;
+        v16.val[0] = vshl_n_u16(vmovn_u32(vandq_u32(w, mask)), 6);
+        v16.val[1] = vshl_n_u16(vmovn_u32(vandq_u32(vshrq_n_u32(w, 10), mask)), 6);
+        v16.val[2] = vshl_n_u16(vmovn_u32(vandq_u32(vshrq_n_u32(w, 20), mask)), 6);
+        vst3_u16((uint16_t*)dst, v16); // 24 bytes = 1 block
+        src += kV210BlockBytes;
+        dst += kV210BlockComponents * 2;
+    }
+}
+
+static void twoVuyToV210NEON(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    size_t n = 0;
+    for (; n + 2 <= blocks; n += 2) {
+        uint8x8x3_t v8 = vld3_u8(src); // 24 bytes = 2 blocks
+        uint16x8_t a = vshll_n_u8(v8.val[0], 2);
+        uint16x8_t b = vshll_n_u8(v8.val[1], 2);
+        uint16x8_t c = vshll_n_u8(v8.val[2], 2);
+        uint32x4_t w0 = vorrq_u32(vmovl_u16(vget_low_u16(a)),
+                                  vorrq_u32(vshlq_n_u32(vmovl_u16(vget_low_u16(b)), 10),
+                                            vshlq_n_u32(vmovl_u16(vget_low_u16(c)), 20)));
+        uint32x4_t w1 = vorrq_u32(vmovl_u16(vget_high_u16(a)),
+                                  vorrq_u32(vshlq_n_u32(vmovl_u16(vget_high_u16(b)), 10),
+                                            vshlq_n_u32(vmovl_u16(vget_high_u16(c)), 20)));
+        vst1q_u32((uint32_t*)dst, w0);
+        vst1q_u32((uint32_t*)(dst + 16), w1);
+        src += kV210BlockComponents * 2;
+        dst += kV210BlockBytes * 2;
+    }
+    if (n < blocks) {
+        twoVuyToV210Scalar(src, dst, blocks - n);
+    }
+}
+
+static void v216ToV210NEON(const uint8_t* src, uint8_t* dst, size_t blocks)
+{
+    const uint16x4_t limit = vdup_n_u16(1023);
+    for (size_t n = 0; n < blocks; n++) {
+        uint16x4x3_t v16 = vld3_u16((const uint16_t*)src); // 24 bytes = 1 block
+        uint16x4_t a = vmin_u16(vrshr_n_u16(v16.val[0], 6), limit);
+        uint16x4_t b = vmin_u16(vrshr_n_u16(v16.val[1], 6), limit);
+        uint16x4_t c = vmin_u16(vrshr_n_u16(v16.val[2], 6), limit);
+        uint32x4_t w = vorrq_u32(vmovl_u16(a),
+                                 vorrq_u32(vshlq_n_u32(vmovl_u16(b), 10),
+                                           vshlq_n_u32(vmovl_u16(c), 20)));
+        vst1q_u32((uint32_t*)dst, w);
+        src += kV210BlockComponents * 2;
+        dst += kV210BlockBytes;
+    }
+}
+
+#endif /* DLAB_KERNEL_NEON */
+
+/* =================================================================================== */
+// MARK: - dispatch
+/* =================================================================================== */
+
+typedef void (*DLABKernelRowFunc)(const uint8_t* src, uint8_t* dst, size_t blocks);
+typedef void (*DLABKernelPartialFunc)(const uint8_t* src, uint8_t* dst, size_t count);
+
+typedef struct {
+    DLABKernelRowFunc v210To2vuy;
+    DLABKernelRowFunc v210ToV216;
+    DLABKernelRowFunc twoVuyToV210;
+    DLABKernelRowFunc v216ToV210;
+} DLABKernelTable;
+
+static const DLABKernelTable kScalarTable = {
+    v210To2vuyScalar, v210ToV216Scalar, twoVuyToV210Scalar, v216ToV210Scalar
+};
+#if DLAB_KERNEL_X86
+static const DLABKernelTable kSSE41Table = {
+    v210To2vuySSE41, v210ToV216SSE41, twoVuyToV210SSE41, v216ToV210SSE41
+};
+static const DLABKernelTable kAVX2Table = {
+    v210To2vuyAVX2, v210ToV216AVX2, twoVuyToV210SSE41, v216ToV210SSE41
+};
+#endif
+#if DLAB_KERNEL_NEON
+static const DLABKernelTable kNEONTable = {
+    v210To2vuyNEON, v210ToV216NEON, twoVuyToV210NEON, v216ToV210NEON
+};
+#endif
+
+static std::atomic<int> activeBackend(-1);
+
+static bool isSupported(DLABKernelBackend backend)
+{
+    switch (backend) {
+        case DLABKernelBackendScalar:
+            return true;
+#if DLAB_KERNEL_X86
+        case DLABKernelBackendSSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case DLABKernelBackendAVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("sse4.1");
+#endif
+#if DLAB_KERNEL_NEON
+        case DLABKernelBackendNEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+static DLABKernelBackend bestBackend(void)
+{
+    if (isSupported(DLABKernelBackendNEON)) return DLABKernelBackendNEON;
+    if (isSupported(DLABKernelBackendAVX2)) return DLABKernelBackendAVX2;
+    if (isSupported(DLABKernelBackendSSE41)) return DLABKernelBackendSSE41;
+    return DLABKernelBackendScalar;
+}
+
+static const DLABKernelTable* currentTable(void)
+{
+    switch (DLABKernelGetBackend()) {
+#if DLAB_KERNEL_X86
+        case DLABKernelBackendSSE41:
+            return &kSSE41Table;
+        case DLABKernelBackendAVX2:
+            return &kAVX2Table;
+#endif
+#if DLAB_KERNEL_NEON
+        case DLABKernelBackendNEON:
+            return &kNEONTable;
+#endif
+        default:
+            return &kScalarTable;
+    }
+}
+
+DLABKernelBackend DLABKernelGetBackend(void)
+{
+    int backend = activeBackend.load(std::memory_order_relaxed);
+    if (backend < 0) {
+        backend = (int)bestBackend();
+        activeBackend.store(backend, std::memory_order_relaxed);
+    }
+    return (DLABKernelBackend)backend;
+}
+
+DLABKernelBackend DLABKernelSetBackend(DLABKernelBackend backend)
+{
+    DLABKernelBackend applied = isSupported(backend) ? backend : DLABKernelBackendScalar;
+    activeBackend.store((int)applied, std::memory_order_relaxed);
+    return applied;
+}
+
+const char* DLABKernelBackendName(DLABKernelBackend backend)
+{
+    switch (backend) {
+        case DLABKernelBackendScalar: return "Scalar";
+        case DLABKernelBackendSSE41: return "SSE4.1";
+        case DLABKernelBackendAVX2: return "AVX2";
+        case DLABKernelBackendNEON: return "NEON";
+        default: return "Unknown";
+    }
+}
+
+/* =================================================================================== */
+// MARK: - image
+/* =================================================================================== */
+
+static inline size_t v210RowBytesFor(size_t width)
+{
+    return ((width + kV210BlockPixels - 1) / kV210BlockPixels) * kV210BlockBytes;
+}
+
+static bool processImage(const void* src, size_t srcRowBytes, size_t srcBlockBytes,
+                         void* dst, size_t dstRowBytes, size_t dstBlockBytes,
+                         size_t width, size_t height,
+                         DLABKernelRowFunc rowFunc, DLABKernelPartialFunc partialFunc)
+{
+    const uint8_t* srcRow = (const uint8_t*)src;
+    uint8_t* dstRow = (uint8_t*)dst;
+    size_t blocks = width / kV210BlockPixels;
+    size_t remain = width % kV210BlockPixels;
+    for (size_t y = 0; y < height; y++) {
+        rowFunc(srcRow, dstRow, blocks);
+        if (remain) {
+            partialFunc(srcRow + blocks * srcBlockBytes,
+                        dstRow + blocks * dstBlockBytes,
+                        remain * 2);
+        }
+        srcRow += srcRowBytes;
+        dstRow += dstRowBytes;
+    }
+    return true;
+}
+
+bool DLABKernelV210To2vuy(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height)
+{
+    if (!src || !dst || !width || !height || (width & 1)) return false;
+    if (srcRowBytes < v210RowBytesFor(width) || dstRowBytes < width * 2) return false;
+    return processImage(src, srcRowBytes, kV210BlockBytes,
+                        dst, dstRowBytes, kV210BlockComponents,
+                        width, height,
+                        currentTable()->v210To2vuy, v210To2vuyPartial);
+}
+
+bool DLABKernelV210ToV216(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height)
+{
+    if (!src || !dst || !width || !height || (width & 1)) return false;
+    if (srcRowBytes < v210RowBytesFor(width) || dstRowBytes < width * 4) return false;
+    return processImage(src, srcRowBytes, kV210BlockBytes,
+                        dst, dstRowBytes, kV210BlockComponents * 2,
+                        width, height,
+                        currentTable()->v210ToV216, v210ToV216Partial);
+}
+
+bool DLABKernel2vuyToV210(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height)
+{
+    if (!src || !dst || !width || !height || (width & 1)) return false;
+    if (srcRowBytes < width * 2 || dstRowBytes < v210RowBytesFor(width)) return false;
+    return processImage(src, srcRowBytes, kV210BlockComponents,
+                        dst, dstRowBytes, kV210BlockBytes,
+                        width, height,
+                        currentTable()->twoVuyToV210, twoVuyToV210Partial);
+}
+
+bool DLABKernelV216ToV210(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height)
+{
+    if (!src || !dst || !width || !height || (width & 1)) return false;
+    if (srcRowBytes < width * 4 || dstRowBytes < v210RowBytesFor(width)) return false;
+    return processImage(src, srcRowBytes, kV210BlockComponents * 2,
+                        dst, dstRowBytes, kV210BlockBytes,
+                        width, height,
+                        currentTable()->v216ToV210, v216ToV210Partial);
+}
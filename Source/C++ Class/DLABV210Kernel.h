@@ -0,0 +1,80 @@
+//
+//  DLABV210Kernel.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABV210Kernel_h
+#define DLABV210Kernel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Internal use only
+ * Portable v210 unpack/pack kernels (plain C++, no Apple framework dependency)
+ *
+ * Each function converts whole image in single pass without interim buffer.
+ * Component order (Cb Y0 Cr Y1) and video range are preserved; only bit depth
+ * is changed. So no colorspace conversion is performed.
+ *
+ * - v210 => 2vuy : 10bit => 8bit (rounded)
+ * - v210 => v216 : 10bit => 16bit (msb aligned, little endian)
+ * - 2vuy => v210 : 8bit => 10bit
+ * - v216 => v210 : 16bit => 10bit (rounded)
+ *
+ * Width should be even. Row of v210 must be padded to 6 pixel (16 bytes) block
+ * boundary, as DeckLink and CoreVideo always do.
+ */
+
+typedef enum {
+    DLABKernelBackendScalar = 0,
+    DLABKernelBackendSSE41  = 1,    // x86_64 : SSE4.1 (unpack/pack)
+    DLABKernelBackendAVX2   = 2,    // x86_64 : AVX2 (unpack), SSE4.1 (pack)
+    DLABKernelBackendNEON   = 3,    // arm64  : NEON (unpack/pack)
+} DLABKernelBackend;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Currently active backend. Best available one is selected on first use.
+DLABKernelBackend DLABKernelGetBackend(void);
+
+/// Override backend (for debugging/verification). Unsupported backend falls back to scalar.
+/// @return actually applied backend
+DLABKernelBackend DLABKernelSetBackend(DLABKernelBackend backend);
+
+/// Human readable name of backend
+const char* DLABKernelBackendName(DLABKernelBackend backend);
+
+/// Convert v210 image into 2vuy image.
+bool DLABKernelV210To2vuy(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height);
+
+/// Convert v210 image into v216 image.
+bool DLABKernelV210ToV216(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height);
+
+/// Convert 2vuy image into v210 image.
+bool DLABKernel2vuyToV210(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height);
+
+/// Convert v216 image into v210 image.
+bool DLABKernelV216ToV210(const void* src, size_t srcRowBytes,
+                          void* dst, size_t dstRowBytes,
+                          size_t width, size_t height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DLABV210Kernel_h */
@@ -0,0 +1,146 @@
+//
+//  DLABVideoBufferAllocator.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <DeckLinkAPI.h>
+#import <atomic>
+#import <mutex>
+
+/*
+ * Internal use only
+ * This is C++ subclass from
+ * IDeckLinkVideoBuffer, IDeckLinkMacVideoBuffer,
+ * IDeckLinkVideoBufferAllocator, IDeckLinkVideoBufferAllocatorProvider
+ *
+ * Captured frame is DMA'd directly into CVPixelBuffer from CVPixelBufferPool.
+ * Requires DeckLink API 14.3 or later.
+ *
+ * DLABExternalVideoBuffer wraps read-only memory owned by someone else (e.g. mapped
+ * file) for IDeckLinkOutput::CreateVideoFrameWithBuffer(). Owner is notified via
+ * release callback when the last reference is gone.
+ */
+
+/* =================================================================================== */
+
+class DLABVideoBuffer : public IDeckLinkVideoBuffer, public IDeckLinkMacVideoBuffer
+{
+public:
+    DLABVideoBuffer(CVPixelBufferRef pixelBuffer);
+    DLABVideoBuffer(void* bytes, size_t length);
+
+    // IDeckLinkVideoBuffer
+    HRESULT GetBytes(void** buffer);
+    HRESULT StartAccess(BMDBufferAccessFlags flags);
+    HRESULT EndAccess(BMDBufferAccessFlags flags);
+
+    // IDeckLinkMacVideoBuffer
+    HRESULT CreateCVPixelBufferRef(void** cvPixelBuffer);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABVideoBuffer();
+
+    CVPixelBufferRef pixelBuffer;   // either pixelBuffer or bytes is available
+    void* bytes;
+    size_t length;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+
+class DLABExternalVideoBuffer : public IDeckLinkVideoBuffer
+{
+public:
+    typedef void (*ReleaseCallback)(void* context);
+
+    DLABExternalVideoBuffer(const void* bytes, ReleaseCallback callback, void* context);
+
+    // IDeckLinkVideoBuffer
+    HRESULT GetBytes(void** buffer);
+    HRESULT StartAccess(BMDBufferAccessFlags flags);
+    HRESULT EndAccess(BMDBufferAccessFlags flags);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABExternalVideoBuffer();
+
+    const void* bytes;
+    ReleaseCallback callback;
+    void* context;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+
+class DLABVideoBufferAllocator : public IDeckLinkVideoBufferAllocator
+{
+public:
+    DLABVideoBufferAllocator(uint32_t bufferSize, uint32_t width, uint32_t height,
+                             uint32_t rowBytes, BMDPixelFormat pixelFormat,
+                             NSDictionary* pixelBufferAttributes);
+
+    // Utility
+    bool IsCompatible(uint32_t bufferSize, uint32_t width, uint32_t height,
+                      uint32_t rowBytes, BMDPixelFormat pixelFormat);
+
+    // IDeckLinkVideoBufferAllocator
+    HRESULT AllocateVideoBuffer(IDeckLinkVideoBuffer** allocatedBuffer);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABVideoBufferAllocator();
+
+    uint32_t _bufferSize;
+    uint32_t _width;
+    uint32_t _height;
+    uint32_t _rowBytes;
+    BMDPixelFormat _pixelFormat;
+    CVPixelBufferPoolRef pool;
+    std::atomic<ULONG> refCount;
+};
+
+/* =================================================================================== */
+
+class DLABVideoBufferAllocatorProvider : public IDeckLinkVideoBufferAllocatorProvider
+{
+public:
+    DLABVideoBufferAllocatorProvider(NSDictionary* pixelBufferAttributes);
+
+    // IDeckLinkVideoBufferAllocatorProvider
+    HRESULT GetVideoBufferAllocator(uint32_t bufferSize, uint32_t width, uint32_t height,
+                                    uint32_t rowBytes, BMDPixelFormat pixelFormat,
+                                    IDeckLinkVideoBufferAllocator** allocator);
+
+    // IUnknown
+    HRESULT QueryInterface(REFIID iid, LPVOID *ppv);
+    ULONG AddRef();
+    ULONG Release();
+
+private:
+    virtual ~DLABVideoBufferAllocatorProvider();
+
+    NSDictionary* attributes;
+    DLABVideoBufferAllocator* current;
+    std::mutex mutex;
+    std::atomic<ULONG> refCount;
+};
@@ -0,0 +1,413 @@
+//
+//  DLABVideoBufferAllocator.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABVideoBufferAllocator.h>
+
+/* =================================================================================== */
+// MARK: - DLABVideoBuffer
+/* =================================================================================== */
+
+DLABVideoBuffer::DLABVideoBuffer(CVPixelBufferRef pixelBuffer)
+: pixelBuffer(pixelBuffer), bytes(NULL), length(0), refCount(1)
+{
+    CVPixelBufferRetain(pixelBuffer);
+}
+
+DLABVideoBuffer::DLABVideoBuffer(void* bytes, size_t length)
+: pixelBuffer(NULL), bytes(bytes), length(length), refCount(1)
+{
+}
+
+DLABVideoBuffer::~DLABVideoBuffer()
+{
+    if (pixelBuffer) {
+        CVPixelBufferRelease(pixelBuffer);
+        pixelBuffer = NULL;
+    }
+    if (bytes) {
+        free(bytes);
+        bytes = NULL;
+    }
+}
+
+// IDeckLinkVideoBuffer
+
+HRESULT DLABVideoBuffer::GetBytes(void** buffer)
+{
+    if (!buffer) return E_INVALIDARG;
+    if (pixelBuffer) {
+        *buffer = CVPixelBufferGetBaseAddress(pixelBuffer);
+    } else {
+        *buffer = bytes;
+    }
+    return (*buffer != NULL) ? S_OK : E_FAIL;
+}
+
+HRESULT DLABVideoBuffer::StartAccess(BMDBufferAccessFlags flags)
+{
+    if (pixelBuffer) {
+        BOOL readOnly = ((flags & bmdBufferAccessWrite) == 0);
+        CVPixelBufferLockFlags lockFlags = (readOnly ? kCVPixelBufferLock_ReadOnly : 0);
+        CVReturn err = CVPixelBufferLockBaseAddress(pixelBuffer, lockFlags);
+        return (err == kCVReturnSuccess) ? S_OK : E_FAIL;
+    }
+    return S_OK;
+}
+
+HRESULT DLABVideoBuffer::EndAccess(BMDBufferAccessFlags flags)
+{
+    if (pixelBuffer) {
+        BOOL readOnly = ((flags & bmdBufferAccessWrite) == 0);
+        CVPixelBufferLockFlags lockFlags = (readOnly ? kCVPixelBufferLock_ReadOnly : 0);
+        CVReturn err = CVPixelBufferUnlockBaseAddress(pixelBuffer, lockFlags);
+        return (err == kCVReturnSuccess) ? S_OK : E_FAIL;
+    }
+    return S_OK;
+}
+
+// IDeckLinkMacVideoBuffer
+
+HRESULT DLABVideoBuffer::CreateCVPixelBufferRef(void** cvPixelBuffer)
+{
+    if (!cvPixelBuffer) return E_INVALIDARG;
+    *cvPixelBuffer = NULL;
+    if (!pixelBuffer) return E_FAIL; // fallback memory is not backed by CVPixelBuffer
+
+    *cvPixelBuffer = (void*)CVPixelBufferRetain(pixelBuffer); // caller owns one ref
+    return S_OK;
+}
+
+// IUnknown
+
+HRESULT DLABVideoBuffer::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+    if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBuffer *)this;
+        AddRef();
+        return S_OK;
+    }
+    if (memcmp(&iid, &IID_IDeckLinkVideoBuffer, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBuffer *)this;
+        AddRef();
+        return S_OK;
+    }
+    if (memcmp(&iid, &IID_IDeckLinkMacVideoBuffer, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkMacVideoBuffer *)this;
+        AddRef();
+        return S_OK;
+    }
+    return E_NOINTERFACE;
+}
+
+ULONG DLABVideoBuffer::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABVideoBuffer::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
+
+/* =================================================================================== */
+// MARK: - DLABExternalVideoBuffer
+/* =================================================================================== */
+
+DLABExternalVideoBuffer::DLABExternalVideoBuffer(const void* bytes, ReleaseCallback callback, void* context)
+: bytes(bytes), callback(callback), context(context), refCount(1)
+{
+}
+
+DLABExternalVideoBuffer::~DLABExternalVideoBuffer()
+{
+    if (callback) {
+        callback(context);
+        callback = NULL;
+    }
+}
+
+// IDeckLinkVideoBuffer
+
+HRESULT DLABExternalVideoBuffer::GetBytes(void** buffer)
+{
+    if (!buffer) return E_INVALIDARG;
+    *buffer = (void*)bytes;
+    return (*buffer != NULL) ? S_OK : E_FAIL;
+}
+
+HRESULT DLABExternalVideoBuffer::StartAccess(BMDBufferAccessFlags flags)
+{
+    // External memory is read-only
+    return (flags & bmdBufferAccessWrite) ? E_ACCESSDENIED : S_OK;
+}
+
+HRESULT DLABExternalVideoBuffer::EndAccess(BMDBufferAccessFlags flags)
+{
+    return S_OK;
+}
+
+// IUnknown
+
+HRESULT DLABExternalVideoBuffer::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+    if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBuffer *)this;
+        AddRef();
+        return S_OK;
+    }
+    if (memcmp(&iid, &IID_IDeckLinkVideoBuffer, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBuffer *)this;
+        AddRef();
+        return S_OK;
+    }
+    return E_NOINTERFACE;
+}
+
+ULONG DLABExternalVideoBuffer::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABExternalVideoBuffer::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
+
+/* =================================================================================== */
+// MARK: - DLABVideoBufferAllocator
+/* =================================================================================== */
+
+DLABVideoBufferAllocator::DLABVideoBufferAllocator(uint32_t bufferSize, uint32_t width, uint32_t height,
+                                                   uint32_t rowBytes, BMDPixelFormat pixelFormat,
+                                                   NSDictionary* pixelBufferAttributes)
+: _bufferSize(bufferSize), _width(width), _height(height), _rowBytes(rowBytes),
+_pixelFormat(pixelFormat), pool(NULL), refCount(1)
+{
+    // BMDPixelFormat for 2vuy/v210/BGRA shares same FourCC with CoreVideo
+    NSString* minimunCountKey = (__bridge NSString *)kCVPixelBufferPoolMinimumBufferCountKey;
+    NSDictionary *poolAttributes = @{minimunCountKey : @(4)};
+
+    NSString* pixelFormatKey = (__bridge NSString *)kCVPixelBufferPixelFormatTypeKey;
+    NSString* widthKey = (__bridge NSString *)kCVPixelBufferWidthKey;
+    NSString* heightKey = (__bridge NSString *)kCVPixelBufferHeightKey;
+    NSMutableDictionary* pbAttributes = [NSMutableDictionary dictionary];
+    pbAttributes[pixelFormatKey] = @(pixelFormat);
+    pbAttributes[widthKey] = @(width);
+    pbAttributes[heightKey] = @(height);
+    if (pixelBufferAttributes) {
+        [pbAttributes addEntriesFromDictionary:pixelBufferAttributes];
+    } else {
+        NSString* bytesPerRowAlignmentKey = (__bridge NSString *)kCVPixelBufferBytesPerRowAlignmentKey;
+        NSString* ioSurfacePropertiesKey = (__bridge NSString *)kCVPixelBufferIOSurfacePropertiesKey;
+        pbAttributes[bytesPerRowAlignmentKey] = @(16); // = 2^4 = 2 * sizeof(void*)
+        pbAttributes[ioSurfacePropertiesKey] = @{};
+    }
+
+    CVReturn err = CVPixelBufferPoolCreate(NULL, (__bridge CFDictionaryRef)poolAttributes,
+                                           (__bridge CFDictionaryRef)pbAttributes,
+                                           &pool);
+    if (err) {
+        pool = NULL;
+    }
+
+    // Verify if CVPixelBuffer layout is identical to what DeckLink expects
+    if (pool) {
+        CVPixelBufferRef pixelBuffer = NULL;
+        err = CVPixelBufferPoolCreatePixelBuffer(NULL, pool, &pixelBuffer);
+        if (!err && pixelBuffer) {
+            size_t pbRowBytes = CVPixelBufferGetBytesPerRow(pixelBuffer);
+            size_t pbDataSize = CVPixelBufferGetDataSize(pixelBuffer);
+            BOOL layoutOK = (pbRowBytes == rowBytes && pbDataSize >= bufferSize);
+            BOOL planarOK = (CVPixelBufferIsPlanar(pixelBuffer) == false);
+            CVPixelBufferRelease(pixelBuffer);
+            if (!(layoutOK && planarOK)) {
+                NSLog(@"NOTICE: CVPixelBuffer layout mismatch; zero-copy capture is disabled.");
+                CVPixelBufferPoolRelease(pool);
+                pool = NULL;
+            }
+        } else {
+            CVPixelBufferPoolRelease(pool);
+            pool = NULL;
+        }
+    }
+}
+
+DLABVideoBufferAllocator::~DLABVideoBufferAllocator()
+{
+    if (pool) {
+        CVPixelBufferPoolRelease(pool);
+        pool = NULL;
+    }
+}
+
+// Utility
+
+bool DLABVideoBufferAllocator::IsCompatible(uint32_t bufferSize, uint32_t width, uint32_t height,
+                                            uint32_t rowBytes, BMDPixelFormat pixelFormat)
+{
+    return (_bufferSize == bufferSize && _width == width && _height == height &&
+            _rowBytes == rowBytes && _pixelFormat == pixelFormat);
+}
+
+// IDeckLinkVideoBufferAllocator
+
+HRESULT DLABVideoBufferAllocator::AllocateVideoBuffer(IDeckLinkVideoBuffer** allocatedBuffer)
+{
+    if (!allocatedBuffer) return E_INVALIDARG;
+    *allocatedBuffer = NULL;
+
+    if (pool) {
+        CVPixelBufferRef pixelBuffer = NULL;
+        CVReturn err = CVPixelBufferPoolCreatePixelBuffer(NULL, pool, &pixelBuffer);
+        if (!err && pixelBuffer) {
+            *allocatedBuffer = new DLABVideoBuffer(pixelBuffer);
+            CVPixelBufferRelease(pixelBuffer);
+            return S_OK;
+        }
+    }
+
+    // Fallback: plain host memory (captured frame will be copied as usual)
+    void* ptr = NULL;
+    if (posix_memalign(&ptr, 16, (size_t)_bufferSize) == 0 && ptr != NULL) {
+        *allocatedBuffer = new DLABVideoBuffer(ptr, (size_t)_bufferSize);
+        return S_OK;
+    }
+    return E_OUTOFMEMORY;
+}
+
+// IUnknown
+
+HRESULT DLABVideoBufferAllocator::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+    if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0) {
+        *ppv = this;
+        AddRef();
+        return S_OK;
+    }
+    if (memcmp(&iid, &IID_IDeckLinkVideoBufferAllocator, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBufferAllocator *)this;
+        AddRef();
+        return S_OK;
+    }
+    return E_NOINTERFACE;
+}
+
+ULONG DLABVideoBufferAllocator::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABVideoBufferAllocator::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
+
+/* =================================================================================== */
+// MARK: - DLABVideoBufferAllocatorProvider
+/* =================================================================================== */
+
+DLABVideoBufferAllocatorProvider::DLABVideoBufferAllocatorProvider(NSDictionary* pixelBufferAttributes)
+: attributes([pixelBufferAttributes copy]), current(NULL), refCount(1)
+{
+}
+
+DLABVideoBufferAllocatorProvider::~DLABVideoBufferAllocatorProvider()
+{
+    if (current) {
+        current->Release();
+        current = NULL;
+    }
+    attributes = nil;
+}
+
+// IDeckLinkVideoBufferAllocatorProvider
+
+HRESULT DLABVideoBufferAllocatorProvider::GetVideoBufferAllocator(uint32_t bufferSize, uint32_t width, uint32_t height,
+                                                                  uint32_t rowBytes, BMDPixelFormat pixelFormat,
+                                                                  IDeckLinkVideoBufferAllocator** allocator)
+{
+    if (!allocator) return E_INVALIDARG;
+    *allocator = NULL;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Reuse current allocator if compatible; otherwise replace
+    if (!(current && current->IsCompatible(bufferSize, width, height, rowBytes, pixelFormat))) {
+        if (current) {
+            current->Release();
+            current = NULL;
+        }
+        current = new DLABVideoBufferAllocator(bufferSize, width, height,
+                                               rowBytes, pixelFormat, attributes);
+    }
+
+    current->AddRef();
+    *allocator = current; // caller owns one ref
+    return S_OK;
+}
+
+// IUnknown
+
+HRESULT DLABVideoBufferAllocatorProvider::QueryInterface(REFIID iid, LPVOID *ppv)
+{
+    *ppv = NULL;
+    CFUUIDBytes iunknown = CFUUIDGetUUIDBytes(IUnknownUUID);
+    if (memcmp(&iid, &iunknown, sizeof(REFIID)) == 0) {
+        *ppv = this;
+        AddRef();
+        return S_OK;
+    }
+    if (memcmp(&iid, &IID_IDeckLinkVideoBufferAllocatorProvider, sizeof(REFIID)) == 0) {
+        *ppv = (IDeckLinkVideoBufferAllocatorProvider *)this;
+        AddRef();
+        return S_OK;
+    }
+    return E_NOINTERFACE;
+}
+
+ULONG DLABVideoBufferAllocatorProvider::AddRef()
+{
+    ULONG newRefValue = ++refCount;
+    return newRefValue;
+}
+
+ULONG DLABVideoBufferAllocatorProvider::Release()
+{
+    ULONG newRefValue = --refCount;
+    if (newRefValue == 0) {
+        delete this;
+        return 0;
+    }
+    return newRefValue;
+}
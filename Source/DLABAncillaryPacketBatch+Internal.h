@@ -0,0 +1,36 @@
+//
+//  DLABAncillaryPacketBatch+Internal.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABAncillaryPacketBatch.h>
+#import <DLABAncillaryArena.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface DLABAncillaryPacketBatch ()
+{
+    DLABAncillaryArenaPool* _pool;
+    DLABAncillaryArena* _arena;
+}
+
+/**
+ Create batch which owns arena. Arena is recycled into pool on dealloc.
+ 
+ @param arena DLABAncillaryArena reserved from pool.
+ @param pool DLABAncillaryArenaPool which arena is reserved from.
+ @param timingInfo TimingInfo of Video Input Frame.
+ @return Instance of DLABAncillaryPacketBatch.
+ */
+- (instancetype) initWithArena:(DLABAncillaryArena*)arena
+                          pool:(DLABAncillaryArenaPool*)pool
+                    timingInfo:(CMSampleTimingInfo)timingInfo NS_DESIGNATED_INITIALIZER;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,90 @@
+//
+//  DLABAncillaryPacketBatch.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ DLABAncillaryPacketBatch is a read-only container of every VANC packet of one input video frame.
+ 
+ All packet payloads (bmdAncillaryPacketFormatUInt8) are stored back to back in one
+ contiguous buffer, and each packet is described by index entry of
+ (DID, SDID, lineNumber, dataStreamIndex, offset, length).
+ 
+ Storage is recycled when the batch is deallocated. Raw pointer from bytes property is
+ valid only while the batch is alive. NSData from dataAtIndex: retains the batch, so the
+ storage is recycled only after the batch and every such NSData are released.
+ */
+@interface DLABAncillaryPacketBatch : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+
+/* =================================================================================== */
+// MARK: Property
+/* =================================================================================== */
+
+/**
+ TimingInfo of Video Input Frame.
+ */
+@property (nonatomic, assign, readonly) CMSampleTimingInfo timingInfo;
+
+/**
+ Number of packets in batch.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ Contiguous payload buffer of all packets. NULL if no payload.
+ */
+@property (nonatomic, assign, readonly, nullable) const void* bytes NS_RETURNS_INNER_POINTER;
+
+/**
+ Total length in bytes of payload buffer.
+ */
+@property (nonatomic, assign, readonly) NSUInteger length;
+
+/* =================================================================================== */
+// MARK: Query
+/* =================================================================================== */
+
+/**
+ Query index entry of packet.
+ 
+ @param index packet index (0 ..< count).
+ @param did Data ID (DID) for ancillary packet.
+ @param sdid Secondary Data ID (SDID) for ancillary packet.
+ @param lineNumber lineNumber of VANC buffer.
+ @param dataStreamIndex the data stream index for ancillary packet.
+ @param offset payload offset in bytes buffer.
+ @param length payload length.
+ @return NO if index is out of range.
+ */
+- (BOOL) getPacketAtIndex:(NSUInteger)index
+                      did:(nullable uint8_t*)did
+                     sdid:(nullable uint8_t*)sdid
+               lineNumber:(nullable uint32_t*)lineNumber
+          dataStreamIndex:(nullable uint8_t*)dataStreamIndex
+                   offset:(nullable NSUInteger*)offset
+                   length:(nullable NSUInteger*)length;
+
+/**
+ Payload of packet without copy. Returned data refers storage of the batch,
+ and keeps the batch alive until the data is released.
+ 
+ @param index packet index (0 ..< count).
+ @return payload data, or nil if index is out of range.
+ */
+- (nullable NSData*) dataAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
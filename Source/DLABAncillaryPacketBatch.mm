@@ -0,0 +1,113 @@
+//
+//  DLABAncillaryPacketBatch.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABAncillaryPacketBatch+Internal.h>
+
+@implementation DLABAncillaryPacketBatch
+
+- (instancetype) init
+{
+    NSString *classString = NSStringFromClass([self class]);
+    [NSException raise:NSGenericException
+                format:@"Disabled. %@ is created by DLABDevice only.", classString];
+    return nil;
+}
+
+- (instancetype) initWithArena:(DLABAncillaryArena*)arena
+                          pool:(DLABAncillaryArenaPool*)pool
+                    timingInfo:(CMSampleTimingInfo)timingInfo
+{
+    NSParameterAssert(arena && pool);
+    
+    self = [super init];
+    if (self) {
+        // Take ownership of reserved arena
+        _arena = arena;
+        _pool = pool;
+        _timingInfo = timingInfo;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    if (_pool && _arena) {
+        _pool->Recycle(_arena);
+        //_arena = NULL;
+        //_pool = NULL;
+    }
+}
+
+/* =================================================================================== */
+// MARK: - accessors
+/* =================================================================================== */
+
+@synthesize timingInfo = _timingInfo;
+@dynamic count;
+@dynamic bytes;
+@dynamic length;
+
+- (NSUInteger) count
+{
+    return (NSUInteger)_arena->Count();
+}
+
+- (const void*) bytes
+{
+    return (_arena->Length() ? _arena->Bytes() : NULL);
+}
+
+- (NSUInteger) length
+{
+    return (NSUInteger)_arena->Length();
+}
+
+/* =================================================================================== */
+// MARK: - query
+/* =================================================================================== */
+
+- (BOOL) getPacketAtIndex:(NSUInteger)index
+                      did:(uint8_t*)did
+                     sdid:(uint8_t*)sdid
+               lineNumber:(uint32_t*)lineNumber
+          dataStreamIndex:(uint8_t*)dataStreamIndex
+                   offset:(NSUInteger*)offset
+                   length:(NSUInteger*)length
+{
+    if (index >= _arena->Count()) return NO;
+    
+    const DLABAncillaryArena::Entry& entry = _arena->Entries()[index];
+    if (did) *did = entry.did;
+    if (sdid) *sdid = entry.sdid;
+    if (lineNumber) *lineNumber = entry.lineNumber;
+    if (dataStreamIndex) *dataStreamIndex = entry.dataStreamIndex;
+    if (offset) *offset = (NSUInteger)entry.offset;
+    if (length) *length = (NSUInteger)entry.length;
+    return YES;
+}
+
+- (NSData*) dataAtIndex:(NSUInteger)index
+{
+    if (index >= _arena->Count()) return nil;
+    
+    const DLABAncillaryArena::Entry& entry = _arena->Entries()[index];
+    if (entry.length == 0) return [NSData data];
+    
+    // NSData retains self, so arena outlives the data
+    void* ptr = (void*)(_arena->Bytes() + entry.offset);
+    DLABAncillaryPacketBatch* owner = self;
+    return [[NSData alloc] initWithBytesNoCopy:ptr
+                                        length:(NSUInteger)entry.length
+                                   deallocator:^(void *bytes, NSUInteger length) {
+        (void)owner;
+    }];
+}
+
+@end
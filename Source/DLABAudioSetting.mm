@@ -211,7 +211,7 @@
         } else {
             if (channelCount != validChannelCount) {
                 NSLog(@"NOTICE: Unbalanced audio channel configuration detected. It requires ");
-                NSLog(@"        instant audio buffer reassembling (Inefficient operation).");
+                NSLog(@"        instant audio channel extraction per audio packet.");
             }
             
             // Prepare backing store
@@ -127,6 +127,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSString*) stringValueForAPIInformation:(DLABDeckLinkAPIInformation)informationID;
 
+/* =================================================================================== */
+// MARK: Public - Simulated device support (experimental)
+/* =================================================================================== */
+
+/**
+ Number of software simulated devices to detect instead of DeckLink hardware.
+ 
+ Default is 0 (use DeckLink driver). When set to 1 or more, browser enumerates
+ simulated devices only, which generate color bars, timecode, AFD and tone at
+ the rate of enabled display mode. Intended for hardware-free testing and
+ benchmarking. Change this only while browser is stopped.
+ */
+@property (nonatomic, assign) NSUInteger simulatedDeviceCount;
+
 /* =================================================================================== */
 // MARK: Public method
 /* =================================================================================== */
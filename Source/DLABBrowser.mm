@@ -41,6 +41,7 @@ const char* kBrowserQueue = "DLABDevice.browserQueue";
 /* =================================================================================== */
 
 @synthesize delegate = _delegate;
+@synthesize simulatedDeviceCount = _simulatedDeviceCount;
 @dynamic isRunning;
 @dynamic allDevices;
 
@@ -248,7 +249,11 @@ const char* kBrowserQueue = "DLABDevice.browserQueue";
     HRESULT result = E_FAIL;
     if (flag) {
         if (!self.isInstalled) {
-            discovery = CreateDeckLinkDiscoveryInstance();
+            if (self.simulatedDeviceCount > 0) {
+                discovery = DLABSimulatorCreateDiscoveryInstance((uint32_t)self.simulatedDeviceCount);
+            } else {
+                discovery = CreateDeckLinkDiscoveryInstance();
+            }
             callback = new DLABDeviceNotificationCallback(self);
             if (discovery && callback) {
                 result = discovery->InstallDeviceNotifications(callback);
@@ -325,7 +330,12 @@ const char* kBrowserQueue = "DLABDevice.browserQueue";
     NSMutableArray* newDevices = [NSMutableArray array];
     
     // Iterate every DeckLinkDevice and register as initial state
-    IDeckLinkIterator* iterator = CreateDeckLinkIteratorInstance();
+    IDeckLinkIterator* iterator = NULL;
+    if (self.simulatedDeviceCount > 0) {
+        iterator = DLABSimulatorCreateIteratorInstance((uint32_t)self.simulatedDeviceCount);
+    } else {
+        iterator = CreateDeckLinkIteratorInstance();
+    }
     if (iterator) {
         IDeckLink* newDeckLink = NULL;
         while (iterator->Next(&newDeckLink) == S_OK) {
@@ -0,0 +1,84 @@
+//
+//  DLABCaptureGroup+Internal.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABCaptureGroup.h>
+#import <DLABCaptureAligner.h>
+
+/* =================================================================================== */
+
+/*
+ * Internal use only
+ * Aligner item of one captured frame; owned by aligner until delivered or dropped.
+ */
+typedef struct {
+    CMSampleBufferRef sampleBuffer;     // retained
+    CFTypeRef timecodeSetting;          // retained DLABTimecodeSetting, or NULL
+} DLABCaptureGroupItem;
+
+/* =================================================================================== */
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface DLABCaptureBundle ()
+{
+    CMSampleBufferRef _samples[DLABCaptureAligner::kMaxMemberCount];
+    int64_t _times[DLABCaptureAligner::kMaxMemberCount];
+    DLABTimecodeSetting* _timecodeSettings[DLABCaptureAligner::kMaxMemberCount];
+}
+
+/**
+ Create bundle which owns every sample of aligned bundle.
+
+ @param bundle DLABCaptureAligner::Bundle. items are DLABCaptureGroupItem.
+ @param count Number of devices in group.
+ @return Instance of DLABCaptureBundle.
+ */
+- (instancetype) initWithAlignedBundle:(const DLABCaptureAligner::Bundle&)bundle
+                                 count:(NSUInteger)count NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/* =================================================================================== */
+
+@interface DLABCaptureGroup ()
+{
+    DLABCaptureAligner* _aligner;
+    int64_t _clockOffsets[DLABCaptureAligner::kMaxMemberCount];
+    int64_t _scheduledDeadline;
+}
+
+/**
+ Serial queue to align samples. Aligner is accessed only on this queue.
+ */
+@property (nonatomic, strong) dispatch_queue_t groupQueue;
+
+/**
+ Serial queue to call DLABCaptureGroupDelegate.
+ */
+@property (nonatomic, strong) dispatch_queue_t delegateQueue;
+
+/**
+ Called by member DLABDevice on capture thread for each captured video sample.
+
+ @param device Member DLABDevice.
+ @param sampleBuffer Video sample. Retained by group if needed.
+ @param setting Timecode of the sample, if any.
+ @param hardwareTime Hardware reference timestamp of the frame in nanoseconds.
+ @param frameDuration Frame duration in nanoseconds.
+ */
+- (void) device:(DLABDevice*)device
+didCaptureVideoSample:(CMSampleBufferRef)sampleBuffer
+timecodeSetting:(nullable DLABTimecodeSetting*)setting
+   hardwareTime:(int64_t)hardwareTime
+  frameDuration:(int64_t)frameDuration;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,231 @@
+//
+//  DLABCaptureGroup.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <CoreMedia/CoreMedia.h>
+#import <DLABridging/DLABDevice.h>
+
+@class DLABCaptureGroup;
+@class DLABCaptureBundle;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Policy of DLABCaptureGroup when a frame arrives after its instant is delivered.
+ */
+typedef NS_ENUM(NSUInteger, DLABCaptureGroupLatePolicy) {
+    DLABCaptureGroupLatePolicyDrop = 0,             // Discard late frame (default)
+    DLABCaptureGroupLatePolicyDeliver = 1,          // Deliver late frame alone, as late bundle
+};
+
+/**
+ Statistics of DLABCaptureGroup measured per delivered bundle.
+ */
+typedef NS_ENUM(NSUInteger, DLABCaptureGroupStatistics) {
+    DLABCaptureGroupStatisticsSkew = 0,             // Max - min of aligned frame times in bundle
+    DLABCaptureGroupStatisticsWait = 1,             // First frame arrival => Bundle delivery
+};
+
+@protocol DLABCaptureGroupDelegate <NSObject>
+@required
+- (void) processCaptureBundle:(DLABCaptureBundle*)bundle ofGroup:(DLABCaptureGroup*)group;
+@optional
+@end
+
+NS_ASSUME_NONNULL_END
+
+/* =================================================================================== */
+// MARK: -
+/* =================================================================================== */
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ DLABCaptureBundle is a set of video samples captured at one instant by devices of DLABCaptureGroup.
+ */
+@interface DLABCaptureBundle : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+
+/**
+ Frame index on shared timeline; aligned time divided by frame duration.
+ */
+@property (nonatomic, assign, readonly) int64_t instant;
+
+/**
+ Number of devices in group. Same as devices.count of DLABCaptureGroup.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ Number of devices which have sample in this bundle.
+ */
+@property (nonatomic, assign, readonly) NSUInteger presentCount;
+
+/**
+ YES if every device has sample in this bundle.
+ */
+@property (nonatomic, assign, readonly, getter=isComplete) BOOL complete;
+
+/**
+ YES if this bundle is delivered after its instant (DLABCaptureGroupLatePolicyDeliver).
+ */
+@property (nonatomic, assign, readonly, getter=isLate) BOOL late;
+
+/**
+ Video sample of device at index. Valid while the bundle is alive.
+
+ @param index device index in devices of DLABCaptureGroup.
+ @return CMSampleBufferRef, or NULL if the device has no sample in this bundle.
+ */
+- (nullable CMSampleBufferRef) sampleBufferAtIndex:(NSUInteger)index;
+
+/**
+ Aligned time of device sample at index in nanoseconds.
+
+ @param index device index in devices of DLABCaptureGroup.
+ @return aligned time, or 0 if the device has no sample in this bundle.
+ */
+- (int64_t) alignedTimeAtIndex:(NSUInteger)index;
+
+/**
+ Timecode of device sample at index.
+
+ @param index device index in devices of DLABCaptureGroup.
+ @return DLABTimecodeSetting, or nil if the device has no sample or no timecode in this bundle.
+ */
+- (nullable DLABTimecodeSetting*) timecodeSettingAtIndex:(NSUInteger)index;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+/* =================================================================================== */
+// MARK: -
+/* =================================================================================== */
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ DLABCaptureGroup aligns video frames of multiple input devices into one bundle per instant.
+
+ Hardware reference timestamp of each frame is converted onto shared host timeline,
+ using per-device offset of hardware reference clock measured by calibration.
+ Aligned time is quantized by frame duration. Bundle is delivered when every device
+ has delivered its frame, or when maxWaitInterval has elapsed since the first frame.
+
+ While the group is running, video samples of member devices are delivered to the
+ group instead of DLABInputCaptureDelegate. Audio samples are not affected.
+ */
+@interface DLABCaptureGroup : NSObject
+
+- (instancetype) init NS_UNAVAILABLE;
+
+/**
+ Create group of input devices.
+
+ @param devices Input devices (up to 16). Each device should have video input enabled before start.
+ @param error Error description if failed.
+ @return Instance of DLABCaptureGroup.
+ */
+- (nullable instancetype) initWithDevices:(NSArray<DLABDevice*>*)devices
+                                    error:(NSError * _Nullable * _Nullable)error NS_DESIGNATED_INITIALIZER;
+
+/* =================================================================================== */
+// MARK: Property
+/* =================================================================================== */
+
+/**
+ Member devices. Index is used in DLABCaptureBundle.
+ */
+@property (nonatomic, copy, readonly) NSArray<DLABDevice*>* devices;
+
+/**
+ Caller should populate to receive DLABCaptureGroupDelegate call.
+ */
+@property (nonatomic, weak, nullable) id<DLABCaptureGroupDelegate> delegate;
+
+/**
+ Maximum wait for missing devices since the first frame of the instant. Default is 0.020 sec.
+ */
+@property (nonatomic, assign) NSTimeInterval maxWaitInterval;
+
+/**
+ Policy for frame arriving after its instant is delivered. Default is DLABCaptureGroupLatePolicyDrop.
+ */
+@property (nonatomic, assign) DLABCaptureGroupLatePolicy latePolicy;
+
+/**
+ YES while the group is running.
+ */
+@property (nonatomic, assign, readonly, getter=isRunning) BOOL running;
+
+/* =================================================================================== */
+// MARK: Control
+/* =================================================================================== */
+
+/**
+ Calibrate clocks, and start receiving video samples of member devices.
+
+ @param error Error description if failed.
+ @return YES if no error, NO if failed.
+ */
+- (BOOL) startWithError:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Stop receiving video samples. Pending bundles are delivered as is.
+ Instant history is cleared, so the group can be started again.
+ */
+- (void) stop;
+
+/**
+ Measure offset of hardware reference clock of each device against host clock.
+ Called by startWithError:; call again to compensate clock drift between devices.
+
+ @param error Error description if failed.
+ @return YES if no error, NO if failed.
+ */
+- (BOOL) calibrateClocksWithError:(NSError * _Nullable * _Nullable)error;
+
+/* =================================================================================== */
+// MARK: Statistics
+/* =================================================================================== */
+
+/**
+ Number of bundles delivered with every device.
+ */
+@property (nonatomic, assign, readonly) NSUInteger completeBundleCount;
+
+/**
+ Number of bundles delivered with missing devices.
+ */
+@property (nonatomic, assign, readonly) NSUInteger partialBundleCount;
+
+/**
+ Number of frames which arrived after its instant is delivered.
+ */
+@property (nonatomic, assign, readonly) NSUInteger lateFrameCount;
+
+/**
+ Query snapshot of statistics histogram.
+
+ @param statistics DLABCaptureGroupStatistics
+ @return DLABLatencySnapshot in nanoseconds. count is 0 if no sample is recorded.
+ */
+- (DLABLatencySnapshot) snapshotForStatistics:(DLABCaptureGroupStatistics)statistics;
+
+/**
+ Clear all counters and histograms.
+ */
+- (void) resetStatistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
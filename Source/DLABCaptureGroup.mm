@@ -0,0 +1,374 @@
+//
+//  DLABCaptureGroup.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABCaptureGroup+Internal.h>
+#import <DLABDevice+Internal.h>
+
+const char* kGroupQueue = "DLABCaptureGroup.groupQueue";
+const char* kGroupDelegateQueue = "DLABCaptureGroup.delegateQueue";
+
+static const int64_t kNanoSecondTimeScale = 1000000000;
+
+/* =================================================================================== */
+// MARK: - DLABCaptureBundle
+/* =================================================================================== */
+
+@implementation DLABCaptureBundle
+
+- (instancetype) init
+{
+    NSString *classString = NSStringFromClass([self class]);
+    [NSException raise:NSGenericException
+                format:@"Disabled. %@ is created by DLABCaptureGroup only.", classString];
+    return nil;
+}
+
+- (instancetype) initWithAlignedBundle:(const DLABCaptureAligner::Bundle&)bundle
+                                 count:(NSUInteger)count
+{
+    self = [super init];
+    if (self) {
+        // Take ownership of retained samples and timecodes
+        _count = MIN(count, (NSUInteger)DLABCaptureAligner::kMaxMemberCount);
+        for (NSUInteger i = 0; i < _count; i++) {
+            DLABCaptureGroupItem* item = (DLABCaptureGroupItem*)bundle.items[i];
+            if (item) {
+                _samples[i] = item->sampleBuffer;
+                _timecodeSettings[i] = (item->timecodeSetting ? CFBridgingRelease(item->timecodeSetting) : nil);
+                delete item;
+            }
+            _times[i] = (_samples[i] ? bundle.times[i] : 0);
+        }
+        _instant = bundle.instant;
+        _presentCount = bundle.presentCount;
+        _late = bundle.late;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    for (NSUInteger i = 0; i < _count; i++) {
+        if (_samples[i]) CFRelease(_samples[i]);
+    }
+}
+
+/* =================================================================================== */
+// MARK: - accessors
+/* =================================================================================== */
+
+@synthesize instant = _instant;
+@synthesize count = _count;
+@synthesize presentCount = _presentCount;
+@synthesize late = _late;
+@dynamic complete;
+
+- (BOOL) isComplete
+{
+    return (_presentCount == _count);
+}
+
+- (CMSampleBufferRef) sampleBufferAtIndex:(NSUInteger)index
+{
+    return (index < _count ? _samples[index] : NULL);
+}
+
+- (int64_t) alignedTimeAtIndex:(NSUInteger)index
+{
+    return (index < _count ? _times[index] : 0);
+}
+
+- (DLABTimecodeSetting*) timecodeSettingAtIndex:(NSUInteger)index
+{
+    return (index < _count ? _timecodeSettings[index] : nil);
+}
+
+@end
+
+/* =================================================================================== */
+// MARK: - DLABCaptureAligner callbacks
+/* =================================================================================== */
+
+static void deliverAlignedBundle(const DLABCaptureAligner::Bundle& bundle, void* context)
+{
+    // Called on groupQueue
+    DLABCaptureGroup* group = (__bridge DLABCaptureGroup*)context;
+    NSUInteger count = group.devices.count;
+    DLABCaptureBundle* captureBundle = [[DLABCaptureBundle alloc] initWithAlignedBundle:bundle
+                                                                                  count:count];
+
+    id<DLABCaptureGroupDelegate> delegate = group.delegate;
+    if (delegate) {
+        __weak typeof(group) wgroup = group;
+        dispatch_async(group.delegateQueue, ^{
+            [delegate processCaptureBundle:captureBundle ofGroup:wgroup]; // async
+        });
+    }
+}
+
+static void dropAlignedItem(void* item, void* /*context*/)
+{
+    DLABCaptureGroupItem* groupItem = (DLABCaptureGroupItem*)item;
+    CFRelease(groupItem->sampleBuffer);
+    if (groupItem->timecodeSetting) CFRelease(groupItem->timecodeSetting);
+    delete groupItem;
+}
+
+/* =================================================================================== */
+// MARK: - DLABCaptureGroup
+/* =================================================================================== */
+
+@implementation DLABCaptureGroup
+
+- (instancetype) init
+{
+    NSString *classString = NSStringFromClass([self class]);
+    NSString *selectorString = NSStringFromSelector(@selector(initWithDevices:error:));
+    [NSException raise:NSGenericException
+                format:@"Disabled. Use +[[%@ alloc] %@] instead", classString, selectorString];
+    return nil;
+}
+
+- (instancetype) initWithDevices:(NSArray<DLABDevice*>*)devices error:(NSError**)error
+{
+    NSParameterAssert(devices);
+
+    if (devices.count == 0 || devices.count > DLABCaptureAligner::kMaxMemberCount) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Number of devices is out of range (1-16)."
+              code:E_INVALIDARG
+                to:error];
+        return nil;
+    }
+    for (DLABDevice* device in devices) {
+        if (device.captureGroup || [devices indexOfObjectIdenticalTo:device] != [devices indexOfObject:device]) {
+            [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+                reason:@"Device is already in use by another group."
+                  code:E_INVALIDARG
+                    to:error];
+            return nil;
+        }
+    }
+
+    self = [super init];
+    if (self) {
+        _devices = [devices copy];
+        _maxWaitInterval = 0.020;
+        _latePolicy = DLABCaptureGroupLatePolicyDrop;
+        _aligner = new DLABCaptureAligner((uint32_t)devices.count,
+                                          deliverAlignedBundle, dropAlignedItem,
+                                          (__bridge void*)self);
+
+        _groupQueue = dispatch_queue_create(kGroupQueue, DISPATCH_QUEUE_SERIAL);
+        _delegateQueue = dispatch_queue_create(kGroupDelegateQueue, DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    // captureGroup of member device is weak; no need to clear here
+    if (_aligner) {
+        delete _aligner; // pending samples are released
+        //_aligner = NULL;
+    }
+}
+
+/* =================================================================================== */
+// MARK: - (Public/Private) - property accessors
+/* =================================================================================== */
+
+@synthesize devices = _devices;
+@synthesize delegate = _delegate;
+@synthesize maxWaitInterval = _maxWaitInterval;
+@synthesize latePolicy = _latePolicy;
+@synthesize running = _running;
+@synthesize groupQueue = _groupQueue;
+@synthesize delegateQueue = _delegateQueue;
+@dynamic completeBundleCount;
+@dynamic partialBundleCount;
+@dynamic lateFrameCount;
+
+- (NSUInteger) completeBundleCount
+{
+    return (NSUInteger)_aligner->CompleteCount();
+}
+
+- (NSUInteger) partialBundleCount
+{
+    return (NSUInteger)_aligner->PartialCount();
+}
+
+- (NSUInteger) lateFrameCount
+{
+    return (NSUInteger)_aligner->LateCount();
+}
+
+/* =================================================================================== */
+// MARK: - (Private) - error helper
+/* =================================================================================== */
+
+- (BOOL) post:(NSString*)description
+       reason:(NSString*)failureReason
+         code:(NSInteger)result
+           to:(NSError**)error;
+{
+    if (error) {
+        if (!description) description = @"unknown description";
+        if (!failureReason) failureReason = @"unknown failureReason";
+
+        NSString *domain = @"com.MyCometG3.DLABridging.ErrorDomain";
+        NSInteger code = (NSInteger)result;
+        NSDictionary *userInfo = @{NSLocalizedDescriptionKey : description,
+                                   NSLocalizedFailureReasonErrorKey : failureReason,};
+        *error = [NSError errorWithDomain:domain code:code userInfo:userInfo];
+        return YES;
+    }
+    return NO;
+}
+
+/* =================================================================================== */
+// MARK: - Control
+/* =================================================================================== */
+
+- (BOOL) startWithError:(NSError**)error
+{
+    if (self.running) return YES;
+
+    if (![self calibrateClocksWithError:error]) {
+        return NO;
+    }
+
+    // Member devices deliver video samples to group from now
+    for (DLABDevice* device in _devices) {
+        device.captureGroup = self;
+    }
+    _running = YES;
+    return YES;
+}
+
+- (void) stop
+{
+    if (!self.running) return;
+
+    for (DLABDevice* device in _devices) {
+        if (device.captureGroup == self) device.captureGroup = nil;
+    }
+    _running = NO;
+
+    // Deliver pending bundles, then forget delivered instants for next start
+    DLABCaptureAligner* aligner = _aligner;
+    dispatch_sync(_groupQueue, ^{
+        aligner->Flush((int64_t)DLABLatencyStats::Now());
+        aligner->Reset();
+    });
+}
+
+- (BOOL) calibrateClocksWithError:(NSError**)error
+{
+    // Offset from hardware reference clock of each device to host clock
+    __block int64_t offsets[DLABCaptureAligner::kMaxMemberCount] = {0};
+    NSUInteger count = _devices.count;
+    for (NSUInteger i = 0; i < count; i++) {
+        DLABDevice* device = _devices[i];
+        NSInteger hardwareTime = 0;
+        NSInteger timeInFrame = 0;
+        NSInteger ticksPerFrame = 0;
+        int64_t hostTime0 = (int64_t)DLABLatencyStats::Now();
+        BOOL result = [device getInputHardwareReferenceClockInTimeScale:kNanoSecondTimeScale
+                                                           hardwareTime:&hardwareTime
+                                                            timeInFrame:&timeInFrame
+                                                          ticksPerFrame:&ticksPerFrame
+                                                                  error:error];
+        int64_t hostTime1 = (int64_t)DLABLatencyStats::Now();
+        if (!result) return NO;
+
+        offsets[i] = (hostTime0 + (hostTime1 - hostTime0) / 2) - (int64_t)hardwareTime;
+    }
+
+    int64_t* clockOffsets = _clockOffsets;
+    dispatch_sync(_groupQueue, ^{
+        memcpy(clockOffsets, offsets, sizeof(int64_t) * count);
+    });
+    return YES;
+}
+
+/* =================================================================================== */
+// MARK: - Statistics
+/* =================================================================================== */
+
+- (DLABLatencySnapshot) snapshotForStatistics:(DLABCaptureGroupStatistics)statistics
+{
+    DLABLatencySnapshot result = {0};
+    DLABCaptureAligner::StatsStage stage = (statistics == DLABCaptureGroupStatisticsSkew
+                                            ? DLABCaptureAligner::StatsStageSkew
+                                            : DLABCaptureAligner::StatsStageWait);
+    DLABLatencyStats::Snapshot snapshot = _aligner->GetSnapshot(stage);
+    result.count = snapshot.count;
+    result.p50 = snapshot.p50;
+    result.p99 = snapshot.p99;
+    result.max = snapshot.max;
+    result.mean = snapshot.mean;
+    return result;
+}
+
+- (void) resetStatistics
+{
+    _aligner->ResetStatistics();
+}
+
+/* =================================================================================== */
+// MARK: - (Private) - sample delivery from DLABDevice
+/* =================================================================================== */
+
+- (void) device:(DLABDevice*)device
+didCaptureVideoSample:(CMSampleBufferRef)sampleBuffer
+timecodeSetting:(DLABTimecodeSetting*)setting
+   hardwareTime:(int64_t)hardwareTime
+  frameDuration:(int64_t)frameDuration
+{
+    NSParameterAssert(device && sampleBuffer);
+
+    NSUInteger index = [_devices indexOfObjectIdenticalTo:device];
+    if (index == NSNotFound) return;
+
+    // aligner owns item until delivered or dropped
+    DLABCaptureGroupItem* item = new DLABCaptureGroupItem;
+    item->sampleBuffer = (CMSampleBufferRef)CFRetain(sampleBuffer);
+    item->timecodeSetting = (setting ? CFBridgingRetain(setting) : NULL);
+    dispatch_async(_groupQueue, ^{
+        DLABCaptureAligner* aligner = self->_aligner;
+        aligner->SetMaxWait((int64_t)(self.maxWaitInterval * kNanoSecondTimeScale));
+        aligner->SetLatePolicy((DLABCaptureAligner::LatePolicy)self.latePolicy);
+
+        int64_t alignedTime = hardwareTime + self->_clockOffsets[index];
+        int64_t now = (int64_t)DLABLatencyStats::Now();
+        aligner->Submit((uint32_t)index, alignedTime, frameDuration, (void*)item, now);
+
+        [self scheduleDeadline:aligner->Poll(now) now:now];
+    });
+}
+
+// Called on groupQueue
+- (void) scheduleDeadline:(int64_t)deadline now:(int64_t)now
+{
+    if (!deadline) return;
+    if (_scheduledDeadline && _scheduledDeadline <= deadline) return; // earlier poll is pending
+
+    _scheduledDeadline = deadline;
+    dispatch_time_t when = dispatch_time(DISPATCH_TIME_NOW, (deadline > now ? deadline - now : 0));
+    dispatch_after(when, _groupQueue, ^{
+        self->_scheduledDeadline = 0;
+        int64_t now = (int64_t)DLABLatencyStats::Now();
+        [self scheduleDeadline:self->_aligner->Poll(now) now:now];
+    });
+}
+
+@end
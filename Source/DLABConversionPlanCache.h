@@ -0,0 +1,136 @@
+//
+//  DLABConversionPlanCache.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <Foundation/Foundation.h>
+#import <CoreVideo/CoreVideo.h>
+#import <Accelerate/Accelerate.h>
+#import <DeckLinkAPI.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ Internal use only
+
+ Identity of prepared conversion plan of DLABVideoConverter.
+
+ @discussion
+ Colorspaces and CVPixelBuffer attachments are compared by CFEqual().
+ Hash is computed from numeric fields only.
+ */
+@interface DLABConversionPlanKey : NSObject <NSCopying>
+
+- (instancetype) init NS_UNAVAILABLE;
+
+/// Create key for conversion plan
+/// @param toCV TRUE for capture (DL => CV), FALSE for playback (CV => DL)
+/// @param dlFormat BMDPixelFormat of IDeckLinkVideoFrame
+/// @param cvFormat OSType of CVPixelBuffer
+/// @param width width of both image
+/// @param height height of both image
+/// @param dlColorSpace CGColorSpace for IDeckLinkVideoFrame
+/// @param cvColorSpace CGColorSpace for CVPixelBuffer
+/// @param ycbcrMatrix kCVImageBufferYCbCrMatrixKey attachment of CVPixelBuffer
+/// @param chromaLocation kCVImageBufferChromaLocationTopFieldKey attachment of CVPixelBuffer
+/// @param flags Conversion flags. See DLABVideoConverter.
+- (instancetype) initToCV:(BOOL)toCV
+                 dlFormat:(BMDPixelFormat)dlFormat
+                 cvFormat:(OSType)cvFormat
+                    width:(vImagePixelCount)width
+                   height:(vImagePixelCount)height
+             dlColorSpace:(CGColorSpaceRef)dlColorSpace
+             cvColorSpace:(CGColorSpaceRef)cvColorSpace
+              ycbcrMatrix:(nullable CFTypeRef)ycbcrMatrix
+           chromaLocation:(nullable CFTypeRef)chromaLocation
+                    flags:(uint32_t)flags NS_DESIGNATED_INITIALIZER;
+
+@end
+
+/**
+ Internal use only
+
+ Prepared conversion plan of DLABVideoConverter.
+
+ @discussion
+ YpCbCr conversion info and vImageConverter objects are immutable once prepared,
+ and shared by every DLABVideoConverter of same configuration.
+ Scratch buffers (interimBuffer/argb8888Buffer) are mutable, so they are lent to
+ one DLABVideoConverter at a time; Returned buffers are parked in the plan and
+ reused by next DLABVideoConverter.
+ */
+@interface DLABConversionPlan : NSObject
+
+@property (nonatomic, assign) vImage_YpCbCrToARGB infoToARGB;
+@property (nonatomic, assign) vImage_ARGBToYpCbCr infoToYpCbCr;
+
+/// Bits per pixel of interimBuffer
+@property (nonatomic, assign) uint32_t interimBitsPerPixel;
+/// TRUE if argb8888Buffer is required (YUV8 with useXRGB16U)
+@property (nonatomic, assign) BOOL useARGB8888Buffer;
+
+/// vImageConverter between CVPixelBuffer and interimBuffer (retained)
+@property (nonatomic, assign, nullable) vImageConverterRef mainConverter;
+/// vImageConverter between interimBuffer and RGB12U (retained)
+@property (nonatomic, assign, nullable) vImageConverterRef rgb12UConverter;
+
+/// Take scratch buffers of width x height. Parked buffers are reused if available.
+/// @param interimBuffer interimBuffer to fill
+/// @param argb8888Buffer argb8888Buffer to fill (only if useARGB8888Buffer)
+/// @param width width of image
+/// @param height height of image
+- (BOOL) checkoutInterimBuffer:(vImage_Buffer*)interimBuffer
+                argb8888Buffer:(vImage_Buffer*)argb8888Buffer
+                         width:(vImagePixelCount)width
+                        height:(vImagePixelCount)height;
+
+/// Return scratch buffers. Buffers are parked, or freed if plan already has parked ones.
+/// @param interimBuffer interimBuffer to return (cleared on return)
+/// @param argb8888Buffer argb8888Buffer to return (cleared on return)
+- (void) checkinInterimBuffer:(vImage_Buffer*)interimBuffer
+               argb8888Buffer:(vImage_Buffer*)argb8888Buffer;
+
+@end
+
+/**
+ Internal use only
+
+ Process-wide LRU cache of DLABConversionPlan.
+
+ @discussion
+ Thread safe. Least recently used plan is evicted when capacity is exceeded.
+ Evicted plan is released when the last DLABVideoConverter using it is released.
+ */
+@interface DLABConversionPlanCache : NSObject
+
+/// Shared instance
+@property (class, nonatomic, readonly) DLABConversionPlanCache* sharedCache;
+
+/// Maximum number of plans. Default is 4. Set 0 to disable cache.
+@property (atomic, assign) NSUInteger capacity;
+
+/// Number of cached plans
+@property (atomic, assign, readonly) NSUInteger count;
+
+/// Statistics
+@property (atomic, assign, readonly) NSUInteger hitCount;
+@property (atomic, assign, readonly) NSUInteger missCount;
+@property (atomic, assign, readonly) NSUInteger evictionCount;
+
+/// Lookup plan. Found plan becomes most recently used one.
+- (nullable DLABConversionPlan*) planForKey:(DLABConversionPlanKey*)key;
+
+/// Register plan as most recently used one. Evict least recently used one if required.
+- (void) setPlan:(DLABConversionPlan*)plan forKey:(DLABConversionPlanKey*)key;
+
+/// Remove every plan, and reset statistics
+- (void) removeAllPlans;
+
+@end
+
+NS_ASSUME_NONNULL_END
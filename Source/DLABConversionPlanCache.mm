@@ -0,0 +1,370 @@
+//
+//  DLABConversionPlanCache.mm
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#import <DLABConversionPlanCache.h>
+
+static const NSUInteger kDefaultCapacity = 4;
+
+NS_INLINE BOOL sameCFType(CFTypeRef a, CFTypeRef b)
+{
+    if (a == b) return TRUE;
+    if (a == NULL || b == NULL) return FALSE;
+    return CFEqual(a, b);
+}
+
+/* =================================================================================== */
+// MARK: - DLABConversionPlanKey
+/* =================================================================================== */
+
+@implementation DLABConversionPlanKey
+{
+    BOOL _toCV;
+    BMDPixelFormat _dlFormat;
+    OSType _cvFormat;
+    vImagePixelCount _width;
+    vImagePixelCount _height;
+    CGColorSpaceRef _dlColorSpace;
+    CGColorSpaceRef _cvColorSpace;
+    CFTypeRef _ycbcrMatrix;
+    CFTypeRef _chromaLocation;
+    uint32_t _flags;
+}
+
+- (instancetype) initToCV:(BOOL)toCV
+                 dlFormat:(BMDPixelFormat)dlFormat
+                 cvFormat:(OSType)cvFormat
+                    width:(vImagePixelCount)width
+                   height:(vImagePixelCount)height
+             dlColorSpace:(CGColorSpaceRef)dlColorSpace
+             cvColorSpace:(CGColorSpaceRef)cvColorSpace
+              ycbcrMatrix:(CFTypeRef)ycbcrMatrix
+           chromaLocation:(CFTypeRef)chromaLocation
+                    flags:(uint32_t)flags
+{
+    self = [super init];
+    if (self) {
+        _toCV = toCV;
+        _dlFormat = dlFormat;
+        _cvFormat = cvFormat;
+        _width = width;
+        _height = height;
+        _dlColorSpace = CGColorSpaceRetain(dlColorSpace);
+        _cvColorSpace = CGColorSpaceRetain(cvColorSpace);
+        _ycbcrMatrix = (ycbcrMatrix ? CFRetain(ycbcrMatrix) : NULL);
+        _chromaLocation = (chromaLocation ? CFRetain(chromaLocation) : NULL);
+        _flags = flags;
+    }
+    return self;
+}
+
+- (void) dealloc
+{
+    CGColorSpaceRelease(_dlColorSpace);
+    CGColorSpaceRelease(_cvColorSpace);
+    if (_ycbcrMatrix) CFRelease(_ycbcrMatrix);
+    if (_chromaLocation) CFRelease(_chromaLocation);
+}
+
+- (id) copyWithZone:(NSZone *)zone
+{
+    return self; // immutable
+}
+
+- (NSUInteger) hash
+{
+    NSUInteger value = (NSUInteger)_dlFormat;
+    value = value * 31 + (NSUInteger)_cvFormat;
+    value = value * 31 + (NSUInteger)_width;
+    value = value * 31 + (NSUInteger)_height;
+    value = value * 31 + (NSUInteger)_flags;
+    value = value * 31 + (NSUInteger)_toCV;
+    return value;
+}
+
+- (BOOL) isEqual:(id)object
+{
+    if (self == object) return TRUE;
+    if (![object isKindOfClass:[DLABConversionPlanKey class]]) return FALSE;
+
+    DLABConversionPlanKey* other = (DLABConversionPlanKey*)object;
+    return (_toCV == other->_toCV &&
+            _dlFormat == other->_dlFormat &&
+            _cvFormat == other->_cvFormat &&
+            _width == other->_width &&
+            _height == other->_height &&
+            _flags == other->_flags &&
+            sameCFType(_dlColorSpace, other->_dlColorSpace) &&
+            sameCFType(_cvColorSpace, other->_cvColorSpace) &&
+            sameCFType(_ycbcrMatrix, other->_ycbcrMatrix) &&
+            sameCFType(_chromaLocation, other->_chromaLocation));
+}
+
+@end
+
+/* =================================================================================== */
+// MARK: - DLABConversionPlan
+/* =================================================================================== */
+
+@implementation DLABConversionPlan
+{
+    vImage_Buffer _parkedInterim;
+    vImage_Buffer _parkedARGB8888;
+}
+
+@synthesize infoToARGB = _infoToARGB;
+@synthesize infoToYpCbCr = _infoToYpCbCr;
+@synthesize interimBitsPerPixel = _interimBitsPerPixel;
+@synthesize useARGB8888Buffer = _useARGB8888Buffer;
+@synthesize mainConverter = _mainConverter;
+@synthesize rgb12UConverter = _rgb12UConverter;
+
+- (void) dealloc
+{
+    vImageConverter_Release(_mainConverter);
+    vImageConverter_Release(_rgb12UConverter);
+    free(_parkedInterim.data);
+    free(_parkedARGB8888.data);
+}
+
+- (void) setMainConverter:(vImageConverterRef)newConverter
+{
+    if (_mainConverter != newConverter) {
+        vImageConverter_Release(_mainConverter);
+        if (newConverter) vImageConverter_Retain(newConverter);
+        _mainConverter = newConverter;
+    }
+}
+
+- (void) setRgb12UConverter:(vImageConverterRef)newConverter
+{
+    if (_rgb12UConverter != newConverter) {
+        vImageConverter_Release(_rgb12UConverter);
+        if (newConverter) vImageConverter_Retain(newConverter);
+        _rgb12UConverter = newConverter;
+    }
+}
+
+- (BOOL) checkoutInterimBuffer:(vImage_Buffer*)interimBuffer
+                argb8888Buffer:(vImage_Buffer*)argb8888Buffer
+                         width:(vImagePixelCount)width
+                        height:(vImagePixelCount)height
+{
+    NSParameterAssert(interimBuffer != NULL && argb8888Buffer != NULL);
+
+    vImage_Buffer interim = {0};
+    vImage_Buffer argb8888 = {0};
+    @synchronized (self) {
+        // Take parked buffers if they fit
+        if (_parkedInterim.data && _parkedInterim.width == width && _parkedInterim.height == height) {
+            interim = _parkedInterim;
+            _parkedInterim = {0};
+        }
+        if (_parkedARGB8888.data && _parkedARGB8888.width == width && _parkedARGB8888.height == height) {
+            argb8888 = _parkedARGB8888;
+            _parkedARGB8888 = {0};
+        }
+    }
+
+    BOOL ready = TRUE;
+    if (!interim.data) {
+        vImage_Error err = vImageBuffer_Init(&interim, height, width,
+                                             _interimBitsPerPixel, kvImageNoFlags);
+        if (err != kvImageNoError) {
+            interim = {0};
+            ready = FALSE;
+        }
+    }
+    if (_useARGB8888Buffer && !argb8888.data) {
+        size_t rowBytes = (width * 4);
+        void* ptr = NULL;
+        size_t bufferSize = (rowBytes * height);
+        if (posix_memalign(&ptr, 16, bufferSize) == 0 && ptr != NULL) {
+            argb8888.data = ptr;
+            argb8888.width = width;
+            argb8888.height = height;
+            argb8888.rowBytes = rowBytes;
+        } else {
+            ready = FALSE;
+        }
+    }
+    if (!_useARGB8888Buffer && argb8888.data) {
+        free(argb8888.data); argb8888 = {0};
+    }
+
+    if (!ready) {
+        free(interim.data); interim = {0};
+        free(argb8888.data); argb8888 = {0};
+    }
+    *interimBuffer = interim;
+    *argb8888Buffer = argb8888;
+    return ready;
+}
+
+- (void) checkinInterimBuffer:(vImage_Buffer*)interimBuffer
+               argb8888Buffer:(vImage_Buffer*)argb8888Buffer
+{
+    NSParameterAssert(interimBuffer != NULL && argb8888Buffer != NULL);
+
+    @synchronized (self) {
+        if (interimBuffer->data && !_parkedInterim.data) {
+            _parkedInterim = *interimBuffer;
+            *interimBuffer = {0};
+        }
+        if (argb8888Buffer->data && !_parkedARGB8888.data) {
+            _parkedARGB8888 = *argb8888Buffer;
+            *argb8888Buffer = {0};
+        }
+    }
+    free(interimBuffer->data); *interimBuffer = {0};
+    free(argb8888Buffer->data); *argb8888Buffer = {0};
+}
+
+@end
+
+/* =================================================================================== */
+// MARK: - DLABConversionPlanCache
+/* =================================================================================== */
+
+@implementation DLABConversionPlanCache
+{
+    NSMutableDictionary<DLABConversionPlanKey*, DLABConversionPlan*>* _plans;
+    NSMutableArray<DLABConversionPlanKey*>* _order; // least recently used first
+}
+
+@synthesize capacity = _capacity;
+@synthesize hitCount = _hitCount;
+@synthesize missCount = _missCount;
+@synthesize evictionCount = _evictionCount;
+
++ (DLABConversionPlanCache*) sharedCache
+{
+    static DLABConversionPlanCache* sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[DLABConversionPlanCache alloc] init];
+    });
+    return sharedCache;
+}
+
+- (instancetype) init
+{
+    self = [super init];
+    if (self) {
+        _plans = [NSMutableDictionary dictionary];
+        _order = [NSMutableArray array];
+        _capacity = kDefaultCapacity;
+    }
+    return self;
+}
+
+- (NSUInteger) capacity
+{
+    @synchronized (self) {
+        return _capacity;
+    }
+}
+
+- (void) setCapacity:(NSUInteger)newCapacity
+{
+    @synchronized (self) {
+        _capacity = newCapacity;
+        [self evictLocked];
+    }
+}
+
+- (NSUInteger) count
+{
+    @synchronized (self) {
+        return _plans.count;
+    }
+}
+
+- (NSUInteger) hitCount
+{
+    @synchronized (self) {
+        return _hitCount;
+    }
+}
+
+- (NSUInteger) missCount
+{
+    @synchronized (self) {
+        return _missCount;
+    }
+}
+
+- (NSUInteger) evictionCount
+{
+    @synchronized (self) {
+        return _evictionCount;
+    }
+}
+
+- (DLABConversionPlan*) planForKey:(DLABConversionPlanKey*)key
+{
+    NSParameterAssert(key);
+
+    @synchronized (self) {
+        DLABConversionPlan* plan = _plans[key];
+        if (plan) {
+            _hitCount++;
+
+            // Move to most recently used position
+            NSUInteger index = [_order indexOfObject:key];
+            if (index != NSNotFound) {
+                DLABConversionPlanKey* storedKey = _order[index];
+                [_order removeObjectAtIndex:index];
+                [_order addObject:storedKey];
+            }
+        } else {
+            _missCount++;
+        }
+        return plan;
+    }
+}
+
+- (void) setPlan:(DLABConversionPlan*)plan forKey:(DLABConversionPlanKey*)key
+{
+    NSParameterAssert(plan && key);
+
+    @synchronized (self) {
+        if (_capacity == 0) return;
+
+        if (_plans[key]) {
+            [_order removeObject:key];
+        }
+        _plans[key] = plan;
+        [_order addObject:key];
+        [self evictLocked];
+    }
+}
+
+- (void) removeAllPlans
+{
+    @synchronized (self) {
+        [_plans removeAllObjects];
+        [_order removeAllObjects];
+        _hitCount = 0;
+        _missCount = 0;
+        _evictionCount = 0;
+    }
+}
+
+- (void) evictLocked
+{
+    while (_order.count > _capacity) {
+        DLABConversionPlanKey* key = _order.firstObject;
+        [_plans removeObjectForKey:key];
+        [_order removeObjectAtIndex:0];
+        _evictionCount++;
+    }
+}
+
+@end
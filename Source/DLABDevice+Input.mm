@@ -9,6 +9,7 @@
 /* This software is released under the MIT License, see LICENSE.txt. */
 
 #import <DLABDevice+Internal.h>
+#import <DLABAudioKernel.h>
 
 /* =================================================================================== */
 // MARK: - input (internal)
@@ -16,6 +17,213 @@
 
 @implementation DLABDevice (InputInternal)
 
+/* =================================================================================== */
+// MARK: Capture latency instrumentation
+/* =================================================================================== */
+
+// NULL if instrumentation is disabled
+NS_INLINE DLABLatencyStats* latencyStatsOf(DLABDevice* self) {
+    return (self.captureLatencyEnabled ? self.captureLatencyStats : NULL);
+}
+
+NS_INLINE uint64_t latencyNow(DLABLatencyStats* stats) {
+    return (stats ? DLABLatencyStats::Now() : 0);
+}
+
+NS_INLINE void recordLatency(DLABLatencyStats* stats, DLABCaptureLatencyStage stage, uint64_t startTime) {
+    if (stats) stats->RecordSince((uint32_t)stage, startTime);
+}
+
+NS_INLINE void recordDriverArrival(DLABDevice* self, DLABLatencyStats* stats, IDeckLinkVideoInputFrame* videoFrame) {
+    IDeckLinkInput* input = self.deckLinkInput;
+    if (!stats || !input) return;
+    
+    // Compare hardware reference timestamp of frame against current hardware clock
+    const BMDTimeScale timeScale = 1000000000; // nanoseconds
+    BMDTimeValue frameTime = 0, frameDuration = 0;
+    BMDTimeValue hardwareTime = 0, timeInFrame = 0, ticksPerFrame = 0;
+    HRESULT result1 = videoFrame->GetHardwareReferenceTimestamp(timeScale, &frameTime, &frameDuration);
+    HRESULT result2 = input->GetHardwareReferenceClock(timeScale, &hardwareTime, &timeInFrame, &ticksPerFrame);
+    if (!result1 && !result2 && hardwareTime >= frameTime) {
+        stats->Record((uint32_t)DLABCaptureLatencyStageDriverArrival, (uint64_t)(hardwareTime - frameTime));
+    }
+}
+
+NS_INLINE void recordDelegateStart(DLABLatencyStats* stats, uint64_t arrivalTime, uint64_t enqueueTime, uint64_t startTime) {
+    if (stats) {
+        stats->Record((uint32_t)DLABCaptureLatencyStageDelegateDispatch, startTime - enqueueTime);
+        stats->Record((uint32_t)DLABCaptureLatencyStageTotal, startTime - arrivalTime);
+    }
+}
+
+/* =================================================================================== */
+// MARK: Input frame context
+/* =================================================================================== */
+
+NS_INLINE BOOL checkPre1403(DLABDevice *self)
+{
+    BOOL pre1403 = (self.apiVersion < 0x0e030000); // -14.2.1; BLACKMAGIC_DECKLINK_API_VERSION
+    return pre1403;
+}
+
+NS_INLINE BOOL VideoBufferLockBaseAddress(IDeckLinkVideoFrame* videoFrame,
+                                          BMDBufferAccessFlags accessFlags,
+                                          IDeckLinkVideoBuffer** outVideoBuffer) {
+    if (!videoFrame || !outVideoBuffer) return NO;
+    *outVideoBuffer = NULL;
+    
+    IDeckLinkVideoBuffer* buf = NULL;
+    HRESULT hr = videoFrame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&buf);
+    if (FAILED(hr)) return NO;
+    
+    hr = buf->StartAccess(accessFlags);
+    if (FAILED(hr)) {
+        buf->Release();
+        return NO;
+    }
+    
+    *outVideoBuffer = buf; // caller owns one ref
+    return YES;
+}
+
+NS_INLINE BOOL VideoBufferGetBaseAddress(IDeckLinkVideoBuffer* videoBuffer, void** pointer) {
+    if (!videoBuffer || !pointer) return NO;
+    *pointer = NULL;
+    
+    HRESULT hr = videoBuffer->GetBytes(pointer);
+    return SUCCEEDED(hr) && (*pointer != NULL);
+}
+
+NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
+                                            BMDBufferAccessFlags accessFlags) {
+    if (!videoBuffer) return;
+    (void)videoBuffer->EndAccess(accessFlags);
+    videoBuffer->Release();
+}
+
+NS_INLINE void prepareInputFrameContext(DLABDevice* self, IDeckLinkVideoInputFrame* videoFrame,
+                                        DLABInputFrameContext* context) {
+    *context = DLABInputFrameContext();
+    context->videoFrame = videoFrame;
+    context->videoSetting = self.inputVideoSetting;
+    context->pre1403 = checkPre1403(self);
+    context->flags = videoFrame->GetFlags();
+    context->width = videoFrame->GetWidth();
+    context->height = videoFrame->GetHeight();
+    context->rowBytes = videoFrame->GetRowBytes();
+    context->pixelFormat = videoFrame->GetPixelFormat();
+    
+    // Query stream time only once per frame
+    if ((context->flags & bmdFrameHasNoInputSource) == 0 && context->videoSetting) {
+        BMDTimeValue frameTime = 0;
+        BMDTimeValue frameDuration = 0;
+        BMDTimeScale timeScale = context->videoSetting.timeScale;
+        HRESULT result = videoFrame->GetStreamTime(&frameTime, &frameDuration, timeScale);
+        if (!result) {
+            // Create timinginfo struct
+            CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
+            CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
+            CMTime decodeTimeStamp = kCMTimeInvalid;
+            context->timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+            context->timingValid = TRUE;
+        }
+    }
+}
+
+// Lock videoFrame buffer for read on first use; unlocked in releaseInputFrameContext()
+NS_INLINE void* baseAddressOfInputFrameContext(DLABInputFrameContext* context) {
+    if (context->baseAddress) return context->baseAddress;
+    
+    void* src = NULL;
+    if (!context->pre1403) {
+        IDeckLinkVideoBuffer* videoBuffer = NULL;
+        if (VideoBufferLockBaseAddress(context->videoFrame, bmdBufferAccessRead, &videoBuffer)) {
+            context->videoBuffer = videoBuffer;
+            VideoBufferGetBaseAddress(videoBuffer, &src);
+        }
+    } else {
+        IDeckLinkVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkVideoFrame_v14_2_1*)context->videoFrame;
+        videoFrame_v14_2_1->GetBytes(&src);
+    }
+    context->baseAddress = src;
+    return src;
+}
+
+NS_INLINE void releaseInputFrameContext(DLABInputFrameContext* context) {
+    if (context->videoBuffer) {
+        VideoBufferUnlockBaseAddress(context->videoBuffer, bmdBufferAccessRead);
+    }
+    *context = DLABInputFrameContext();
+}
+
+/* =================================================================================== */
+// MARK: Raw recorder
+/* =================================================================================== */
+
+// NULL unless raw recording is in progress
+NS_INLINE DLABRawRecorder* rawRecorderOf(DLABDevice* self) {
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder && recorder->IsRecording() ? recorder : NULL);
+}
+
+// Same preference order as createTimecodeSettingOf:
+NS_INLINE BOOL rawTimecodeOf(DLABInputFrameContext* context, uint32_t* bcd, uint32_t* flags) {
+    DLABVideoSetting* videoSetting = context->videoSetting;
+    BMDTimecodeFormat formats[7] = {0};
+    int count = 0;
+    if (videoSetting.useSERIAL) {
+        formats[count++] = DLABTimecodeFormatSerial;
+    }
+    if (videoSetting.useVITC) {
+        formats[count++] = DLABTimecodeFormatVITC;
+        formats[count++] = DLABTimecodeFormatVITCField2;
+    }
+    if (videoSetting.useRP188) {
+        formats[count++] = DLABTimecodeFormatRP188HighFrameRate;
+        formats[count++] = DLABTimecodeFormatRP188VITC1;
+        formats[count++] = DLABTimecodeFormatRP188LTC;
+        formats[count++] = DLABTimecodeFormatRP188VITC2;
+    }
+    for (int i = 0; i < count; i++) {
+        IDeckLinkTimecode* timecodeObj = NULL;
+        HRESULT result = context->videoFrame->GetTimecode(formats[i], &timecodeObj);
+        if (!result && timecodeObj) {
+            *bcd = (uint32_t)timecodeObj->GetBCD();
+            *flags = (uint32_t)timecodeObj->GetFlags();
+            timecodeObj->Release();
+            return YES;
+        }
+    }
+    return NO;
+}
+
+// Copy raw payload into recorder; never blocks capture thread.
+// context is shared with delivery stages, and locked buffer is released by caller.
+NS_INLINE void recordRawInput(DLABDevice* self, DLABRawRecorder* recorder,
+                              DLABInputFrameContext* context, IDeckLinkAudioInputPacket* audioPacket) {
+    if (context && context->videoFrame) {
+        void* src = (context->timingValid ? baseAddressOfInputFrameContext(context) : NULL);
+        if (src) {
+            uint32_t bcd = 0, flags = 0;
+            rawTimecodeOf(context, &bcd, &flags);
+            recorder->AppendVideo(src, (uint32_t)context->rowBytes, (uint32_t)context->height,
+                                  context->timingInfo.presentationTimeStamp.value,
+                                  context->timingInfo.duration.value, bcd, flags);
+        }
+    }
+    if (audioPacket) {
+        DLABAudioSetting* audioSetting = self.inputAudioSetting;
+        long frameCount = audioPacket->GetSampleFrameCount();
+        void* buffer = NULL;
+        BMDTimeValue packetTime = 0;
+        HRESULT result1 = audioPacket->GetBytes(&buffer);
+        HRESULT result2 = audioPacket->GetPacketTime(&packetTime, bmdAudioSampleRate48kHz);
+        if (audioSetting && frameCount > 0 && !result1 && buffer && !result2) {
+            recorder->AppendAudio(buffer, audioSetting.sampleSize, (uint32_t)frameCount, packetTime);
+        }
+    }
+}
+
 /* =================================================================================== */
 // MARK: DLABInputCallbackDelegate
 /* =================================================================================== */
@@ -89,41 +297,112 @@
 - (void) didReceiveVideoInputFrame:(IDeckLinkVideoInputFrame*)videoFrame
                   audioInputPacket:(IDeckLinkAudioInputPacket*)audioPacket
 {
+    DLABRawRecorder* recorder = rawRecorderOf(self);
     id<DLABInputCaptureDelegate> delegate = self.inputDelegate;
-    if (!delegate)
+    DLABCaptureGroup* group = self.captureGroup;
+    if (!recorder && !delegate && !group)
+        return;
+    
+    // Snapshot timing/format of videoFrame once for raw recorder and every stage
+    DLABInputFrameContext context = DLABInputFrameContext();
+    if (videoFrame) {
+        prepareInputFrameContext(self, videoFrame, &context);
+    }
+    
+    // Raw recorder takes every frame regardless of delegate backpressure
+    if (recorder) {
+        recordRawInput(self, recorder, &context, audioPacket);
+    }
+    
+    if (!delegate && !group) {
+        releaseInputFrameContext(&context);
         return;
+    }
+    
+    // Capture latency instrumentation
+    DLABLatencyStats* stats = latencyStatsOf(self);
+    uint64_t arrivalTime = latencyNow(stats);
     
     // Retain objects first - possible lengthy operation
     if (videoFrame) videoFrame->AddRef();
     if (audioPacket) audioPacket->AddRef();
     
+    // Delegate queue admission control
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    DLABDelegateQueueGate::Policy policy = (DLABDelegateQueueGate::Policy)self.inputDelegateQueueDropPolicy;
+    size_t limit = (size_t)self.inputDelegateQueueMaxVideoDepth;
+    
+    // Ancillary handlers run on capture thread for every frame, even if the gate drops it
     if (videoFrame) {
+        BOOL hasHandler = (self.inputVANCHandler || self.inputVANCPacketHandler ||
+                           self.inputVANCPacketBatchHandler || self.inputFrameMetadataHandler);
+        uint64_t handlerTime = latencyNow(stats);
+        
+        // Callback VANCHandler block
+        if (self.inputVANCHandler) {
+            [self callbackInputVANCHandler:&context];
+        }
+        
+        // Callback VANCPacketHandler block
+        if (self.inputVANCPacketHandler) {
+            [self callbackInputVANCPacketHandler:&context];
+        }
+        
+        // Callback VANCPacketBatchHandler block
+        if (self.inputVANCPacketBatchHandler) {
+            [self callbackInputVANCPacketBatchHandler:&context];
+        }
+        
+        // Callback InputFrameMetadataHandler block
+        if (self.inputFrameMetadataHandler) {
+            [self callbackInputFrameMetadataHandler:&context];
+        }
+        
+        if (hasHandler) {
+            recordLatency(stats, DLABCaptureLatencyStageAncillaryHandler, handlerTime);
+        }
+    }
+    
+    if (videoFrame && !gate->ShouldDropNewest(policy, limit)) {
+        recordDriverArrival(self, stats, videoFrame);
+        
         // Create video sampleBuffer
-        CMSampleBufferRef sampleBuffer = [self createVideoSampleForVideoFrame:videoFrame];
+        CMSampleBufferRef sampleBuffer = [self createVideoSampleForFrameContext:&context];
         
         // Create timecodeSetting
-        DLABTimecodeSetting* setting = [self createTimecodeSettingOf:videoFrame];
+        DLABTimecodeSetting* setting = [self createTimecodeSettingOf:&context];
         
         if (sampleBuffer) {
-            // Callback VANCHandler block
-            if (self.inputVANCHandler) {
-                [self callbackInputVANCHandler:videoFrame];
-            }
-            
-            // Callback VANCPacketHandler block
-            if (self.inputVANCPacketHandler) {
-                [self callbackInputVANCPacketHandler:videoFrame];
+            // group will handle InputVideoSampleBuffer instead of delegate
+            DLABDelegateQueueGate::Ticket* ticket = NULL;
+            if (group) {
+                BMDTimeValue hardwareTime = 0;
+                BMDTimeValue frameDuration = 0;
+                HRESULT result = videoFrame->GetHardwareReferenceTimestamp(1000000000, &hardwareTime, &frameDuration);
+                if (!result) {
+                    [group device:self didCaptureVideoSample:sampleBuffer timecodeSetting:setting
+                     hardwareTime:hardwareTime frameDuration:frameDuration];
+                }
+                CFRelease(sampleBuffer);
             }
             
-            // Callback InputFrameMetadataHandler block
-            if (self.inputFrameMetadataHandler) {
-                [self callbackInputFrameMetadataHandler:videoFrame];
+            // delegate will handle InputVideoSampleBuffer (gate owns sampleBuffer until Take)
+            uint64_t enqueueTime = latencyNow(stats);
+            if (!group) {
+                ticket = gate->EnqueueVideo(sampleBuffer, policy, limit);
             }
-            
-            // delegate will handle InputVideoSampleBuffer
-            if (setting) {
+            if (ticket && setting) {
                 __weak typeof(self) wself = self;
                 [self delegate_async:^{
+                    CMSampleBufferRef sampleBuffer = (CMSampleBufferRef)gate->Take(ticket);
+                    if (!sampleBuffer) return; // dropped
+                    
+                    // stats is owned by device; refer it via strong device reference
+                    DLABDevice* sself = wself;
+                    DLABLatencyStats* stats = (sself && arrivalTime ? latencyStatsOf(sself) : NULL);
+                    uint64_t startTime = latencyNow(stats);
+                    recordDelegateStart(stats, arrivalTime, enqueueTime, startTime);
+                    
                     SEL selector = @selector(processCapturedVideoSample:timecodeSetting:ofDevice:);
                     if ([delegate respondsToSelector:selector]) {
                         [delegate processCapturedVideoSample:sampleBuffer
@@ -131,27 +410,48 @@
                                                     ofDevice:wself]; // async
                     }
                     CFRelease(sampleBuffer);
+                    
+                    recordLatency(stats, DLABCaptureLatencyStageDelegateCallback, startTime);
                 }];
-            } else {
+            } else if (ticket) {
                 __weak typeof(self) wself = self;
                 [self delegate_async:^{
+                    CMSampleBufferRef sampleBuffer = (CMSampleBufferRef)gate->Take(ticket);
+                    if (!sampleBuffer) return; // dropped
+                    
+                    // stats is owned by device; refer it via strong device reference
+                    DLABDevice* sself = wself;
+                    DLABLatencyStats* stats = (sself && arrivalTime ? latencyStatsOf(sself) : NULL);
+                    uint64_t startTime = latencyNow(stats);
+                    recordDelegateStart(stats, arrivalTime, enqueueTime, startTime);
+                    
                     [delegate processCapturedVideoSample:sampleBuffer
                                                 ofDevice:wself]; // async
                     CFRelease(sampleBuffer);
+                    
+                    recordLatency(stats, DLABCaptureLatencyStageDelegateCallback, startTime);
                 }];
             }
         } else {
             // do nothing
         }
     }
+    
+    // Unlock videoFrame buffer if locked
+    releaseInputFrameContext(&context);
+    
     if (audioPacket) {
         // Create audio sampleBuffer
         CMSampleBufferRef sampleBuffer = [self createAudioSampleForAudioPacket:audioPacket];
         
-        // delegate will handle InputAudioSampleBuffer
-        if (sampleBuffer) {
+        // delegate will handle InputAudioSampleBuffer (never dropped)
+        DLABDelegateQueueGate::Ticket* ticket = gate->EnqueueAudio(sampleBuffer);
+        if (ticket) {
             __weak typeof(self) wself = self;
             [self delegate_async:^{
+                CMSampleBufferRef sampleBuffer = (CMSampleBufferRef)gate->Take(ticket);
+                if (!sampleBuffer) return;
+                
                 [delegate processCapturedAudioSample:sampleBuffer
                                             ofDevice:wself]; // async
                 CFRelease(sampleBuffer);
@@ -199,14 +499,13 @@ NS_INLINE size_t pixelSizeForDL(IDeckLinkVideoFrame* videoFrame) {
     return pixelSize;
 }
 
-NS_INLINE size_t pixelSizeForCV(CVPixelBufferRef pixelBuffer) {
+NS_INLINE size_t pixelSizeForCV(OSType pixelFormat) {
     size_t pixelSize = 0;   // For vImageCopyBuffer()
     {
         NSString* kBitsPerBlock = (__bridge NSString*)kCVPixelFormatBitsPerBlock;
         NSString* kBlockWidth = (__bridge NSString*)kCVPixelFormatBlockWidth;
         NSString* kBlockHeight = (__bridge NSString*)kCVPixelFormatBlockHeight;
         
-        OSType pixelFormat = CVPixelBufferGetPixelFormatType(pixelBuffer);
         CFDictionaryRef pfDict = CVPixelFormatDescriptionCreateWithPixelFormatType(kCFAllocatorDefault, pixelFormat);
         NSDictionary* dict = CFBridgingRelease(pfDict);
         
@@ -221,78 +520,23 @@ NS_INLINE size_t pixelSizeForCV(CVPixelBufferRef pixelBuffer) {
     return pixelSize;
 }
 
-NS_INLINE BOOL checkPre1403(DLABDevice *self)
-{
-    BOOL pre1403 = (self.apiVersion < 0x0e030000); // -14.2.1; BLACKMAGIC_DECKLINK_API_VERSION
-    return pre1403;
-}
-
-NS_INLINE BOOL VideoBufferLockBaseAddress(IDeckLinkVideoFrame* videoFrame,
-                                          BMDBufferAccessFlags accessFlags,
-                                          IDeckLinkVideoBuffer** outVideoBuffer) {
-    if (!videoFrame || !outVideoBuffer) return NO;
-    *outVideoBuffer = NULL;
-    
-    IDeckLinkVideoBuffer* buf = NULL;
-    HRESULT hr = videoFrame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&buf);
-    if (FAILED(hr)) return NO;
-    
-    hr = buf->StartAccess(accessFlags);
-    if (FAILED(hr)) {
-        buf->Release();
-        return NO;
-    }
+NS_INLINE BOOL copyBufferDLtoCV(DLABDevice* self, DLABInputFrameContext* context, CVPixelBufferRef pixelBuffer,
+                                size_t pixelSize) {
+    assert(context && pixelBuffer && pixelSize);
     
-    *outVideoBuffer = buf; // caller owns one ref
-    return YES;
-}
-
-NS_INLINE BOOL VideoBufferGetBaseAddress(IDeckLinkVideoBuffer* videoBuffer, void** pointer) {
-    if (!videoBuffer || !pointer) return NO;
-    *pointer = NULL;
-    
-    HRESULT hr = videoBuffer->GetBytes(pointer);
-    return SUCCEEDED(hr) && (*pointer != NULL);
-}
-
-NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
-                                            BMDBufferAccessFlags accessFlags) {
-    if (!videoBuffer) return;
-    (void)videoBuffer->EndAccess(accessFlags);
-    videoBuffer->Release();
-}
-
-NS_INLINE BOOL copyBufferDLtoCV(DLABDevice* self, IDeckLinkVideoFrame* videoFrame, CVPixelBufferRef pixelBuffer) {
-    assert(videoFrame && pixelBuffer);
-    
-    BOOL pre1403 = checkPre1403(self);
-    
-    IDeckLinkVideoBuffer* videoBuffer = NULL;
-    BMDBufferAccessFlags accessFlags = bmdBufferAccessRead;
-    if (!pre1403) {
-        if (!VideoBufferLockBaseAddress(videoFrame, accessFlags , &videoBuffer)) {
-            return FALSE;
-        }
-    }
+    void* src = baseAddressOfInputFrameContext(context);
+    if (!src) return FALSE;
     
     bool result = FALSE;
     CVReturn err = CVPixelBufferLockBaseAddress(pixelBuffer, 0);
     if (!err) {
-        void* src = NULL;
         void* dst = CVPixelBufferGetBaseAddress(pixelBuffer);
         
-        if (!pre1403) {
-            VideoBufferGetBaseAddress(videoBuffer, &src);
-        } else {
-            IDeckLinkVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkVideoFrame_v14_2_1*)videoFrame;
-            videoFrame_v14_2_1->GetBytes(&src);
-        }
-        
         vImage_Buffer sourceBuffer = {0};
         sourceBuffer.data = src;
-        sourceBuffer.width = videoFrame->GetWidth();
-        sourceBuffer.height = videoFrame->GetHeight();
-        sourceBuffer.rowBytes = videoFrame->GetRowBytes();
+        sourceBuffer.width = context->width;
+        sourceBuffer.height = context->height;
+        sourceBuffer.rowBytes = context->rowBytes;
         
         vImage_Buffer targetBuffer = {0};
         targetBuffer.data = dst;
@@ -301,14 +545,6 @@ NS_INLINE BOOL copyBufferDLtoCV(DLABDevice* self, IDeckLinkVideoFrame* videoFram
         targetBuffer.rowBytes = CVPixelBufferGetBytesPerRow(pixelBuffer);
         
         if (src && dst) {
-            size_t pixelSize = 0;
-            if (self.debugCalcPixelSizeFast) {
-                pixelSize = pixelSizeForDL(videoFrame);
-            } else {
-                pixelSize = pixelSizeForCV(pixelBuffer);
-            }
-            assert(pixelSize > 0);
-            
             vImage_Error convErr = kvImageNoError;
             convErr = vImageCopyBuffer(&sourceBuffer, &targetBuffer,
                                        pixelSize, kvImageNoFlags);
@@ -317,79 +553,117 @@ NS_INLINE BOOL copyBufferDLtoCV(DLABDevice* self, IDeckLinkVideoFrame* videoFram
         CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
     }
     
-    if (!pre1403) {
-        VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
-    }
-    
     return result;
 }
 
-NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* videoFrame, CVPixelBufferRef pixelBuffer) {
-    assert(videoFrame && pixelBuffer);
+NS_INLINE BOOL copyKernelDLtoCV(DLABDevice* self, DLABInputFrameContext* context, CVPixelBufferRef pixelBuffer,
+                                DLABCopyKernelFunc copyKernel) {
+    assert(context && pixelBuffer && copyKernel);
     
-    BOOL pre1403 = checkPre1403(self);
+    void* src = baseAddressOfInputFrameContext(context);
+    if (!src) return FALSE;
     
-    IDeckLinkVideoBuffer* videoBuffer = NULL;
-    BMDBufferAccessFlags accessFlags = bmdBufferAccessRead;
-    if (!pre1403) {
-        if (!VideoBufferLockBaseAddress(videoFrame, accessFlags , &videoBuffer)) {
-            return FALSE;
+    BOOL ready = FALSE;
+    CVReturn err = CVPixelBufferLockBaseAddress(pixelBuffer, 0);
+    if (!err) {
+        void* dst = CVPixelBufferGetBaseAddress(pixelBuffer);
+        size_t pbRowByte = CVPixelBufferGetBytesPerRow(pixelBuffer);
+        if (dst) {
+            size_t bytes = (size_t)context->rowBytes * (size_t)context->height;
+            ready = copyKernel(src, (size_t)context->rowBytes, dst, pbRowByte,
+                               (size_t)context->width, (size_t)context->height,
+                               DLABBlitModeSelect(self.useStreamingCaptureCopy, bytes));
         }
+        CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
     }
+    return ready;
+}
+
+NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, DLABInputFrameContext* context, CVPixelBufferRef pixelBuffer) {
+    assert(context && pixelBuffer);
+    
+    void* src = baseAddressOfInputFrameContext(context);
+    if (!src) return FALSE;
     
     BOOL ready = FALSE;
     
-    // Simply check if stride is same
     size_t pbRowByte = CVPixelBufferGetBytesPerRow(pixelBuffer);
-    size_t ifRowByte = videoFrame->GetRowBytes();
-    size_t ifHeight = videoFrame->GetHeight();
-    BOOL rowByteOK = (pbRowByte == ifRowByte);
+    size_t ifRowByte = (size_t)context->rowBytes;
+    size_t ifHeight = (size_t)context->height;
     
     // Copy pixel data from inputVideoFrame to CVPixelBuffer
     CVReturn err = CVPixelBufferLockBaseAddress(pixelBuffer, 0);
     if (!err) {
-        // get buffer address for src and dst
+        // get buffer address for dst
         void* dst = CVPixelBufferGetBaseAddress(pixelBuffer);
-        void* src = NULL;
-        
-        if (!pre1403) {
-            VideoBufferGetBaseAddress(videoBuffer, &src);
-        } else {
-            IDeckLinkVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkVideoFrame_v14_2_1*)videoFrame;
-            videoFrame_v14_2_1->GetBytes(&src);
-        }
         
         if (dst && src) {
-            if (rowByteOK) { // bulk copy
-                memcpy(dst, src, ifRowByte * ifHeight);
-            } else { // line copy with different stride
-                size_t length = MIN(pbRowByte, ifRowByte);
-                for (size_t line = 0; line < ifHeight; line++) {
-                    char* srcAddr = (char*)src + pbRowByte * line;
-                    char* dstAddr = (char*)dst + ifRowByte * line;
-                    memcpy(dstAddr, srcAddr, length);
-                }
-            }
-            ready = TRUE;
+            // src uses inputFrame stride, dst uses CVPixelBuffer stride (bulk copy if same)
+            size_t length = MIN(pbRowByte, ifRowByte);
+            ready = DLABBlit2D(src, ifRowByte, dst, pbRowByte, length, ifHeight,
+                               DLABBlitModeSelect(self.useStreamingCaptureCopy, length * ifHeight));
         }
         CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
     }
     
-    if (!pre1403) {
-        VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
-    }
-    
     return ready;
 }
 
-- (CVPixelBufferRef) createPixelBufferForVideoFrame:(IDeckLinkVideoInputFrame*)videoFrame
+NS_INLINE CVPixelBufferRef createPixelBufferFromVideoBuffer(DLABDevice* self, DLABInputFrameContext* context, OSType cvPixelFormat) {
+    assert(context && cvPixelFormat);
+    
+    // Zero-copy capture is available only when videoFrame is backed by DLABVideoBuffer
+    if (!self.inputVideoBufferAllocatorProvider || context->pre1403)
+        return NULL;
+    
+    IDeckLinkVideoBuffer* videoBuffer = NULL;
+    context->videoFrame->QueryInterface(IID_IDeckLinkVideoBuffer, (void**)&videoBuffer);
+    if (!videoBuffer)
+        return NULL;
+    
+    IDeckLinkMacVideoBuffer* macVideoBuffer = NULL;
+    videoBuffer->QueryInterface(IID_IDeckLinkMacVideoBuffer, (void**)&macVideoBuffer);
+    videoBuffer->Release();
+    if (!macVideoBuffer)
+        return NULL;
+    
+    CVPixelBufferRef pixelBuffer = NULL;
+    macVideoBuffer->CreateCVPixelBufferRef((void**)&pixelBuffer);
+    macVideoBuffer->Release();
+    if (!pixelBuffer)
+        return NULL;
+    
+    // Verify pixelBuffer is usable as is
+    size_t pbWidth = CVPixelBufferGetWidth(pixelBuffer);
+    size_t pbHeight = CVPixelBufferGetHeight(pixelBuffer);
+    size_t ifWidth = (size_t)context->width;
+    size_t ifHeight = (size_t)context->height;
+    BOOL sizeOK = (pbWidth == ifWidth && pbHeight == ifHeight);
+    BOOL formatOK = (CVPixelBufferGetPixelFormatType(pixelBuffer) == cvPixelFormat);
+    if (sizeOK && formatOK) {
+        return pixelBuffer; // caller owns one ref
+    }
+    CVPixelBufferRelease(pixelBuffer);
+    return NULL;
+}
+
+- (CVPixelBufferRef) createPixelBufferForFrameContext:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(videoFrame);
+    NSParameterAssert(context && context->videoFrame);
     
     BOOL ready = false;
-    OSType cvPixelFormat = self.inputVideoSetting.cvPixelFormatType;
+    OSType cvPixelFormat = context->videoSetting.cvPixelFormatType;
     assert(cvPixelFormat);
     
+    // Check if DeckLink has already captured into CVPixelBuffer (zero-copy)
+    {
+        CVPixelBufferRef pixelBuffer = createPixelBufferFromVideoBuffer(self, context, cvPixelFormat);
+        if (pixelBuffer) {
+            self.inputVideoCopiedBytesPerFrame = 0;
+            return pixelBuffer;
+        }
+    }
+    
     // Check pool, and create if required
     CVPixelBufferPoolRef pool = self.inputPixelBufferPool;
     if (pool == NULL) {
@@ -402,8 +676,8 @@ NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* video
         NSString* heightKey = (__bridge NSString *)kCVPixelBufferHeightKey;
         NSMutableDictionary* pbAttributes = [NSMutableDictionary dictionary];
         pbAttributes[pixelFormatKey] = @(cvPixelFormat);
-        pbAttributes[widthKey] = @(videoFrame->GetWidth());
-        pbAttributes[heightKey] = @(videoFrame->GetHeight());
+        pbAttributes[widthKey] = @(context->width);
+        pbAttributes[heightKey] = @(context->height);
         if (self.inputPixelBufferAttributes) {
             [pbAttributes addEntriesFromDictionary:self.inputPixelBufferAttributes];
         } else {
@@ -422,42 +696,83 @@ NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* video
         
         self.inputPixelBufferPool = pool;
         CVPixelBufferPoolRelease(pool);
+        
+        // Resolve copy kernel once per pool, regardless of following allocation result;
+        // stride is assumed equal until pool buffer tells otherwise
+        DLABCopyKernel kernel = DLABCopyKernelResolve(context->pixelFormat, cvPixelFormat, true);
+        if (context->pixelFormat == cvPixelFormat) {
+            if (self.debugCalcPixelSizeFast) {
+                kernel.pixelSize = pixelSizeForDL(context->videoFrame);
+            } else {
+                kernel.pixelSize = pixelSizeForCV(cvPixelFormat);
+            }
+        }
+        self.inputCopyKernel = kernel;
     }
     
     // Create new pixelBuffer and copy image
+    DLABLatencyStats* stats = latencyStatsOf(self);
     CVPixelBufferRef pixelBuffer = NULL;
     if (pool) {
         CVReturn err = kCVReturnError;
+        uint64_t allocTime = latencyNow(stats);
         err = CVPixelBufferPoolCreatePixelBuffer(NULL, pool, &pixelBuffer);
+        recordLatency(stats, DLABCaptureLatencyStagePixelBufferAllocation, allocTime);
         if (!err && pixelBuffer) {
+            uint64_t copyTime = latencyNow(stats);
+            
             // Simply check if width, height are same
             size_t pbWidth = CVPixelBufferGetWidth(pixelBuffer);
             size_t pbHeight = CVPixelBufferGetHeight(pixelBuffer);
-            size_t ifWidth = videoFrame->GetWidth();
-            size_t ifHeight = videoFrame->GetHeight();
+            size_t ifWidth = (size_t)context->width;
+            size_t ifHeight = (size_t)context->height;
             BOOL sizeOK = (pbWidth == ifWidth && pbHeight == ifHeight);
             
-            BMDPixelFormat pixelFormat = videoFrame->GetPixelFormat();
+            BMDPixelFormat pixelFormat = context->pixelFormat;
             BOOL sameFormat = (pixelFormat == cvPixelFormat);
+            BOOL strideEqual = (CVPixelBufferGetBytesPerRow(pixelBuffer) == (size_t)context->rowBytes);
+            
             if (sameFormat && sizeOK) {
-                if (self.debugUsevImageCopyBuffer) {
-                    ready = copyBufferDLtoCV(self, videoFrame, pixelBuffer);
+                DLABCopyKernel kernel = self.inputCopyKernel;
+                BOOL formatMatched = (kernel.dlFormat == pixelFormat && kernel.cvFormat == cvPixelFormat);
+                if (formatMatched && kernel.strideEqual != strideEqual) {
+                    // Pool buffers share same stride; re-resolve once for actual stride
+                    kernel.copy = DLABCopyKernelResolve(pixelFormat, cvPixelFormat, strideEqual).copy;
+                    kernel.strideEqual = strideEqual;
+                    self.inputCopyKernel = kernel;
+                }
+                BOOL kernelOK = (kernel.copy && formatMatched && kernel.strideEqual == strideEqual);
+                if (self.debugUsevImageCopyBuffer && formatMatched && kernel.pixelSize) {
+                    ready = copyBufferDLtoCV(self, context, pixelBuffer, kernel.pixelSize);
+                } else if (kernelOK) {
+                    ready = copyKernelDLtoCV(self, context, pixelBuffer, kernel.copy);
                 } else {
-                    ready = copyPlaneDLtoCV(self, videoFrame, pixelBuffer);
+                    ready = copyPlaneDLtoCV(self, context, pixelBuffer);
                 }
             } else {
                 // Use DLABVideoConverter/vImage to convert video image
                 DLABVideoConverter *converter = self.inputVideoConverter;
+                if (converter && ![converter compatibleWithDL:context->videoFrame andCV:pixelBuffer]) {
+                    converter = nil; // Input format changed; Cached plan is reused if available
+                }
                 if (!converter) {
-                    converter = [[DLABVideoConverter alloc] initWithDL:videoFrame
+                    converter = [[DLABVideoConverter alloc] initWithDL:context->videoFrame
                                                                   toCV:pixelBuffer];
-                    converter.pre1403 = checkPre1403(self);
+                    converter.pre1403 = context->pre1403;
                     self.inputVideoConverter = converter;
                 }
                 if (converter) {
-                    ready = [converter convertDL:videoFrame toCV:pixelBuffer];
+                    converter.threadCount = self.videoConverterThreadCount;
+                    ready = [converter convertDL:context->videoFrame toCV:pixelBuffer];
                 }
             }
+            if (ready) {
+                recordLatency(stats, DLABCaptureLatencyStageCopyConvert, copyTime);
+                
+                uint64_t copiedBytes = (uint64_t)CVPixelBufferGetDataSize(pixelBuffer);
+                self.inputVideoCopiedBytesPerFrame = copiedBytes;
+                self.inputVideoCopiedByteCount = self.inputVideoCopiedByteCount + copiedBytes;
+            }
         }
     }
     
@@ -470,31 +785,21 @@ NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* video
     }
 }
 
-- (CMSampleBufferRef) createVideoSampleForVideoFrame:(IDeckLinkVideoInputFrame*)videoFrame
+- (CMSampleBufferRef) createVideoSampleForFrameContext:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(videoFrame);
-    
-    BMDFrameFlags flags = videoFrame->GetFlags();
-    if ((flags & bmdFrameHasNoInputSource) != 0)
-        return NULL;
+    NSParameterAssert(context && context->videoFrame);
     
-    BMDTimeValue frameTime = 0;
-    BMDTimeValue frameDuration = 0;
-    BMDTimeScale timeScale = self.inputVideoSetting.timeScale;
-    HRESULT result = videoFrame->GetStreamTime(&frameTime, &frameDuration, timeScale);
-    if (result)
+    // No input source, or stream time is not available
+    if (!context->timingValid)
         return NULL;
     
-    // Create timinginfo struct
-    CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
-    CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
-    CMTime decodeTimeStamp = kCMTimeInvalid;
-    CMSampleTimingInfo timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+    DLABVideoSetting* videoSetting = context->videoSetting;
+    CMSampleTimingInfo timingInfo = context->timingInfo;
     
     // Check if refreshing pool is required (prior to create pixelbuffer)
     if (self.needsInputVideoConfigurationRefresh) {
         // Update InputVideoFormmatDescription using videoFrame
-        BOOL result = [self.inputVideoSetting updateInputVideoFormatDescriptionUsingVideoFrame:videoFrame];
+        BOOL result = [videoSetting updateInputVideoFormatDescriptionUsingVideoFrame:context->videoFrame];
         if (!result)
             return NULL;
         
@@ -505,37 +810,37 @@ NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* video
         self.needsInputVideoConfigurationRefresh = FALSE;
     }
     
-    CMFormatDescriptionRef formatDescription = self.inputVideoSetting.videoFormatDescription;
+    CMFormatDescriptionRef formatDescription = videoSetting.videoFormatDescription;
     if (!formatDescription)
         return NULL;
     
     // Create new pixelBuffer, copy image from videoFrame, and create sampleBuffer
     OSStatus err = noErr;
     CMSampleBufferRef sampleBuffer = NULL;
-    CVPixelBufferRef pixelBuffer = [self createPixelBufferForVideoFrame:videoFrame];
+    CVPixelBufferRef pixelBuffer = [self createPixelBufferForFrameContext:context];
     if (pixelBuffer) {
         // Attach formatDescriptionExtensions to new PixelBuffer
-        CFDictionaryRef dict = (__bridge CFDictionaryRef)self.inputVideoSetting.extensions;
+        CFDictionaryRef dict = (__bridge CFDictionaryRef)videoSetting.extensions;
         if (dict) {
             CVBufferRemoveAllAttachments(pixelBuffer);
             CVBufferSetAttachments(pixelBuffer, dict, kCVAttachmentMode_ShouldPropagate);
         } else {
-            CMFormatDescriptionRef formatDescription = self.inputVideoSetting.videoFormatDescription;
-            if (formatDescription) {
-                CFDictionaryRef extensions = CMFormatDescriptionGetExtensions(formatDescription);
-                if (extensions) {
-                    CMRemoveAllAttachments(pixelBuffer);
-                    CMSetAttachments(pixelBuffer, extensions, kCMAttachmentMode_ShouldPropagate);
-                }
+            CFDictionaryRef extensions = CMFormatDescriptionGetExtensions(formatDescription);
+            if (extensions) {
+                CMRemoveAllAttachments(pixelBuffer);
+                CMSetAttachments(pixelBuffer, extensions, kCMAttachmentMode_ShouldPropagate);
             }
         }
         
         // Create CMSampleBuffer for videoFrame
+        DLABLatencyStats* stats = latencyStatsOf(self);
+        uint64_t createTime = latencyNow(stats);
         err = CMSampleBufferCreateReadyWithImageBuffer(NULL,
                                                        pixelBuffer,
                                                        formatDescription,
                                                        &timingInfo,
                                                        &sampleBuffer);
+        recordLatency(stats, DLABCaptureLatencyStageSampleBufferCreate, createTime);
         
         // Free pixelBuffer
         CVPixelBufferRelease(pixelBuffer);
@@ -589,30 +894,50 @@ NS_INLINE BOOL copyPlaneDLtoCV(DLABDevice* self, IDeckLinkVideoInputFrame* video
     if (!formatDescription)
         return NULL;
     
+    // Retain pool; disableAudioInput may release it concurrently
+    DLABAudioBlockPool* pool = NULL;
+    @synchronized (self) {
+        pool = self.inputAudioBlockPool;
+        if (pool) pool->AddRef();
+    }
+    
     // Create CMBlockBuffer for audioPacket, copy sample data, and create sampleBuffer
     CMBlockBufferRef blockBuffer = NULL;
     CMSampleBufferRef sampleBuffer = NULL;
-    OSStatus err = CMBlockBufferCreateWithMemoryBlock(NULL,
-                                                      NULL,
-                                                      blockLength,
-                                                      NULL,
-                                                      NULL,
-                                                      0,
-                                                      blockLength,
-                                                      flags,
-                                                      &blockBuffer);
+    OSStatus err = noErr;
+    if (pool) {
+        // Recycle memory block from pool (each block retains pool)
+        err = pool->CreateBlockBuffer(blockLength, &blockBuffer);
+        pool->Release();
+    } else {
+        err = CMBlockBufferCreateWithMemoryBlock(NULL,
+                                                 NULL,
+                                                 blockLength,
+                                                 NULL,
+                                                 NULL,
+                                                 0,
+                                                 blockLength,
+                                                 flags,
+                                                 &blockBuffer);
+    }
     if (!err && blockBuffer) {
         if (sampleSize == sampleSizeInUse) {
             // Copy whole sample data into blockBuffer
             err = CMBlockBufferReplaceDataBytes(buffer, blockBuffer, 0, blockLength);
         } else {
-            // Extract audio channel data from audioPacket
-            for (size_t frame = 0; frame < frameCount; frame++) {
-                size_t srcOffset = frame * sampleSize;
-                size_t dstOffset = frame * sampleSizeInUse;
-                void* srcPtr = (void*)((char*)buffer + srcOffset);
-                err = CMBlockBufferReplaceDataBytes(srcPtr, blockBuffer, dstOffset, sampleSizeInUse);
-                if (err) break;
+            // Extract audio channel data from audioPacket directly into blockBuffer
+            size_t channelCount = (size_t)self.inputAudioSetting.channelCount;
+            size_t channelCountInUse = (size_t)self.inputAudioSetting.channelCountInUse;
+            size_t bytesPerSample = sampleSize / channelCount;
+            char* dataPtr = NULL;
+            size_t totalLength = 0;
+            err = CMBlockBufferGetDataPointer(blockBuffer, 0, NULL, &totalLength, &dataPtr);
+            if (!err) {
+                BOOL ready = (dataPtr && totalLength >= blockLength &&
+                              DLABKernelAudioExtract(buffer, channelCount,
+                                                     dataPtr, channelCountInUse,
+                                                     NULL, bytesPerSample, numSamples));
+                if (!ready) err = kCMBlockBufferBadLengthParameterErr;
             }
         }
         if (!err) {
@@ -661,16 +986,18 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     return setting;
 }
 
-- (DLABTimecodeSetting*) createTimecodeSettingOf:(IDeckLinkVideoInputFrame*)videoFrame
+- (DLABTimecodeSetting*) createTimecodeSettingOf:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(videoFrame);
+    NSParameterAssert(context && context->videoFrame);
     
     // Check videoFrame
+    IDeckLinkVideoInputFrame* videoFrame = context->videoFrame;
     DLABTimecodeSetting* setting = nil;
     
-    BOOL useSERIAL = self.inputVideoSetting.useSERIAL;
-    BOOL useVITC = self.inputVideoSetting.useVITC;
-    BOOL useRP188 = self.inputVideoSetting.useRP188;
+    DLABVideoSetting* videoSetting = context->videoSetting;
+    BOOL useSERIAL = videoSetting.useSERIAL;
+    BOOL useVITC = videoSetting.useVITC;
+    BOOL useRP188 = videoSetting.useRP188;
     
     if (useSERIAL) {
         setting = createTimecodeSetting(videoFrame, DLABTimecodeFormatSerial);
@@ -730,25 +1057,15 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     }
 }
 
-- (void) callbackInputVANCHandler:(IDeckLinkVideoInputFrame*)inFrame
+- (void) callbackInputVANCHandler:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(inFrame);
+    NSParameterAssert(context && context->videoFrame);
     
     // Validate input frame
-    BMDFrameFlags flags = inFrame->GetFlags();
-    if ((flags & bmdFrameHasNoInputSource) != 0) return;
-    
-    BMDTimeValue frameTime = 0;
-    BMDTimeValue frameDuration = 0;
-    BMDTimeScale timeScale = self.inputVideoSetting.timeScale;
-    HRESULT result = inFrame->GetStreamTime(&frameTime, &frameDuration, timeScale);
-    if (result) return;
-    
-    // Create timinginfo struct
-    CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
-    CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
-    CMTime decodeTimeStamp = kCMTimeInvalid;
-    CMSampleTimingInfo timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+    if (!context->timingValid) return;
+    
+    IDeckLinkVideoInputFrame* inFrame = context->videoFrame;
+    CMSampleTimingInfo timingInfo = context->timingInfo;
     
     //
     VANCHandler inHandler = self.inputVANCHandler;
@@ -775,25 +1092,15 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
 
 // private experimental - VANC Packet Capture support
 
-- (void) callbackInputVANCPacketHandler:(IDeckLinkVideoInputFrame*)inFrame
+- (void) callbackInputVANCPacketHandler:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(inFrame);
+    NSParameterAssert(context && context->videoFrame);
     
     // Validate input frame
-    BMDFrameFlags flags = inFrame->GetFlags();
-    if ((flags & bmdFrameHasNoInputSource) != 0) return;
-    
-    BMDTimeValue frameTime = 0;
-    BMDTimeValue frameDuration = 0;
-    BMDTimeScale timeScale = self.inputVideoSetting.timeScale;
-    HRESULT result = inFrame->GetStreamTime(&frameTime, &frameDuration, timeScale);
-    if (result) return;
-    
-    // Create timinginfo struct
-    CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
-    CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
-    CMTime decodeTimeStamp = kCMTimeInvalid;
-    CMSampleTimingInfo timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+    if (!context->timingValid) return;
+    
+    IDeckLinkVideoInputFrame* inFrame = context->videoFrame;
+    CMSampleTimingInfo timingInfo = context->timingInfo;
     
     //
     InputVANCPacketHandler inHandler = self.inputVANCPacketHandler;
@@ -845,26 +1152,133 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     }
 }
 
+// private experimental - batched VANC Packet Capture support
+
+- (void) callbackInputVANCPacketBatchHandler:(DLABInputFrameContext*)context
+{
+    NSParameterAssert(context && context->videoFrame);
+    
+    // Validate input frame
+    if (!context->timingValid) return;
+    
+    CMSampleTimingInfo timingInfo = context->timingInfo;
+    
+    //
+    InputVANCPacketBatchHandler inHandler = self.inputVANCPacketBatchHandler;
+    DLABAncillaryArenaPool* pool = self.inputAncillaryArenaPool;
+    if (inHandler && pool) {
+        // Copy every packet once into arena on capture thread
+        DLABAncillaryArena* arena = NULL;
+        if (self.inputVANCLineParsing) {
+            arena = [self arenaOfInputFrameAncillaryLines:context pool:pool];
+        } else {
+            arena = [self arenaOfInputFrameAncillaryPackets:context pool:pool];
+        }
+        
+        if (arena) {
+            // Batch owns arena; recycled on dealloc
+            DLABAncillaryPacketBatch* batch = [[DLABAncillaryPacketBatch alloc] initWithArena:arena
+                                                                                         pool:pool
+                                                                                   timingInfo:timingInfo];
+            if (batch.count) {
+                [self delegate_async:^{
+                    inHandler(batch);
+                }];
+            }
+        }
+    }
+}
+
+- (DLABAncillaryArena*) arenaOfInputFrameAncillaryPackets:(DLABInputFrameContext*)context
+                                                     pool:(DLABAncillaryArenaPool*)pool
+{
+    NSParameterAssert(context && context->videoFrame && pool);
+    
+    // Packets decoded by driver
+    DLABAncillaryArena* arena = NULL;
+    IDeckLinkVideoFrameAncillaryPackets* frameAncillaryPackets = NULL;
+    context->videoFrame->QueryInterface(IID_IDeckLinkVideoFrameAncillaryPackets,
+                            (void**)&frameAncillaryPackets);
+    if (frameAncillaryPackets) {
+        IDeckLinkAncillaryPacketIterator* iterator = NULL;
+        frameAncillaryPackets->GetPacketIterator(&iterator);
+        if (iterator) {
+            arena = pool->Reserve();
+            IDeckLinkAncillaryPacket* packet = NULL;
+            while (iterator->Next(&packet) == S_OK && packet) {
+                BMDAncillaryPacketFormat format = bmdAncillaryPacketFormatUInt8;
+                const void* ptr = NULL;
+                uint32_t size = 0;
+                packet->GetBytes(format, &ptr, &size);
+                if (ptr && size) {
+                    arena->Append(packet->GetDID(), packet->GetSDID(),
+                                  packet->GetLineNumber(), packet->GetDataStreamIndex(),
+                                  ptr, size);
+                }
+                packet->Release();
+                packet = NULL;
+            }
+            iterator->Release();
+        }
+        
+        frameAncillaryPackets->Release();
+    }
+    return arena; // Nullable
+}
+
+- (DLABAncillaryArena*) arenaOfInputFrameAncillaryLines:(DLABInputFrameContext*)context
+                                                   pool:(DLABAncillaryArenaPool*)pool
+{
+    NSParameterAssert(context && context->videoFrame && pool);
+    
+    // Packets parsed from raw VANC lines
+    DLABAncillaryArena* arena = NULL;
+    IDeckLinkVideoFrameAncillary* frameAncillary = [self prepareInputFrameAncillary:context->videoFrame];
+    if (frameAncillary) {
+        DLABAncLineFormat format = DLABAncLineFormatV210;
+        size_t width = 0;
+        if (ancillaryLineFormatOf(frameAncillary, context->width, &format, &width)) {
+            arena = pool->Reserve();
+            
+            DLABAncPacketInfo packets[ancillaryLineMaxPackets];
+            uint8_t payload[ancillaryLinePayloadCapacity];
+            NSArray<NSNumber*>* lines = self.inputVANCLines;
+            for (NSNumber* num in lines) {
+                int32_t lineNumber = num.intValue;
+                void* buffer = [self bufferOfInputFrameAncillary:frameAncillary line:lineNumber];
+                if (!buffer) continue;
+                
+                size_t count = DLABAncLineParse(buffer, width, format,
+                                                packets, ancillaryLineMaxPackets,
+                                                payload, ancillaryLinePayloadCapacity);
+                for (size_t i = 0; i < count; i++) {
+                    DLABAncPacketInfo* info = &packets[i];
+                    if (!info->parityValid || !info->checksumValid) continue;
+                    arena->Append(info->did, info->sdid,
+                                  (uint32_t)lineNumber, info->stream,
+                                  payload + info->payloadOffset, info->dataCount);
+                }
+            }
+        }
+        
+        frameAncillary->Release();
+    }
+    return arena; // Nullable
+}
+
 /* =================================================================================== */
 // MARK: HDR Metadata support
 /* =================================================================================== */
 
 // private experimental - Input FrameMetadata support
-- (DLABFrameMetadata*) callbackInputFrameMetadataHandler:(IDeckLinkVideoInputFrame*)inFrame
+- (DLABFrameMetadata*) callbackInputFrameMetadataHandler:(DLABInputFrameContext*)context
 {
-    NSParameterAssert(inFrame);
+    NSParameterAssert(context && context->videoFrame);
     
-    BMDTimeValue frameTime = 0;
-    BMDTimeValue frameDuration = 0;
-    BMDTimeScale timeScale = self.inputVideoSetting.timeScale;
-    HRESULT result = inFrame->GetStreamTime(&frameTime, &frameDuration, timeScale);
-    if (result) return nil;
+    if (!context->timingValid) return nil;
     
-    // Create timinginfo struct
-    CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
-    CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
-    CMTime decodeTimeStamp = kCMTimeInvalid;
-    CMSampleTimingInfo timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+    IDeckLinkVideoInputFrame* inFrame = context->videoFrame;
+    CMSampleTimingInfo timingInfo = context->timingInfo;
     
     InputFrameMetadataHandler inHandler = self.inputFrameMetadataHandler;
     if (inHandler) {
@@ -1102,8 +1516,28 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
         BMDVideoInputFlags inputFlag = setting.inputFlag;
         BMDPixelFormat format = setting.pixelFormat;
         
+        // Zero-copy capture requires native pixel format and 14.3 or later
+        BOOL pre1403 = checkPre1403(self);
+        BOOL nativeFormat = (format == bmdFormat8BitYUV ||
+                             format == bmdFormat10BitYUV ||
+                             format == bmdFormat8BitBGRA);
+        BOOL zeroCopy = (self.useZeroCopyCapture && !pre1403 && nativeFormat &&
+                         format == setting.cvPixelFormatType);
+        if (zeroCopy) {
+            DLABVideoBufferAllocatorProvider* provider = new DLABVideoBufferAllocatorProvider(self.inputPixelBufferAttributes);
+            self.inputVideoBufferAllocatorProvider = provider;
+            provider->Release();
+        } else {
+            self.inputVideoBufferAllocatorProvider = NULL;
+        }
+        
+        DLABVideoBufferAllocatorProvider* provider = self.inputVideoBufferAllocatorProvider;
         [self capture_sync:^{
-            result = input->EnableVideoInput(displayMode, format, inputFlag);
+            if (provider) {
+                result = input->EnableVideoInputWithAllocatorProvider(displayMode, format, inputFlag, provider);
+            } else {
+                result = input->EnableVideoInput(displayMode, format, inputFlag);
+            }
         }];
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
@@ -1116,8 +1550,11 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     if (!result) {
         self.inputVideoSettingW = setting;
         self.needsInputVideoConfigurationRefresh = TRUE;
+        self.inputVideoCopiedBytesPerFrame = 0;
+        self.inputVideoCopiedByteCount = 0;
         return YES;
     } else {
+        self.inputVideoBufferAllocatorProvider = NULL;
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
             reason:@"IDeckLinkInput::EnableVideoInput failed."
               code:result
@@ -1189,6 +1626,7 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     
     if (!result) {
         self.inputVideoSettingW = nil;
+        self.inputVideoBufferAllocatorProvider = NULL;
         return YES;
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
@@ -1250,6 +1688,13 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     
     if (!result) {
         self.inputAudioSettingW = setting;
+        
+        // Prepare audio block pool for this setting
+        size_t sampleSizeInUse = (setting.sampleSizeInUse ? setting.sampleSizeInUse : setting.sampleSize);
+        size_t blockSize = sampleSizeInUse * maxInputAudioPacketFrameCount;
+        DLABAudioBlockPool* pool = new DLABAudioBlockPool(blockSize, inputAudioBlockPoolCapacity);
+        self.inputAudioBlockPool = pool;
+        pool->Release();
         return YES;
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
@@ -1294,6 +1739,7 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     
     if (!result) {
         self.inputAudioSettingW = nil;
+        self.inputAudioBlockPool = NULL;
         return YES;
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
@@ -1333,6 +1779,71 @@ static DLABTimecodeSetting* createTimecodeSetting(IDeckLinkVideoInputFrame* vide
     }
 }
 
+/* =================================================================================== */
+// MARK: Raw recorder (experimental)
+/* =================================================================================== */
+
+- (BOOL) startRawRecordingToURL:(NSURL*)url
+                          error:(NSError**)error
+{
+    NSParameterAssert(url);
+    
+    DLABVideoSetting* videoSetting = self.inputVideoSetting;
+    DLABAudioSetting* audioSetting = self.inputAudioSetting;
+    if (!url.isFileURL || !videoSetting) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Either file URL or input DLABVideoSetting is not available."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    
+    DLABRawRecorder::VideoFormat video = {};
+    video.width = (uint32_t)videoSetting.width;
+    video.height = (uint32_t)videoSetting.height;
+    video.pixelFormat = (uint32_t)videoSetting.pixelFormat;
+    video.rowBytes = (uint32_t)videoSetting.rowBytes;
+    video.timeScale = (int64_t)videoSetting.timeScale;
+    video.frameDuration = (int64_t)videoSetting.duration;
+    
+    DLABRawRecorder::AudioFormat audio = {};
+    if (audioSetting) {
+        audio.sampleRate = (uint32_t)audioSetting.sampleRate;
+        audio.channelCount = audioSetting.channelCount;
+        audio.bytesPerFrame = audioSetting.sampleSize;
+        audio.bitsPerSample = (uint32_t)audioSetting.sampleType;
+    }
+    
+    DLABRawRecorder* recorder = [self prepareInputRawRecorder];
+    int err = recorder->Start(url.fileSystemRepresentation, video, audio, inputRawRecorderSegmentCount);
+    if (err) {
+        NSString* reason = [NSString stringWithFormat:@"DLABRawRecorder::Start failed. (%s)", strerror(err)];
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:reason
+              code:(err == EBUSY ? E_ACCESSDENIED : E_FAIL)
+                to:error];
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL) stopRawRecordingWithError:(NSError**)error
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    if (!recorder) return YES;
+    
+    int err = recorder->Stop();
+    if (err) {
+        NSString* reason = [NSString stringWithFormat:@"DLABRawRecorder::Stop failed. (%s)", strerror(err)];
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:reason
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+    return YES;
+}
+
 /* =================================================================================== */
 // MARK: Stream
 /* =================================================================================== */
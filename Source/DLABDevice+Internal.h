@@ -25,6 +25,19 @@
 #import <DLABInputCallback.h>
 #import <DLABOutputCallback.h>
 #import <DLABAncillaryPacket.h>
+#import <DLABAncillaryKernel.h>
+#import <DLABCopyKernel.h>
+#import <DLABVideoBufferAllocator.h>
+#import <DLABFramePool.h>
+#import <DLABAudioBlockPool.h>
+#import <DLABAudioRing.h>
+#import <DLABPlaybackScheduler.h>
+#import <DLABPlaybackTelemetry.h>
+#import <DLABLatencyStats.h>
+#import <DLABDelegateQueueGate.h>
+#import <DLABRawRecorder.h>
+#import <DLABRawReplaySource.h>
+#import <DLABSimulator.h>
 #import <DLABNotificationCallback.h>
 #import <DLABVideoSetting+Internal.h>
 #import <DLABAudioSetting+Internal.h>
@@ -32,10 +45,86 @@
 #import <DLABProfileCallback.h>
 #import <DLABProfileAttributes+Internal.h>
 #import <DLABFrameMetadata+Internal.h>
+#import <DLABAncillaryPacketBatch+Internal.h>
 #import <DLABVideoConverter.h>
+#import <DLABConversionPlanCache.h>
+#import <DLABCaptureGroup+Internal.h>
 #import <DLABDeckControl+Internal.h>
 
 const int maxOutputVideoFrameCount = 8;
+const int maxInputAudioPacketFrameCount = 4096; // 85.3 mSec at 48kHz
+const int inputAudioBlockPoolCapacity = 16;
+const int inputAncillaryArenaPoolCapacity = 8;
+const int outputAncillaryPacketPoolCapacity = 32;
+const int outputAudioRingDefaultTargetLevel = 4800; // 100 mSec at 48kHz
+const int outputSchedulerDefaultTargetDepth = 3;
+const int outputSchedulerMaxTargetDepth = maxOutputVideoFrameCount - 1;
+const int inputRawRecorderSegmentCount = 8;
+const int ancillaryLineMaxPackets = 64;
+const int ancillaryLineMaxLines = 32;
+const int ancillaryLinePayloadCapacity = 8192;
+
+/* =================================================================================== */
+
+// Raw VANC line format/width of IDeckLinkVideoFrameAncillary; NO if neither v210 nor 2vuy
+NS_INLINE BOOL ancillaryLineFormatOf(IDeckLinkVideoFrameAncillary* ancillaryData, long frameWidth,
+                                     DLABAncLineFormat* format, size_t* width) {
+    // Above HD, VANC line is 1920 pixels for UHD modes and 2048 pixels for DCI modes
+    *width = (size_t)frameWidth;
+    if (frameWidth > 2048) {
+        *width = ((frameWidth % 1024) == 0) ? 2048 : 1920;
+    }
+    BMDDisplayMode mode = ancillaryData->GetDisplayMode();
+    BOOL sd = (mode == bmdModeNTSC || mode == bmdModeNTSC2398 || mode == bmdModePAL ||
+               mode == bmdModeNTSCp || mode == bmdModePALp);
+    switch (ancillaryData->GetPixelFormat()) {
+        case bmdFormat10BitYUV:
+            *format = (sd ? DLABAncLineFormatV210SD : DLABAncLineFormatV210);
+            return YES;
+        case bmdFormat8BitYUV:
+            *format = (sd ? DLABAncLineFormat2vuySD : DLABAncLineFormat2vuy);
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+/* =================================================================================== */
+
+/*
+ * Internal use only
+ * Snapshot of one input videoFrame, populated once in didReceiveVideoInputFrame:
+ * and shared by every capture stage, so that all stages agree on same timing/format.
+ */
+typedef struct DLABInputFrameContext {
+    IDeckLinkVideoInputFrame* videoFrame;       // not retained
+    DLABVideoSetting* videoSetting;             // snapshot of inputVideoSetting
+    BOOL pre1403;
+    BMDFrameFlags flags;
+    BOOL timingValid;                           // NO if no input source or no stream time
+    CMSampleTimingInfo timingInfo;
+    long width;
+    long height;
+    long rowBytes;
+    BMDPixelFormat pixelFormat;
+    IDeckLinkVideoBuffer* videoBuffer;          // locked for read on first use of baseAddress
+    void* baseAddress;
+} DLABInputFrameContext;
+
+/*
+ * Internal use only
+ * Per-frame destination of output ancillary packets, prepared once per output frame
+ * and shared by VANCPacketHandler and VANCPacketWriteHandler.
+ */
+typedef struct DLABAncillarySink {
+    IDeckLinkVideoFrameAncillaryPackets* frameAncillaryPackets; // attach mode
+    IDeckLinkVideoFrameAncillary* frameAncillary;               // serialize mode
+    DLABAncLineFormat format;
+    size_t width;
+    size_t lineCount;
+    uint32_t lineNumbers[ancillaryLineMaxLines];
+    size_t positions[ancillaryLineMaxLines][2];                 // next word position per stream
+} DLABAncillarySink;
 
 /* =================================================================================== */
 
@@ -120,10 +209,27 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (BOOL) subscribeInput:(BOOL) flag;
 - (BOOL) subscribeOutput:(BOOL) flag;
+- (BOOL) subscribeOutputAudio:(BOOL) flag;
 - (BOOL) subscribeStatusChangeNotification:(BOOL) flag;
 - (BOOL) subscribePrefsChangeNotification:(BOOL) flag;
 - (BOOL) subscribeProfileChange:(BOOL) flag;
 
+// Lazy creation of cpp objects
+
+/**
+ Create outputScheduler on first use.
+ 
+ @return DLABPlaybackScheduler
+ */
+- (DLABPlaybackScheduler*) prepareOutputScheduler;
+
+/**
+ Create inputRawRecorder on first use.
+ 
+ @return DLABRawRecorder
+ */
+- (DLABRawRecorder*) prepareInputRawRecorder;
+
 /* =================================================================================== */
 // MARK: - (Private) - Paired with public readonly
 /* =================================================================================== */
@@ -282,17 +388,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign, readonly) void* delegateQueueKey;
 
-// NSMutableSet* - OutputVideoFramePool management
+// cpp objects - OutputVideoFramePool management
+
+/**
+ OutputVideoFramePool management. Lock-free free-list of IDeckLinkMutableVideoFrame.
+ Capacity is maxOutputVideoFrameCount.
+ */
+@property (nonatomic, assign, readonly) DLABFramePool* outputVideoFramePool;
+
+// cpp objects - Capture delegate queue admission control
+
+/**
+ Admission control of captured samples on delegate queue.
+ */
+@property (nonatomic, assign, readonly) DLABDelegateQueueGate* inputDelegateQueueGate;
+
+// cpp objects - Batched VANC packet capture
 
 /**
- OutputVideoFramePool management.
+ Recycling pool of VANC packet arena for DLABAncillaryPacketBatch.
  */
-@property (nonatomic, strong, readonly) NSMutableSet* outputVideoFrameSet;
+@property (nonatomic, assign, readonly) DLABAncillaryArenaPool* inputAncillaryArenaPool;
+
+// cpp objects - Output VANC packet insertion
 
 /**
- OutputVideoFramePool management.
+ Recycling pool of DLABAncillaryPacket for output VideoFrame.
  */
-@property (nonatomic, strong, readonly) NSMutableSet* outputVideoFrameIdleSet;
+@property (nonatomic, assign, readonly) DLABAncillaryPacketPool* outputAncillaryPacketPool;
 
 /* =================================================================================== */
 
@@ -315,6 +438,63 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign, nullable) IDeckLinkScreenPreviewCallback* inputPreviewCallback;
 
+// cpp objects - Ready after enabling video input with zero-copy capture
+
+/**
+ IDeckLinkVideoBufferAllocatorProvider object for input.
+ */
+@property (nonatomic, assign, nullable) DLABVideoBufferAllocatorProvider* inputVideoBufferAllocatorProvider;
+
+// cpp objects - Ready after enabling audio input
+
+/**
+ Recycling pool of memory blocks for captured audio CMBlockBuffer.
+ */
+@property (nonatomic, assign, nullable) DLABAudioBlockPool* inputAudioBlockPool;
+
+// cpp objects - Ready after enabling capture latency instrumentation
+
+/**
+ Latency histograms of capture pipeline. Once created, kept until dealloc.
+ */
+@property (nonatomic, assign, readonly, nullable) DLABLatencyStats* captureLatencyStats;
+
+// cpp objects - Ready after enabling output audio ring
+
+/**
+ Lock-free audio ring drained by RenderAudioSamples. Reused while capacity fits.
+ Setter retains/releases under @synchronized (self); accessors from other threads retain under same lock.
+ */
+@property (nonatomic, assign, nullable) DLABAudioRing* outputAudioRing;
+
+// cpp objects - Ready after first use of output scheduler
+
+/**
+ Frame pacing state of output scheduler. Once created, kept until dealloc.
+ */
+@property (nonatomic, assign, nullable) DLABPlaybackScheduler* outputScheduler;
+
+// cpp objects - Ready after enabling playback telemetry
+
+/**
+ Frame completion telemetry of playback. Once created, kept until dealloc.
+ */
+@property (nonatomic, assign, readonly, nullable) DLABPlaybackTelemetry* playbackTelemetry;
+
+// cpp objects - Ready after first use of raw recorder
+
+/**
+ Raw frame recorder of capture. Once created, kept until dealloc.
+ */
+@property (nonatomic, assign, readonly, nullable) DLABRawRecorder* inputRawRecorder;
+
+// cpp objects - Ready after opening raw replay file
+
+/**
+ Memory mapped raw replay file. Retained; in-flight wrapped frames keep their own reference.
+ */
+@property (nonatomic, assign, nullable) DLABRawReplaySource* outputRawReplaySource;
+
 /* =================================================================================== */
 
 // Initial videoFrame forces update.
@@ -336,6 +516,48 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong, nullable) DLABVideoConverter* outputVideoConverter;
 
+/**
+ Copy kernel for same format capture; resolved when inputPixelBufferPool is (re)built
+ */
+@property (nonatomic, assign) DLABCopyKernel inputCopyKernel;
+
+/**
+ Bytes copied or converted into CVPixelBuffer for last captured video frame. Written by capture
+ thread; reset by enableVideoInput before input stream starts.
+ */
+@property (atomic, assign, readwrite) uint64_t inputVideoCopiedBytesPerFrame;
+
+/**
+ Total bytes copied or converted into CVPixelBuffer. Accumulated by capture thread; reset by
+ enableVideoInput before input stream starts.
+ */
+@property (atomic, assign, readwrite) uint64_t inputVideoCopiedByteCount;
+
+/**
+ Running DLABCaptureGroup; video samples are delivered to the group instead of delegate
+ */
+@property (nonatomic, weak, nullable) DLABCaptureGroup* captureGroup;
+
+/**
+ YES while RenderAudioSamples drains outputAudioRing
+ */
+@property (atomic, assign, readwrite) BOOL outputAudioRingEnabled;
+
+/**
+ Stream time of next sample frame scheduled from outputAudioRing (48kHz). Audio callback only.
+ */
+@property (nonatomic, assign) int64_t outputAudioRingStreamTime;
+
+/**
+ Number of sample frames buffered in device at last RenderAudioSamples
+ */
+@property (atomic, assign, readwrite) NSUInteger outputAudioRingDeviceBufferedLevel;
+
+/**
+ YES while ScheduledFrameCompleted refills frames from outputScheduler
+ */
+@property (nonatomic, assign, readwrite) BOOL outputSchedulerRunning;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -377,6 +599,15 @@ NS_ASSUME_NONNULL_BEGIN
 // MARK: private method
 /* =================================================================================== */
 
+/**
+ Create output VideoFrame and register into output VideoFrame pool.
+ Caller should lock self.
+ 
+ @param count number of VideoFrame to add (limited by pool capacity)
+ @return number of VideoFrame actually added
+ */
+- (NSUInteger) expandOutputVideoFramePoolBy:(NSUInteger)count;
+
 /**
  Check output VideoFrame pool and expand if required.
  
@@ -412,6 +643,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable IDeckLinkMutableVideoFrame*) outputVideoFrameWithPixelBuffer:(CVPixelBufferRef)pb;
 
+/**
+ Prepare output VideoFrame rendered in place by handler
+ 
+ @param handler OutputVideoFrameRenderHandler
+ @return IDeckLinkMutableVideoFrame or null if failed or cancelled.
+ */
+- (nullable IDeckLinkMutableVideoFrame*) outputVideoFrameWithRenderHandler:(OutputVideoFrameRenderHandler)handler;
+
+/**
+ Prepare output VideoFrame from mapped frame of raw replay file
+ 
+ @param source DLABRawReplaySource
+ @param index video frame index
+ @param wrapped YES if frame wraps mapped memory (not pooled; caller should release it after scheduling)
+ @return IDeckLinkMutableVideoFrame or null if failed.
+ */
+- (nullable IDeckLinkMutableVideoFrame*) outputVideoFrameWithRawReplaySource:(DLABRawReplaySource*)source
+                                                                       index:(uint64_t)index
+                                                                     wrapped:(BOOL*)wrapped;
+
 /**
  Validate timecode combination for current output VideoSetting
  
@@ -422,6 +673,21 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL) validateTimecodeFormat:(DLABTimecodeFormat)format
                    videoSetting:(DLABVideoSetting*)outputVideoSetting;
 
+/**
+ Schedule sample frames in audio ring up to outputAudioRingTargetLevel.
+ Called on RenderAudioSamples callback thread.
+ 
+ @param ring DLABAudioRing
+ @param preroll preroll or not
+ */
+- (void) drainOutputAudioRing:(DLABAudioRing*)ring preroll:(BOOL)preroll;
+
+/**
+ Schedule frames from outputScheduler up to outputSchedulerTargetDepth.
+ Called on ScheduledFrameCompleted callback thread, or on start.
+ */
+- (void) fillOutputScheduler;
+
 /* =================================================================================== */
 // MARK: private experimental - VANC support
 /* =================================================================================== */
@@ -460,16 +726,29 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  Call VANCPacketHandler for output VideoFrame
  
- @param outFrame IDeckLinkMutableVideoFrame
+ @param sink per-frame ancillary destination, shared with VANCPacketWriteHandler
  @param displayTime time at which to display the frame in timeScale units
  @param frameDuration duration for which to display the frame in timeScale units
  @param timeScale time scale for displayTime and displayDuration
  */
-- (void) callbackOutputVANCPacketHandler:(IDeckLinkMutableVideoFrame*)outFrame
+- (void) callbackOutputVANCPacketHandler:(DLABAncillarySink*)sink
                                   atTime:(NSInteger)displayTime
                                 duration:(NSInteger)frameDuration
                              inTimeScale:(NSInteger)timeScale;
 
+/**
+ Call VANCPacketWriteHandler for output VideoFrame
+ 
+ @param sink per-frame ancillary destination, shared with VANCPacketHandler
+ @param displayTime time at which to display the frame in timeScale units
+ @param frameDuration duration for which to display the frame in timeScale units
+ @param timeScale time scale for displayTime and displayDuration
+ */
+- (void) callbackOutputVANCPacketWriteHandler:(DLABAncillarySink*)sink
+                                       atTime:(NSInteger)displayTime
+                                     duration:(NSInteger)frameDuration
+                                  inTimeScale:(NSInteger)timeScale;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -515,26 +794,26 @@ NS_ASSUME_NONNULL_BEGIN
  
  If videoFrame contains timecode, either RP188 or VITC family will be returned.
  
- @param videoFrame IDeckLinkVideoInputFrame
+ @param context DLABInputFrameContext of videoFrame
  @return DLABTimecodeSetting for videoFrame or null if failed.
  */
-- (nullable DLABTimecodeSetting*) createTimecodeSettingOf:(IDeckLinkVideoInputFrame*)videoFrame;
+- (nullable DLABTimecodeSetting*) createTimecodeSettingOf:(DLABInputFrameContext*)context;
 
 /**
  Prepare PixelBuffer for VideoFrame. Different stride is supported.
  
- @param videoFrame IDeckLinkVideoInputFrame
+ @param context DLABInputFrameContext of videoFrame
  @return CVPixelBufferRef for videoFrame or null if failed.
  */
-- (nullable CVPixelBufferRef) createPixelBufferForVideoFrame:(IDeckLinkVideoInputFrame*)videoFrame;
+- (nullable CVPixelBufferRef) createPixelBufferForFrameContext:(DLABInputFrameContext*)context;
 
 /**
  Utility method to convert videoFrame into CMSampleBufferRef.
  
- @param videoFrame IDeckLinkVideoInputFrame
+ @param context DLABInputFrameContext of videoFrame
  @return CMSampleBufferRef for videoFrame or null if failed.
  */
-- (nullable CMSampleBufferRef) createVideoSampleForVideoFrame:(IDeckLinkVideoInputFrame*)videoFrame;
+- (nullable CMSampleBufferRef) createVideoSampleForFrameContext:(DLABInputFrameContext*)context;
 
 /**
  Utility method to convert audioPacket into CMSampleBufferRef.
@@ -569,16 +848,43 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  Call VANCHandler block for input VideoFrame.
  
- @param inFrame IDeckLinkVideoInputFrame
+ @param context DLABInputFrameContext of input VideoFrame
  */
-- (void) callbackInputVANCHandler:(IDeckLinkVideoInputFrame*)inFrame;
+- (void) callbackInputVANCHandler:(DLABInputFrameContext*)context;
 
 /**
  Call VANCPacketHandler block for input VideoFrame.
  
- @param inFrame IDeckLinkVideoInputFrame
+ @param context DLABInputFrameContext of input VideoFrame
+ */
+- (void) callbackInputVANCPacketHandler:(DLABInputFrameContext*)context;
+
+/**
+ Call VANCPacketBatchHandler block for input VideoFrame.
+ 
+ @param context DLABInputFrameContext of input VideoFrame
+ */
+- (void) callbackInputVANCPacketBatchHandler:(DLABInputFrameContext*)context;
+
+/**
+ Copy driver-decoded ancillary packets of input VideoFrame into pooled arena.
+ 
+ @param context DLABInputFrameContext of input VideoFrame
+ @param pool DLABAncillaryArenaPool
+ @return DLABAncillaryArena reserved from pool. Caller should recycle it.
+ */
+- (nullable DLABAncillaryArena*) arenaOfInputFrameAncillaryPackets:(DLABInputFrameContext*)context
+                                                              pool:(DLABAncillaryArenaPool*)pool;
+
+/**
+ Parse raw VANC lines (inputVANCLines) of input VideoFrame into pooled arena.
+ 
+ @param context DLABInputFrameContext of input VideoFrame
+ @param pool DLABAncillaryArenaPool
+ @return DLABAncillaryArena reserved from pool. Caller should recycle it.
  */
-- (void) callbackInputVANCPacketHandler:(IDeckLinkVideoInputFrame*)inFrame;
+- (nullable DLABAncillaryArena*) arenaOfInputFrameAncillaryLines:(DLABInputFrameContext*)context
+                                                            pool:(DLABAncillaryArenaPool*)pool;
 
 @end
 
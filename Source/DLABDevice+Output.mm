@@ -16,21 +16,112 @@
 
 @implementation DLABDevice (OutputInternal)
 
+/* =================================================================================== */
+// MARK: Playback telemetry
+/* =================================================================================== */
+
+// NULL if telemetry is disabled
+NS_INLINE DLABPlaybackTelemetry* playbackTelemetryOf(DLABDevice* self) {
+    return (self.playbackTelemetryEnabled ? self.playbackTelemetry : NULL);
+}
+
+NS_INLINE void recordScheduledFrame(DLABDevice* self, IDeckLinkMutableVideoFrame* outFrame,
+                                    NSInteger displayTime, NSInteger frameDuration, NSInteger timeScale) {
+    DLABPlaybackTelemetry* telemetry = playbackTelemetryOf(self);
+    IDeckLinkOutput* output = self.deckLinkOutput;
+    if (!telemetry || !output) return;
+    
+    // Hardware reference clock at schedule
+    const BMDTimeScale nanoTimeScale = 1000000000;
+    BMDTimeValue hardwareTime = 0, timeInFrame = 0, ticksPerFrame = 0;
+    HRESULT result = output->GetHardwareReferenceClock(nanoTimeScale, &hardwareTime, &timeInFrame, &ticksPerFrame);
+    telemetry->RecordScheduled(outFrame, displayTime, frameDuration, timeScale, (result ? 0 : hardwareTime));
+}
+
+NS_INLINE void recordCompletedFrame(DLABDevice* self, IDeckLinkVideoFrame* frame,
+                                    BMDOutputFrameCompletionResult result) {
+    DLABPlaybackTelemetry* telemetry = playbackTelemetryOf(self);
+    IDeckLinkOutput* output = self.deckLinkOutput;
+    if (!telemetry || !output) return;
+    
+    // Hardware reference timestamp when frame completed
+    const BMDTimeScale nanoTimeScale = 1000000000;
+    BMDTimeValue completionTime = 0;
+    if (output->GetFrameCompletionReferenceTimestamp(frame, nanoTimeScale, &completionTime)) {
+        completionTime = 0;
+    }
+    
+    DLABPlaybackTelemetry::Result telemetryResult = DLABPlaybackTelemetry::ResultCompleted;
+    switch (result) {
+        case bmdOutputFrameDisplayedLate:
+            telemetryResult = DLABPlaybackTelemetry::ResultDisplayedLate; break;
+        case bmdOutputFrameDropped:
+            telemetryResult = DLABPlaybackTelemetry::ResultDropped; break;
+        case bmdOutputFrameFlushed:
+            telemetryResult = DLABPlaybackTelemetry::ResultFlushed; break;
+        default:
+            break;
+    }
+    DLABPlaybackTelemetry::Completion info = {};
+    telemetry->Complete(frame, telemetryResult, completionTime, &info);
+    
+    // Streaming callback
+    OutputFrameCompletionHandler handler = self.outputFrameCompletionHandler;
+    if (handler) {
+        DLABOutputFrameCompletion completion = {};
+        completion.result = (DLABOutputFrameCompletionResult)result;
+        completion.displayTime = info.displayTime;
+        completion.frameDuration = info.frameDuration;
+        completion.timeScale = info.timeScale;
+        completion.completionTime = info.completionTime;
+        completion.scheduleToAir = info.scheduleToAir;
+        completion.timingError = info.timingError;
+        [self delegate_async:^{
+            handler(completion); // async
+        }];
+    }
+}
+
 /* =================================================================================== */
 // MARK: DLABOutputCallbackDelegate
 /* =================================================================================== */
 
+NS_INLINE DLABPlaybackScheduler::Completion completionOf(BMDOutputFrameCompletionResult result) {
+    switch (result) {
+        case bmdOutputFrameDisplayedLate:
+            return DLABPlaybackScheduler::CompletionLate;
+        case bmdOutputFrameDropped:
+            return DLABPlaybackScheduler::CompletionDropped;
+        case bmdOutputFrameFlushed:
+            return DLABPlaybackScheduler::CompletionFlushed;
+        case bmdOutputFrameCompleted:
+        default:
+            return DLABPlaybackScheduler::CompletionCompleted;
+    }
+}
+
 - (void)scheduledFrameCompleted:(IDeckLinkVideoFrame *)frame
                          result:(BMDOutputFrameCompletionResult)result
 {
     NSParameterAssert(frame);
     
-    // TODO eval BMDOutputFrameCompletionResult here
-    // TODO eval GetFrameCompletionReferenceTimestamp() here
+    // Count BMDOutputFrameCompletionResult
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    if (scheduler) {
+        scheduler->RecordCompletion(completionOf(result));
+    }
+    
+    // Completion telemetry (frame is still owned by device here)
+    recordCompletedFrame(self, frame, result);
     
     // free output frame
     [self releaseOutputVideoFrame:(IDeckLinkMutableVideoFrame *)frame];
     
+    // output scheduler refills frames on this thread
+    if (scheduler && self.outputSchedulerRunning) {
+        [self fillOutputScheduler];
+    }
+    
     // delegate can schedule next frame here
     __weak typeof(self) wself = self;
     id<DLABOutputPlaybackDelegate> delegate = self.outputDelegate;
@@ -39,8 +130,29 @@
     }];
 }
 
+// Retain ring; enableOutputAudioRing may replace it concurrently
+NS_INLINE DLABAudioRing* retainOutputAudioRing(DLABDevice* self) {
+    DLABAudioRing* ring = NULL;
+    @synchronized (self) {
+        ring = self.outputAudioRing;
+        if (ring) ring->AddRef();
+    }
+    return ring;
+}
+
 - (void)renderAudioSamplesPreroll:(BOOL)preroll
 {
+    // audio ring is drained on this thread, without queue hop
+    DLABAudioRing* ring = retainOutputAudioRing(self);
+    if (ring) {
+        BOOL enabled = self.outputAudioRingEnabled;
+        if (enabled) {
+            [self drainOutputAudioRing:ring preroll:preroll];
+        }
+        ring->Release();
+        if (enabled) return;
+    }
+    
     __weak typeof(self) wself = self;
     id<DLABOutputPlaybackDelegate> delegate = self.outputDelegate;
     [self delegate_async:^{
@@ -61,69 +173,174 @@
     }];
 }
 
+/* =================================================================================== */
+// MARK: Audio ring
+/* =================================================================================== */
+
+- (void) drainOutputAudioRing:(DLABAudioRing*)ring preroll:(BOOL)preroll
+{
+    IDeckLinkOutput* output = self.deckLinkOutput;
+    if (!output) return;
+    
+    // Check level of sample frames buffered in device
+    uint32_t bufferedFrameCount = 0;
+    HRESULT result = output->GetBufferedAudioSampleFrameCount(&bufferedFrameCount);
+    if (result) return;
+    self.outputAudioRingDeviceBufferedLevel = bufferedFrameCount;
+    
+    uint32_t targetLevel = (uint32_t)MIN(self.outputAudioRingTargetLevel, (NSUInteger)UINT32_MAX);
+    if (bufferedFrameCount >= targetLevel) return;
+    uint32_t requiredCount = targetLevel - bufferedFrameCount;
+    
+    // Schedule readable regions (wrapped part follows)
+    const void* data[2] = {NULL, NULL};
+    uint32_t count[2] = {0, 0};
+    ring->Peek(&data[0], &count[0], &data[1], &count[1]);
+    
+    BMDTimeValue streamTime = self.outputAudioRingStreamTime;
+    uint32_t scheduledCount = 0;
+    for (int index = 0; index < 2 && scheduledCount < requiredCount; index++) {
+        uint32_t sampleFrameCount = MIN(count[index], requiredCount - scheduledCount);
+        if (!sampleFrameCount) break;
+        
+        uint32_t written = 0;
+        result = output->ScheduleAudioSamples((void*)data[index],
+                                              sampleFrameCount,
+                                              streamTime,
+                                              DLABAudioSampleRate48kHz,
+                                              &written);
+        
+        // Update queuing status
+        ring->Consume(written);
+        streamTime += written;
+        scheduledCount += written;
+        if (result || written < sampleFrameCount) break;
+    }
+    self.outputAudioRingStreamTime = streamTime;
+    
+    // Ring ran short of target level
+    if (!preroll && scheduledCount < requiredCount && !result) {
+        ring->CountUnderrun();
+    }
+}
+
+/* =================================================================================== */
+// MARK: Output scheduler
+/* =================================================================================== */
+
+- (void) fillOutputScheduler
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    IDeckLinkOutput* output = self.deckLinkOutput;
+    DLABVideoSetting* setting = self.outputVideoSetting;
+    if (!scheduler || !output || !setting) return;
+    
+    NSInteger frameDuration = setting.duration;
+    NSInteger timeScale = setting.timeScale;
+    
+    // Skip display times which are already behind stream time
+    BMDTimeValue streamTime = 0;
+    double playbackSpeed = 0.0;
+    HRESULT result = output->GetScheduledStreamTime(timeScale, &streamTime, &playbackSpeed);
+    if (!result && playbackSpeed > 0.0) {
+        scheduler->CatchUp(streamTime);
+    }
+    
+    uint32_t bufferedFrameCount = 0;
+    result = output->GetBufferedVideoFrameCount(&bufferedFrameCount);
+    if (result) return;
+    
+    // Keep target depth; repeat last frame if starved
+    while (bufferedFrameCount < scheduler->TargetDepth()) {
+        int64_t displayTime = 0;
+        bool repeated = false;
+        CVPixelBufferRef pixelBuffer = (CVPixelBufferRef)scheduler->Next(&displayTime, &repeated);
+        if (!pixelBuffer) break;
+        
+        BOOL scheduled = [self schedulePlaybackOfPixelBuffer:pixelBuffer
+                                                      atTime:displayTime
+                                                    duration:frameDuration
+                                                 inTimeScale:timeScale
+                                                       error:nil];
+        CFRelease(pixelBuffer);
+        if (!scheduled) break;
+        bufferedFrameCount++;
+    }
+}
+
 /* =================================================================================== */
 // MARK: Manage output VideoFrame pool
 /* =================================================================================== */
 
-- (BOOL) prepareOutputVideoFramePool
+- (NSUInteger) expandOutputVideoFramePoolBy:(NSUInteger)count
 {
-    BOOL ret = NO;
-    HRESULT result = E_FAIL;
+    NSUInteger added = 0;
+    DLABFramePool* pool = self.outputVideoFramePool;
     DLABVideoSetting* setting = self.outputVideoSetting;
     IDeckLinkOutput* output = self.deckLinkOutput;
-    if (output && setting) {
-        @synchronized (self) {
-            // Set initial pool size as 4 frames
-            BOOL initialSetup = (self.outputVideoFrameSet.count == 0);
-            int expandingUnit = initialSetup ? 4 : 2;
+    if (pool && output && setting) {
+        // Get frame properties
+        int32_t width = (int32_t)setting.width;
+        int32_t height = (int32_t)setting.height;
+        int32_t rowBytes = (int32_t)setting.rowBytes;
+        BMDPixelFormat pixelFormat = setting.pixelFormat;
+        BMDFrameFlags flags = setting.outputFlag;
+        
+        // Try expanding the OutputVideoFramePool
+        for (NSUInteger i = 0; i < count; i++) {
+            // Check if pool size is at maximum value
+            BOOL poolIsFull = (pool->Count() >= pool->Capacity());
+            if (poolIsFull) break;
             
-            BOOL needsExpansion = (self.outputVideoFrameIdleSet.count == 0);
-            if (needsExpansion) {
-                // Get frame properties
-                int32_t width = (int32_t)setting.width;
-                int32_t height = (int32_t)setting.height;
-                int32_t rowBytes = (int32_t)setting.rowBytes;
-                BMDPixelFormat pixelFormat = setting.pixelFormat;
-                BMDFrameFlags flags = setting.outputFlag;
-                
-                // Try expanding the OutputVideoFramePool
-                for (int i = 0; i < expandingUnit; i++) {
-                    // Check if pool size is at maximum value
-                    BOOL poolIsFull = (self.outputVideoFrameSet.count >= maxOutputVideoFrameCount);
-                    if (poolIsFull) break;
-                    
-                    // Create new output videoFrame object
-                    IDeckLinkMutableVideoFrame *outFrame = NULL;
-                    result = output->CreateVideoFrame(width, height, rowBytes,
+            // Create new output videoFrame object
+            IDeckLinkMutableVideoFrame *outFrame = NULL;
+            HRESULT result = output->CreateVideoFrame(width, height, rowBytes,
                                                       pixelFormat, flags, &outFrame);
-                    if (result) break;
-                    
-                    // register outputVideoFrame into the pool
-                    NSValue* ptrValue = [NSValue valueWithPointer:(void*)outFrame];
-                    [self.outputVideoFrameSet addObject:ptrValue];
-                    [self.outputVideoFrameIdleSet addObject:ptrValue];
-                }
+            if (result) break;
+            
+            // register outputVideoFrame into the pool
+            if (!pool->Add((void*)outFrame)) {
+                outFrame->Release();
+                break;
             }
-            ret = (self.outputVideoFrameIdleSet.count > 0);
+            added++;
         }
     }
-    return ret;
+    return added;
 }
 
-- (void) freeOutputVideoFramePool
+- (BOOL) prepareOutputVideoFramePool
 {
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (!pool) return NO;
+    
+    // Fast path - idle frame is available (lock-free)
+    if (pool->IdleCount() > 0) return YES;
+    
+    // Slow path - expansion is serialized
     @synchronized (self) {
-        // Release all outputVideoFrame objects
-        for (NSValue *ptrValue in self.outputVideoFrameSet) {
-            IDeckLinkMutableVideoFrame *outFrame = (IDeckLinkMutableVideoFrame*)ptrValue.pointerValue;
-            if (outFrame) {
-                outFrame->Release();
-            }
+        BOOL needsExpansion = (pool->IdleCount() == 0);
+        if (needsExpansion) {
+            // Set initial pool size as 4 frames
+            BOOL initialSetup = (pool->Count() == 0);
+            NSUInteger expandingUnit = initialSetup ? 4 : 2;
+            [self expandOutputVideoFramePoolBy:expandingUnit];
         }
-        
-        // unregister all of outputVideoFrame in the pool
-        [self.outputVideoFrameIdleSet removeAllObjects];
-        [self.outputVideoFrameSet removeAllObjects];
+    }
+    return (pool->IdleCount() > 0);
+}
+
+- (void) freeOutputVideoFramePool
+{
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (!pool) return;
+    
+    @synchronized (self) {
+        // Release all outputVideoFrame objects, and unregister them
+        pool->RemoveAll([](void* item, void* /*context*/) {
+            IDeckLinkMutableVideoFrame *outFrame = (IDeckLinkMutableVideoFrame*)item;
+            outFrame->Release();
+        }, NULL);
     }
 }
 
@@ -133,29 +350,20 @@
     [self prepareOutputVideoFramePool];
     
     IDeckLinkMutableVideoFrame *outFrame = NULL;
-    @synchronized (self) {
-        NSValue* ptrValue = [self.outputVideoFrameIdleSet anyObject];
-        if (ptrValue) {
-            [self.outputVideoFrameIdleSet removeObject:ptrValue];
-            outFrame = (IDeckLinkMutableVideoFrame*)ptrValue.pointerValue;
-        }
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (pool) {
+        outFrame = (IDeckLinkMutableVideoFrame*)pool->Reserve();
     }
-    
     return outFrame;
 }
 
 - (BOOL) releaseOutputVideoFrame:(IDeckLinkMutableVideoFrame*)outFrame
 {
-    BOOL result = NO;
-    @synchronized (self) {
-        NSValue* ptrValue = [NSValue valueWithPointer:(void*)outFrame];
-        NSValue* orgValue = [self.outputVideoFrameSet member:ptrValue];
-        if (orgValue) {
-            [self.outputVideoFrameIdleSet addObject:orgValue];
-            result = YES;
-        }
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (pool && outFrame) {
+        return pool->Release((void*)outFrame);
     }
-    return result;
+    return NO;
 }
 
 /* =================================================================================== */
@@ -331,11 +539,9 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
     
     BOOL ready = FALSE;
     
-    // Simply check if stride is same
     size_t pbRowByte = CVPixelBufferGetBytesPerRow(pixelBuffer);
     size_t ofRowByte = (size_t)videoFrame->GetRowBytes();
     size_t ofHeight = videoFrame->GetHeight();
-    BOOL rowByteOK = (pbRowByte == ofRowByte);
     
     // Copy pixel data from CVPixelBuffer to outputVideoFrame
     CVReturn err = CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
@@ -352,17 +558,10 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
         }
         
         if (dst && src) {
-            if (rowByteOK) { // bulk copy
-                memcpy(dst, src, ofRowByte * ofHeight);
-            } else { // line copy with different stride
-                size_t length = MIN(pbRowByte, ofRowByte);
-                for (size_t line = 0; line < ofHeight; line++) {
-                    char* srcAddr = (char*)src + pbRowByte * line;
-                    char* dstAddr = (char*)dst + ofRowByte * line;
-                    memcpy(dstAddr, srcAddr, length);
-                }
-            }
-            ready = true;
+            // src uses CVPixelBuffer stride, dst uses outputFrame stride (bulk copy if same)
+            size_t length = MIN(pbRowByte, ofRowByte);
+            ready = DLABBlit2D(src, pbRowByte, dst, ofRowByte, length, ofHeight,
+                               DLABBlitModeForSize(length * ofHeight));
         }
         CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
     }
@@ -403,6 +602,9 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
         } else {
             // Use DLABVideoConverter/vImage to convert video image
             DLABVideoConverter *converter = self.outputVideoConverter;
+            if (converter && ![converter compatibleWithDL:videoFrame andCV:pixelBuffer]) {
+                converter = nil; // Output setting changed; Cached plan is reused if available
+            }
             if (!converter) {
                 converter = [[DLABVideoConverter alloc] initWithCV:pixelBuffer
                                                               toDL:videoFrame];
@@ -410,6 +612,7 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
                 self.outputVideoConverter = converter;
             }
             if (converter) {
+                converter.threadCount = self.videoConverterThreadCount;
                 ready = [converter convertCV:pixelBuffer toDL:videoFrame];
             }
         }
@@ -424,6 +627,124 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
     }
 }
 
+- (IDeckLinkMutableVideoFrame*) outputVideoFrameWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+{
+    NSParameterAssert(handler);
+    
+    // take out free output frame from frame pool
+    IDeckLinkMutableVideoFrame* videoFrame = [self reserveOutputVideoFrame];
+    if (!videoFrame) return NULL;
+    
+    BOOL pre1403 = checkPre1403(self);
+    BOOL ready = NO;
+    
+    // Keep frame locked for write while handler renders into it
+    IDeckLinkVideoBuffer* videoBuffer = NULL;
+    BMDBufferAccessFlags accessFlags = bmdBufferAccessWrite;
+    if (pre1403 || VideoBufferLockBaseAddress(videoFrame, accessFlags, &videoBuffer)) {
+        void* dst = NULL;
+        if (!pre1403) {
+            VideoBufferGetBaseAddress(videoBuffer, &dst);
+        } else {
+            IDeckLinkMutableVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkMutableVideoFrame_v14_2_1*)videoFrame;
+            videoFrame_v14_2_1->GetBytes(&dst);
+        }
+        if (dst) {
+            ready = handler(dst,
+                            (size_t)videoFrame->GetRowBytes(),
+                            (size_t)videoFrame->GetWidth(),
+                            (size_t)videoFrame->GetHeight(),
+                            (DLABPixelFormat)videoFrame->GetPixelFormat());
+        }
+        if (!pre1403) {
+            VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
+        }
+    }
+    
+    if (ready) {
+        return videoFrame;
+    } else {
+        [self releaseOutputVideoFrame:videoFrame];
+        return NULL;
+    }
+}
+
+// Release callback of DLABExternalVideoBuffer; mapping is kept while device refers it
+static void releaseRawReplaySource(void* context)
+{
+    ((DLABRawReplaySource*)context)->Release();
+}
+
+- (IDeckLinkMutableVideoFrame*) outputVideoFrameWithRawReplaySource:(DLABRawReplaySource*)source
+                                                              index:(uint64_t)index
+                                                            wrapped:(BOOL*)wrapped
+{
+    NSParameterAssert(source && wrapped);
+    *wrapped = NO;
+    
+    IDeckLinkOutput* output = self.deckLinkOutput;
+    DLABVideoSetting* setting = self.outputVideoSetting;
+    if (!output || !setting) return NULL;
+    
+    // Read ahead following frames
+    uint32_t readAheadCount = (uint32_t)MIN(self.rawReplayReadAheadCount, (NSUInteger)UINT32_MAX);
+    const void* src = source->VideoFrameAt(index, readAheadCount, NULL);
+    if (!src) return NULL;
+    
+    int32_t width = (int32_t)setting.width;
+    int32_t height = (int32_t)setting.height;
+    int32_t rowBytes = (int32_t)setting.rowBytes;
+    BMDPixelFormat pixelFormat = setting.pixelFormat;
+    BMDFrameFlags flags = setting.outputFlag;
+    BOOL pre1403 = checkPre1403(self);
+    
+    // Zero-copy - device reads mapped frame directly
+    if (self.rawReplayZeroCopy && !pre1403) {
+        source->AddRef(); // released with videoBuffer
+        DLABExternalVideoBuffer* videoBuffer = new DLABExternalVideoBuffer(src, releaseRawReplaySource, source);
+        IDeckLinkMutableVideoFrame* outFrame = NULL;
+        HRESULT result = output->CreateVideoFrameWithBuffer(width, height, rowBytes, pixelFormat,
+                                                            flags, videoBuffer, &outFrame);
+        videoBuffer->Release(); // outFrame owns videoBuffer
+        if (!result && outFrame) {
+            *wrapped = YES;
+            return outFrame;
+        }
+    }
+    
+    // Single copy into pooled output frame
+    IDeckLinkMutableVideoFrame* videoFrame = [self reserveOutputVideoFrame];
+    if (!videoFrame) return NULL;
+    
+    BOOL ready = NO;
+    BOOL layoutOK = (videoFrame->GetRowBytes() == rowBytes && videoFrame->GetHeight() == height);
+    IDeckLinkVideoBuffer* videoBuffer = NULL;
+    BMDBufferAccessFlags accessFlags = bmdBufferAccessWrite;
+    if (layoutOK && (pre1403 || VideoBufferLockBaseAddress(videoFrame, accessFlags, &videoBuffer))) {
+        void* dst = NULL;
+        if (!pre1403) {
+            VideoBufferGetBaseAddress(videoBuffer, &dst);
+        } else {
+            IDeckLinkMutableVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkMutableVideoFrame_v14_2_1*)videoFrame;
+            videoFrame_v14_2_1->GetBytes(&dst);
+        }
+        if (dst) {
+            memcpy(dst, src, (size_t)rowBytes * (size_t)height);
+            ready = YES;
+        }
+        if (!pre1403) {
+            VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
+        }
+    }
+    
+    if (ready) {
+        return videoFrame;
+    } else {
+        [self releaseOutputVideoFrame:videoFrame];
+        return NULL;
+    }
+}
+
 - (BOOL) validateTimecodeFormat:(DLABTimecodeFormat)format
                    videoSetting:(DLABVideoSetting*)outputVideoSetting
 {
@@ -540,14 +861,97 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
     }
 }
 
+// private experimental - VANC Packet serialization into raw VANC line
+
+NS_INLINE size_t* positionsOfSinkLine(DLABDevice* self, DLABAncillarySink* sink, uint32_t lineNumber) {
+    for (size_t i = 0; i < sink->lineCount; i++) {
+        if (sink->lineNumbers[i] == lineNumber) return sink->positions[i];
+    }
+    if (sink->lineCount >= ancillaryLineMaxLines) return NULL;
+    
+    // First use of the line in this frame; clear it
+    void* buffer = [self bufferOfOutputFrameAncillary:sink->frameAncillary line:lineNumber];
+    if (!buffer || !DLABAncLineClear(buffer, sink->width, sink->format)) return NULL;
+    size_t i = sink->lineCount++;
+    sink->lineNumbers[i] = lineNumber;
+    sink->positions[i][0] = 0;
+    sink->positions[i][1] = 0;
+    return sink->positions[i];
+}
+
+NS_INLINE BOOL prepareAncillarySink(DLABDevice* self, IDeckLinkMutableVideoFrame* outFrame,
+                                    DLABAncillarySink* sink) {
+    memset(sink, 0, sizeof(DLABAncillarySink));
+    if (self.outputVANCLineSerializing) {
+        IDeckLinkVideoFrameAncillary* frameAncillary = [self prepareOutputFrameAncillary:outFrame];
+        if (!frameAncillary) return NO;
+        if (!ancillaryLineFormatOf(frameAncillary, outFrame->GetWidth(), &sink->format, &sink->width)) {
+            frameAncillary->Release();
+            return NO;
+        }
+        sink->frameAncillary = frameAncillary;
+        
+        // Recycled frame may still hold lines of previous use;
+        // lines written by outputVANCHandler are kept unless packet is written there
+        if (!self.outputVANCHandler) {
+            for (NSNumber* num in self.outputVANCLines) {
+                positionsOfSinkLine(self, sink, (uint32_t)num.intValue);
+            }
+        }
+    } else {
+        IDeckLinkVideoFrameAncillaryPackets* frameAncillaryPackets = NULL;
+        outFrame->QueryInterface(IID_IDeckLinkVideoFrameAncillaryPackets,
+                                 (void**)&frameAncillaryPackets);
+        if (!frameAncillaryPackets) return NO;
+        sink->frameAncillaryPackets = frameAncillaryPackets;
+        
+        // Recycled frame may still hold packets of previous use
+        frameAncillaryPackets->DetachAllPackets();
+    }
+    return YES;
+}
+
+NS_INLINE HRESULT attachAncillarySink(DLABDevice* self, DLABAncillarySink* sink,
+                                      IDeckLinkAncillaryPacket* packet) {
+    if (sink->frameAncillaryPackets) {
+        return sink->frameAncillaryPackets->AttachPacket(packet);
+    }
+    
+    const void* ptr = NULL;
+    uint32_t size = 0;
+    HRESULT ret = packet->GetBytes(bmdAncillaryPacketFormatUInt8, &ptr, &size);
+    if (ret != S_OK) return ret;
+    if (size > DLABAncMaxUserDataCount) return E_INVALIDARG;
+    
+    DLABAncStream stream = (packet->GetDataStreamIndex() == 0) ? DLABAncStreamLuma : DLABAncStreamChroma;
+    size_t* positions = positionsOfSinkLine(self, sink, packet->GetLineNumber());
+    if (!positions) return E_FAIL;
+    
+    void* buffer = [self bufferOfOutputFrameAncillary:sink->frameAncillary line:packet->GetLineNumber()];
+    if (!buffer) return E_FAIL;
+    size_t next = DLABAncLineWritePacket(buffer, sink->width, sink->format,
+                                         stream, positions[stream],
+                                         packet->GetDID(), packet->GetSDID(),
+                                         (const uint8_t*)ptr, size);
+    if (!next) return E_OUTOFMEMORY; // line is full
+    positions[stream] = next;
+    return S_OK;
+}
+
+NS_INLINE void releaseAncillarySink(DLABAncillarySink* sink) {
+    if (sink->frameAncillaryPackets) sink->frameAncillaryPackets->Release();
+    if (sink->frameAncillary) sink->frameAncillary->Release();
+    memset(sink, 0, sizeof(DLABAncillarySink));
+}
+
 // private experimental - VANC Packet Playback support
 
-- (void) callbackOutputVANCPacketHandler:(IDeckLinkMutableVideoFrame*)outFrame
+- (void) callbackOutputVANCPacketHandler:(DLABAncillarySink*)sink
                                   atTime:(NSInteger)displayTime
                                 duration:(NSInteger)frameDuration
                              inTimeScale:(NSInteger)timeScale
 {
-    NSParameterAssert(outFrame && frameDuration && timeScale);
+    NSParameterAssert(sink && frameDuration && timeScale);
     
     //
     int64_t frameTime = displayTime;
@@ -560,40 +964,83 @@ NS_INLINE BOOL copyPlaneCVtoDL(DLABDevice* self, CVPixelBufferRef pixelBuffer, I
     
     //
     OutputVANCPacketHandler outHandler = self.outputVANCPacketHandler;
-    if (outHandler) {
-        // Prepare for callback
-        IDeckLinkVideoFrameAncillaryPackets* frameAncillaryPackets = NULL;
-        outFrame->QueryInterface(IID_IDeckLinkVideoFrameAncillaryPackets,
-                                 (void**)&frameAncillaryPackets);
-        if (frameAncillaryPackets) {
-            [self delegate_sync:^{
-                // Callback in delegate queue
-                while (TRUE) {
-                    BOOL ready = FALSE;
-                    DLABAncillaryPacket* packet = new DLABAncillaryPacket();
-                    if (packet) {
-                        uint8_t did = 0;
-                        uint8_t sdid = 0;
-                        uint32_t lineNumber = 0;
-                        uint8_t dataStreamIndex = 0;
-                        NSData* data = outHandler(timingInfo,
-                                                  &did, &sdid, &lineNumber, &dataStreamIndex);
-                        if (data) {
-                            HRESULT ret = packet->Update(did, sdid, lineNumber, dataStreamIndex,
-                                                         data);
-                            if (ret == S_OK) {
-                                ret = frameAncillaryPackets->AttachPacket(packet);
-                            }
-                            ready = (ret == S_OK);
+    DLABAncillaryPacketPool* pool = self.outputAncillaryPacketPool;
+    if (outHandler && pool) {
+        [self delegate_sync:^{
+            // Callback in delegate queue
+            while (TRUE) {
+                BOOL ready = FALSE;
+                DLABAncillaryPacket* packet = pool->Reserve();
+                if (packet) {
+                    uint8_t did = 0;
+                    uint8_t sdid = 0;
+                    uint32_t lineNumber = 0;
+                    uint8_t dataStreamIndex = 0;
+                    NSData* data = outHandler(timingInfo,
+                                              &did, &sdid, &lineNumber, &dataStreamIndex);
+                    if (data) {
+                        HRESULT ret = packet->Update(did, sdid, lineNumber, dataStreamIndex,
+                                                     data);
+                        if (ret == S_OK) {
+                            ret = attachAncillarySink(self, sink, packet);
                         }
-                        delete packet;
+                        ready = (ret == S_OK);
                     }
-                    if (!ready) break;
+                    packet->Release(); // frame keeps its own reference if attached
                 }
-            }];
-            
-            frameAncillaryPackets->Release();
-        }
+                if (!ready) break;
+            }
+        }];
+    }
+}
+
+- (void) callbackOutputVANCPacketWriteHandler:(DLABAncillarySink*)sink
+                                       atTime:(NSInteger)displayTime
+                                     duration:(NSInteger)frameDuration
+                                  inTimeScale:(NSInteger)timeScale
+{
+    NSParameterAssert(sink && frameDuration && timeScale);
+    
+    //
+    int64_t frameTime = displayTime;
+    
+    // Create timinginfo struct
+    CMTime duration = CMTimeMake(frameDuration, (int32_t)timeScale);
+    CMTime presentationTimeStamp = CMTimeMake(frameTime, (int32_t)timeScale);
+    CMTime decodeTimeStamp = kCMTimeInvalid;
+    CMSampleTimingInfo timingInfo = {duration, presentationTimeStamp, decodeTimeStamp};
+    
+    //
+    OutputVANCPacketWriteHandler outHandler = self.outputVANCPacketWriteHandler;
+    DLABAncillaryPacketPool* pool = self.outputAncillaryPacketPool;
+    if (outHandler && pool) {
+        [self delegate_sync:^{
+            // Callback in delegate queue; payload is written into pooled packet
+            while (TRUE) {
+                BOOL ready = FALSE;
+                DLABAncillaryPacket* packet = pool->Reserve();
+                if (packet) {
+                    uint8_t did = 0;
+                    uint8_t sdid = 0;
+                    uint32_t lineNumber = 0;
+                    uint8_t dataStreamIndex = 0;
+                    uint32_t length = 0;
+                    BOOL written = outHandler(timingInfo,
+                                              &did, &sdid, &lineNumber, &dataStreamIndex,
+                                              packet->MutableBytes(), &length);
+                    if (written) {
+                        HRESULT ret = packet->Commit(did, sdid, lineNumber, dataStreamIndex,
+                                                     length);
+                        if (ret == S_OK) {
+                            ret = attachAncillarySink(self, sink, packet);
+                        }
+                        ready = (ret == S_OK);
+                    }
+                    packet->Release(); // frame keeps its own reference if attached
+                }
+                if (!ready) break;
+            }
+        }];
     }
 }
 
@@ -965,12 +1412,25 @@ static DLABFrameMetadata * processCallbacks(DLABDevice *self, IDeckLinkMutableVi
                             inTimeScale:timeScale];
     }
     
-    // Callback VANCPacketHandler block
-    if (self.outputVANCPacketHandler) {
-        [self callbackOutputVANCPacketHandler:outFrame
-                                       atTime:displayTime
-                                     duration:frameDuration
-                                  inTimeScale:timeScale];
+    // Callback VANCPacketHandler/VANCPacketWriteHandler blocks; both write into one sink
+    // so packets of the former are kept when the latter writes into the same line
+    if (self.outputVANCPacketHandler || self.outputVANCPacketWriteHandler) {
+        DLABAncillarySink sink;
+        if (prepareAncillarySink(self, outFrame, &sink)) {
+            if (self.outputVANCPacketHandler) {
+                [self callbackOutputVANCPacketHandler:&sink
+                                               atTime:displayTime
+                                             duration:frameDuration
+                                          inTimeScale:timeScale];
+            }
+            if (self.outputVANCPacketWriteHandler) {
+                [self callbackOutputVANCPacketWriteHandler:&sink
+                                                    atTime:displayTime
+                                                  duration:frameDuration
+                                               inTimeScale:timeScale];
+            }
+            releaseAncillarySink(&sink);
+        }
     }
     
     // Callback OutputFrameMetadataHandler block
@@ -1072,6 +1532,7 @@ static DLABFrameMetadata * processCallbacks(DLABDevice *self, IDeckLinkMutableVi
         processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
         
         // async display
+        recordScheduledFrame(self, outFrame, displayTime, frameDuration, timeScale);
         result = output->ScheduleVideoFrame(outFrame, displayTime, frameDuration, timeScale);
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
@@ -1162,6 +1623,7 @@ static DLABFrameMetadata * processCallbacks(DLABDevice *self, IDeckLinkMutableVi
                 processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
                 
                 // async display
+                recordScheduledFrame(self, outFrame, displayTime, frameDuration, timeScale);
                 result = output->ScheduleVideoFrame(outFrame, displayTime, frameDuration, timeScale);
                 if (result) {
                     reason = @"IDeckLinkOutput::ScheduleVideoFrame failed";
@@ -1195,48 +1657,266 @@ static DLABFrameMetadata * processCallbacks(DLABDevice *self, IDeckLinkMutableVi
     }
 }
 
-- (NSNumber*) getBufferedVideoFrameCountWithError:(NSError**)error
+- (BOOL) instantPlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    error:(NSError**)error
 {
-    __block HRESULT result = E_FAIL;
-    __block uint32_t bufferedFrameCount = 0;
+    NSParameterAssert(handler);
     
     IDeckLinkOutput *output = self.deckLinkOutput;
-    if (output) {
-        [self playback_sync:^{
-            result = output->GetBufferedVideoFrameCount(&bufferedFrameCount);
-        }];
-    } else {
+    if (!output) {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
             reason:@"IDeckLinkOutput is not supported."
               code:E_NOINTERFACE
                 to:error];
-        return nil;
+        return NO;
+    }
+    
+    // Render in place into output frame
+    IDeckLinkMutableVideoFrame* outFrame = [self outputVideoFrameWithRenderHandler:handler];
+    if (!outFrame) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"DLABDevice - outputVideoFrameWithRenderHandler: failed."
+              code:paramErr
+                to:error];
+        return NO;
     }
     
+    // dummy Time/Duration/TimeScale values
+    NSInteger displayTime = 0;
+    NSInteger frameDuration = self.outputVideoSetting.duration;
+    NSInteger timeScale = self.outputVideoSetting.timeScale;
+    
+    // process callbacks
+    processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
+    
+    // sync display - blocking operation
+    HRESULT result = output->DisplayVideoFrameSync(outFrame);
+    
+    // free output frame
+    [self releaseOutputVideoFrame:outFrame];
+    
     if (!result) {
-        return @(bufferedFrameCount);
+        return YES;
     } else {
         [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
-            reason:@"IDeckLinkOutput::GetBufferedVideoFrameCount failed."
+            reason:@"IDeckLinkOutput::DisplayVideoFrameSync failed."
               code:result
                 to:error];
-        return nil;
+        return NO;
     }
 }
 
-/* =================================================================================== */
-// MARK: Audio
-/* =================================================================================== */
-
-- (BOOL) enableAudioOutputWithAudioSetting:(DLABAudioSetting*)setting
+- (BOOL) schedulePlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    atTime:(NSInteger)displayTime
+                                  duration:(NSInteger)frameDuration
+                               inTimeScale:(NSInteger)timeScale
                                      error:(NSError**)error
 {
-    NSParameterAssert(setting);
+    NSParameterAssert(handler && frameDuration && timeScale);
     
-    if (self.swapHDMICh3AndCh4OnOutput != nil) {
-        NSError *err = nil;
-        BOOL newValue = self.swapHDMICh3AndCh4OnOutput.boolValue;
-        DLABConfiguration key = DLABConfigurationSwapHDMICh3AndCh4OnOutput;
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    if (!output) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    
+    // Render in place into output frame
+    IDeckLinkMutableVideoFrame* outFrame = [self outputVideoFrameWithRenderHandler:handler];
+    if (!outFrame) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"DLABDevice - outputVideoFrameWithRenderHandler: failed."
+              code:paramErr
+                to:error];
+        return NO;
+    }
+    
+    // process callbacks
+    processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
+    
+    // async display
+    recordScheduledFrame(self, outFrame, displayTime, frameDuration, timeScale);
+    HRESULT result = output->ScheduleVideoFrame(outFrame, displayTime, frameDuration, timeScale);
+    
+    if (!result) {
+        return YES;
+    } else {
+        [self releaseOutputVideoFrame:outFrame];
+        
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::ScheduleVideoFrame failed."
+              code:result
+                to:error];
+        return NO;
+    }
+}
+
+- (BOOL) schedulePlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    atTime:(NSInteger)displayTime
+                                  duration:(NSInteger)frameDuration
+                               inTimeScale:(NSInteger)timeScale
+                           timecodeSetting:(DLABTimecodeSetting*)timecodeSetting
+                                     error:(NSError**)error
+{
+    NSParameterAssert(handler && frameDuration && timeScale && timecodeSetting);
+    
+    // Validate timecode format and outputVideoSetting combination
+    DLABVideoSetting *videoSetting = self.outputVideoSetting;
+    if (!videoSetting || ![self validateTimecodeFormat:timecodeSetting.format
+                                          videoSetting:videoSetting]) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Unsupported timecode settings detected."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    if (!output) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    
+    // Render in place into output frame
+    IDeckLinkMutableVideoFrame* outFrame = [self outputVideoFrameWithRenderHandler:handler];
+    if (!outFrame) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"DLABDevice - outputVideoFrameWithRenderHandler: failed."
+              code:paramErr
+                to:error];
+        return NO;
+    }
+    
+    NSString* reason = nil;
+    HRESULT result = outFrame->SetTimecodeFromComponents(timecodeSetting.format,
+                                                         timecodeSetting.hour,
+                                                         timecodeSetting.minute,
+                                                         timecodeSetting.second,
+                                                         timecodeSetting.frame,
+                                                         timecodeSetting.flags);
+    if (!result) {
+        result = outFrame->SetTimecodeUserBits(timecodeSetting.format, timecodeSetting.userBits);
+        if (!result) {
+            // process callbacks
+            processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
+            
+            // async display
+            recordScheduledFrame(self, outFrame, displayTime, frameDuration, timeScale);
+            result = output->ScheduleVideoFrame(outFrame, displayTime, frameDuration, timeScale);
+            if (result) {
+                reason = @"IDeckLinkOutput::ScheduleVideoFrame failed";
+            }
+        } else {
+            reason = @"IDeckLinkMutableVideoFrame::SetTimecodeUserBits failed";
+        }
+    } else {
+        reason = @"IDeckLinkMutableVideoFrame::SetTimecodeFromComponents failed.";
+    }
+    
+    if (!result) {
+        return YES;
+    } else {
+        [self releaseOutputVideoFrame:outFrame];
+        
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:reason
+              code:result
+                to:error];
+        return NO;
+    }
+}
+
+- (NSNumber*) getBufferedVideoFrameCountWithError:(NSError**)error
+{
+    __block HRESULT result = E_FAIL;
+    __block uint32_t bufferedFrameCount = 0;
+    
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    if (output) {
+        [self playback_sync:^{
+            result = output->GetBufferedVideoFrameCount(&bufferedFrameCount);
+        }];
+    } else {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return nil;
+    }
+    
+    if (!result) {
+        return @(bufferedFrameCount);
+    } else {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::GetBufferedVideoFrameCount failed."
+              code:result
+                to:error];
+        return nil;
+    }
+}
+
+- (BOOL) prewarmOutputVideoFramePoolWithCount:(NSUInteger)count error:(NSError**)error
+{
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (!self.deckLinkOutput || !self.outputVideoSetting || !pool) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Video output is not enabled."
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+    
+    NSUInteger target = MIN(count, (NSUInteger)pool->Capacity());
+    @synchronized (self) {
+        NSUInteger current = pool->Count();
+        if (current < target) {
+            [self expandOutputVideoFramePoolBy:(target - current)];
+        }
+    }
+    
+    if (pool->Count() < target) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::CreateVideoFrame failed."
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+    return YES;
+}
+
+- (NSUInteger) shrinkOutputVideoFramePoolToCount:(NSUInteger)count
+{
+    DLABFramePool* pool = self.outputVideoFramePool;
+    if (!pool) return 0;
+    
+    @synchronized (self) {
+        while (pool->Count() > count) {
+            IDeckLinkMutableVideoFrame *outFrame = (IDeckLinkMutableVideoFrame*)pool->Shrink();
+            if (!outFrame) break; // remaining frames are in use
+            outFrame->Release();
+        }
+    }
+    return pool->Count();
+}
+
+/* =================================================================================== */
+// MARK: Audio
+/* =================================================================================== */
+
+- (BOOL) enableAudioOutputWithAudioSetting:(DLABAudioSetting*)setting
+                                     error:(NSError**)error
+{
+    NSParameterAssert(setting);
+    
+    if (self.swapHDMICh3AndCh4OnOutput != nil) {
+        NSError *err = nil;
+        BOOL newValue = self.swapHDMICh3AndCh4OnOutput.boolValue;
+        DLABConfiguration key = DLABConfigurationSwapHDMICh3AndCh4OnOutput;
         
         // Verify if SwapHDMICh3AndCh4 flag is available on this device
         [self boolValueForConfiguration:key error:&err];
@@ -1762,6 +2442,393 @@ static DLABFrameMetadata * processCallbacks(DLABDevice *self, IDeckLinkMutableVi
     }
 }
 
+/* =================================================================================== */
+// MARK: Audio ring (experimental)
+/* =================================================================================== */
+
+- (BOOL) enableOutputAudioRingWithCapacity:(NSUInteger)capacity
+                                    atTime:(NSInteger)streamTime
+                                     error:(NSError**)error
+{
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    DLABAudioSetting *setting = self.outputAudioSetting;
+    if (!output || !setting) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Either IDeckLinkOutput or DLABAudioSetting is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    if (capacity == 0 || capacity > INT32_MAX) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Invalid audio ring capacity."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    if (self.outputAudioRingEnabled) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Audio ring is already enabled."
+              code:E_ACCESSDENIED
+                to:error];
+        return NO;
+    }
+    
+    // Reuse current ring if it fits and no other thread still refers it; ring is quiescent then,
+    // as callback is not subscribed and writer finds outputAudioRingEnabled NO.
+    uint32_t bytesPerFrame = setting.sampleSize;
+    BOOL reusable = NO;
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        reusable = (ring && ring->BytesPerFrame() == bytesPerFrame && ring->Capacity() >= capacity &&
+                    ring->RefCount() == 1);
+        if (reusable) ring->Reset();
+    }
+    if (!reusable) {
+        DLABAudioRing* ring = new DLABAudioRing((uint32_t)capacity, bytesPerFrame);
+        if (ring->Capacity() == 0) {
+            ring->Release();
+            [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+                reason:@"Failed to allocate audio ring."
+                  code:E_OUTOFMEMORY
+                    to:error];
+            return NO;
+        }
+        self.outputAudioRing = ring; // previous one is released when last user releases it
+        ring->Release();
+    }
+    self.outputAudioRingStreamTime = streamTime;
+    self.outputAudioRingDeviceBufferedLevel = 0;
+    
+    // Let RenderAudioSamples drain the ring
+    __block BOOL result = NO;
+    [self playback_sync:^{
+        self.outputAudioRingEnabled = YES;
+        result = [self subscribeOutputAudio:YES];
+        if (!result) self.outputAudioRingEnabled = NO;
+    }];
+    
+    if (result) {
+        return YES;
+    } else {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::SetAudioCallback failed."
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+}
+
+- (BOOL) disableOutputAudioRingWithError:(NSError**)error
+{
+    if (!self.deckLinkOutput) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    if (!self.outputAudioRingEnabled) return YES;
+    
+    // Ring is kept for reuse; released on dealloc or replacement
+    __block BOOL result = NO;
+    [self playback_sync:^{
+        result = [self subscribeOutputAudio:NO];
+        self.outputAudioRingEnabled = NO;
+    }];
+    
+    if (result) {
+        return YES;
+    } else {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::SetAudioCallback failed."
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+}
+
+- (NSUInteger) writeOutputAudioRingFromAudioBufferList:(AudioBufferList*)audioBufferList
+{
+    NSParameterAssert(audioBufferList);
+    
+    DLABAudioRing* ring = retainOutputAudioRing(self);
+    if (!ring) return 0;
+    
+    NSUInteger written = 0;
+    DLABAudioSetting *setting = self.outputAudioSetting;
+    if (self.outputAudioRingEnabled && setting) {
+        // Accept only interleaved buffer; non-interleaved list has one buffer per channel
+        AudioBuffer ab = audioBufferList->mBuffers[0];
+        BOOL interleaved = (audioBufferList->mNumberBuffers == 1 &&
+                            ab.mNumberChannels == setting.channelCount);
+        if (interleaved && ab.mDataByteSize && ab.mData) {
+            uint32_t sampleFrameCount = ab.mDataByteSize / ring->BytesPerFrame();
+            written = ring->Write(ab.mData, sampleFrameCount);
+        }
+    }
+    ring->Release();
+    return written;
+}
+
+- (NSUInteger) writeOutputAudioRingBytes:(const void*)bytes frameCount:(NSUInteger)frameCount
+{
+    NSParameterAssert(bytes);
+    
+    DLABAudioRing* ring = retainOutputAudioRing(self);
+    if (!ring) return 0;
+    
+    NSUInteger written = 0;
+    if (self.outputAudioRingEnabled) {
+        uint32_t sampleFrameCount = (uint32_t)MIN(frameCount, (NSUInteger)UINT32_MAX);
+        written = ring->Write(bytes, sampleFrameCount);
+    }
+    ring->Release();
+    return written;
+}
+
+- (void) resetOutputAudioRingStatistics
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        if (ring) {
+            ring->ResetStatistics();
+        }
+    }
+}
+
+/* =================================================================================== */
+// MARK: Output scheduler (experimental)
+/* =================================================================================== */
+
+- (BOOL) startOutputSchedulerWithTargetDepth:(NSUInteger)targetDepth
+                                       error:(NSError**)error
+{
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    DLABVideoSetting *setting = self.outputVideoSetting;
+    if (!output || !setting) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Either IDeckLinkOutput or DLABVideoSetting is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    if (self.outputSchedulerRunning) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Output scheduler is already running."
+              code:E_ACCESSDENIED
+                to:error];
+        return NO;
+    }
+    
+    DLABPlaybackScheduler* scheduler = [self prepareOutputScheduler];
+    if (scheduler->QueuedCount() == 0) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"No pixel buffer is enqueued."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    
+    // Timeline starts at frame 0
+    uint32_t depth = (uint32_t)MIN(MAX(targetDepth, (NSUInteger)1), (NSUInteger)outputSchedulerMaxTargetDepth);
+    scheduler->Start(setting.duration, depth, 0);
+    self.outputSchedulerRunning = YES;
+    
+    // Automatic preroll
+    [self fillOutputScheduler];
+    
+    NSError *err = nil;
+    BOOL result = [self startScheduledPlaybackAtTime:0
+                                         inTimeScale:(NSUInteger)setting.timeScale
+                                               error:&err];
+    if (!result) {
+        self.outputSchedulerRunning = NO;
+        scheduler->Stop();
+        if (error) *error = err;
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL) stopOutputSchedulerWithError:(NSError**)error
+{
+    if (!self.outputSchedulerRunning) return YES;
+    
+    // No refill after this point; remaining frames are flushed
+    self.outputSchedulerRunning = NO;
+    BOOL result = [self stopScheduledPlaybackWithError:error];
+    
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    if (scheduler) {
+        scheduler->Stop();
+    }
+    return result;
+}
+
+- (BOOL) enqueueOutputPixelBuffer:(CVPixelBufferRef)pixelBuffer
+                            error:(NSError**)error
+{
+    NSParameterAssert(pixelBuffer);
+    
+    DLABPlaybackScheduler* scheduler = [self prepareOutputScheduler];
+    CFRetain(pixelBuffer);
+    if (scheduler->Enqueue((void*)pixelBuffer)) {
+        return YES;
+    } else {
+        CFRelease(pixelBuffer);
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Output scheduler queue is full."
+              code:E_ACCESSDENIED
+                to:error];
+        return NO;
+    }
+}
+
+- (void) resetOutputSchedulerStatistics
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    if (scheduler) {
+        scheduler->ResetStatistics();
+    }
+}
+
+/* =================================================================================== */
+// MARK: Raw replay (experimental)
+/* =================================================================================== */
+
+- (BOOL) openRawReplayAtURL:(NSURL*)url
+                      error:(NSError**)error
+{
+    NSParameterAssert(url);
+    
+    DLABVideoSetting* setting = self.outputVideoSetting;
+    if (!url.isFileURL || !setting) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Either file URL or output DLABVideoSetting is not available."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    
+    DLABRawReplaySource* source = new DLABRawReplaySource();
+    int err = source->Open(url.fileSystemRepresentation);
+    if (err) {
+        source->Release();
+        NSString* reason = [NSString stringWithFormat:@"DLABRawReplaySource::Open failed. (%s)", strerror(err)];
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:reason
+              code:E_FAIL
+                to:error];
+        return NO;
+    }
+    
+    // Mapped frame is used as is; layout should match output frame
+    const DLABRawRecorder::VideoFormat& video = source->Header().video;
+    BOOL layoutOK = (video.width == (uint32_t)setting.width &&
+                     video.height == (uint32_t)setting.height &&
+                     video.pixelFormat == (uint32_t)setting.pixelFormat &&
+                     video.rowBytes == (uint32_t)setting.rowBytes);
+    if (!layoutOK) {
+        source->Release();
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Video format of raw replay file does not match outputVideoSetting."
+              code:E_INVALIDARG
+                to:error];
+        return NO;
+    }
+    
+    DLABRawReplaySource* oldSource = NULL;
+    @synchronized (self) {
+        oldSource = self.outputRawReplaySource;
+        self.outputRawReplaySource = source;
+    }
+    if (oldSource) {
+        oldSource->Release(); // unmapped when in-flight frames are completed
+    }
+    return YES;
+}
+
+- (void) closeRawReplay
+{
+    DLABRawReplaySource* oldSource = NULL;
+    @synchronized (self) {
+        oldSource = self.outputRawReplaySource;
+        self.outputRawReplaySource = NULL;
+    }
+    if (oldSource) {
+        oldSource->Release(); // unmapped when in-flight frames are completed
+    }
+}
+
+- (BOOL) scheduleRawReplayVideoFrameAtIndex:(uint64_t)index
+                                     atTime:(NSInteger)displayTime
+                                   duration:(NSInteger)frameDuration
+                                inTimeScale:(NSInteger)timeScale
+                                      error:(NSError**)error
+{
+    NSParameterAssert(frameDuration && timeScale);
+    
+    IDeckLinkOutput *output = self.deckLinkOutput;
+    if (!output) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput is not supported."
+              code:E_NOINTERFACE
+                to:error];
+        return NO;
+    }
+    
+    DLABRawReplaySource* source = NULL;
+    @synchronized (self) {
+        source = self.outputRawReplaySource;
+        if (source) source->AddRef();
+    }
+    if (!source) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"Raw replay file is not opened."
+              code:E_ACCESSDENIED
+                to:error];
+        return NO;
+    }
+    
+    BOOL wrapped = NO;
+    IDeckLinkMutableVideoFrame* outFrame = [self outputVideoFrameWithRawReplaySource:source
+                                                                               index:index
+                                                                             wrapped:&wrapped];
+    source->Release();
+    if (!outFrame) {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"DLABDevice - outputVideoFrameWithRawReplaySource: failed."
+              code:paramErr
+                to:error];
+        return NO;
+    }
+    
+    // process callbacks
+    processCallbacks(self, outFrame, displayTime, frameDuration, timeScale);
+    
+    // async display
+    recordScheduledFrame(self, outFrame, displayTime, frameDuration, timeScale);
+    HRESULT result = output->ScheduleVideoFrame(outFrame, displayTime, frameDuration, timeScale);
+    
+    // Wrapped frame is not pooled; device keeps its own reference until completion
+    if (wrapped) {
+        outFrame->Release();
+    } else if (result) {
+        [self releaseOutputVideoFrame:outFrame];
+    }
+    
+    if (!result) {
+        return YES;
+    } else {
+        [self post:[NSString stringWithFormat:@"%s (%d)", __PRETTY_FUNCTION__, __LINE__]
+            reason:@"IDeckLinkOutput::ScheduleVideoFrame failed."
+              code:result
+                to:error];
+        return NO;
+    }
+}
+
 /* =================================================================================== */
 // MARK: Stream
 /* =================================================================================== */
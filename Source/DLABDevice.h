@@ -20,6 +20,76 @@
 @class DLABProfileAttributes;
 @class DLABFrameMetadata;
 @class DLABDeckControl;
+@class DLABAncillaryPacketBatch;
+
+/* =================================================================================== */
+// MARK: - Capture latency instrumentation (experimental)
+/* =================================================================================== */
+
+/**
+ Stages of capture pipeline measured by DLABDevice latency instrumentation.
+ */
+typedef NS_ENUM(NSUInteger, DLABCaptureLatencyStage) {
+    DLABCaptureLatencyStageDriverArrival = 0,       // Hardware timestamp of frame => Input callback
+    DLABCaptureLatencyStagePixelBufferAllocation,   // CVPixelBufferPoolCreatePixelBuffer()
+    DLABCaptureLatencyStageCopyConvert,             // Copy or convert image into CVPixelBuffer
+    DLABCaptureLatencyStageAncillaryHandler,        // VANC/VANCPacket/FrameMetadata handlers
+    DLABCaptureLatencyStageSampleBufferCreate,      // CMSampleBufferCreateReadyWithImageBuffer()
+    DLABCaptureLatencyStageDelegateDispatch,        // Enqueue => Start on delegate queue
+    DLABCaptureLatencyStageDelegateCallback,        // processCapturedVideoSample:... call
+    DLABCaptureLatencyStageTotal,                   // Input callback => Start on delegate queue
+    DLABCaptureLatencyStageCount
+};
+
+/* =================================================================================== */
+// MARK: - Playback telemetry (experimental)
+/* =================================================================================== */
+
+/**
+ Measurements of output frame completion, on hardware reference clock.
+ */
+typedef NS_ENUM(NSUInteger, DLABPlaybackLatencyStage) {
+    DLABPlaybackLatencyStageScheduleToAir = 0,      // ScheduleVideoFrame => Frame completion
+    DLABPlaybackLatencyStageTimingError,            // |Actual - expected completion| on display timeline
+    DLABPlaybackLatencyStageInterval,               // Frame completion => Next frame completion
+    DLABPlaybackLatencyStageCount
+};
+
+/**
+ Completion of one output video frame. Times are nanoseconds of hardware reference clock.
+ */
+typedef struct {
+    DLABOutputFrameCompletionResult result;
+    int64_t displayTime;            // Scheduled display time in timeScale. 0 if unknown.
+    int64_t frameDuration;          // Scheduled duration in timeScale. 0 if unknown.
+    int64_t timeScale;              // 0 if unknown.
+    int64_t completionTime;         // GetFrameCompletionReferenceTimestamp(). 0 if unavailable.
+    int64_t scheduleToAir;          // ScheduleVideoFrame => Frame completion. 0 if unavailable.
+    int64_t timingError;            // Actual - expected completion (signed). 0 if unavailable.
+} DLABOutputFrameCompletion;
+
+/* =================================================================================== */
+
+/**
+ Policy of capture delegate queue when in-flight video samples reach the limit.
+ Audio samples are never dropped.
+ */
+typedef NS_ENUM(NSUInteger, DLABDelegateQueueDropPolicy) {
+    DLABDelegateQueueDropPolicyNone = 0,            // Unlimited (default)
+    DLABDelegateQueueDropPolicyDropOldestVideo = 1, // Drop oldest pending video sample
+    DLABDelegateQueueDropPolicyDropNewestVideo = 2, // Drop incoming video frame
+};
+
+/**
+ Snapshot of latency histogram. All values are in nanoseconds.
+ */
+typedef struct {
+    uint64_t count;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t max;
+    uint64_t mean;
+} DLABLatencySnapshot;
 
 /* =================================================================================== */
 /*
@@ -39,10 +109,6 @@
  : 2.5.49 IDeskLinkMetalScreenPreviewHelper
  : 2.5.50 IDeckLinkWPFDX9ScreenPreviewHelper
  : 2.5.51 IDeckLinkMacOutput
- : 2.5.52 IDeckLinkMacVideoBuffer
- : 2.5.53 IDeckLinkVideoBuffer
- : 2.5.54 IDeckLinkVideoBufferAllocatorProvider
- : 2.5.55 IDeckLinkVideoBufferAllocator
  : 2.5.57 IDeckLinkIPExtensions
  : 2.5.58 IDeckLinkIPFlowIterator
  : 2.5.59 IDeckLinkIPFlow
@@ -286,6 +352,19 @@ typedef BOOL (^InputVANCPacketHandler) (CMSampleTimingInfo timingInfo,
                                         uint8_t dataStreamIndex,
                                         NSData* data);
 
+/**
+ Experimental VANC Packet support : batched VANC Capture callback block
+ 
+ This block is called async on delegate queue, once per input video frame.
+ Every VANC packet of the frame is copied once into single batch object.
+ Keep the batch as long as required; its storage is recycled on dealloc.
+ 
+ - input : This block is queued prior to inputVideoSample delegate call is queued
+ 
+ @param batch All VANC packets of the Video Input Frame, with timingInfo.
+ */
+typedef void (^InputVANCPacketBatchHandler) (DLABAncillaryPacketBatch* batch);
+
 /**
  Experimental VANC Packet support : VANC Playback callback block
  
@@ -306,6 +385,32 @@ typedef NSData* _Nullable (^OutputVANCPacketHandler) (CMSampleTimingInfo timingI
                                                       uint8_t* sdid,
                                                       uint32_t* lineNumber,
                                                       uint8_t* dataStreamIndex);
+
+/**
+ Experimental VANC Packet support : VANC Playback callback block with direct write
+ 
+ This block is called in sync on delegate queue. You should process immediately.
+ Sequence of callback will be triggered until you returned FALSE (when you finish all of VANC packets).
+ Write payload into buffer directly; no NSData is required. Packets are recycled per device.
+ 
+ - output : This block is called prior to outputVideoFrame is scheduled
+ 
+ @param timingInfo TimingInfo of Video Output Frame
+ @param did Data ID (DID) for ancillary packet.
+ @param sdid Secondary Data ID (SDID) for ancillary packet.
+ @param lineNumber lineNumber of VANC buffer.
+ @param dataStreamIndex the data stream index for ancillary packet.
+ @param buffer Payload buffer in bmdAncillaryPacketFormatUInt8 format. Capacity is 255 bytes.
+ @param length Payload length written into buffer (0 ... 255).
+ @return Return FALSE if no packet is written (futher call is not required).
+ */
+typedef BOOL (^OutputVANCPacketWriteHandler) (CMSampleTimingInfo timingInfo,
+                                              uint8_t* did,
+                                              uint8_t* sdid,
+                                              uint32_t* lineNumber,
+                                              uint8_t* dataStreamIndex,
+                                              uint8_t* buffer,
+                                              uint32_t* length);
 NS_ASSUME_NONNULL_END
 
 /* =================================================================================== */
@@ -341,6 +446,36 @@ typedef BOOL (^OutputFrameMetadataHandler) (CMSampleTimingInfo timingInfo,
 typedef void (^InputFrameMetadataHandler) (CMSampleTimingInfo timingInfo,
                                            DLABFrameMetadata* frameMetadata);
 
+/**
+ Experimental playback telemetry: frame completion callback block
+ 
+ This block is called async on delegate queue, once per completed output video frame.
+ Called only while playbackTelemetryEnabled is YES.
+ 
+ @param completion Completion of Output Video Frame.
+ */
+typedef void (^OutputFrameCompletionHandler) (DLABOutputFrameCompletion completion);
+
+/**
+ Experimental in-place rendering: output video frame render callback block
+ 
+ This block is called in sync on caller's thread, while pooled output frame is locked
+ for write (IDeckLinkVideoBuffer::StartAccess/EndAccess). Render image directly in
+ DeckLink native layout of outputVideoSetting. Do not refer baseAddress after return.
+ 
+ @param baseAddress Writable base address of output frame
+ @param rowBytes Row bytes of output frame
+ @param width Width of output frame in pixels
+ @param height Height of output frame in lines
+ @param pixelFormat Pixel format of output frame
+ @return Return FALSE to cancel playback of this frame.
+ */
+typedef BOOL (^OutputVideoFrameRenderHandler) (void* baseAddress,
+                                               size_t rowBytes,
+                                               size_t width,
+                                               size_t height,
+                                               DLABPixelFormat pixelFormat);
+
 NS_ASSUME_NONNULL_END
 
 /* =================================================================================== */
@@ -570,11 +705,37 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, copy, nullable) InputVANCPacketHandler inputVANCPacketHandler;
 
+/**
+ Experimental VANC Packet Capture support: Caller should populate batched VANC Packet callback block.
+ Unlike inputVANCPacketHandler, this does not block capture thread.
+ */
+@property (nonatomic, copy, nullable) InputVANCPacketBatchHandler inputVANCPacketBatchHandler;
+
 /**
  Experimental VANC Packet Output support: Caller should populate VANC Packet callback block.
  */
 @property (nonatomic, copy, nullable) OutputVANCPacketHandler outputVANCPacketHandler;
 
+/**
+ Experimental VANC Packet Output support: Caller should populate VANC Packet direct write callback block.
+ When both are populated, outputVANCPacketHandler is called first.
+ */
+@property (nonatomic, copy, nullable) OutputVANCPacketWriteHandler outputVANCPacketWriteHandler;
+
+/**
+ Experimental VANC Packet Capture support: Parse raw VANC lines of inputVANCLines for inputVANCPacketBatchHandler.
+ When YES, SMPTE 291 packets are scanned from v210/2vuy line buffer instead of driver-decoded packets.
+ Packets with invalid parity or checksum are skipped.
+ */
+@property (nonatomic, assign) BOOL inputVANCLineParsing;
+
+/**
+ Experimental VANC Packet Output support: Serialize packets from VANC Packet callback blocks into raw VANC lines.
+ When YES, each packet is written into v210/2vuy line buffer of its lineNumber instead of being attached to the frame.
+ Use dataStreamIndex 0 for luma (or SD) stream, and 1 for HD chroma stream.
+ */
+@property (nonatomic, assign) BOOL outputVANCLineSerializing;
+
 /* =================================================================================== */
 // MARK: (Public) - HDR Metadata support (experimental)
 /* =================================================================================== */
@@ -616,6 +777,410 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong, readwrite, nullable) NSDictionary *inputPixelBufferAttributes;
 
+/* =================================================================================== */
+// MARK: (Public) - Zero-copy capture support (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Let DeckLink DMA captured frame directly into pooled CVPixelBuffer.
+ 
+ Effective on next enableVideoInput call. Requires DeckLink API 14.3 or later.
+ Only native pixel formats (2vuy, v210, BGRA) are supported; others are copied/converted as usual.
+ inputPixelBufferAttributes is also applied to this pool.
+ */
+@property (nonatomic, assign) BOOL useZeroCopyCapture;
+
+/**
+ Experimental - Bytes copied or converted into CVPixelBuffer for last captured video frame.
+ 
+ 0 if the frame is captured with zero-copy. Reset on enableVideoInput call.
+ */
+@property (atomic, assign, readonly) uint64_t inputVideoCopiedBytesPerFrame;
+
+/**
+ Experimental - Total bytes copied or converted into CVPixelBuffer since enableVideoInput call.
+ */
+@property (atomic, assign, readonly) uint64_t inputVideoCopiedByteCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Streaming copy support (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Copy captured frame into CVPixelBuffer using non-temporal (streaming) stores.
+ 
+ Destination stores bypass CPU cache, but source reads still fill it, so working set of
+ other threads is evicted in every mode; DLABCacheFootprintBench shows similar slowdown of
+ the victim after cached, prefetch and streaming copy. Streaming copy itself is slower
+ (about 3.4-3.7 GB/s against 10.8 GB/s of cached copy for 2160p 'v210' on one test host),
+ so measure before enabling. Only worth trying when pixel buffer goes to hardware encoder
+ or disk without CPU access.
+ Default is NO (cached copy, with source prefetch for large frames).
+ */
+@property (nonatomic, assign) BOOL useStreamingCaptureCopy;
+
+/* =================================================================================== */
+// MARK: (Public) - Parallel video conversion support (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Number of threads used by DLABVideoConverter.
+ 
+ Frame is split into horizontal bands which are converted in parallel.
+ Default is 1 (single thread). Set 0 to use active processor count, or a small
+ count; with several capturing devices, keep the total within available cores.
+ */
+@property (nonatomic, assign) NSUInteger videoConverterThreadCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Video conversion plan cache (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Maximum number of prepared video conversion plans in process-wide cache.
+ 
+ Conversion plan (YpCbCr conversion info, vImageConverter objects and scratch buffers)
+ is shared by every DLABDevice, and reused when DLABVideoConverter is recreated for
+ same configuration. Least recently used plan is evicted. Default is 4. Set 0 to disable.
+ */
+@property (class, nonatomic, assign) NSUInteger videoConversionPlanCacheCapacity;
+
+/**
+ Experimental - Number of DLABVideoConverter prepared with cached plan.
+ */
+@property (class, nonatomic, assign, readonly) NSUInteger videoConversionPlanCacheHitCount;
+
+/**
+ Experimental - Number of DLABVideoConverter which required new plan.
+ */
+@property (class, nonatomic, assign, readonly) NSUInteger videoConversionPlanCacheMissCount;
+
+/**
+ Experimental - Remove every plan from process-wide cache, and reset statistics.
+ */
++ (void) purgeVideoConversionPlanCache;
+
+/**
+ Experimental - Prepare video conversion plans for expected capture modes in advance.
+ 
+ Only settings which require DLABVideoConverter are prepared; i.e. cvPixelFormatType
+ differs from pixelFormat, and no SIMD fast path is available.
+ 
+ @param settings Array of DLABVideoSetting. cvPixelFormatType should be set.
+ @return Number of settings which are ready for capture.
+ */
++ (NSUInteger) prewarmVideoConversionForInputSettings:(NSArray<DLABVideoSetting*>*)settings;
+
+/**
+ Experimental - Prepare video conversion plans for expected playback modes in advance.
+ 
+ Source CVPixelBuffer is supposed to have extensions of DLABVideoSetting as attachments.
+ 
+ @param settings Array of DLABVideoSetting. cvPixelFormatType should be set.
+ @return Number of settings which are ready for playback.
+ */
++ (NSUInteger) prewarmVideoConversionForOutputSettings:(NSArray<DLABVideoSetting*>*)settings;
+
+/* =================================================================================== */
+// MARK: (Public) - Audio block pool support (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Number of captured audio packets served from recycled memory block.
+ 
+ Reset when audio input is enabled.
+ */
+@property (nonatomic, assign, readonly) uint64_t inputAudioBlockPoolHitCount;
+
+/**
+ Experimental - Number of captured audio packets which required new memory block.
+ 
+ Increases when consumer holds too many audio sample buffers, or packet is too large.
+ Reset when audio input is enabled.
+ */
+@property (nonatomic, assign, readonly) uint64_t inputAudioBlockPoolMissCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Capture latency instrumentation (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Record per-stage latency of captured video frames.
+ 
+ When disabled (default), no timestamp is taken on capture path.
+ Recorded histograms are kept while disabled; use resetCaptureLatency to clear.
+ */
+@property (nonatomic, assign) BOOL captureLatencyEnabled;
+
+/**
+ Experimental - Query snapshot of latency histogram of specified stage.
+ 
+ @param stage DLABCaptureLatencyStage
+ @return DLABLatencySnapshot. count is 0 if no sample is recorded.
+ */
+- (DLABLatencySnapshot) captureLatencySnapshotForStage:(DLABCaptureLatencyStage)stage;
+
+/**
+ Experimental - Clear all latency histograms.
+ */
+- (void) resetCaptureLatency;
+
+/* =================================================================================== */
+// MARK: (Public) - Capture delegate queue backpressure (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Drop policy when in-flight video samples on delegate queue reach
+ inputDelegateQueueMaxVideoDepth. Default is DLABDelegateQueueDropPolicyNone.
+ 
+ Only video sample delivery is dropped. VANC handlers and inputFrameMetadataHandler
+ are called on capture thread for every frame, before admission control.
+ */
+@property (nonatomic, assign) DLABDelegateQueueDropPolicy inputDelegateQueueDropPolicy;
+
+/**
+ Experimental - Maximum number of in-flight video samples on delegate queue. Default is 4.
+ 0 for unlimited.
+ */
+@property (nonatomic, assign) NSUInteger inputDelegateQueueMaxVideoDepth;
+
+/**
+ Experimental - Current number of video samples waiting for delegate.
+ */
+@property (nonatomic, assign, readonly) NSUInteger inputDelegateQueueVideoDepth;
+
+/**
+ Experimental - Current number of audio samples waiting for delegate.
+ */
+@property (nonatomic, assign, readonly) NSUInteger inputDelegateQueueAudioDepth;
+
+/**
+ Experimental - Total number of video samples queued for delegate.
+ */
+@property (nonatomic, assign, readonly) uint64_t inputQueuedVideoFrameCount;
+
+/**
+ Experimental - Total number of audio samples queued for delegate.
+ */
+@property (nonatomic, assign, readonly) uint64_t inputQueuedAudioSampleCount;
+
+/**
+ Experimental - Total number of video frames dropped by inputDelegateQueueDropPolicy.
+ */
+@property (nonatomic, assign, readonly) uint64_t inputDroppedVideoFrameCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Output audio ring (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - YES while audio ring is enabled.
+ */
+@property (atomic, assign, readonly) BOOL outputAudioRingEnabled;
+
+/**
+ Experimental - Level of sample frames buffered in device, which audio ring keeps on each
+ RenderAudioSamples callback. Default is 4800 (100 mSec).
+ */
+@property (nonatomic, assign) NSUInteger outputAudioRingTargetLevel;
+
+/**
+ Experimental - Capacity of audio ring in sample frames. 0 if audio ring is not allocated.
+ */
+@property (nonatomic, assign, readonly) NSUInteger outputAudioRingCapacity;
+
+/**
+ Experimental - Current number of sample frames in audio ring.
+ */
+@property (nonatomic, assign, readonly) NSUInteger outputAudioRingFillLevel;
+
+/**
+ Experimental - Peak number of sample frames in audio ring.
+ */
+@property (nonatomic, assign, readonly) NSUInteger outputAudioRingPeakFillLevel;
+
+/**
+ Experimental - Number of sample frames buffered in device at last RenderAudioSamples callback.
+ */
+@property (atomic, assign, readonly) NSUInteger outputAudioRingDeviceBufferedLevel;
+
+/**
+ Experimental - Total number of sample frames scheduled from audio ring.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputAudioRingScheduledFrameCount;
+
+/**
+ Experimental - Number of RenderAudioSamples callbacks which could not reach target level
+ because audio ring ran short. Not counted during preroll.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputAudioRingUnderrunCount;
+
+/**
+ Experimental - Total number of sample frames rejected because audio ring was full.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputAudioRingOverflowFrameCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Playback telemetry (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Measure completion of output video frames using
+ IDeckLinkOutput::GetFrameCompletionReferenceTimestamp.
+ 
+ When disabled (default), no timestamp is taken on playback path.
+ Recorded histograms are kept while disabled; use resetPlaybackTelemetry to clear.
+ */
+@property (nonatomic, assign) BOOL playbackTelemetryEnabled;
+
+/**
+ Experimental - Caller may populate to receive every output frame completion.
+ */
+@property (nonatomic, copy, nullable) OutputFrameCompletionHandler outputFrameCompletionHandler;
+
+/**
+ Experimental - Query snapshot of playback telemetry histogram of specified stage.
+ 
+ @param stage DLABPlaybackLatencyStage
+ @return DLABLatencySnapshot. count is 0 if no sample is recorded.
+ */
+- (DLABLatencySnapshot) playbackLatencySnapshotForStage:(DLABPlaybackLatencyStage)stage;
+
+/**
+ Experimental - Clear all playback telemetry histograms and counters.
+ */
+- (void) resetPlaybackTelemetry;
+
+/**
+ Experimental - Number of output frames completed on time.
+ */
+@property (nonatomic, assign, readonly) uint64_t playbackCompletedFrameCount;
+
+/**
+ Experimental - Number of output frames displayed late.
+ */
+@property (nonatomic, assign, readonly) uint64_t playbackDisplayedLateFrameCount;
+
+/**
+ Experimental - Number of output frames dropped.
+ */
+@property (nonatomic, assign, readonly) uint64_t playbackDroppedFrameCount;
+
+/**
+ Experimental - Number of output frames flushed.
+ */
+@property (nonatomic, assign, readonly) uint64_t playbackFlushedFrameCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Output scheduler (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - YES while output scheduler is running.
+ */
+@property (nonatomic, assign, readonly) BOOL outputSchedulerRunning;
+
+/**
+ Experimental - Number of frames buffered in device which output scheduler keeps. Default is 3.
+ */
+@property (nonatomic, assign) NSUInteger outputSchedulerTargetDepth;
+
+/**
+ Experimental - Current number of pixel buffers waiting in output scheduler queue.
+ */
+@property (nonatomic, assign, readonly) NSUInteger outputSchedulerQueuedCount;
+
+/**
+ Experimental - Number of frames completed on time.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerCompletedFrameCount;
+
+/**
+ Experimental - Number of frames displayed late.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerLateFrameCount;
+
+/**
+ Experimental - Number of frames dropped by device.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerDroppedFrameCount;
+
+/**
+ Experimental - Number of frames flushed on stop.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerFlushedFrameCount;
+
+/**
+ Experimental - Number of frames repeated because queue was starved.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerRepeatedFrameCount;
+
+/**
+ Experimental - Number of frame slots skipped because display time fell behind stream time.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerSkippedFrameCount;
+
+/**
+ Experimental - Number of pixel buffers rejected because queue was full.
+ */
+@property (nonatomic, assign, readonly) uint64_t outputSchedulerRejectedCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Raw recorder (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - YES while raw recorder is writing captured frames.
+ */
+@property (nonatomic, assign, readonly) BOOL rawRecording;
+
+/**
+ Experimental - Number of video frames written by raw recorder.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawRecordedVideoFrameCount;
+
+/**
+ Experimental - Number of audio sample frames written by raw recorder.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawRecordedAudioSampleFrameCount;
+
+/**
+ Experimental - Number of video frames dropped because disk I/O fell behind.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawRecorderDroppedVideoFrameCount;
+
+/**
+ Experimental - Number of audio packets dropped because disk I/O fell behind.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawRecorderDroppedAudioPacketCount;
+
+/**
+ Experimental - Number of bytes written into raw recording file.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawRecordedByteCount;
+
+/* =================================================================================== */
+// MARK: (Public) - Raw replay (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Number of video frames in opened raw replay file. 0 if not opened.
+ */
+@property (nonatomic, assign, readonly) uint64_t rawReplayVideoFrameCount;
+
+/**
+ Experimental - Number of following video frames to read ahead on each schedule. Default is 4.
+ */
+@property (atomic, assign) NSUInteger rawReplayReadAheadCount;
+
+/**
+ Experimental - Set YES to let device read mapped frame directly. Default is YES.
+ 
+ Requires DeckLink API 14.3 or later. When NO, or not available, mapped frame is
+ copied once into pooled output frame.
+ */
+@property (atomic, assign) BOOL rawReplayZeroCopy;
+
 /* =================================================================================== */
 // MARK: (Public) - Key/Value
 /* =================================================================================== */
@@ -975,6 +1540,54 @@ NS_ASSUME_NONNULL_BEGIN
                        timecodeSetting:(DLABTimecodeSetting*)setting
                                  error:(NSError * _Nullable * _Nullable)error;
 
+/**
+ Experimental - Wrapper of IDeckLinkOutput::DisplayVideoFrameSync with in-place rendering
+ 
+ Pooled output frame is vended to handler for rendering, without CVPixelBuffer.
+ 
+ @param handler Block to render into output frame
+ @param error Error description if failed
+ @return YES if no error, NO if failed or cancelled by handler
+ */
+- (BOOL) instantPlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Wrapper of IDeckLinkOutput::ScheduleVideoFrame with in-place rendering
+ 
+ Pooled output frame is vended to handler for rendering, without CVPixelBuffer.
+ 
+ @param handler Block to render into output frame
+ @param displayTime time at which to display the frame in timeScale units
+ @param frameDuration duration for which to display the frame in timeScale units
+ @param timeScale time scale for displayTime and displayDuration
+ @param error Error description if failed
+ @return YES if no error, NO if failed or cancelled by handler
+ */
+- (BOOL) schedulePlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    atTime:(NSInteger)displayTime
+                                  duration:(NSInteger)frameDuration
+                               inTimeScale:(NSInteger)timeScale
+                                     error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Wrapper of IDeckLinkOutput::ScheduleVideoFrame with in-place rendering and Timecode support
+ 
+ @param handler Block to render into output frame
+ @param displayTime time at which to display the frame in timeScale units
+ @param frameDuration duration for which to display the frame in timeScale units
+ @param timeScale time scale for displayTime and displayDuration
+ @param setting Output Timecode Setting to attach
+ @param error Error description if failed
+ @return YES if no error, NO if failed or cancelled by handler
+ */
+- (BOOL) schedulePlaybackWithRenderHandler:(OutputVideoFrameRenderHandler)handler
+                                    atTime:(NSInteger)displayTime
+                                  duration:(NSInteger)frameDuration
+                               inTimeScale:(NSInteger)timeScale
+                           timecodeSetting:(DLABTimecodeSetting*)setting
+                                     error:(NSError * _Nullable * _Nullable)error;
+
 /**
  Wrapper of IDeckLinkOutput::GetBufferedVideoFrameCount
  
@@ -983,6 +1596,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSNumber*) getBufferedVideoFrameCountWithError:(NSError * _Nullable * _Nullable)error;
 
+/**
+ Pre-allocate output VideoFrames in pool to avoid allocation on first scheduling.
+ 
+ Pool capacity is limited to 8 frames. Requires enabled video output.
+ 
+ @param count Total number of VideoFrame in pool
+ @param error Error description if failed
+ @return YES if pool contains count frames or more, NO if failed.
+ */
+- (BOOL) prewarmOutputVideoFramePoolWithCount:(NSUInteger)count
+                                        error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Release idle output VideoFrames in pool. Frames in use are never released.
+ 
+ @param count Total number of VideoFrame to keep in pool
+ @return Number of VideoFrame in pool after shrink.
+ */
+- (NSUInteger) shrinkOutputVideoFramePoolToCount:(NSUInteger)count;
+
 /* =================================================================================== */
 // MARK: Audio
 /* =================================================================================== */
@@ -1118,6 +1751,146 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL) flushBufferedAudioSamplesWithError:(NSError * _Nullable * _Nullable)error;
 
+/* =================================================================================== */
+// MARK: Audio ring (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Enable lock-free audio ring between producer and output audio callback.
+ 
+ While enabled, IDeckLinkAudioOutputCallback::RenderAudioSamples drains the ring directly
+ into IDeckLinkOutput::ScheduleAudioSamples up to outputAudioRingTargetLevel, without
+ hopping to delegate queue or playback queue. renderAudioSamplesOfDevice: is not called.
+ Audio output should be enabled first. Do not mix with schedulePlaybackOfAudio... methods.
+ 
+ @param capacity Ring capacity in sample frames. Rounded up to power of two.
+ @param streamTime Stream time of the first sample frame in the ring, in 48kHz time scale.
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) enableOutputAudioRingWithCapacity:(NSUInteger)capacity
+                                    atTime:(NSInteger)streamTime
+                                     error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Disable audio ring. Producer should stop writing before this call.
+ 
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) disableOutputAudioRingWithError:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Write interleaved sample frames into audio ring. Lock-free.
+ 
+ Only one producer may write at a time, but it may be any thread.
+ @param audioBufferList audioBufferList containing interleaved audio sample frames, in single
+ buffer with mNumberChannels of outputAudioSetting.
+ @return Number of sample frames accepted. The rest are counted as overflow. 0 if audioBufferList
+ is not interleaved.
+ */
+- (NSUInteger) writeOutputAudioRingFromAudioBufferList:(AudioBufferList*)audioBufferList;
+
+/**
+ Experimental - Write interleaved sample frames into audio ring. Lock-free.
+ 
+ Only one producer may write at a time, but it may be any thread.
+ @param bytes Interleaved audio sample frames.
+ @param frameCount Number of sample frames in bytes.
+ @return Number of sample frames accepted. The rest are counted as overflow.
+ */
+- (NSUInteger) writeOutputAudioRingBytes:(const void*)bytes frameCount:(NSUInteger)frameCount;
+
+/**
+ Experimental - Clear underrun/overflow counters and peak fill level of audio ring.
+ */
+- (void) resetOutputAudioRingStatistics;
+
+/* =================================================================================== */
+// MARK: Output scheduler (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Start scheduled playback driven by built-in output scheduler.
+ 
+ Enqueued pixel buffers are scheduled with display time of (frame counter * duration)
+ of outputVideoSetting. Scheduler keeps outputSchedulerTargetDepth frames buffered in
+ device on each ScheduledFrameCompleted callback. When queue is starved, last frame
+ is repeated. When display time falls behind stream time, frame counter skips ahead.
+ Preroll is automatic; at least one pixel buffer should be enqueued before start.
+ Do not mix with schedulePlaybackOfPixelBuffer:... methods while running.
+ 
+ @param targetDepth Number of frames buffered in device (1-7).
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) startOutputSchedulerWithTargetDepth:(NSUInteger)targetDepth
+                                       error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Stop scheduled playback of output scheduler, and release queued pixel buffers.
+ 
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) stopOutputSchedulerWithError:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Enqueue pixel buffer for output scheduler. Pixel buffer is retained.
+ 
+ @param pixelBuffer CVPixelBuffer to play back. Same dimension as outputVideoSetting.
+ @param error Error description if failed
+ @return YES if no error, NO if queue is full.
+ */
+- (BOOL) enqueueOutputPixelBuffer:(CVPixelBufferRef)pixelBuffer
+                            error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Clear counters of output scheduler.
+ */
+- (void) resetOutputSchedulerStatistics;
+
+/* =================================================================================== */
+// MARK: Raw replay (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Map raw file written by startRawRecordingToURL:error: for playback.
+ 
+ Video format of the file should match outputVideoSetting (width, height, pixel
+ format and row bytes). Previously opened file is closed.
+ 
+ @param url File URL to read.
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) openRawReplayAtURL:(NSURL*)url
+                      error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Close raw replay file. Mapping is kept until scheduled frames are completed.
+ */
+- (void) closeRawReplay;
+
+/**
+ Experimental - Schedule video frame of raw replay file without decode.
+ 
+ Mapped frame is either handed to device as is (rawReplayZeroCopy), or copied once
+ into output frame. Following rawReplayReadAheadCount frames are read ahead.
+ 
+ @param index Video frame index in raw replay file
+ @param displayTime Time at which to display the frame in timeScale units
+ @param frameDuration Duration for which to display the frame in timeScale units
+ @param timeScale Time scale for displayTime and displayDuration
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) scheduleRawReplayVideoFrameAtIndex:(uint64_t)index
+                                     atTime:(NSInteger)displayTime
+                                   duration:(NSInteger)frameDuration
+                                inTimeScale:(NSInteger)timeScale
+                                      error:(NSError * _Nullable * _Nullable)error;
+
 /* =================================================================================== */
 // MARK: Stream
 /* =================================================================================== */
@@ -1420,6 +2193,35 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable NSNumber*) getAvailableAudioSampleFrameCountWithError:(NSError * _Nullable * _Nullable)error;
 
+/* =================================================================================== */
+// MARK: Raw recorder (experimental)
+/* =================================================================================== */
+
+/**
+ Experimental - Start writing captured video frames and audio packets into raw file.
+ 
+ Frames are written as is (native pixel format and interleaved PCM) into page
+ aligned container with trailing index of time, duration and timecode. Disk I/O
+ is performed on dedicated thread using fixed number of page aligned segments,
+ bypassing unified buffer cache. When every segment is in flight, new frame is
+ dropped instead of blocking capture. Recording is independent of inputDelegate.
+ Video input should be enabled. Audio input is optional.
+ 
+ @param url File URL to write. Existing file is replaced.
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) startRawRecordingToURL:(NSURL*)url
+                          error:(NSError * _Nullable * _Nullable)error;
+
+/**
+ Experimental - Stop raw recording. Pending segments are flushed, and index is written.
+ 
+ @param error Error description if failed
+ @return YES if no error, NO if failed
+ */
+- (BOOL) stopRawRecordingWithError:(NSError * _Nullable * _Nullable)error;
+
 /* =================================================================================== */
 // MARK: Stream
 /* =================================================================================== */
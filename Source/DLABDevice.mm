@@ -9,6 +9,7 @@
 /* This software is released under the MIT License, see LICENSE.txt. */
 
 #import <DLABDevice+Internal.h>
+#import <DeckLinkAPIVersion.h>
 
 const char* kCaptureQueue = "DLABDevice.captureQueue";
 const char* kPlaybackQueue = "DLABDevice.playbackQueue";
@@ -53,8 +54,15 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
         _deckLink->AddRef();
         
         //
-        outputVideoFrameSet = [NSMutableSet set];
-        outputVideoFrameIdleSet = [NSMutableSet set];
+        outputVideoFramePool = new DLABFramePool(maxOutputVideoFrameCount);
+        inputDelegateQueueGate = new DLABDelegateQueueGate();
+        inputAncillaryArenaPool = new DLABAncillaryArenaPool(inputAncillaryArenaPoolCapacity);
+        outputAncillaryPacketPool = new DLABAncillaryPacketPool(outputAncillaryPacketPoolCapacity);
+        _inputDelegateQueueMaxVideoDepth = 4;
+        _videoConverterThreadCount = 1;
+        _outputAudioRingTargetLevel = outputAudioRingDefaultTargetLevel;
+        _rawReplayReadAheadCount = DLABRawReplaySource::kDefaultReadAheadCount;
+        _rawReplayZeroCopy = YES;
         
         //
         [self validate];
@@ -267,6 +275,14 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
         _inputPreviewCallback->Release();
         _inputPreviewCallback = NULL;
     }
+    if (_inputVideoBufferAllocatorProvider) {
+        _inputVideoBufferAllocatorProvider->Release();
+        _inputVideoBufferAllocatorProvider = NULL;
+    }
+    if (_inputAudioBlockPool) {
+        _inputAudioBlockPool->Release();
+        _inputAudioBlockPool = NULL;
+    }
     if (_profileCallback) {
         [self subscribeProfileChange:NO];
         _profileCallback->Release();
@@ -283,6 +299,11 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
         _statusChangeCallback = NULL;
     }
     if (_outputCallback) {
+        if (_outputAudioRingEnabled) {
+            [self subscribeOutputAudio:NO];
+            _outputAudioRingEnabled = NO;
+        }
+        _outputSchedulerRunning = NO;
         [self subscribeOutput:NO];
         _outputCallback->Release();
         _outputCallback = NULL;
@@ -321,6 +342,46 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
     [self shutdown];
     
     // Release c++ objects
+    if (outputVideoFramePool) {
+        delete outputVideoFramePool;
+        //outputVideoFramePool = NULL;
+    }
+    if (_captureLatencyStats) {
+        delete _captureLatencyStats;
+        //_captureLatencyStats = NULL;
+    }
+    if (_outputAudioRing) {
+        _outputAudioRing->Release();
+        _outputAudioRing = NULL;
+    }
+    if (_outputScheduler) {
+        delete _outputScheduler; // queued pixel buffers are released
+        //_outputScheduler = NULL;
+    }
+    if (_playbackTelemetry) {
+        delete _playbackTelemetry;
+        //_playbackTelemetry = NULL;
+    }
+    if (_inputRawRecorder) {
+        delete _inputRawRecorder; // pending segments are flushed
+        //_inputRawRecorder = NULL;
+    }
+    if (_outputRawReplaySource) {
+        _outputRawReplaySource->Release();
+        //_outputRawReplaySource = NULL;
+    }
+    if (inputDelegateQueueGate) {
+        inputDelegateQueueGate->Release();
+        //inputDelegateQueueGate = NULL;
+    }
+    if (inputAncillaryArenaPool) {
+        inputAncillaryArenaPool->Release();
+        //inputAncillaryArenaPool = NULL;
+    }
+    if (outputAncillaryPacketPool) {
+        outputAncillaryPacketPool->Release();
+        //outputAncillaryPacketPool = NULL;
+    }
     if (_deckLinkNotification) {
         _deckLinkNotification->Release();
         //_deckLinkNotification = NULL;
@@ -402,7 +463,11 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
 @synthesize outputVANCLines = _outputVANCLines;
 @synthesize outputVANCHandler = _outputVANCHandler;
 @synthesize inputVANCPacketHandler = _inputVANCPacketHandler;
+@synthesize inputVANCPacketBatchHandler = _inputVANCPacketBatchHandler;
 @synthesize outputVANCPacketHandler = _outputVANCPacketHandler;
+@synthesize outputVANCPacketWriteHandler = _outputVANCPacketWriteHandler;
+@synthesize inputVANCLineParsing = _inputVANCLineParsing;
+@synthesize outputVANCLineSerializing = _outputVANCLineSerializing;
 
 @synthesize inputFrameMetadataHandler = _inputFrameMetadataHandler;
 @synthesize outputFrameMetadataHandler = _outputFrameMetadataHandler;
@@ -411,6 +476,11 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
 @synthesize debugCalcPixelSizeFast = _debugCalcPixelSizeFast;
 
 @synthesize inputPixelBufferAttributes = _inputPixelBufferAttributes;
+@synthesize useZeroCopyCapture = _useZeroCopyCapture;
+@synthesize inputVideoCopiedBytesPerFrame = _inputVideoCopiedBytesPerFrame;
+@synthesize inputVideoCopiedByteCount = _inputVideoCopiedByteCount;
+@synthesize useStreamingCaptureCopy = _useStreamingCaptureCopy;
+@synthesize videoConverterThreadCount = _videoConverterThreadCount;
 
 /* =================================================================================== */
 // MARK: - (Private) property accessor
@@ -445,15 +515,39 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
 @synthesize captureQueueKey = captureQueueKey;
 @synthesize playbackQueueKey = playbackQueueKey;
 @synthesize delegateQueueKey = delegateQueueKey;
-@synthesize outputVideoFrameSet = outputVideoFrameSet;
-@synthesize outputVideoFrameIdleSet = outputVideoFrameIdleSet;
+@synthesize outputVideoFramePool = outputVideoFramePool;
+@synthesize inputDelegateQueueGate = inputDelegateQueueGate;
+@synthesize inputAncillaryArenaPool = inputAncillaryArenaPool;
+@synthesize outputAncillaryPacketPool = outputAncillaryPacketPool;
 
 @synthesize inputPixelBufferPool = _inputPixelBufferPool;
 @synthesize outputPreviewCallback = _outputPreviewCallback;
 @synthesize inputPreviewCallback = _inputPreviewCallback;
+@synthesize inputVideoBufferAllocatorProvider = _inputVideoBufferAllocatorProvider;
+@synthesize inputAudioBlockPool = _inputAudioBlockPool;
+@synthesize captureLatencyStats = _captureLatencyStats;
+@synthesize captureLatencyEnabled = _captureLatencyEnabled;
+@synthesize inputDelegateQueueDropPolicy = _inputDelegateQueueDropPolicy;
+@synthesize inputDelegateQueueMaxVideoDepth = _inputDelegateQueueMaxVideoDepth;
+@synthesize outputAudioRing = _outputAudioRing;
+@synthesize outputAudioRingEnabled = _outputAudioRingEnabled;
+@synthesize outputAudioRingTargetLevel = _outputAudioRingTargetLevel;
+@synthesize outputAudioRingStreamTime = _outputAudioRingStreamTime;
+@synthesize outputAudioRingDeviceBufferedLevel = _outputAudioRingDeviceBufferedLevel;
+@synthesize outputScheduler = _outputScheduler;
+@synthesize outputSchedulerRunning = _outputSchedulerRunning;
+@synthesize playbackTelemetry = _playbackTelemetry;
+@synthesize playbackTelemetryEnabled = _playbackTelemetryEnabled;
+@synthesize outputFrameCompletionHandler = _outputFrameCompletionHandler;
+@synthesize inputRawRecorder = _inputRawRecorder;
+@synthesize outputRawReplaySource = _outputRawReplaySource;
+@synthesize rawReplayReadAheadCount = _rawReplayReadAheadCount;
+@synthesize rawReplayZeroCopy = _rawReplayZeroCopy;
 
 @synthesize needsInputVideoConfigurationRefresh = _needsInputVideoConfigurationRefresh;
 @synthesize inputVideoConverter = _inputVideoConverter;
+@synthesize inputCopyKernel = _inputCopyKernel;
+@synthesize captureGroup = _captureGroup;
 @synthesize outputVideoConverter = _outputVideoConverter;
 
 /* =================================================================================== */
@@ -647,6 +741,61 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
     return (result == S_OK);
 }
 
+// Private helper method for output audio
+- (BOOL) subscribeOutputAudio:(BOOL) flag
+{
+    HRESULT result = E_FAIL;
+    IDeckLinkOutput * output = self.deckLinkOutput;
+    DLABOutputCallback* callback = self.outputCallback;
+    if (!output || !callback) return FALSE;
+    if (flag) {
+        result = output->SetAudioCallback(callback);
+        if (result) {
+            NSLog(@"ERROR: IDeckLinkOutput::SetAudioCallback failed.");
+        }
+    } else {
+        result = output->SetAudioCallback(NULL);
+        if (result) {
+            NSLog(@"ERROR: IDeckLinkOutput::SetAudioCallback failed.");
+        }
+    }
+    return (result == S_OK);
+}
+
+// Private helper method for output scheduler
+static void retainScheduledItem(void* item)
+{
+    CFRetain((CVPixelBufferRef)item);
+}
+
+static void releaseScheduledItem(void* item)
+{
+    CFRelease((CVPixelBufferRef)item);
+}
+
+- (DLABPlaybackScheduler*) prepareOutputScheduler
+{
+    @synchronized (self) {
+        // Scheduler is never released until dealloc; callback thread may refer it
+        if (!_outputScheduler) {
+            _outputScheduler = new DLABPlaybackScheduler(retainScheduledItem, releaseScheduledItem);
+            _outputScheduler->SetTargetDepth(outputSchedulerDefaultTargetDepth);
+        }
+        return _outputScheduler;
+    }
+}
+
+- (DLABRawRecorder*) prepareInputRawRecorder
+{
+    @synchronized (self) {
+        // Recorder is never released until dealloc; callback thread may refer it
+        if (!_inputRawRecorder) {
+            _inputRawRecorder = new DLABRawRecorder();
+        }
+        return _inputRawRecorder;
+    }
+}
+
 // Private helper method for statusChange
 - (BOOL) subscribeStatusChangeNotification:(BOOL) flag
 {
@@ -957,6 +1106,10 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
 
 - (int) apiVersion
 {
+    if (_apiVersion == 0 && DLABSimulatorIsSimulatedDeckLink(_deckLink)) {
+        // Simulated device implements current API interfaces only
+        _apiVersion = BLACKMAGIC_DECKLINK_API_VERSION;
+    }
     if (_apiVersion == 0) {
         IDeckLinkAPIInformation* api = CreateDeckLinkAPIInformationInstance();
         if (api != NULL) {
@@ -1016,6 +1169,414 @@ const char* kDelegateQueue = "DLABDevice.delegateQueue";
     }
 }
 
+- (void) setInputVideoBufferAllocatorProvider:(DLABVideoBufferAllocatorProvider *)newProvider
+{
+    if (_inputVideoBufferAllocatorProvider == newProvider) return;
+    if (_inputVideoBufferAllocatorProvider) {
+        _inputVideoBufferAllocatorProvider->Release();
+        _inputVideoBufferAllocatorProvider = NULL;
+    }
+    if (newProvider) {
+        _inputVideoBufferAllocatorProvider = newProvider;
+        _inputVideoBufferAllocatorProvider->AddRef();
+    }
+}
+
+- (void) setOutputAudioRing:(DLABAudioRing *)newRing
+{
+    // Producer/consumer threads retain ring under same lock
+    @synchronized (self) {
+        if (_outputAudioRing == newRing) return;
+        if (_outputAudioRing) {
+            _outputAudioRing->Release();
+            _outputAudioRing = NULL;
+        }
+        if (newRing) {
+            _outputAudioRing = newRing;
+            _outputAudioRing->AddRef();
+        }
+    }
+}
+
+- (void) setInputAudioBlockPool:(DLABAudioBlockPool *)newPool
+{
+    // Capture thread retains pool under same lock
+    @synchronized (self) {
+        if (_inputAudioBlockPool == newPool) return;
+        if (_inputAudioBlockPool) {
+            _inputAudioBlockPool->Release();
+            _inputAudioBlockPool = NULL;
+        }
+        if (newPool) {
+            _inputAudioBlockPool = newPool;
+            _inputAudioBlockPool->AddRef();
+        }
+    }
+}
+
+- (uint64_t) inputAudioBlockPoolHitCount
+{
+    @synchronized (self) {
+        DLABAudioBlockPool* pool = self.inputAudioBlockPool;
+        return (pool ? pool->HitCount() : 0);
+    }
+}
+
+- (uint64_t) inputAudioBlockPoolMissCount
+{
+    @synchronized (self) {
+        DLABAudioBlockPool* pool = self.inputAudioBlockPool;
+        return (pool ? pool->MissCount() : 0);
+    }
+}
+
++ (NSUInteger) videoConversionPlanCacheCapacity
+{
+    return DLABConversionPlanCache.sharedCache.capacity;
+}
+
++ (void) setVideoConversionPlanCacheCapacity:(NSUInteger)newCapacity
+{
+    DLABConversionPlanCache.sharedCache.capacity = newCapacity;
+}
+
++ (NSUInteger) videoConversionPlanCacheHitCount
+{
+    return DLABConversionPlanCache.sharedCache.hitCount;
+}
+
++ (NSUInteger) videoConversionPlanCacheMissCount
+{
+    return DLABConversionPlanCache.sharedCache.missCount;
+}
+
++ (void) purgeVideoConversionPlanCache
+{
+    [DLABConversionPlanCache.sharedCache removeAllPlans];
+}
+
++ (NSUInteger) prewarmVideoConversionForInputSettings:(NSArray<DLABVideoSetting*>*)settings
+{
+    return [self prewarmVideoConversionForSettings:settings toCV:TRUE];
+}
+
++ (NSUInteger) prewarmVideoConversionForOutputSettings:(NSArray<DLABVideoSetting*>*)settings
+{
+    return [self prewarmVideoConversionForSettings:settings toCV:FALSE];
+}
+
++ (NSUInteger) prewarmVideoConversionForSettings:(NSArray<DLABVideoSetting*>*)settings toCV:(BOOL)toCV
+{
+    NSUInteger count = 0;
+    for (DLABVideoSetting* setting in settings) {
+        OSType cvPixelFormat = setting.cvPixelFormatType;
+        BMDPixelFormat pixelFormat = (BMDPixelFormat)setting.pixelFormat;
+        if (!cvPixelFormat || pixelFormat == cvPixelFormat) continue; // copied without converter
+        
+        // Template CVPixelBuffer; Captured one has no attachment at conversion
+        CVPixelBufferRef pixelBuffer = NULL;
+        CVReturn err = CVPixelBufferCreate(NULL, (size_t)setting.width, (size_t)setting.height,
+                                           cvPixelFormat, NULL, &pixelBuffer);
+        if (err || !pixelBuffer) continue;
+        if (!toCV) {
+            CFDictionaryRef dict = (__bridge CFDictionaryRef)setting.extensions;
+            if (dict) {
+                CVBufferSetAttachments(pixelBuffer, dict, kCVAttachmentMode_ShouldPropagate);
+            }
+        }
+        
+        BOOL ready = FALSE;
+        if (toCV) {
+            ready = [DLABVideoConverter prewarmPlanForDLFormat:pixelFormat
+                                                         width:setting.width
+                                                        height:setting.height
+                                                          toCV:pixelBuffer];
+        } else {
+            ready = [DLABVideoConverter prewarmPlanForCV:pixelBuffer
+                                              toDLFormat:pixelFormat
+                                                   width:setting.width
+                                                  height:setting.height];
+        }
+        CVPixelBufferRelease(pixelBuffer);
+        if (ready) count++;
+    }
+    return count;
+}
+
+- (void) setCaptureLatencyEnabled:(BOOL)enabled
+{
+    @synchronized (self) {
+        // Histograms are never released until dealloc; capture thread may refer them
+        if (enabled && !_captureLatencyStats) {
+            _captureLatencyStats = new DLABLatencyStats((uint32_t)DLABCaptureLatencyStageCount);
+        }
+        _captureLatencyEnabled = enabled;
+    }
+}
+
+- (DLABLatencySnapshot) captureLatencySnapshotForStage:(DLABCaptureLatencyStage)stage
+{
+    DLABLatencySnapshot result = {0};
+    DLABLatencyStats* stats = self.captureLatencyStats;
+    if (stats) {
+        DLABLatencyStats::Snapshot snapshot = stats->GetSnapshot((uint32_t)stage);
+        result.count = snapshot.count;
+        result.p50 = snapshot.p50;
+        result.p99 = snapshot.p99;
+        result.max = snapshot.max;
+        result.mean = snapshot.mean;
+    }
+    return result;
+}
+
+- (void) resetCaptureLatency
+{
+    DLABLatencyStats* stats = self.captureLatencyStats;
+    if (stats) {
+        stats->Reset();
+    }
+}
+
+- (NSUInteger) inputDelegateQueueVideoDepth
+{
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    return (gate ? (NSUInteger)gate->PendingVideoCount() : 0);
+}
+
+- (NSUInteger) inputDelegateQueueAudioDepth
+{
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    return (gate ? (NSUInteger)gate->PendingAudioCount() : 0);
+}
+
+- (uint64_t) inputQueuedVideoFrameCount
+{
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    return (gate ? gate->QueuedVideoCount() : 0);
+}
+
+- (uint64_t) inputQueuedAudioSampleCount
+{
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    return (gate ? gate->QueuedAudioCount() : 0);
+}
+
+- (uint64_t) inputDroppedVideoFrameCount
+{
+    DLABDelegateQueueGate* gate = self.inputDelegateQueueGate;
+    return (gate ? gate->DroppedVideoCount() : 0);
+}
+
+- (NSUInteger) outputAudioRingCapacity
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? (NSUInteger)ring->Capacity() : 0);
+    }
+}
+
+- (NSUInteger) outputAudioRingFillLevel
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? (NSUInteger)ring->FillLevel() : 0);
+    }
+}
+
+- (NSUInteger) outputAudioRingPeakFillLevel
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? (NSUInteger)ring->PeakFillLevel() : 0);
+    }
+}
+
+- (uint64_t) outputAudioRingScheduledFrameCount
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? ring->ConsumedCount() : 0);
+    }
+}
+
+- (uint64_t) outputAudioRingUnderrunCount
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? ring->UnderrunCount() : 0);
+    }
+}
+
+- (uint64_t) outputAudioRingOverflowFrameCount
+{
+    @synchronized (self) {
+        DLABAudioRing* ring = self.outputAudioRing;
+        return (ring ? ring->OverflowCount() : 0);
+    }
+}
+
+- (void) setPlaybackTelemetryEnabled:(BOOL)enabled
+{
+    @synchronized (self) {
+        // Telemetry is never released until dealloc; callback thread may refer it
+        if (enabled && !_playbackTelemetry) {
+            _playbackTelemetry = new DLABPlaybackTelemetry();
+        }
+        _playbackTelemetryEnabled = enabled;
+    }
+}
+
+- (DLABLatencySnapshot) playbackLatencySnapshotForStage:(DLABPlaybackLatencyStage)stage
+{
+    DLABLatencySnapshot result = {0};
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    if (telemetry && stage < DLABPlaybackLatencyStageCount) {
+        DLABLatencyStats::Snapshot snapshot = telemetry->GetSnapshot((DLABPlaybackTelemetry::StatsStage)stage);
+        result.count = snapshot.count;
+        result.p50 = snapshot.p50;
+        result.p99 = snapshot.p99;
+        result.max = snapshot.max;
+        result.mean = snapshot.mean;
+    }
+    return result;
+}
+
+- (void) resetPlaybackTelemetry
+{
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    if (telemetry) {
+        telemetry->Reset();
+    }
+}
+
+- (uint64_t) playbackCompletedFrameCount
+{
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    return (telemetry ? telemetry->ResultCountOf(DLABPlaybackTelemetry::ResultCompleted) : 0);
+}
+
+- (uint64_t) playbackDisplayedLateFrameCount
+{
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    return (telemetry ? telemetry->ResultCountOf(DLABPlaybackTelemetry::ResultDisplayedLate) : 0);
+}
+
+- (uint64_t) playbackDroppedFrameCount
+{
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    return (telemetry ? telemetry->ResultCountOf(DLABPlaybackTelemetry::ResultDropped) : 0);
+}
+
+- (uint64_t) playbackFlushedFrameCount
+{
+    DLABPlaybackTelemetry* telemetry = self.playbackTelemetry;
+    return (telemetry ? telemetry->ResultCountOf(DLABPlaybackTelemetry::ResultFlushed) : 0);
+}
+
+- (NSUInteger) outputSchedulerTargetDepth
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? (NSUInteger)scheduler->TargetDepth() : (NSUInteger)outputSchedulerDefaultTargetDepth);
+}
+
+- (void) setOutputSchedulerTargetDepth:(NSUInteger)depth
+{
+    DLABPlaybackScheduler* scheduler = [self prepareOutputScheduler];
+    scheduler->SetTargetDepth((uint32_t)MIN(MAX(depth, (NSUInteger)1), (NSUInteger)outputSchedulerMaxTargetDepth));
+}
+
+- (NSUInteger) outputSchedulerQueuedCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? (NSUInteger)scheduler->QueuedCount() : 0);
+}
+
+- (uint64_t) outputSchedulerCompletedFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->CompletionCountOf(DLABPlaybackScheduler::CompletionCompleted) : 0);
+}
+
+- (uint64_t) outputSchedulerLateFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->CompletionCountOf(DLABPlaybackScheduler::CompletionLate) : 0);
+}
+
+- (uint64_t) outputSchedulerDroppedFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->CompletionCountOf(DLABPlaybackScheduler::CompletionDropped) : 0);
+}
+
+- (uint64_t) outputSchedulerFlushedFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->CompletionCountOf(DLABPlaybackScheduler::CompletionFlushed) : 0);
+}
+
+- (uint64_t) outputSchedulerRepeatedFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->RepeatedCount() : 0);
+}
+
+- (uint64_t) outputSchedulerSkippedFrameCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->SkippedCount() : 0);
+}
+
+- (uint64_t) outputSchedulerRejectedCount
+{
+    DLABPlaybackScheduler* scheduler = self.outputScheduler;
+    return (scheduler ? scheduler->RejectedCount() : 0);
+}
+
+- (BOOL) rawRecording
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->IsRecording() : NO);
+}
+
+- (uint64_t) rawRecordedVideoFrameCount
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->VideoCount() : 0);
+}
+
+- (uint64_t) rawRecordedAudioSampleFrameCount
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->AudioFrameCount() : 0);
+}
+
+- (uint64_t) rawRecorderDroppedVideoFrameCount
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->DroppedVideoCount() : 0);
+}
+
+- (uint64_t) rawRecorderDroppedAudioPacketCount
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->DroppedAudioCount() : 0);
+}
+
+- (uint64_t) rawRecordedByteCount
+{
+    DLABRawRecorder* recorder = self.inputRawRecorder;
+    return (recorder ? recorder->WrittenBytes() : 0);
+}
+
+- (uint64_t) rawReplayVideoFrameCount
+{
+    @synchronized (self) {
+        DLABRawReplaySource* source = self.outputRawReplaySource;
+        return (source ? source->VideoFrameCount() : 0);
+    }
+}
+
 /* =================================================================================== */
 // MARK: - getter attributeID
 /* =================================================================================== */
@@ -24,6 +24,21 @@ NS_ASSUME_NONNULL_BEGIN
  - Supported: DLABPixelFormat(10BitRGB/10BitRGBXLE/10BitRGBX)
  
  - Experimental: DLABPixelFormat(12BitRGB/12BitRGBLE)
+ 
+ - Fast path: DLABPixelFormat(10BitYUV) <=> kCVPixelFormatType(422YpCbCr8/422YpCbCr16)
+   is converted in single pass by DLABV210Kernel (SIMD) without interimBuffer,
+   only when useDLColorSpace is FALSE and both colorspaces are equal. Otherwise
+   vImage path is used. v210 to RGB or planar formats is not fused; it still
+   goes through interimBuffer and vImageConverter.
+ 
+ - BigEndian DLABPixelFormat(10BitRGB/10BitRGBX/12BitRGB) is byte swapped and
+   unpacked in single pass by DLABRGBKernel (SIMD).
+ 
+ - Each conversion stage is split into horizontal bands and processed in parallel.
+   Banding is opt-in; see threadCount property.
+ 
+ - Prepared conversion plan (YpCbCr conversion info, vImageConverter objects) is
+   shared process-wide via DLABConversionPlanCache.
  */
 @interface DLABVideoConverter : NSObject
 
@@ -63,9 +78,44 @@ NS_ASSUME_NONNULL_BEGIN
 /// For Debugging purpose only; Use XRGB16U interimBuffer.
 @property (nonatomic, assign) BOOL useXRGB16U;
 
+/// For Debugging purpose only; Disable DLABV210Kernel fast path.
+/// @discussion If this is changed after prepare, converter is prepared again on next convert.
+@property (nonatomic, assign) BOOL useVImageOnly;
+
+/// Number of threads for row-band parallel conversion.
+/// @discussion Default is 1 (single thread). Set 0 to use active processor count.
+/// @discussion Up to 16 bands are used. Small frame uses fewer bands.
+@property (nonatomic, assign) NSUInteger threadCount;
+
 /// SDK 14.3 or later dropped IDeckLinkVideoFrame::GetBytes() method.
 @property (nonatomic, assign) BOOL pre1403; // for DeckLink 1403 or earlier
 
+/* ================================================================ */
+// MARK: - Conversion plan cache
+/* ================================================================ */
+
+/// Prepare conversion plan for capture in advance, and keep it in DLABConversionPlanCache
+/// @discussion Converter of same configuration reuses cached plan and scratch buffers.
+/// @param format BMDPixelFormat of IDeckLinkVideoFrame
+/// @param width width of IDeckLinkVideoFrame
+/// @param height height of IDeckLinkVideoFrame
+/// @param pixelBuffer CVPixelBuffer as template of destination (format/size/attachments)
++ (BOOL)prewarmPlanForDLFormat:(BMDPixelFormat)format
+                         width:(long)width
+                        height:(long)height
+                          toCV:(CVPixelBufferRef)pixelBuffer;
+
+/// Prepare conversion plan for playback in advance, and keep it in DLABConversionPlanCache
+/// @discussion Converter of same configuration reuses cached plan and scratch buffers.
+/// @param pixelBuffer CVPixelBuffer as template of source (format/size/attachments)
+/// @param format BMDPixelFormat of IDeckLinkVideoFrame
+/// @param width width of IDeckLinkVideoFrame
+/// @param height height of IDeckLinkVideoFrame
++ (BOOL)prewarmPlanForCV:(CVPixelBufferRef)pixelBuffer
+              toDLFormat:(BMDPixelFormat)format
+                   width:(long)width
+                  height:(long)height;
+
 /* ================================================================ */
 // MARK: - Validate VideoFrame and CVPixelBuffer (optional)
 /* ================================================================ */
@@ -81,7 +131,7 @@ NS_ASSUME_NONNULL_BEGIN
                    andCV:(CVPixelBufferRef)pixelBuffer;
 
 /* ================================================================ */
-// MARK: - VideoFrame (permute) dlHostBuffer (xfer) XRGB16U (convCGtoCV) CVPixelBuffer
+// MARK: - VideoFrame (xfer) XRGB16U (convCGtoCV) CVPixelBuffer
 /* ================================================================ */
 
 /// Prepare interimBuffer and converter object
@@ -99,7 +149,7 @@ NS_ASSUME_NONNULL_BEGIN
              toCV:(CVPixelBufferRef)pixelBuffer;
 
 /* ================================================================ */
-// MARK: - CVPixelBuffer (convCVtoCG) XRGB16U (xfer) dlHostBuffer (permute) VideoFrame
+// MARK: - CVPixelBuffer (convCVtoCG) XRGB16U (xfer) VideoFrame
 /* ================================================================ */
 
 /// Prepare interimBuffer and converter object
@@ -9,6 +9,9 @@
 /* This software is released under the MIT License, see LICENSE.txt. */
 
 #import <DLABVideoConverter.h>
+#import <DLABV210Kernel.h>
+#import <DLABRGBKernel.h>
+#import <DLABConversionPlanCache.h>
 
 /* =================================================================================== */
 // MARK: -
@@ -33,7 +36,6 @@
 @property (nonatomic, assign) vImage_YpCbCrToARGB infoToARGB;
 @property (nonatomic, assign) vImage_ARGBToYpCbCr infoToYpCbCr;
 
-@property (nonatomic, assign) vImage_Buffer dlHostBuffer; // dlBuffer in HostEndian
 @property (nonatomic, assign) vImage_Buffer interimBuffer; // interim XRGB16U format (RGB444)
 @property (nonatomic, assign) vImage_Buffer argb8888Buffer; // For useXRGB16U: YUV8 <-> RGB8 <-> RGB16
 
@@ -47,6 +49,16 @@
 @property (nonatomic, assign) void* temp1216Buffer;
 @property (nonatomic, assign) BOOL queryTemp1216Buffer;
 
+@property (nonatomic, assign) BOOL useV210Kernel; // v210 <=> 2vuy/v216 without interimBuffer
+@property (nonatomic, assign) BOOL needsPlanRefresh; // useVImageOnly is changed after prepare
+
+@property (nonatomic, assign) size_t bandCount; // number of row-bands in use
+@property (nonatomic, assign) vImagePixelCount bandRows; // rows per band
+@property (nonatomic, assign) size_t tempBufferStride; // slot size per band in tempBuffer
+@property (nonatomic, assign) size_t temp1216BufferStride; // slot size per band in temp1216Buffer
+
+@property (nonatomic, strong, nullable) DLABConversionPlan* plan; // shared with other converters via cache
+
 @end
 
 /* =================================================================================== */
@@ -55,9 +67,18 @@
 
 @implementation DLABVideoConverter
 
-- (instancetype) initWithDL:(IDeckLinkVideoFrame*)videoFrame toCV:(CVPixelBufferRef)pixelBuffer
+- (instancetype) init
 {
     self = [super init];
+    if (self) {
+        threadCount = 1; // banding is opt-in
+    }
+    return self;
+}
+
+- (instancetype) initWithDL:(IDeckLinkVideoFrame*)videoFrame toCV:(CVPixelBufferRef)pixelBuffer
+{
+    self = [self init];
     if (self) {
         BOOL ready = [self prepareDL:videoFrame toCV:pixelBuffer];
         if (ready) return self;
@@ -67,7 +88,7 @@
 
 - (instancetype) initWithCV:(CVPixelBufferRef)pixelBuffer toDL:(IDeckLinkMutableVideoFrame*)videoFrame
 {
-    self = [super init];
+    self = [self init];
     if (self) {
         BOOL ready = [self prepareCV:pixelBuffer toDL:videoFrame];
         if (ready) return self;
@@ -92,6 +113,8 @@
 @synthesize useDLColorSpace = useDLColorSpace;
 @synthesize useGammaSubstitute = useGammaSubstitute;
 @synthesize useXRGB16U = useXRGB16U;
+@synthesize useVImageOnly = useVImageOnly;
+@synthesize threadCount = threadCount;
 
 - (void)setDlColorSpace:(CGColorSpaceRef)newColorSpace
 {
@@ -111,6 +134,16 @@
     }
 }
 
+- (void)setUseVImageOnly:(BOOL)newValue
+{
+    @synchronized (self) {
+        if (useVImageOnly != newValue) {
+            useVImageOnly = newValue;
+            needsPlanRefresh = (dlFormat != 0); // prepared plan depends on this flag
+        }
+    }
+}
+
 /* =================================================================================== */
 // MARK: Private accessor
 /* =================================================================================== */
@@ -132,7 +165,6 @@
 @synthesize infoToARGB = infoToARGB;
 @synthesize infoToYpCbCr = infoToYpCbCr;
 
-@synthesize dlHostBuffer = dlHostBuffer;
 @synthesize interimBuffer = interimBuffer;
 @synthesize argb8888Buffer = argb8888Buffer;
 
@@ -146,6 +178,16 @@
 @synthesize temp1216Buffer = temp1216Buffer;
 @synthesize queryTemp1216Buffer = queryTemp1216Buffer;
 
+@synthesize useV210Kernel = useV210Kernel;
+@synthesize needsPlanRefresh = needsPlanRefresh;
+
+@synthesize bandCount = bandCount;
+@synthesize bandRows = bandRows;
+@synthesize tempBufferStride = tempBufferStride;
+@synthesize temp1216BufferStride = temp1216BufferStride;
+
+@synthesize plan = plan;
+
 @synthesize pre1403 = pre1403;
 
 /* =================================================================================== */
@@ -599,11 +641,10 @@ NS_INLINE CGColorSpaceRef createColorSpaceSubstitutedFor(size_t w, size_t h, BOO
     return cs;
 }
 
-NS_INLINE BOOL dl12bits(IDeckLinkVideoFrame* videoFrame)
+NS_INLINE BOOL dl12bits(BMDPixelFormat format)
 {
     // Check if format is high bit depth (12bits and more)
     BOOL componentIn12bits = FALSE;
-    BMDPixelFormat format = videoFrame->GetPixelFormat();
     switch (format) {
         case bmdFormat12BitRGB:
         case bmdFormat12BitRGBLE:
@@ -615,22 +656,19 @@ NS_INLINE BOOL dl12bits(IDeckLinkVideoFrame* videoFrame)
     return componentIn12bits;
 }
 
-CGColorSpaceRef createColorSpaceForVideoFrame(IDeckLinkVideoFrame* videoFrame, BOOL tfSubstitute)
+CGColorSpaceRef createColorSpaceForDLFormat(BMDPixelFormat format, size_t w, size_t h, BOOL tfSubstitute)
 {
-    // Create ColorSpaceRef for IDeckLinkVideoFrame
-    size_t w = videoFrame->GetWidth();
-    size_t h = videoFrame->GetHeight();
-    
+    // Create ColorSpaceRef for IDeckLinkVideoFrame of format/size
     CGColorSpaceRef cs = NULL;
     if (!tfSubstitute) {
         {
-            cs = createColorSpaceITURFor(w, h, dl12bits(videoFrame));
+            cs = createColorSpaceITURFor(w, h, dl12bits(format));
         }
         if (!cs) {
             cs = CGColorSpaceCreateDeviceRGB(); // owned - inaccurate
         }
     } else {
-        cs = createColorSpaceSubstitutedFor(w, h, dl12bits(videoFrame));
+        cs = createColorSpaceSubstitutedFor(w, h, dl12bits(format));
     }
     return cs;
 }
@@ -821,6 +859,16 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
     }
 }
 
+// MARK: v210 kernel
+
+NS_INLINE BOOL v210KernelSupports(BMDPixelFormat dlFormat, OSType cvFormat)
+{
+    // YUV to YUV conversion which only changes bit depth; no matrix, no interimBuffer
+    if (dlFormat != bmdFormat10BitYUV) return FALSE;
+    return (cvFormat == kCVPixelFormatType_422YpCbCr8 ||
+            cvFormat == kCVPixelFormatType_422YpCbCr16);
+}
+
 /* =================================================================================== */
 // MARK: - Methods -
 /* =================================================================================== */
@@ -899,15 +947,19 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
 
 - (BOOL)applyFormatDL:(IDeckLinkVideoFrame*)videoFrame
 {
-    long width  = videoFrame->GetWidth();
-    long height = videoFrame->GetHeight();
-    long rowBytes = videoFrame->GetRowBytes();
+    return [self applyFormatDL:videoFrame->GetPixelFormat()
+                         width:videoFrame->GetWidth()
+                        height:videoFrame->GetHeight()
+                      rowBytes:videoFrame->GetRowBytes()];
+}
+
+- (BOOL)applyFormatDL:(BMDPixelFormat)format width:(long)width height:(long)height rowBytes:(long)rowBytes
+{
     BOOL endianSwap = false;
     int32_t rangeMin = 64;
     int32_t rangeMax = 940;
     BOOL default16Q12 = true;
     BOOL supported = (width * height > 0);
-    BMDPixelFormat format = videoFrame->GetPixelFormat();
     switch (format) {
         case bmdFormat8BitYUV:
             endianSwap = false;
@@ -960,7 +1012,7 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
     }
     if (supported) {
         if (!dlColorSpace) {
-            dlColorSpace = createColorSpaceForVideoFrame(videoFrame, useGammaSubstitute);
+            dlColorSpace = createColorSpaceForDLFormat(format, width, height, useGammaSubstitute);
         }
         if (dlColorSpace) {
             dlFormat = format;
@@ -980,6 +1032,7 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
 
 - (vImage_Error) vImageConvertDLRGB:(vImage_Buffer *)src
                           toInterim:(vImage_Buffer *)dest
+                           temp1216:(void *)temp
                               flags:(vImage_Flags)flags
 {
     // Convert DLRGB to interimBuffer
@@ -989,46 +1042,13 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
         // bmdFormat10BitRGBX
         // bmdFormat10BitRGB
         // bmdFormat12BitRGB
-        if (dlFormat == bmdFormat10BitRGBX) { // 1010102 BE
-            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-            if (!useXRGB16U) {
-                convErr = vImageConvert_RGBA1010102ToARGB16Q12(src, dest,
-                                                               dlRangeMin, dlRangeMax,
-                                                               permuteMap, flags);
-            } else {
-                convErr = vImageConvert_RGBA1010102ToARGB16U(src, dest,
-                                                             dlRangeMin, dlRangeMax,
-                                                             permuteMap, flags);
-            }
-        } else if (dlFormat == bmdFormat10BitRGB) { // 2101010 BE
-            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-            if (!useXRGB16U) {
-                convErr = vImageConvert_ARGB2101010ToARGB16Q12(src, dest,
-                                                               dlRangeMin, dlRangeMax,
-                                                               permuteMap, flags);
-            } else {
-                convErr = vImageConvert_ARGB2101010ToARGB16U(src, dest,
-                                                             dlRangeMin, dlRangeMax,
-                                                             permuteMap, flags);
-            }
-        } else if (dlFormat == bmdFormat12BitRGB) {
-            if (convRGB12UtoCG) { // R12L to interimBuffer converter reference
-                if (queryTemp1216Buffer) {
-                    queryTemp1216Buffer = FALSE;
-                    free(temp1216Buffer); temp1216Buffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convRGB12UtoCG, src, dest,
-                                                               temp1216Buffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        posix_memalign(&ptr, 16, (size_t)size);
-                        temp1216Buffer = ptr;
-                    }
-                }
-                endianRGB12U_L2B(src); // 12U endian swap in place
-                convErr = vImageConvert_AnyToAny(convRGB12UtoCG, src, dest,
-                                                 temp1216Buffer, flags);
-            }
-        }
+        // Fused endian swap and unpack; no host endian copy of VideoFrame is required
+        bool result = DLABKernelRGBUnpack(dlFormat,
+                                          src->data, src->rowBytes,
+                                          dest->data, dest->rowBytes,
+                                          src->width, src->height,
+                                          dlRangeMin, dlRangeMax, useXRGB16U);
+        convErr = (result ? kvImageNoError : kvImageInternalError);
     } else {
         // bmdFormat8BitARGB
         // bmdFormat8BitBGRA
@@ -1070,20 +1090,9 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
             }
         } else if (dlFormat == bmdFormat12BitRGBLE) {
             if (convRGB12UtoCG) { // R12L to interimBuffer converter reference
-                if (queryTemp1216Buffer) {
-                    queryTemp1216Buffer = FALSE;
-                    free(temp1216Buffer); temp1216Buffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convRGB12UtoCG, src, dest,
-                                                               temp1216Buffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        posix_memalign(&ptr, 16, (size_t)size);
-                        temp1216Buffer = ptr;
-                    }
-                }
                 endianRGB12U_L2B(src); // 12U endian swap in place
                 convErr = vImageConvert_AnyToAny(convRGB12UtoCG, src, dest,
-                                                 temp1216Buffer, flags);
+                                                 temp, flags);
             }
         }
     }
@@ -1092,6 +1101,7 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
 
 - (vImage_Error) vImageConvertInterim:(vImage_Buffer *)src
                               toDLRGB:(vImage_Buffer *)dest
+                             temp1216:(void *)temp
                                 flags:(vImage_Flags)flags
 {
     // Convert interimBuffer to DLRGB
@@ -1101,48 +1111,13 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
         // bmdFormat10BitRGBX
         // bmdFormat10BitRGB
         // bmdFormat12BitRGB
-        if (dlFormat == bmdFormat10BitRGBX) { // 1010102 BE
-            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-            if (!useXRGB16U) {
-                convErr = vImageConvert_ARGB16Q12ToRGBA1010102(src, dest,
-                                                               dlRangeMin, dlRangeMax,
-                                                               dlRangeMin, dlRangeMax,
-                                                               permuteMap, flags);
-            } else {
-                convErr = vImageConvert_ARGB16UToRGBA1010102(src, dest,
-                                                             dlRangeMin, dlRangeMax,
-                                                             permuteMap, flags);
-            }
-        } else if (dlFormat == bmdFormat10BitRGB) { // 2101010 BE
-            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-            if (!useXRGB16U) {
-                convErr = vImageConvert_ARGB16Q12ToARGB2101010(src, dest,
-                                                               dlRangeMin, dlRangeMax,
-                                                               dlRangeMin, dlRangeMax,
-                                                               permuteMap, flags);
-            } else {
-                convErr = vImageConvert_ARGB16UToARGB2101010(src, dest,
-                                                             dlRangeMin, dlRangeMax,
-                                                             permuteMap, flags);
-            }
-        } else if (dlFormat == bmdFormat12BitRGB) {
-            if (convCGtoRGB12U) { // interimBuffer to R12L converter reference
-                if (queryTemp1216Buffer) {
-                    queryTemp1216Buffer = FALSE;
-                    free(temp1216Buffer); temp1216Buffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convCGtoRGB12U, src, dest,
-                                                               temp1216Buffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        posix_memalign(&ptr, 16, (size_t)size);
-                        temp1216Buffer = ptr;
-                    }
-                }
-                convErr = vImageConvert_AnyToAny(convCGtoRGB12U, src, dest,
-                                                 temp1216Buffer, flags);
-                endianRGB12U_B2L(dest); // 12U endian swap in place
-            }
-        }
+        // Fused pack and endian swap; no host endian copy of VideoFrame is required
+        bool result = DLABKernelRGBPack(dlFormat,
+                                        src->data, src->rowBytes,
+                                        dest->data, dest->rowBytes,
+                                        src->width, src->height,
+                                        dlRangeMin, dlRangeMax, useXRGB16U);
+        convErr = (result ? kvImageNoError : kvImageInternalError);
     } else {
         // bmdFormat8BitARGB
         // bmdFormat8BitBGRA
@@ -1185,19 +1160,8 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
             }
         } else if (dlFormat == bmdFormat12BitRGBLE) {
             if (convCGtoRGB12U) { // interimBuffer to R12L converter reference
-                if (queryTemp1216Buffer) {
-                    queryTemp1216Buffer = FALSE;
-                    free(temp1216Buffer); temp1216Buffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convCGtoRGB12U, src, dest,
-                                                               temp1216Buffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        posix_memalign(&ptr, 16, (size_t)size);
-                        temp1216Buffer = ptr;
-                    }
-                }
                 convErr = vImageConvert_AnyToAny(convCGtoRGB12U, src, dest,
-                                                 temp1216Buffer, flags);
+                                                 temp, flags);
                 endianRGB12U_B2L(dest); // 12U endian swap in place
             }
         }
@@ -1205,6 +1169,596 @@ void endianRGB12U_L2B(vImage_Buffer *buffer) {
     return convErr;
 }
 
+- (vImage_Error) convertDLBand:(vImage_Buffer *)src
+                     toInterim:(vImage_Buffer *)dest
+                      argb8888:(vImage_Buffer *)argb
+                      temp1216:(void *)temp
+                         flags:(vImage_Flags)flags
+{
+    // Convert VideoFrame band to interimBuffer band
+    vImage_Error convErr = kvImageInternalError;
+    
+    if (dlEndianSwap) {
+        // Convert VideoFrame format (in BigEndian) to interimBuffer
+        {
+            // bmdFormat10BitRGBX
+            // bmdFormat10BitRGB
+            // bmdFormat12BitRGB
+            convErr = [self vImageConvertDLRGB:src
+                                     toInterim:dest
+                                      temp1216:temp
+                                         flags:flags];
+        }
+    } else {
+        // Convert VideoFrame format to interimBuffer
+        if (dlFormat == bmdFormat10BitYUV) { // v210
+            if (useXRGB16U) {
+                // conv: YUV10 => XRGB16Q12 => XRGB16U
+                {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    convErr = vImageConvert_422CrYpCbYpCbYpCbYpCrYpCrYp10ToARGB16Q12(src,
+                                                                                     dest,
+                                                                                     &infoToARGB,
+                                                                                     permuteMap,
+                                                                                     4096,
+                                                                                     flags);
+                }
+                if (convErr == kvImageNoError) {
+                    vImage_Buffer inPlace = *dest;
+                    inPlace.width = inPlace.width * 4;
+                    convErr = vImageConvert_16Q12to16U(&inPlace, &inPlace, flags);
+                }
+            } else {
+                // conv: YUV10 => XRGB16Q12
+                uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                convErr = vImageConvert_422CrYpCbYpCbYpCbYpCrYpCrYp10ToARGB16Q12(src,
+                                                                                 dest,
+                                                                                 &infoToARGB,
+                                                                                 permuteMap,
+                                                                                 4096,
+                                                                                 flags);
+            }
+        } else if (dlFormat == bmdFormat8BitYUV) { // 2vuy
+            if (useXRGB16U) {
+                // conv: YUV8 => XRGB8 => XRGB16U
+                {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    convErr = vImageConvert_422CbYpCrYp8ToARGB8888(src, argb,
+                                                                   &infoToARGB, permuteMap,
+                                                                   255, flags);
+                }
+                if (convErr == kvImageNoError) {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    uint8_t copyMask = 0;
+                    Pixel_16U bgColor[4] = {0,0,0,0};
+                    convErr = vImageConvert_ARGB8888ToARGB16U(argb, dest,
+                                                              permuteMap, copyMask, bgColor,
+                                                              flags);
+                }
+            } else {
+                // conv: YUV8 => XRGB8
+                uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                convErr = vImageConvert_422CbYpCrYp8ToARGB8888(src, dest,
+                                                               &infoToARGB, permuteMap,
+                                                               255, flags);
+            }
+        } else {
+            // bmdFormat8BitARGB
+            // bmdFormat8BitBGRA
+            // bmdFormat10BitRGBXLE
+            // bmdFormat12BitRGBLE
+            convErr = [self vImageConvertDLRGB:src
+                                     toInterim:dest
+                                      temp1216:temp
+                                         flags:flags];
+        }
+    }
+    return convErr;
+}
+
+- (vImage_Error) convertInterimBand:(vImage_Buffer *)src
+                               toDL:(vImage_Buffer *)dest
+                           argb8888:(vImage_Buffer *)argb
+                           temp1216:(void *)temp
+                              flags:(vImage_Flags)flags
+{
+    // Convert interimBuffer band to VideoFrame band
+    vImage_Error convErr = kvImageInternalError;
+    
+    if (dlEndianSwap) {
+        // Convert interimBuffer to VideoFrame format (in BigEndian)
+        {
+            // bmdFormat10BitRGBX
+            // bmdFormat10BitRGB
+            // bmdFormat12BitRGB
+            convErr = [self vImageConvertInterim:src
+                                         toDLRGB:dest
+                                        temp1216:temp
+                                           flags:flags];
+        }
+    } else {
+        // Convert interimBuffer to VideoFrame format
+        if (dlFormat == bmdFormat10BitYUV) { // v210
+            if (useXRGB16U) {
+                // conv: YUV10 <= XRGB16Q12 <= XRGB16U
+                {
+                    vImage_Buffer inPlace = *src;
+                    inPlace.width = inPlace.width * 4;
+                    convErr = vImageConvert_16Uto16Q12(&inPlace, &inPlace, flags);
+                }
+                if (convErr == kvImageNoError) {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    convErr = vImageConvert_ARGB16Q12To422CrYpCbYpCbYpCbYpCrYpCrYp10(src,
+                                                                                     dest,
+                                                                                     &infoToYpCbCr,
+                                                                                     permuteMap,
+                                                                                     flags);
+                }
+            } else {
+                // conv: YUV10 <= XRGB16Q12
+                uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                convErr = vImageConvert_ARGB16Q12To422CrYpCbYpCbYpCbYpCrYpCrYp10(src,
+                                                                                 dest,
+                                                                                 &infoToYpCbCr,
+                                                                                 permuteMap,
+                                                                                 flags);
+            }
+        } else if (dlFormat == bmdFormat8BitYUV) { // 2vuy
+            if (useXRGB16U) {
+                // conv: YUV8 <= XRGB8 <= XRGB16U
+                {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    uint8_t copyMask = 0;
+                    Pixel_8888 bgColor = {0,0,0,0};
+                    convErr = vImageConvert_ARGB16UToARGB8888(src, argb,
+                                                              permuteMap, copyMask, bgColor,
+                                                              flags);
+                }
+                if (convErr == kvImageNoError) {
+                    uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                    convErr = vImageConvert_ARGB8888To422CbYpCrYp8(argb, dest,
+                                                                   &infoToYpCbCr, permuteMap,
+                                                                   flags);
+                }
+            } else {
+                // conv: YUV8 <= XRGB8
+                uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
+                convErr = vImageConvert_ARGB8888To422CbYpCrYp8(src, dest,
+                                                               &infoToYpCbCr, permuteMap,
+                                                               flags);
+            }
+        } else {
+            // bmdFormat8BitARGB
+            // bmdFormat8BitBGRA
+            // bmdFormat10BitRGBXLE
+            // bmdFormat12BitRGBLE
+            convErr = [self vImageConvertInterim:src
+                                         toDLRGB:dest
+                                        temp1216:temp
+                                           flags:flags];
+        }
+    }
+    return convErr;
+}
+
+/* =================================================================================== */
+// MARK: Row-band scheduler
+/* =================================================================================== */
+
+/*
+ Each conversion stage is split into horizontal bands, and bands are processed in
+ parallel using dispatch_apply(). Every band starts at row boundary, so it always
+ starts at block boundary of packed formats (v210: 6 pixels in 16 bytes,
+ 12bit RGB: 8 pixels in 36 bytes). Each band uses its own slot of tempBuffer and
+ temp1216Buffer, so no scratch buffer is shared between worker threads.
+ */
+
+static const size_t kMaxBandCount = 16;
+static const vImagePixelCount kMinBandRows = 64;
+
+NS_INLINE vImage_Buffer bandOf(const vImage_Buffer* buffer, vImagePixelCount y, vImagePixelCount rows)
+{
+    vImage_Buffer band = *buffer;
+    if (band.data) {
+        band.data = (uint8_t*)buffer->data + buffer->rowBytes * y;
+        band.height = rows;
+    }
+    return band;
+}
+
+NS_INLINE void* tempSlotOf(void* buffer, size_t stride, size_t band)
+{
+    return (buffer ? (uint8_t*)buffer + stride * band : NULL);
+}
+
+- (void)updateBandPlan
+{
+    NSUInteger threads = threadCount;
+    if (threads == 0) {
+        threads = NSProcessInfo.processInfo.activeProcessorCount;
+    }
+    size_t count = MIN((size_t)threads, kMaxBandCount);
+    count = MIN(count, (size_t)MAX(dlHeight / kMinBandRows, 1));
+    count = MAX(count, (size_t)1);
+    
+    vImagePixelCount rows = (dlHeight + count - 1) / count;
+    rows = (rows + 1) & ~((vImagePixelCount)1); // keep even
+    count = (size_t)((dlHeight + rows - 1) / rows);
+    
+    if (count != bandCount || rows != bandRows) {
+        bandCount = count;
+        bandRows = rows;
+        
+        // Scratch buffer slots depend on band layout
+        queryTempBuffer = TRUE;
+        queryTemp1216Buffer = TRUE;
+    }
+}
+
+- (vImage_Error)processBands:(vImage_Error (^)(size_t band, vImagePixelCount y, vImagePixelCount rows))block
+{
+    size_t count = bandCount;
+    vImagePixelCount rows = bandRows;
+    vImagePixelCount height = dlHeight;
+    if (count <= 1) {
+        return block(0, 0, height);
+    }
+    
+    vImage_Error* results = (vImage_Error*)calloc(count, sizeof(vImage_Error));
+    if (!results) return kvImageMemoryAllocationError;
+    
+    dispatch_apply(count, DISPATCH_APPLY_AUTO, ^(size_t band) {
+        vImagePixelCount y = rows * band;
+        vImagePixelCount h = MIN(rows, height - y);
+        results[band] = block(band, y, h);
+    });
+    
+    vImage_Error convErr = kvImageNoError;
+    for (size_t band = 0; band < count; band++) {
+        if (results[band] != kvImageNoError) {
+            convErr = results[band];
+            break;
+        }
+    }
+    free(results);
+    return convErr;
+}
+
+- (vImage_Error)allocTempBuffer:(void**)buffer stride:(size_t*)stride
+                      converter:(vImageConverterRef)converter
+                         source:(const vImage_Buffer*)source target:(const vImage_Buffer*)target
+                          flags:(vImage_Flags)flags
+{
+    free(*buffer); *buffer = NULL;
+    *stride = 0;
+    
+    // Query with first band (the largest one), then allocate one slot per band
+    vImagePixelCount rows = MIN(bandRows, source->height);
+    vImage_Buffer sourceBand = bandOf(source, 0, rows);
+    vImage_Buffer targetBand = bandOf(target, 0, rows);
+    vImage_Error size = vImageConvert_AnyToAny(converter, &sourceBand, &targetBand,
+                                               NULL, flags | kvImageGetTempBufferSize);
+    if (size < 0) return size;
+    if (size > 0) {
+        size_t slot = ((size_t)size + 63) & ~((size_t)63);
+        void* ptr = NULL;
+        if (posix_memalign(&ptr, 64, slot * MAX(bandCount, (size_t)1)) == 0 && ptr != NULL) {
+            *buffer = ptr;
+            *stride = slot;
+        } else {
+            return kvImageMemoryAllocationError;
+        }
+    }
+    return kvImageNoError;
+}
+
+/* =================================================================================== */
+// MARK: Conversion plan
+/* =================================================================================== */
+
+/*
+ YpCbCr conversion info and vImageConverter objects depend only on format/size/
+ colorspaces of both side, so they are prepared once as DLABConversionPlan and
+ shared process-wide via DLABConversionPlanCache. Converter recreated for same
+ configuration (e.g. input format change back and forth) reuses cached plan and
+ its parked scratch buffers, instead of regenerating them.
+ */
+
+static const uint32_t kPlanFlagUseDLColorSpace = 1 << 0;
+static const uint32_t kPlanFlagUseXRGB16U = 1 << 1;
+
+- (DLABConversionPlanKey*)planKeyFor:(CVPixelBufferRef)pixelBuffer toCV:(BOOL)toCV
+{
+    uint32_t flags = 0;
+    if (useDLColorSpace) flags |= kPlanFlagUseDLColorSpace;
+    if (useXRGB16U) flags |= kPlanFlagUseXRGB16U;
+    
+    // vImageCVImageFormat_CreateWithCVPixelBuffer() respects these attachments
+    CFTypeRef matrix = CVBufferGetAttachment(pixelBuffer, kCVImageBufferYCbCrMatrixKey, NULL);
+    CFTypeRef chroma = CVBufferGetAttachment(pixelBuffer, kCVImageBufferChromaLocationTopFieldKey, NULL);
+    
+    return [[DLABConversionPlanKey alloc] initToCV:toCV
+                                          dlFormat:dlFormat
+                                          cvFormat:cvFormat
+                                             width:dlWidth
+                                            height:dlHeight
+                                      dlColorSpace:dlColorSpace
+                                      cvColorSpace:cvColorSpace
+                                       ycbcrMatrix:matrix
+                                    chromaLocation:chroma
+                                             flags:flags];
+}
+
+- (nullable DLABConversionPlan*)createPlanDLtoCV:(CVPixelBufferRef)pixelBuffer
+{
+    DLABConversionPlan* newPlan = [[DLABConversionPlan alloc] init];
+    
+    vImage_Error matrixErr = kvImageInternalError;
+    vImage_Error errCGtoCV = kvImageInternalError;
+    vImage_Error errRGB12UtoCG = kvImageInternalError;
+    {
+        if (dlFormat == bmdFormat10BitYUV) {
+            // conv: YUV10 => either RGB8 or RGB16Q12; No RGB16U. See vImage/Conversion.h
+            vImage_YpCbCrToARGBMatrix matrix = matrixToRGBFor(dlWidth, dlHeight);
+            vImage_YpCbCrPixelRange pixelRange = videoRange10Clamped();
+            vImage_YpCbCrToARGB info = {0};
+            vImageARGBType interimType = (dlDefault16Q12 ? kvImageARGB16Q12 : kvImageARGB8888);
+            matrixErr = vImageConvert_YpCbCrToARGB_GenerateConversion(&matrix,
+                                                                      &pixelRange,
+                                                                      &info,
+                                                                      kvImage422CrYpCbYpCbYpCbYpCrYpCrYp10,
+                                                                      interimType,
+                                                                      kvImageNoFlags);
+            if (matrixErr == kvImageNoError) newPlan.infoToARGB = info;
+        } else if (dlFormat == bmdFormat8BitYUV) {
+            // conv: YUV8 => RGB8 only; See vImage/Conversion.h
+            vImage_YpCbCrToARGBMatrix matrix = matrixToRGBFor(dlWidth, dlHeight);
+            vImage_YpCbCrPixelRange pixelRange = videoRange8Clamped();
+            vImage_YpCbCrToARGB info = {0};
+            vImageARGBType interimType = (kvImageARGB8888);
+            matrixErr = vImageConvert_YpCbCrToARGB_GenerateConversion(&matrix,
+                                                                      &pixelRange,
+                                                                      &info,
+                                                                      kvImage422CbYpCrYp8,
+                                                                      interimType,
+                                                                      kvImageNoFlags);
+            if (matrixErr == kvImageNoError) {
+                newPlan.infoToARGB = info;
+                
+                // For useXRGB16U: YUV8 => RGB8 => RGB16; See vImage/Conversion.h
+                newPlan.useARGB8888Buffer = useXRGB16U;
+            }
+        } else {
+            // RGBtoRGB conversion
+            matrixErr = kvImageNoError;
+        }
+        if (matrixErr) {
+            NSLog(@"ERROR: vImageConvert_YpCbCrToARGB_GenerateConversion() failed.");
+        }
+    }
+    vImage_CGImageFormat interimFormat = {0};
+    if (matrixErr == kvImageNoError) {
+        CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
+        interimFormat = (useXRGB16U ? formatXRGB16U(cs) :
+                         (dlDefault16Q12 ? formatXRGB16Q12(cs) : formatXRGB8888(cs)));
+        newPlan.interimBitsPerPixel = interimFormat.bitsPerPixel;
+        
+        vImageCVImageFormatRef outFormat = vImageCVImageFormat_CreateWithCVPixelBuffer(pixelBuffer);
+        if (outFormat) {
+            assert(kvImageNoError == fillCVColorSpace(outFormat, cvColorSpace));
+            assert(kvImageNoError == fillCVChromaSiting(outFormat, kCVImageBufferChromaLocation_Center));
+            assert(kvImageNoError == fillCVConversionMatrix(outFormat, matrixToYpCbCrFor(dlWidth, dlHeight)));
+            vImage_Flags flags = kvImageNoFlags; // kvImagePrintDiagnosticsToConsole
+            CGFloat bgColor[3] = {0,0,0};
+            vImageConverterRef conv = vImageConverter_CreateForCGToCVImageFormat(&interimFormat,
+                                                                                 outFormat,
+                                                                                 bgColor,
+                                                                                 flags,
+                                                                                 &errCGtoCV);
+            if (errCGtoCV || !conv) {
+                NSLog(@"ERROR: vImageConverter_CreateForCGToCVImageFormat() failed.(%ld)", errCGtoCV);
+            }
+            newPlan.mainConverter = conv;
+            vImageConverter_Release(conv);
+            vImageCVImageFormat_Release(outFormat);
+        } else {
+            NSLog(@"ERROR: vImageCVImageFormat_CreateWithCVPixelBuffer() failed.");
+        }
+    }
+    if (errCGtoCV == kvImageNoError) {
+        if (dlFormat == bmdFormat12BitRGBLE) { // R12B is handled by DLABRGBKernel
+            CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
+            vImage_CGImageFormat inFormat = formatRGB12U(cs);
+            CGFloat bgColor[3] = {0,0,0};
+            vImageConverterRef conv = vImageConverter_CreateWithCGImageFormat(&inFormat,
+                                                                              &interimFormat,
+                                                                              bgColor,
+                                                                              kvImageNoFlags,
+                                                                              &errRGB12UtoCG);
+            newPlan.rgb12UConverter = conv;
+            vImageConverter_Release(conv);
+        } else {
+            errRGB12UtoCG = kvImageNoError;
+        }
+    }
+    
+    BOOL planOK = (newPlan.mainConverter != NULL && errRGB12UtoCG == kvImageNoError);
+    return (planOK ? newPlan : nil);
+}
+
+- (nullable DLABConversionPlan*)createPlanCVtoDL:(CVPixelBufferRef)pixelBuffer
+{
+    DLABConversionPlan* newPlan = [[DLABConversionPlan alloc] init];
+    
+    vImage_Error matrixErr = kvImageInternalError;
+    vImage_Error errCVtoCG = kvImageInternalError;
+    vImage_Error errCGtoRGB12U = kvImageInternalError;
+    {
+        if (dlFormat == bmdFormat10BitYUV) {
+            // conv: YUV10 <= either RGB8 or RGB16Q12; No RGB16U. See vImage/Conversion.h
+            vImage_ARGBToYpCbCrMatrix matrix = matrixToYpCbCrFor(dlWidth, dlHeight);
+            vImage_YpCbCrPixelRange pixelRange = videoRange10Clamped();
+            vImage_ARGBToYpCbCr info = {0};
+            vImageARGBType interimType = (dlDefault16Q12 ? kvImageARGB16Q12 : kvImageARGB8888);
+            matrixErr = vImageConvert_ARGBToYpCbCr_GenerateConversion(&matrix,
+                                                                      &pixelRange,
+                                                                      &info,
+                                                                      interimType,
+                                                                      kvImage422CrYpCbYpCbYpCbYpCrYpCrYp10,
+                                                                      kvImageNoFlags);
+            if (matrixErr == kvImageNoError) newPlan.infoToYpCbCr = info;
+        } else if (dlFormat == bmdFormat8BitYUV) {
+            // conv: YUV8 <= RGB8 only; See vImage/Conversion.h
+            vImage_ARGBToYpCbCrMatrix matrix = matrixToYpCbCrFor(dlWidth, dlHeight);
+            vImage_YpCbCrPixelRange pixelRange = videoRange8Clamped();
+            vImage_ARGBToYpCbCr info = {0};
+            vImageARGBType interimType = (kvImageARGB8888);
+            matrixErr = vImageConvert_ARGBToYpCbCr_GenerateConversion(&matrix,
+                                                                      &pixelRange,
+                                                                      &info,
+                                                                      interimType,
+                                                                      kvImage422CbYpCrYp8,
+                                                                      kvImageNoFlags);
+            if (matrixErr == kvImageNoError) {
+                newPlan.infoToYpCbCr = info;
+                
+                // For useXRGB16U: YUV8 <= RGB8 <= RGB16; See vImage/Conversion.h
+                newPlan.useARGB8888Buffer = useXRGB16U;
+            }
+        } else {
+            // RGBtoTGB conversion
+            matrixErr = kvImageNoError;
+        }
+        if (matrixErr) {
+            NSLog(@"ERROR: vImageConvert_ARGBToYpCbCr_GenerateConversion() failed.");
+        }
+    }
+    vImage_CGImageFormat interimFormat = {0};
+    if (matrixErr == kvImageNoError) {
+        CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
+        interimFormat = (useXRGB16U ? formatXRGB16U(cs) :
+                         (dlDefault16Q12 ? formatXRGB16Q12(cs) : formatXRGB8888(cs)));
+        newPlan.interimBitsPerPixel = interimFormat.bitsPerPixel;
+        
+        vImageCVImageFormatRef inFormat = vImageCVImageFormat_CreateWithCVPixelBuffer(pixelBuffer);
+        if (inFormat) {
+            assert(kvImageNoError == fillCVColorSpace(inFormat, cvColorSpace));
+            assert(kvImageNoError == fillCVChromaSiting(inFormat, kCVImageBufferChromaLocation_Center));
+            assert(kvImageNoError == fillCVConversionMatrix(inFormat, matrixToYpCbCrFor(dlWidth, dlHeight)));
+            vImage_Flags flags = kvImageNoFlags; // kvImagePrintDiagnosticsToConsole
+            CGFloat bgColor[3] = {0,0,0};
+            vImageConverterRef conv = vImageConverter_CreateForCVToCGImageFormat(inFormat,
+                                                                                 &interimFormat,
+                                                                                 bgColor,
+                                                                                 flags,
+                                                                                 &errCVtoCG);
+            if (errCVtoCG || !conv) {
+                NSLog(@"ERROR: vImageConverter_CreateForCVToCGImageFormat() failed.(%ld)", errCVtoCG);
+            }
+            newPlan.mainConverter = conv;
+            vImageConverter_Release(conv);
+            vImageCVImageFormat_Release(inFormat);
+        } else {
+            NSLog(@"ERROR: vImageCVImageFormat_CreateWithCVPixelBuffer() failed.");
+        }
+    }
+    if (errCVtoCG == kvImageNoError) {
+        if (dlFormat == bmdFormat12BitRGBLE) { // R12B is handled by DLABRGBKernel
+            CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
+            vImage_CGImageFormat outFormat = formatRGB12U(cs);
+            CGFloat bgColor[3] = {0,0,0};
+            vImageConverterRef conv = vImageConverter_CreateWithCGImageFormat(&interimFormat,
+                                                                              &outFormat,
+                                                                              bgColor,
+                                                                              kvImageNoFlags,
+                                                                              &errCGtoRGB12U);
+            newPlan.rgb12UConverter = conv;
+            vImageConverter_Release(conv);
+        } else {
+            errCGtoRGB12U = kvImageNoError;
+        }
+    }
+    
+    BOOL planOK = (newPlan.mainConverter != NULL && errCGtoRGB12U == kvImageNoError);
+    return (planOK ? newPlan : nil);
+}
+
+- (void)releasePlan
+{
+    // Return scratch buffers to plan for next converter
+    if (plan) {
+        [plan checkinInterimBuffer:&interimBuffer argb8888Buffer:&argb8888Buffer];
+        plan = nil;
+    } else {
+        free(interimBuffer.data); interimBuffer = {0};
+        free(argb8888Buffer.data); argb8888Buffer = {0};
+    }
+    
+    vImageConverter_Release(convCVtoCG); convCVtoCG = NULL;
+    vImageConverter_Release(convCGtoCV); convCGtoCV = NULL;
+    vImageConverter_Release(convRGB12UtoCG); convRGB12UtoCG = NULL;
+    vImageConverter_Release(convCGtoRGB12U); convCGtoRGB12U = NULL;
+}
+
+- (BOOL)adoptPlan:(DLABConversionPlan*)newPlan toCV:(BOOL)toCV
+{
+    BOOL buffersOK = [newPlan checkoutInterimBuffer:&interimBuffer
+                                     argb8888Buffer:&argb8888Buffer
+                                              width:dlWidth
+                                             height:dlHeight];
+    if (!buffersOK) return FALSE;
+    
+    plan = newPlan;
+    
+    vImageConverterRef mainConverter = newPlan.mainConverter;
+    vImageConverterRef rgb12UConverter = newPlan.rgb12UConverter;
+    vImageConverter_Retain(mainConverter);
+    if (rgb12UConverter) vImageConverter_Retain(rgb12UConverter);
+    if (toCV) {
+        infoToARGB = newPlan.infoToARGB;
+        convCGtoCV = mainConverter;
+        convRGB12UtoCG = rgb12UConverter;
+    } else {
+        infoToYpCbCr = newPlan.infoToYpCbCr;
+        convCVtoCG = mainConverter;
+        convCGtoRGB12U = rgb12UConverter;
+    }
+    
+    // Scratch buffer depends on vImageConverter
+    queryTempBuffer = TRUE;
+    free(tempBuffer); tempBuffer = NULL;
+    queryTemp1216Buffer = TRUE;
+    free(temp1216Buffer); temp1216Buffer = NULL;
+    return TRUE;
+}
+
+- (BOOL)preparePlanFor:(CVPixelBufferRef)pixelBuffer toCV:(BOOL)toCV
+{
+    @synchronized (self) {
+        [self releasePlan];
+        needsPlanRefresh = FALSE;
+        
+        // Kernel only repacks samples; colorspace conversion requires vImage
+        BOOL colorSpaceMatched = (!useDLColorSpace && dlColorSpace && cvColorSpace &&
+                                  CFEqual(dlColorSpace, cvColorSpace));
+        useV210Kernel = (!useVImageOnly && colorSpaceMatched && v210KernelSupports(dlFormat, cvFormat));
+        if (useV210Kernel) {
+            return TRUE; // No interimBuffer nor vImageConverter is required
+        }
+        
+        // Reuse prepared plan of same configuration if available
+        DLABConversionPlanCache* cache = DLABConversionPlanCache.sharedCache;
+        DLABConversionPlanKey* key = [self planKeyFor:pixelBuffer toCV:toCV];
+        DLABConversionPlan* newPlan = [cache planForKey:key];
+        if (!newPlan) {
+            newPlan = (toCV ? [self createPlanDLtoCV:pixelBuffer] : [self createPlanCVtoDL:pixelBuffer]);
+            if (!newPlan) return FALSE;
+            [cache setPlan:newPlan forKey:key];
+        }
+        return [self adoptPlan:newPlan toCV:toCV];
+    }
+}
+
 /* =================================================================================== */
 // MARK: DL VideoBuffer Lock/Unlock Base Address (SDK 14.3 or later)
 /* =================================================================================== */
@@ -1248,6 +1802,46 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
 // MARK: Public methods
 /* =================================================================================== */
 
++ (BOOL)prewarmPlanForDLFormat:(BMDPixelFormat)format
+                         width:(long)width
+                        height:(long)height
+                          toCV:(CVPixelBufferRef)pixelBuffer
+{
+    NSParameterAssert(pixelBuffer != NULL);
+    
+    return [self prewarmPlanForDLFormat:format width:width height:height
+                            pixelBuffer:pixelBuffer toCV:TRUE];
+}
+
++ (BOOL)prewarmPlanForCV:(CVPixelBufferRef)pixelBuffer
+              toDLFormat:(BMDPixelFormat)format
+                   width:(long)width
+                  height:(long)height
+{
+    NSParameterAssert(pixelBuffer != NULL);
+    
+    return [self prewarmPlanForDLFormat:format width:width height:height
+                            pixelBuffer:pixelBuffer toCV:FALSE];
+}
+
++ (BOOL)prewarmPlanForDLFormat:(BMDPixelFormat)format
+                         width:(long)width
+                        height:(long)height
+                   pixelBuffer:(CVPixelBufferRef)pixelBuffer
+                          toCV:(BOOL)toCV
+{
+    // Prepared plan is registered in cache; scratch buffers are parked on dealloc
+    DLABVideoConverter* converter = [[DLABVideoConverter alloc] init];
+    BOOL dlReady = [converter applyFormatDL:format width:width height:height rowBytes:0];
+    BOOL cvReady = [converter applyFormatCV:pixelBuffer];
+    if (!(dlReady && cvReady)) return FALSE;
+    
+    BOOL noScaling = (converter.dlWidth == converter.cvWidth && converter.dlHeight == converter.cvHeight);
+    if (!noScaling) return FALSE;
+    
+    return [converter preparePlanFor:pixelBuffer toCV:toCV];
+}
+
 - (void)cleanup
 {
     @synchronized (self) {
@@ -1265,21 +1859,22 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
         dlDefault16Q12 = FALSE;
         
         useXRGB16U = FALSE;
+        useVImageOnly = FALSE;
+        useV210Kernel = FALSE;
+        needsPlanRefresh = FALSE;
         infoToARGB = {0}; infoToYpCbCr = {0};
         
-        free(dlHostBuffer.data); dlHostBuffer = {0};
-        free(interimBuffer.data); interimBuffer = {0};
-        free(argb8888Buffer.data); argb8888Buffer = {0};
+        [self releasePlan]; // interimBuffer, argb8888Buffer and vImageConverters
         
-        vImageConverter_Release(convCVtoCG); convCVtoCG = NULL;
-        vImageConverter_Release(convCGtoCV); convCGtoCV = NULL;
         free(tempBuffer); tempBuffer = NULL;
+        tempBufferStride = 0;
         queryTempBuffer = TRUE;
         
-        vImageConverter_Release(convRGB12UtoCG); convRGB12UtoCG = NULL;
-        vImageConverter_Release(convCGtoRGB12U); convCGtoRGB12U = NULL;
         free(temp1216Buffer); temp1216Buffer = NULL;
+        temp1216BufferStride = 0;
         queryTemp1216Buffer = TRUE;
+        
+        bandCount = 0; bandRows = 0;
     }
 }
 
@@ -1323,144 +1918,7 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
     BOOL formatOK = [self compatibleWithDL:videoFrame andCV:pixelBuffer];
     if (!formatOK) return false;
     
-    @synchronized (self) {
-        {
-            free(dlHostBuffer.data); dlHostBuffer = {0};
-            free(interimBuffer.data); interimBuffer = {0};
-            free(argb8888Buffer.data); argb8888Buffer = {0};
-            vImageConverter_Release(convCGtoCV); convCGtoCV = NULL;
-        }
-        
-        vImage_Error matrixErr = kvImageInternalError;
-        vImage_Error dlHostErr = kvImageInternalError;
-        vImage_Error interimErr = kvImageInternalError;
-        vImage_Error errCGtoCV = kvImageInternalError;
-        vImage_Error errRGB12UtoCG = kvImageInternalError;
-        {
-            if (dlFormat == bmdFormat10BitYUV) {
-                // conv: YUV10 => either RGB8 or RGB16Q12; No RGB16U. See vImage/Conversion.h
-                vImage_YpCbCrToARGBMatrix matrix = matrixToRGBFor(dlWidth, dlHeight);
-                vImage_YpCbCrPixelRange pixelRange = videoRange10Clamped();
-                vImage_YpCbCrToARGB info = {0};
-                vImageARGBType interimType = (dlDefault16Q12 ? kvImageARGB16Q12 : kvImageARGB8888);
-                matrixErr = vImageConvert_YpCbCrToARGB_GenerateConversion(&matrix,
-                                                                          &pixelRange,
-                                                                          &info,
-                                                                          kvImage422CrYpCbYpCbYpCbYpCrYpCrYp10,
-                                                                          interimType,
-                                                                          kvImageNoFlags);
-                if (matrixErr == kvImageNoError) infoToARGB = info;
-            } else if (dlFormat == bmdFormat8BitYUV) {
-                // conv: YUV8 => RGB8 only; See vImage/Conversion.h
-                vImage_YpCbCrToARGBMatrix matrix = matrixToRGBFor(dlWidth, dlHeight);
-                vImage_YpCbCrPixelRange pixelRange = videoRange8Clamped();
-                vImage_YpCbCrToARGB info = {0};
-                vImageARGBType interimType = (kvImageARGB8888);
-                matrixErr = vImageConvert_YpCbCrToARGB_GenerateConversion(&matrix,
-                                                                          &pixelRange,
-                                                                          &info,
-                                                                          kvImage422CbYpCrYp8,
-                                                                          interimType,
-                                                                          kvImageNoFlags);
-                if (matrixErr == kvImageNoError) {
-                    infoToARGB = info;
-                    
-                    // For useXRGB16U: YUV8 => RGB8 => RGB16; See vImage/Conversion.h
-                    if (useXRGB16U) {
-                        size_t rowBytes = (dlWidth * 4);
-                        void* ptr = NULL;
-                        size_t bufferSize = (rowBytes * dlHeight);
-                        if (posix_memalign(&ptr, 16, bufferSize) == 0 && ptr != NULL) {
-                            argb8888Buffer.data = ptr;
-                            argb8888Buffer.width = dlWidth;
-                            argb8888Buffer.height = dlHeight;
-                            argb8888Buffer.rowBytes = rowBytes;
-                        } else {
-                            matrixErr = kvImageInternalError;
-                        }
-                    }
-                }
-            } else {
-                // RGBtoRGB conversion
-                matrixErr = kvImageNoError;
-            }
-            if (matrixErr) {
-                NSLog(@"ERROR: vImageConvert_YpCbCrToARGB_GenerateConversion() failed.");
-            }
-        }
-        vImage_CGImageFormat interimFormat = {0};
-        if (matrixErr == kvImageNoError) {
-            void* ptr = NULL;
-            size_t bufferSize = (dlRowBytes * dlHeight);
-            if (posix_memalign(&ptr, 16, bufferSize) == 0 && ptr != NULL) {
-                dlHostBuffer.data = ptr;
-                dlHostBuffer.width = dlWidth;
-                dlHostBuffer.height = dlHeight;
-                dlHostBuffer.rowBytes = dlRowBytes;
-                dlHostErr = kvImageNoError;
-            }
-        }
-        if (dlHostErr == kvImageNoError) {
-            CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
-            interimFormat = (useXRGB16U ? formatXRGB16U(cs) :
-                             (dlDefault16Q12 ? formatXRGB16Q12(cs) : formatXRGB8888(cs)));
-            interimErr = vImageBuffer_Init(&interimBuffer,
-                                           dlHeight, dlWidth, // rect of VideoFrame
-                                           interimFormat.bitsPerPixel, kvImageNoFlags);
-        }
-        if (interimErr == kvImageNoError) {
-            vImageCVImageFormatRef outFormat = vImageCVImageFormat_CreateWithCVPixelBuffer(pixelBuffer);
-            if (outFormat) {
-                assert(kvImageNoError == fillCVColorSpace(outFormat, cvColorSpace));
-                assert(kvImageNoError == fillCVChromaSiting(outFormat, kCVImageBufferChromaLocation_Center));
-                assert(kvImageNoError == fillCVConversionMatrix(outFormat, matrixToYpCbCrFor(dlWidth, dlHeight)));
-                vImage_Flags flags = kvImageNoFlags; // kvImagePrintDiagnosticsToConsole
-                CGFloat bgColor[3] = {0,0,0};
-                convCGtoCV = vImageConverter_CreateForCGToCVImageFormat(&interimFormat,
-                                                                        outFormat,
-                                                                        bgColor,
-                                                                        flags,
-                                                                        &errCGtoCV);
-                if (errCGtoCV || !convCGtoCV) {
-                    NSLog(@"ERROR: vImageConverter_CreateForCGToCVImageFormat() failed.(%ld)", errCGtoCV);
-                }
-                vImageCVImageFormat_Release(outFormat);
-                
-                queryTempBuffer = TRUE;
-                free(tempBuffer); tempBuffer = NULL;
-            } else {
-                NSLog(@"ERROR: vImageCVImageFormat_CreateWithCVPixelBuffer() failed.");
-            }
-        }
-        if (errCGtoCV == kvImageNoError) {
-            if (dlFormat == bmdFormat12BitRGB || dlFormat == bmdFormat12BitRGBLE) {
-                CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
-                vImage_CGImageFormat inFormat = formatRGB12U(cs);
-                CGFloat bgColor[3] = {0,0,0};
-                convRGB12UtoCG = vImageConverter_CreateWithCGImageFormat(&inFormat,
-                                                                         &interimFormat,
-                                                                         bgColor,
-                                                                         kvImageNoFlags,
-                                                                         &errRGB12UtoCG);
-                
-                queryTemp1216Buffer = TRUE;
-                free(temp1216Buffer); temp1216Buffer = NULL;
-            } else {
-                errRGB12UtoCG = kvImageNoError;
-            }
-        }
-        
-        BOOL converterOK = (dlHostBuffer.data != NULL && interimBuffer.data != NULL && convCGtoCV != NULL);
-        converterOK = converterOK && (errRGB12UtoCG == kvImageNoError);
-        if (!converterOK) {
-            free(dlHostBuffer.data); dlHostBuffer = {0};
-            free(interimBuffer.data); interimBuffer = {0};
-            free(argb8888Buffer.data); argb8888Buffer = {0};
-            vImageConverter_Release(convCGtoCV); convCGtoCV = NULL;
-            vImageConverter_Release(convRGB12UtoCG); convRGB12UtoCG = NULL;
-        }
-        return converterOK;
-    }
+    return [self preparePlanFor:pixelBuffer toCV:TRUE];
 }
 
 - (BOOL)convertDL:(IDeckLinkVideoFrame*)videoFrame toCV:(CVPixelBufferRef)pixelBuffer
@@ -1469,7 +1927,11 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
     
     //
     BOOL formatOK = [self compatibleWithDL:videoFrame andCV:pixelBuffer];
-    BOOL converterOK = (dlHostBuffer.data != NULL && interimBuffer.data != NULL && convCGtoCV != NULL);
+    if (formatOK && needsPlanRefresh) {
+        if (![self preparePlanFor:pixelBuffer toCV:TRUE]) return FALSE;
+    }
+    BOOL converterOK = (interimBuffer.data != NULL && convCGtoCV != NULL);
+    converterOK = converterOK || useV210Kernel;
     if (!(formatOK && converterOK)) {
         return FALSE; // unsupported conversion
     }
@@ -1484,108 +1946,88 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
             }
         }
         
-        /* ================================================================ */
-        // VideoFrame [(permute) dlHostBuffer] (xfer) interimBuffer (convCGtoCV) CVPixelBuffer
-        /* ================================================================ */
+        // source vImage_Buffer
+        void* ptr = NULL;
+        if (!pre1403) {
+            VideoBufferGetBaseAddress(videoBuffer, &ptr);
+        } else {
+            IDeckLinkVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkVideoFrame_v14_2_1*)videoFrame;
+            videoFrame_v14_2_1->GetBytes(&ptr);
+        }
+        assert (ptr != NULL);
+        
+        vImage_Buffer sourceBuffer = {
+            .data = ptr,
+            .width = dlWidth,
+            .height = dlHeight,
+            .rowBytes = dlRowBytes
+        };
+        
+        [self updateBandPlan];
+        vImage_Flags flags = (bandCount > 1 ? kvImageDoNotTile : kvImageNoFlags);
         
         vImage_Error convErr = kvImageNoError;
-        {
-            // source vImage_Buffer
-            void* ptr = NULL;
-            if (!pre1403) {
-                VideoBufferGetBaseAddress(videoBuffer, &ptr);
-            } else {
-                IDeckLinkVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkVideoFrame_v14_2_1*)videoFrame;
-                videoFrame_v14_2_1->GetBytes(&ptr);
-            }
-            assert (ptr != NULL);
+        if (useV210Kernel) {
+            /* ================================================================ */
+            // VideoFrame (DLABV210Kernel) CVPixelBuffer
+            /* ================================================================ */
             
-            vImage_Buffer sourceBuffer = {
-                .data = ptr,
-                .width = dlWidth,
-                .height = dlHeight,
-                .rowBytes = dlRowBytes
-            };
-            
-            // Read from VideoFrame
-            if (dlEndianSwap) {
-                // Permute BigToHost
-                {
-                    uint8_t permuteMap[4] = {3,2,1,0};
-                    convErr = vImagePermuteChannels_ARGB8888(&sourceBuffer, &dlHostBuffer,
-                                                             permuteMap, kvImageNoFlags);
-                }
-                // Convert VideoFrame format (in hostEndian) to interimBuffer
-                if (convErr == kvImageNoError) {
-                    // bmdFormat10BitRGBX
-                    // bmdFormat10BitRGB
-                    // bmdFormat12BitRGB
-                    convErr = [self vImageConvertDLRGB:&dlHostBuffer
-                                             toInterim:&interimBuffer
-                                                 flags:kvImageNoFlags];
-                }
-            } else {
-                // Convert VideoFrame format to interimBuffer
-                if (dlFormat == bmdFormat10BitYUV) { // v210
-                    if (useXRGB16U) {
-                        // conv: YUV10 => XRGB16Q12 => XRGB16U
-                        {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            convErr = vImageConvert_422CrYpCbYpCbYpCbYpCrYpCrYp10ToARGB16Q12(&sourceBuffer,
-                                                                                             &interimBuffer,
-                                                                                             &infoToARGB,
-                                                                                             permuteMap,
-                                                                                             4096,
-                                                                                             kvImageNoFlags);
-                        }
-                        if (convErr == kvImageNoError) {
-                            vImage_Buffer inPlace = interimBuffer;
-                            inPlace.width = inPlace.width * 4;
-                            convErr = vImageConvert_16Q12to16U(&inPlace, &inPlace, kvImageNoFlags);
-                        }
-                    } else {
-                        // conv: YUV10 => XRGB16Q12
-                        uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                        convErr = vImageConvert_422CrYpCbYpCbYpCbYpCrYpCrYp10ToARGB16Q12(&sourceBuffer,
-                                                                                         &interimBuffer,
-                                                                                         &infoToARGB,
-                                                                                         permuteMap,
-                                                                                         4096,
-                                                                                         kvImageNoFlags);
-                    }
-                } else if (dlFormat == bmdFormat8BitYUV) { // 2vuy
-                    if (useXRGB16U) {
-                        // conv: YUV8 => XRGB8 => XRGB16U
-                        {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            convErr = vImageConvert_422CbYpCrYp8ToARGB8888(&sourceBuffer, &argb8888Buffer,
-                                                                           &infoToARGB, permuteMap,
-                                                                           255, kvImageNoFlags);
-                        }
-                        if (convErr == kvImageNoError) {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            uint8_t copyMask = 0;
-                            Pixel_16U bgColor[4] = {0,0,0,0};
-                            convErr = vImageConvert_ARGB8888ToARGB16U(&argb8888Buffer, &interimBuffer,
-                                                                      permuteMap, copyMask, bgColor,
-                                                                      kvImageNoFlags);
+            CVPixelBufferLockBaseAddress(pixelBuffer, 0);
+            {
+                vImage_Buffer targetBuffer = {
+                    .data = CVPixelBufferGetBaseAddress(pixelBuffer),
+                    .width = cvWidth,
+                    .height = cvHeight,
+                    .rowBytes = CVPixelBufferGetBytesPerRow(pixelBuffer)
+                };
+                BOOL to2vuy = (cvFormat == kCVPixelFormatType_422YpCbCr8);
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&sourceBuffer, y, rows);
+                    vImage_Buffer dst = bandOf(&targetBuffer, y, rows);
+                    bool result = false;
+                    if (src.data && dst.data) {
+                        if (to2vuy) {
+                            result = DLABKernelV210To2vuy(src.data, src.rowBytes, dst.data, dst.rowBytes,
+                                                          src.width, src.height);
+                        } else {
+                            result = DLABKernelV210ToV216(src.data, src.rowBytes, dst.data, dst.rowBytes,
+                                                          src.width, src.height);
                         }
-                    } else {
-                        // conv: YUV8 => XRGB8
-                        uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                        convErr = vImageConvert_422CbYpCrYp8ToARGB8888(&sourceBuffer, &interimBuffer,
-                                                                       &infoToARGB, permuteMap,
-                                                                       255, kvImageNoFlags);
                     }
-                } else {
-                    // bmdFormat8BitARGB
-                    // bmdFormat8BitBGRA
-                    // bmdFormat10BitRGBXLE
-                    // bmdFormat12BitRGBLE
-                    convErr = [self vImageConvertDLRGB:&sourceBuffer
-                                             toInterim:&interimBuffer
-                                                 flags:kvImageNoFlags];
-                }
+                    return (result ? kvImageNoError : kvImageInternalError);
+                }];
+            }
+            CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
+            
+            if (!pre1403) {
+                VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
+            }
+            return (convErr == kvImageNoError);
+        }
+        
+        /* ================================================================ */
+        // VideoFrame (xfer) interimBuffer (convCGtoCV) CVPixelBuffer
+        /* ================================================================ */
+        
+        {
+            // Read from VideoFrame
+            if (convRGB12UtoCG && queryTemp1216Buffer) {
+                queryTemp1216Buffer = FALSE;
+                convErr = [self allocTempBuffer:&temp1216Buffer stride:&temp1216BufferStride
+                                      converter:convRGB12UtoCG
+                                         source:&sourceBuffer target:&interimBuffer flags:flags];
+            }
+            if (convErr == kvImageNoError) {
+                vImage_Buffer fullInterim = interimBuffer;
+                vImage_Buffer fullARGB = argb8888Buffer;
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&sourceBuffer, y, rows);
+                    vImage_Buffer dest = bandOf(&fullInterim, y, rows);
+                    vImage_Buffer argb = bandOf(&fullARGB, y, rows);
+                    void* temp = tempSlotOf(temp1216Buffer, temp1216BufferStride, band);
+                    return [self convertDLBand:&src toInterim:&dest argb8888:&argb
+                                      temp1216:temp flags:flags];
+                }];
             }
             
             if (!pre1403) {
@@ -1601,25 +2043,20 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
             vImage_Flags targetFlags = kvImageNoAllocate;
             convErr = vImageBuffer_InitForCopyToCVPixelBuffer(&targetBuffer, convCGtoCV,
                                                               pixelBuffer, targetFlags);
+            if (convErr == kvImageNoError && queryTempBuffer) {
+                queryTempBuffer = FALSE;
+                convErr = [self allocTempBuffer:&tempBuffer stride:&tempBufferStride
+                                      converter:convCGtoCV
+                                         source:&interimBuffer target:&targetBuffer flags:flags];
+            }
             if (convErr == kvImageNoError) {
-                if (queryTempBuffer) {
-                    queryTempBuffer = FALSE;
-                    free(tempBuffer); tempBuffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convCGtoCV,
-                                                               &interimBuffer, &targetBuffer,
-                                                               tempBuffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        if (posix_memalign(&ptr, 16, (size_t)size) == 0 && ptr != NULL) {
-                            tempBuffer = ptr;
-                        } else {
-                            return FALSE;
-                        }
-                    }
-                }
-                convErr = vImageConvert_AnyToAny(convCGtoCV,
-                                                 &interimBuffer, &targetBuffer,
-                                                 tempBuffer, kvImageNoFlags);
+                vImage_Buffer fullInterim = interimBuffer;
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&fullInterim, y, rows);
+                    vImage_Buffer dest = bandOf(&targetBuffer, y, rows);
+                    void* temp = tempSlotOf(tempBuffer, tempBufferStride, band);
+                    return vImageConvert_AnyToAny(convCGtoCV, &src, &dest, temp, flags);
+                }];
             }
             
             CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
@@ -1642,144 +2079,7 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
     BOOL formatOK = [self compatibleWithDL:videoFrame andCV:pixelBuffer];
     if (!formatOK) return false;
     
-    @synchronized (self) {
-        {
-            free(dlHostBuffer.data); dlHostBuffer = {0};
-            free(interimBuffer.data); interimBuffer = {0};
-            free(argb8888Buffer.data); argb8888Buffer = {0};
-            vImageConverter_Release(convCVtoCG); convCVtoCG = NULL;
-        }
-        
-        vImage_Error matrixErr = kvImageInternalError;
-        vImage_Error dlHostErr = kvImageInternalError;
-        vImage_Error interimErr = kvImageInternalError;
-        vImage_Error errCVtoCG = kvImageInternalError;
-        vImage_Error errCGtoRGB12U = kvImageInternalError;
-        {
-            if (dlFormat == bmdFormat10BitYUV) {
-                // conv: YUV10 <= either RGB8 or RGB16Q12; No RGB16U. See vImage/Conversion.h
-                vImage_ARGBToYpCbCrMatrix matrix = matrixToYpCbCrFor(dlWidth, dlHeight);
-                vImage_YpCbCrPixelRange pixelRange = videoRange10Clamped();
-                vImage_ARGBToYpCbCr info = {0};
-                vImageARGBType interimType = (dlDefault16Q12 ? kvImageARGB16Q12 : kvImageARGB8888);
-                matrixErr = vImageConvert_ARGBToYpCbCr_GenerateConversion(&matrix,
-                                                                          &pixelRange,
-                                                                          &info,
-                                                                          interimType,
-                                                                          kvImage422CrYpCbYpCbYpCbYpCrYpCrYp10,
-                                                                          kvImageNoFlags);
-                if (matrixErr == kvImageNoError) infoToYpCbCr = info;
-            } else if (dlFormat == bmdFormat8BitYUV) {
-                // conv: YUV8 <= RGB8 only; See vImage/Conversion.h
-                vImage_ARGBToYpCbCrMatrix matrix = matrixToYpCbCrFor(dlWidth, dlHeight);
-                vImage_YpCbCrPixelRange pixelRange = videoRange8Clamped();
-                vImage_ARGBToYpCbCr info = {0};
-                vImageARGBType interimType = (kvImageARGB8888);
-                matrixErr = vImageConvert_ARGBToYpCbCr_GenerateConversion(&matrix,
-                                                                          &pixelRange,
-                                                                          &info,
-                                                                          interimType,
-                                                                          kvImage422CbYpCrYp8,
-                                                                          kvImageNoFlags);
-                if (matrixErr == kvImageNoError) {
-                    infoToYpCbCr = info;
-                    
-                    // For useXRGB16U: YUV8 <= RGB8 <= RGB16; See vImage/Conversion.h
-                    if (useXRGB16U) {
-                        size_t rowBytes = (dlWidth * 4);
-                        void* ptr = NULL;
-                        size_t bufferSize = (rowBytes * dlHeight);
-                        if (posix_memalign(&ptr, 16, bufferSize) == 0 && ptr != NULL) {
-                            argb8888Buffer.data = ptr;
-                            argb8888Buffer.width = dlWidth;
-                            argb8888Buffer.height = dlHeight;
-                            argb8888Buffer.rowBytes = rowBytes;
-                        } else {
-                            matrixErr = kvImageInternalError;
-                        }
-                    }
-                }
-            } else {
-                // RGBtoTGB conversion
-                matrixErr = kvImageNoError;
-            }
-            if (matrixErr) {
-                NSLog(@"ERROR: vImageConvert_ARGBToYpCbCr_GenerateConversion() failed.");
-            }
-        }
-        vImage_CGImageFormat interimFormat = {0};
-        if (matrixErr == kvImageNoError) {
-            void* ptr = NULL;
-            size_t bufferSize = (dlRowBytes * dlHeight);
-            if (posix_memalign(&ptr, 16, bufferSize) == 0 && ptr != NULL) {
-                dlHostBuffer.data = ptr;
-                dlHostBuffer.width = dlWidth;
-                dlHostBuffer.height = dlHeight;
-                dlHostBuffer.rowBytes = dlRowBytes;
-                dlHostErr = kvImageNoError;
-            }
-        }
-        if (dlHostErr == kvImageNoError) {
-            CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
-            interimFormat = (useXRGB16U ? formatXRGB16U(cs) :
-                             (dlDefault16Q12 ? formatXRGB16Q12(cs) : formatXRGB8888(cs)));
-            interimErr = vImageBuffer_Init(&interimBuffer,
-                                           dlHeight, dlWidth, // rect of VideoFrame
-                                           interimFormat.bitsPerPixel, kvImageNoFlags);
-        }
-        if (interimErr == kvImageNoError) {
-            vImageCVImageFormatRef inFormat = vImageCVImageFormat_CreateWithCVPixelBuffer(pixelBuffer);
-            if (inFormat) {
-                assert(kvImageNoError == fillCVColorSpace(inFormat, cvColorSpace));
-                assert(kvImageNoError == fillCVChromaSiting(inFormat, kCVImageBufferChromaLocation_Center));
-                assert(kvImageNoError == fillCVConversionMatrix(inFormat, matrixToYpCbCrFor(dlWidth, dlHeight)));
-                vImage_Flags flags = kvImageNoFlags; // kvImagePrintDiagnosticsToConsole
-                CGFloat bgColor[3] = {0,0,0};
-                convCVtoCG = vImageConverter_CreateForCVToCGImageFormat(inFormat,
-                                                                        &interimFormat,
-                                                                        bgColor,
-                                                                        flags,
-                                                                        &errCVtoCG);
-                if (errCVtoCG || !convCVtoCG) {
-                    NSLog(@"ERROR: vImageConverter_CreateForCVToCGImageFormat() failed.(%ld)", errCVtoCG);
-                }
-                vImageCVImageFormat_Release(inFormat);
-                
-                queryTempBuffer = TRUE;
-                free(tempBuffer); tempBuffer = NULL;
-            } else {
-                NSLog(@"ERROR: vImageCVImageFormat_CreateWithCVPixelBuffer() failed.");
-            }
-        }
-        if (errCVtoCG == kvImageNoError) {
-            if (dlFormat == bmdFormat12BitRGB || dlFormat == bmdFormat12BitRGBLE) {
-                CGColorSpaceRef cs = (useDLColorSpace? dlColorSpace : cvColorSpace);
-                vImage_CGImageFormat outFormat = formatRGB12U(cs);
-                CGFloat bgColor[3] = {0,0,0};
-                convCGtoRGB12U = vImageConverter_CreateWithCGImageFormat(&interimFormat,
-                                                                         &outFormat,
-                                                                         bgColor,
-                                                                         kvImageNoFlags,
-                                                                         &errCGtoRGB12U);
-                
-                queryTemp1216Buffer = TRUE;
-                free(temp1216Buffer); temp1216Buffer = NULL;
-            } else {
-                errCGtoRGB12U = kvImageNoError;
-            }
-        }
-        
-        BOOL converterOK = (dlHostBuffer.data != NULL && interimBuffer.data != NULL && convCVtoCG != NULL);
-        converterOK = converterOK && (errCGtoRGB12U == kvImageNoError);
-        if (!converterOK) {
-            free(dlHostBuffer.data); dlHostBuffer = {0};
-            free(interimBuffer.data); interimBuffer = {0};
-            free(argb8888Buffer.data); argb8888Buffer = {0};
-            vImageConverter_Release(convCVtoCG); convCVtoCG = NULL;
-            vImageConverter_Release(convCGtoRGB12U); convCGtoRGB12U = NULL;
-        }
-        return converterOK;
-    }
+    return [self preparePlanFor:pixelBuffer toCV:FALSE];
 }
 
 - (BOOL)convertCV:(CVPixelBufferRef)pixelBuffer toDL:(IDeckLinkMutableVideoFrame*)videoFrame
@@ -1788,7 +2088,11 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
     
     //
     BOOL formatOK = [self compatibleWithDL:videoFrame andCV:pixelBuffer];
-    BOOL converterOK = (dlHostBuffer.data != NULL && interimBuffer.data != NULL && convCVtoCG != NULL);
+    if (formatOK && needsPlanRefresh) {
+        if (![self preparePlanFor:pixelBuffer toCV:FALSE]) return FALSE;
+    }
+    BOOL converterOK = (interimBuffer.data != NULL && convCVtoCG != NULL);
+    converterOK = converterOK || useV210Kernel;
     if (!(formatOK && converterOK)) {
         return FALSE; // unsupported conversion
     }
@@ -1803,11 +2107,69 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
             }
         }
         
+        // target vImage_Buffer
+        void* ptr = NULL;
+        if (!pre1403) {
+            VideoBufferGetBaseAddress(videoBuffer, &ptr);
+        } else {
+            IDeckLinkMutableVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkMutableVideoFrame_v14_2_1*)videoFrame;
+            videoFrame_v14_2_1->GetBytes(&ptr);
+        }
+        assert (ptr != NULL);
+        
+        vImage_Buffer targetBuffer = {
+            .data = ptr,
+            .width = dlWidth,
+            .height = dlHeight,
+            .rowBytes = dlRowBytes
+        };
+        
+        [self updateBandPlan];
+        vImage_Flags flags = (bandCount > 1 ? kvImageDoNotTile : kvImageNoFlags);
+        
+        vImage_Error convErr = kvImageNoError;
+        if (useV210Kernel) {
+            /* ================================================================ */
+            // CVPixelBuffer (DLABV210Kernel) VideoFrame
+            /* ================================================================ */
+            
+            CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+            {
+                vImage_Buffer sourceBuffer = {
+                    .data = CVPixelBufferGetBaseAddress(pixelBuffer),
+                    .width = cvWidth,
+                    .height = cvHeight,
+                    .rowBytes = CVPixelBufferGetBytesPerRow(pixelBuffer)
+                };
+                BOOL from2vuy = (cvFormat == kCVPixelFormatType_422YpCbCr8);
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&sourceBuffer, y, rows);
+                    vImage_Buffer dst = bandOf(&targetBuffer, y, rows);
+                    bool result = false;
+                    if (src.data && dst.data) {
+                        if (from2vuy) {
+                            result = DLABKernel2vuyToV210(src.data, src.rowBytes, dst.data, dst.rowBytes,
+                                                          dst.width, dst.height);
+                        } else {
+                            result = DLABKernelV216ToV210(src.data, src.rowBytes, dst.data, dst.rowBytes,
+                                                          dst.width, dst.height);
+                        }
+                    }
+                    return (result ? kvImageNoError : kvImageInternalError);
+                }];
+            }
+            CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+            
+            if (!pre1403) {
+                VideoBufferUnlockBaseAddress(videoBuffer, accessFlags);
+            }
+            return (convErr == kvImageNoError);
+        }
+        
         /* ================================================================ */
-        // CVPixelBuffer (convCVtoCG) interimBuffer (xfer) [dlHostBuffer (permute)] VideoFrame
+        // CVPixelBuffer (convCVtoCG) interimBuffer (xfer) VideoFrame
         /* ================================================================ */
         
-        vImage_Error convErr = kvImageNoError;
         {
             // Convert CVPixelBuffer format to interimBuffer
             CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
@@ -1817,124 +2179,43 @@ NS_INLINE void VideoBufferUnlockBaseAddress(IDeckLinkVideoBuffer* videoBuffer,
             vImage_Flags sourceFlags = kvImageNoAllocate;
             convErr = vImageBuffer_InitForCopyFromCVPixelBuffer(&sourceBuffer, convCVtoCG,
                                                                 pixelBuffer, sourceFlags);
+            if (convErr == kvImageNoError && queryTempBuffer) {
+                queryTempBuffer = FALSE;
+                convErr = [self allocTempBuffer:&tempBuffer stride:&tempBufferStride
+                                      converter:convCVtoCG
+                                         source:&sourceBuffer target:&interimBuffer flags:flags];
+            }
             if (convErr == kvImageNoError) {
-                if (queryTempBuffer) {
-                    queryTempBuffer = FALSE;
-                    free(tempBuffer); tempBuffer = NULL;
-                    vImage_Error size = vImageConvert_AnyToAny(convCVtoCG,
-                                                               &sourceBuffer, &interimBuffer,
-                                                               tempBuffer, kvImageGetTempBufferSize);
-                    if (size > 0) {
-                        void *ptr = NULL;
-                        if (posix_memalign(&ptr, 16, (size_t)size) == 0 && ptr != NULL) {
-                            tempBuffer = ptr;
-                        } else {
-                            return FALSE;
-                        }
-                    }
-                }
-                convErr = vImageConvert_AnyToAny(convCVtoCG,
-                                                 &sourceBuffer, &interimBuffer,
-                                                 tempBuffer, kvImageNoFlags);
+                vImage_Buffer fullInterim = interimBuffer;
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&sourceBuffer, y, rows);
+                    vImage_Buffer dest = bandOf(&fullInterim, y, rows);
+                    void* temp = tempSlotOf(tempBuffer, tempBufferStride, band);
+                    return vImageConvert_AnyToAny(convCVtoCG, &src, &dest, temp, flags);
+                }];
             }
             
             CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
         }
         if (convErr == kvImageNoError) {
-            // target vImage_Buffer
-            void* ptr = NULL;
-            if (!pre1403) {
-                VideoBufferGetBaseAddress(videoBuffer, &ptr);
-            } else {
-                IDeckLinkMutableVideoFrame_v14_2_1* videoFrame_v14_2_1 = (IDeckLinkMutableVideoFrame_v14_2_1*)videoFrame;
-                videoFrame_v14_2_1->GetBytes(&ptr);
-            }
-            assert (ptr != NULL);
-            
-            vImage_Buffer targetBuffer = {
-                .data = ptr,
-                .width = dlWidth,
-                .height = dlHeight,
-                .rowBytes = dlRowBytes
-            };
-            
             // Write into VideoFrame
-            if (dlEndianSwap) {
-                // Convert interimBuffer to VideoFrame format (in hostEndian)
-                {
-                    // bmdFormat10BitRGBX
-                    // bmdFormat10BitRGB
-                    // bmdFormat12BitRGB
-                    convErr = [self vImageConvertInterim:&interimBuffer
-                                                 toDLRGB:&dlHostBuffer
-                                                   flags:kvImageNoFlags];
-                }
-                // Permute HostToBig
-                if (convErr == kvImageNoError) {
-                    uint8_t permuteMap[4] = {3,2,1,0};
-                    convErr = vImagePermuteChannels_ARGB8888(&dlHostBuffer, &targetBuffer,
-                                                             permuteMap, kvImageNoFlags);
-                }
-            } else {
-                // Convert interimBuffer to VideoFrame format
-                if (dlFormat == bmdFormat10BitYUV) { // v210
-                    if (useXRGB16U) {
-                        // conv: YUV10 <= XRGB16Q12 <= XRGB16U
-                        {
-                            vImage_Buffer inPlace = interimBuffer;
-                            inPlace.width = inPlace.width * 4;
-                            convErr = vImageConvert_16Uto16Q12(&inPlace, &inPlace, kvImageNoFlags);
-                        }
-                        if (convErr == kvImageNoError) {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            convErr = vImageConvert_ARGB16Q12To422CrYpCbYpCbYpCbYpCrYpCrYp10(&interimBuffer,
-                                                                                             &targetBuffer,
-                                                                                             &infoToYpCbCr,
-                                                                                             permuteMap,
-                                                                                             kvImageNoFlags);
-                        }
-                    } else {
-                        // conv: YUV10 <= XRGB16Q12
-                        uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                        convErr = vImageConvert_ARGB16Q12To422CrYpCbYpCbYpCbYpCrYpCrYp10(&interimBuffer,
-                                                                                         &targetBuffer,
-                                                                                         &infoToYpCbCr,
-                                                                                         permuteMap,
-                                                                                         kvImageNoFlags);
-                    }
-                } else if (dlFormat == bmdFormat8BitYUV) { // 2vuy
-                    if (useXRGB16U) {
-                        // conv: YUV8 <= XRGB8 <= XRGB16U
-                        {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            uint8_t copyMask = 0;
-                            Pixel_8888 bgColor = {0,0,0,0};
-                            convErr = vImageConvert_ARGB16UToARGB8888(&interimBuffer, &argb8888Buffer,
-                                                                      permuteMap, copyMask, bgColor,
-                                                                      kvImageNoFlags);
-                        }
-                        if (convErr == kvImageNoError) {
-                            uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                            convErr = vImageConvert_ARGB8888To422CbYpCrYp8(&argb8888Buffer, &targetBuffer,
-                                                                           &infoToYpCbCr, permuteMap,
-                                                                           kvImageNoFlags);
-                        }
-                    } else {
-                        // conv: YUV8 <= XRGB8
-                        uint8_t permuteMap[4] = {0,1,2,3}; // componentOrder: A0, R1, G2, B3
-                        convErr = vImageConvert_ARGB8888To422CbYpCrYp8(&interimBuffer, &targetBuffer,
-                                                                       &infoToYpCbCr, permuteMap,
-                                                                       kvImageNoFlags);
-                    }
-                } else {
-                    // bmdFormat8BitARGB
-                    // bmdFormat8BitBGRA
-                    // bmdFormat10BitRGBXLE
-                    // bmdFormat12BitRGBLE
-                    convErr = [self vImageConvertInterim:&interimBuffer
-                                                 toDLRGB:&targetBuffer
-                                                   flags:kvImageNoFlags];
-                }
+            if (convCGtoRGB12U && queryTemp1216Buffer) {
+                queryTemp1216Buffer = FALSE;
+                convErr = [self allocTempBuffer:&temp1216Buffer stride:&temp1216BufferStride
+                                      converter:convCGtoRGB12U
+                                         source:&interimBuffer target:&targetBuffer flags:flags];
+            }
+            if (convErr == kvImageNoError) {
+                vImage_Buffer fullInterim = interimBuffer;
+                vImage_Buffer fullARGB = argb8888Buffer;
+                convErr = [self processBands:^vImage_Error(size_t band, vImagePixelCount y, vImagePixelCount rows) {
+                    vImage_Buffer src = bandOf(&fullInterim, y, rows);
+                    vImage_Buffer dest = bandOf(&targetBuffer, y, rows);
+                    vImage_Buffer argb = bandOf(&fullARGB, y, rows);
+                    void* temp = tempSlotOf(temp1216Buffer, temp1216BufferStride, band);
+                    return [self convertInterimBand:&src toDL:&dest argb8888:&argb
+                                           temp1216:temp flags:flags];
+                }];
             }
         }
         
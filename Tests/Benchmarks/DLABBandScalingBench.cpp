@@ -0,0 +1,199 @@
+//
+//  DLABBandScalingBench.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABBenchSupport.h"
+#include "DLABV210Kernel.h"
+#include "DLABRGBKernel.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ Scaling of row-band parallel conversion from 1 to N threads.
+
+ Band layout follows -[DLABVideoConverter updateBandPlan] (up to 16 bands, at
+ least 64 rows, even row count). Each band starts at row boundary, so packed
+ formats (v210 6 pixels/16 bytes, R12B 8 pixels/36 bytes) are never split.
+ dispatch_apply is replaced by persistent worker threads; vImage stages of
+ DLABVideoConverter are macOS only, so kernel stages are measured here.
+ Threads are doubled from 1 up to hardware concurrency (or DLAB_BENCH_THREADS).
+ */
+
+static const size_t kMaxBandCount = 16;
+static const size_t kMinBandRows = 64;
+
+// Persistent workers; Run() blocks until every band is processed
+class BandPool
+{
+public:
+    explicit BandPool(size_t threads) : generation(0), pending(0), stopping(false)
+    {
+        for (size_t i = 1; i < threads; i++) {
+            workers.emplace_back([this] { WorkerMain(); });
+        }
+    }
+
+    ~BandPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void Run(size_t count, const std::function<void(size_t)>& body)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &body;
+            taskCount = count;
+            nextBand = 0;
+            pending = count;
+            generation++;
+        }
+        wakeup.notify_all();
+        Drain();
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    void Drain()
+    {
+        while (true) {
+            size_t band;
+            const std::function<void(size_t)>* body;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (nextBand >= taskCount) return;
+                band = nextBand++;
+                body = task;
+            }
+            (*body)(band);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) finished.notify_all();
+        }
+    }
+
+    void WorkerMain()
+    {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeup.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            Drain();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable finished;
+    const std::function<void(size_t)>* task = nullptr;
+    size_t taskCount = 0;
+    size_t nextBand = 0;
+    uint64_t generation;
+    size_t pending;
+    bool stopping;
+};
+
+static void bandPlan(size_t threads, size_t height, size_t* count, size_t* rows)
+{
+    size_t n = std::min(threads, kMaxBandCount);
+    n = std::min(n, std::max(height / kMinBandRows, (size_t)1));
+    n = std::max(n, (size_t)1);
+    size_t r = (height + n - 1) / n;
+    r = (r + 1) & ~(size_t)1;
+    *rows = r;
+    *count = (height + r - 1) / r;
+}
+
+int main()
+{
+    // DLAB_BENCH_THREADS overrides upper limit of thread count
+    size_t maxThreads = std::max((size_t)std::thread::hardware_concurrency(), (size_t)1);
+    const char* limit = getenv("DLAB_BENCH_THREADS");
+    if (limit && atoi(limit) > 0) maxThreads = (size_t)atoi(limit);
+    printf("max threads: %zu\n", maxThreads);
+
+    const struct { size_t width, height; const char* name; } sizes[] = {
+        {3840, 2160, "2160"},
+        {7680, 4320, "4320"},
+    };
+
+    for (const auto& size : sizes) {
+        size_t w = size.width, h = size.height;
+        size_t v210RowBytes = ((w + 47) / 48) * 128;
+        size_t r12bRowBytes = ((w + 7) / 8) * 36;
+        size_t rowBytes8 = w * 2, rowBytesXRGB = w * 8;
+        std::vector<uint8_t> v210(v210RowBytes * h, 0x5A);
+        std::vector<uint8_t> yuv8(rowBytes8 * h, 0x80);
+        std::vector<uint8_t> r12b(r12bRowBytes * h, 0x3C);
+        std::vector<uint8_t> xrgb(rowBytesXRGB * h, 0);
+
+        struct Stage {
+            const char* name;
+            size_t frameBytes;
+            std::function<void(size_t y, size_t rows)> band;
+        };
+        const Stage stages[] = {
+            {"v210->2vuy", v210.size(), [&](size_t y, size_t rows) {
+                DLABKernelV210To2vuy(v210.data() + v210RowBytes * y, v210RowBytes,
+                                     yuv8.data() + rowBytes8 * y, rowBytes8, w, rows);
+            }},
+            {"R12B->XRGB16U", r12b.size(), [&](size_t y, size_t rows) {
+                DLABKernelRGBUnpack(DLABKernelRGBFormat12BitRGB,
+                                    r12b.data() + r12bRowBytes * y, r12bRowBytes,
+                                    xrgb.data() + rowBytesXRGB * y, rowBytesXRGB,
+                                    w, rows, 0, 4095, true);
+            }},
+        };
+
+        // Every power of two below maxThreads, then maxThreads itself
+        std::vector<size_t> threadCounts;
+        for (size_t threads = 1; threads < maxThreads; threads *= 2) {
+            threadCounts.push_back(threads);
+        }
+        threadCounts.push_back(maxThreads);
+
+        for (const Stage& stage : stages) {
+            double base = 0;
+            for (size_t threads : threadCounts) {
+                size_t count = 0, rows = 0;
+                bandPlan(threads, h, &count, &rows);
+                BandPool pool(threads);
+                std::function<void(size_t)> body = [&](size_t band) {
+                    size_t y = rows * band;
+                    stage.band(y, std::min(rows, h - y));
+                };
+                double ns = dlabBenchMeasure(h > 2160 ? 5 : 20, [&](size_t) {
+                    pool.Run(count, body);
+                });
+                if (threads == 1) base = ns;
+                char name[64];
+                snprintf(name, sizeof(name), "%s %s threads=%zu bands=%zu x%.2f",
+                         size.name, stage.name, threads, count, base / ns);
+                dlabBenchReport(name, ns, stage.frameBytes);
+            }
+        }
+    }
+    return 0;
+}
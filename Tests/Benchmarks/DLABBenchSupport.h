@@ -0,0 +1,74 @@
+//
+//  DLABBenchSupport.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABBenchSupport_h
+#define DLABBenchSupport_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+/*
+ * Minimal timing helpers for benchmarks of plain C++ units
+ *
+ * Each benchmark reports median of several runs, as nanoseconds per iteration
+ * and throughput. Iteration count can be scaled by DLAB_BENCH_SCALE environment
+ * variable (e.g. 0.1 for a quick smoke run).
+ */
+
+static inline uint64_t dlabBenchNow()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+static inline size_t dlabBenchIterations(size_t iterations)
+{
+    const char* scale = getenv("DLAB_BENCH_SCALE");
+    double value = (scale ? atof(scale) : 1.0);
+    size_t scaled = (size_t)((double)iterations * (value > 0 ? value : 1.0));
+    return (scaled ? scaled : 1);
+}
+
+/// Run body(iteration) for iterations x runs, and return median nanoseconds per iteration.
+template <typename Body>
+static double dlabBenchMeasure(size_t iterations, Body body)
+{
+    const size_t kRuns = 5;
+    double results[kRuns];
+    iterations = dlabBenchIterations(iterations);
+    body(0); // warm up
+    for (size_t run = 0; run < kRuns; run++) {
+        uint64_t begin = dlabBenchNow();
+        for (size_t i = 0; i < iterations; i++) body(i);
+        results[run] = (double)(dlabBenchNow() - begin) / (double)iterations;
+    }
+    for (size_t i = 1; i < kRuns; i++) { // insertion sort
+        for (size_t j = i; j > 0 && results[j - 1] > results[j]; j--) {
+            double tmp = results[j]; results[j] = results[j - 1]; results[j - 1] = tmp;
+        }
+    }
+    return results[kRuns / 2];
+}
+
+/// Print result. Throughput is omitted if bytesPerIteration is 0.
+static inline void dlabBenchReport(const char* name, double nsPerIteration, size_t bytesPerIteration)
+{
+    if (bytesPerIteration == 0) {
+        printf("%-44s %12.1f ns/iter\n", name, nsPerIteration);
+        return;
+    }
+    double gbps = (nsPerIteration > 0 ? (double)bytesPerIteration / nsPerIteration : 0);
+    printf("%-44s %12.1f ns/iter %8.2f GB/s\n", name, nsPerIteration, gbps);
+}
+
+#endif /* DLABBenchSupport_h */
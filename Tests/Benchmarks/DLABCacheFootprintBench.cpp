@@ -0,0 +1,166 @@
+//
+//  DLABCacheFootprintBench.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABBenchSupport.h"
+#include "DLABCopyKernel.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ Cache footprint of DLABBlit2D per DLABBlitMode.
+
+ A victim working set (kVictimBytes, sized to stay in L2) models the other
+ threads of the host application. Each round warms the victim, copies one
+ 2160p 'v210' frame, then times one pass over the victim. How much the victim
+ pass slows down after the copy shows how much of the working set the copy
+ evicted. Streaming copy does not allocate destination lines in cache, so only
+ source reads compete with the victim.
+
+ On Linux, last level cache misses of the victim pass are also read from
+ perf_event_open(). They are reported as n/a where hardware counters are not
+ exposed (e.g. virtual machines, perf_event_paranoid > 2); on macOS use
+ Instruments (CPU Counters) on this binary for the same figure.
+ */
+
+static const size_t kVictimBytes = 1024 * 1024;
+static const size_t kCacheLineBytes = 64;
+static const size_t kRounds = 25;
+
+class MissCounter
+{
+public:
+    MissCounter() : fd(-1)
+    {
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~MissCounter()
+    {
+#if defined(__linux__)
+        if (fd >= 0) close(fd);
+#endif
+    }
+    bool Available() const { return fd >= 0; }
+    void Begin()
+    {
+#if defined(__linux__)
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+    uint64_t End()
+    {
+        uint64_t count = 0;
+#if defined(__linux__)
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+private:
+    int fd;
+};
+
+// Read-modify-write every cache line of victim; returns checksum to keep the loop
+static uint64_t touchVictim(std::vector<uint8_t>& victim)
+{
+    uint64_t sum = 0;
+    for (size_t offset = 0; offset < victim.size(); offset += kCacheLineBytes) {
+        sum += victim[offset];
+        victim[offset] = (uint8_t)(sum);
+    }
+    return sum;
+}
+
+static double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main()
+{
+    const size_t width = 3840, height = 2160;
+    const size_t rowLength = ((width + 47) / 48) * 128;
+    const size_t dstRowBytes = (rowLength + 255) & ~(size_t)255;
+    std::vector<uint8_t> src(rowLength * height, 0x5A);
+    std::vector<uint8_t> dst(dstRowBytes * height, 0);
+    std::vector<uint8_t> victim(kVictimBytes, 1);
+
+    MissCounter counter;
+    size_t rounds = dlabBenchIterations(kRounds);
+    volatile uint64_t sink = 0;
+
+    // Baseline; victim pass with nothing in between
+    std::vector<double> passNs, misses;
+    for (size_t r = 0; r < rounds; r++) {
+        sink = sink + touchVictim(victim);
+        counter.Begin();
+        uint64_t begin = dlabBenchNow();
+        sink = sink + touchVictim(victim);
+        passNs.push_back((double)(dlabBenchNow() - begin));
+        misses.push_back((double)counter.End());
+    }
+    double baselineNs = median(passNs);
+    printf("%-28s %10.1f us/pass", "victim warm", baselineNs / 1000.0);
+    if (counter.Available()) printf(" %10.0f LLC misses\n", median(misses));
+    else printf("        n/a LLC misses\n");
+
+    const DLABBlitMode modes[] = {DLABBlitModeCached, DLABBlitModePrefetch, DLABBlitModeStreaming};
+    const char* modeNames[] = {"cached", "prefetch", "streaming"};
+    for (size_t m = 0; m < 3; m++) {
+        std::vector<double> copyNs;
+        passNs.clear();
+        misses.clear();
+        for (size_t r = 0; r < rounds; r++) {
+            sink = sink + touchVictim(victim);
+
+            uint64_t begin = dlabBenchNow();
+            DLABBlit2D(src.data(), rowLength, dst.data(), dstRowBytes, rowLength, height, modes[m]);
+            copyNs.push_back((double)(dlabBenchNow() - begin));
+
+            counter.Begin();
+            begin = dlabBenchNow();
+            sink = sink + touchVictim(victim);
+            passNs.push_back((double)(dlabBenchNow() - begin));
+            misses.push_back((double)counter.End());
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "victim after %s copy", modeNames[m]);
+        double ns = median(passNs);
+        printf("%-28s %10.1f us/pass", name, ns / 1000.0);
+        if (counter.Available()) printf(" %10.0f LLC misses", median(misses));
+        else printf("        n/a LLC misses");
+        printf("  x%.2f  (copy %.2f GB/s)\n", ns / baselineNs,
+               (double)(rowLength * height) / median(copyNs));
+    }
+    return 0;
+}
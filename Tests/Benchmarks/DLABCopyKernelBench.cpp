@@ -0,0 +1,88 @@
+//
+//  DLABCopyKernelBench.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABBenchSupport.h"
+#include "DLABCopyKernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Plane copy throughput of DLABBlit2D per DLABBlitMode.
+
+ Source and destination rotate over several frames, so that each copy starts
+ with cold cache as the capture path does. Baseline is a single memcpy of the
+ same payload. Frame sizes are 1080p and 2160p 'v210' (128 bytes per 48 pixels),
+ with same stride and with destination stride padded to 256 bytes (as
+ CVPixelBufferPool may do).
+ */
+
+static const size_t kFrameRing = 4;
+
+typedef struct {
+    const char* name;
+    size_t width;
+    size_t height;
+} FrameSize;
+
+static size_t v210RowBytes(size_t width)
+{
+    return ((width + 47) / 48) * 128;
+}
+
+static void benchFrame(const FrameSize& frame)
+{
+    const size_t rowLength = v210RowBytes(frame.width);
+    const size_t paddedRowBytes = (rowLength + 255) & ~(size_t)255;
+    const size_t bytes = rowLength * frame.height;
+    const size_t iterations = (bytes > 16 * 1024 * 1024 ? 40 : 200);
+
+    std::vector<uint8_t> src(bytes * kFrameRing);
+    std::vector<uint8_t> dst(paddedRowBytes * frame.height * kFrameRing);
+    memset(src.data(), 0x5A, src.size());
+    memset(dst.data(), 0, dst.size());
+
+    char name[64];
+    double ns = dlabBenchMeasure(iterations, [&](size_t i) {
+        size_t slot = i % kFrameRing;
+        memcpy(&dst[bytes * slot], &src[bytes * slot], bytes);
+    });
+    snprintf(name, sizeof(name), "%s memcpy", frame.name);
+    dlabBenchReport(name, ns, bytes);
+
+    const DLABBlitMode modes[] = {DLABBlitModeCached, DLABBlitModePrefetch, DLABBlitModeStreaming};
+    const char* modeNames[] = {"cached", "prefetch", "streaming"};
+    for (size_t m = 0; m < 3; m++) {
+        for (int padded = 0; padded < 2; padded++) {
+            size_t dstRowBytes = (padded ? paddedRowBytes : rowLength);
+            size_t dstFrameBytes = dstRowBytes * frame.height;
+            ns = dlabBenchMeasure(iterations, [&](size_t i) {
+                size_t slot = i % kFrameRing;
+                DLABBlit2D(&src[bytes * slot], rowLength, &dst[dstFrameBytes * slot], dstRowBytes,
+                           rowLength, frame.height, modes[m]);
+            });
+            snprintf(name, sizeof(name), "%s %s %s", frame.name, modeNames[m],
+                     (padded ? "stride differ" : "stride equal"));
+            dlabBenchReport(name, ns, bytes);
+        }
+    }
+}
+
+int main()
+{
+    const FrameSize frames[] = {
+        {"1080p v210", 1920, 1080},
+        {"2160p v210", 3840, 2160},
+    };
+    for (const FrameSize& frame : frames) {
+        benchFrame(frame);
+    }
+    return 0;
+}
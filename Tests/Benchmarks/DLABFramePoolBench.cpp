@@ -0,0 +1,176 @@
+//
+//  DLABFramePoolBench.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABBenchSupport.h"
+#include "DLABFramePool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/*
+ Reserve/Release latency of DLABFramePool.
+
+ Baseline is a mutex + hash set pool, modeling previous @synchronized(self) +
+ NSMutableSet<NSValue*> implementation. In concurrent case, producer thread
+ reserves frames (as scheduleVideoFrame) and hands them to completion thread
+ which releases them (as ScheduledFrameCompleted), via a lock-free SPSC queue.
+ */
+
+static const uint32_t kFrameCount = 16;
+
+class LockedPool
+{
+public:
+    void Add(void* item) { std::lock_guard<std::mutex> lock(mutex); all.insert(item); idle.push_back(item); }
+    void* Reserve()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (idle.empty()) return NULL;
+        void* item = idle.back();
+        idle.pop_back();
+        busy.insert(item);
+        return item;
+    }
+    bool Release(void* item)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!all.count(item) || !busy.erase(item)) return false;
+        idle.push_back(item);
+        return true;
+    }
+private:
+    std::mutex mutex;
+    std::unordered_set<void*> all;
+    std::unordered_set<void*> busy;
+    std::vector<void*> idle;
+};
+
+class FramePool
+{
+public:
+    FramePool() : pool(kFrameCount) {}
+    ~FramePool() { pool.RemoveAll(NULL, NULL); }
+    void Add(void* item) { pool.Add(item); }
+    void* Reserve() { return pool.Reserve(); }
+    bool Release(void* item) { return pool.Release(item); }
+private:
+    DLABFramePool pool;
+};
+
+// Single producer/single consumer handoff of reserved frames
+class Handoff
+{
+public:
+    bool Push(void* item)
+    {
+        size_t w = writeIndex.load(std::memory_order_relaxed);
+        if (w - readIndex.load(std::memory_order_acquire) == kSize) return false;
+        ring[w % kSize] = item;
+        writeIndex.store(w + 1, std::memory_order_release);
+        return true;
+    }
+    void* Pop()
+    {
+        size_t r = readIndex.load(std::memory_order_relaxed);
+        if (r == writeIndex.load(std::memory_order_acquire)) return NULL;
+        void* item = ring[r % kSize];
+        readIndex.store(r + 1, std::memory_order_release);
+        return item;
+    }
+private:
+    static const size_t kSize = 64;
+    void* ring[kSize];
+    std::atomic<size_t> writeIndex{0};
+    std::atomic<size_t> readIndex{0};
+};
+
+static void reportPercentiles(const char* name, std::vector<uint32_t>& samples)
+{
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    printf("%-36s p50 %6u ns  p99 %7u ns  max %8u ns  (%zu ops)\n", name,
+           samples[n / 2], samples[n * 99 / 100], samples[n - 1], n);
+}
+
+template <typename Pool>
+static void benchPool(const char* label)
+{
+    std::vector<int> frames(kFrameCount);
+    char name[64];
+
+    // Uncontended reserve + release pair
+    {
+        Pool pool;
+        for (int& frame : frames) pool.Add(&frame);
+        double ns = dlabBenchMeasure(1000000, [&](size_t) {
+            void* item = pool.Reserve();
+            pool.Release(item);
+        });
+        snprintf(name, sizeof(name), "%s uncontended pair", label);
+        dlabBenchReport(name, ns, 0);
+    }
+
+    // Producer reserves, completion thread releases
+    {
+        Pool pool;
+        for (int& frame : frames) pool.Add(&frame);
+        Handoff handoff;
+        size_t total = dlabBenchIterations(200000);
+        std::vector<uint32_t> reserveNs, releaseNs;
+        reserveNs.reserve(total);
+        releaseNs.reserve(total);
+        std::atomic<bool> done(false);
+
+        std::thread completion([&] {
+            while (true) {
+                void* item = handoff.Pop();
+                if (!item) {
+                    if (done.load(std::memory_order_acquire) && !(item = handoff.Pop())) break;
+                    if (!item) { std::this_thread::yield(); continue; }
+                }
+                uint64_t begin = dlabBenchNow();
+                pool.Release(item);
+                releaseNs.push_back((uint32_t)(dlabBenchNow() - begin));
+            }
+        });
+
+        uint64_t start = dlabBenchNow();
+        for (size_t n = 0; n < total; ) {
+            uint64_t begin = dlabBenchNow();
+            void* item = pool.Reserve();
+            uint64_t end = dlabBenchNow();
+            if (!item) { std::this_thread::yield(); continue; }
+            reserveNs.push_back((uint32_t)(end - begin));
+            while (!handoff.Push(item)) std::this_thread::yield();
+            n++;
+        }
+        done.store(true, std::memory_order_release);
+        completion.join();
+        double elapsed = (double)(dlabBenchNow() - start);
+
+        snprintf(name, sizeof(name), "%s concurrent reserve", label);
+        reportPercentiles(name, reserveNs);
+        snprintf(name, sizeof(name), "%s concurrent release", label);
+        reportPercentiles(name, releaseNs);
+        printf("%-36s %.2f Mframes/s\n", label, (double)total * 1000.0 / elapsed);
+    }
+}
+
+int main()
+{
+    benchPool<FramePool>("DLABFramePool");
+    benchPool<LockedPool>("mutex+set");
+    return 0;
+}
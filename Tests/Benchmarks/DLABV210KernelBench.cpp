@@ -0,0 +1,68 @@
+//
+//  DLABV210KernelBench.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABBenchSupport.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Per-frame cost of DLABV210Kernel for each available backend. Scalar backend is
+ the baseline; vImage path of DLABVideoConverter is macOS only and is not covered.
+ Throughput counts v210 bytes per frame.
+ */
+
+typedef bool (*KernelFunc)(const void* src, size_t srcRowBytes,
+                           void* dst, size_t dstRowBytes,
+                           size_t width, size_t height);
+
+int main()
+{
+    const struct { size_t width, height; const char* name; } sizes[] = {
+        {1920, 1080, "1080"},
+        {3840, 2160, "2160"},
+    };
+    const DLABKernelBackend backends[] = {
+        DLABKernelBackendScalar, DLABKernelBackendSSE41, DLABKernelBackendAVX2, DLABKernelBackendNEON,
+    };
+
+    for (const auto& size : sizes) {
+        size_t v210RowBytes = ((size.width + 47) / 48) * 128; // DeckLink row alignment
+        size_t rowBytes8 = size.width * 2;
+        size_t rowBytes16 = size.width * 4;
+        std::vector<uint8_t> v210(v210RowBytes * size.height, 0x5A);
+        std::vector<uint8_t> yuv8(rowBytes8 * size.height, 0x80);
+        std::vector<uint8_t> yuv16(rowBytes16 * size.height, 0x40);
+        size_t frameBytes = v210.size();
+        size_t iterations = (size.height > 1080 ? 10 : 40);
+
+        const struct { const char* name; KernelFunc func; const void* src; size_t srcRowBytes;
+                       void* dst; size_t dstRowBytes; } cases[] = {
+            {"v210->2vuy", DLABKernelV210To2vuy, v210.data(), v210RowBytes, yuv8.data(), rowBytes8},
+            {"v210->v216", DLABKernelV210ToV216, v210.data(), v210RowBytes, yuv16.data(), rowBytes16},
+            {"2vuy->v210", DLABKernel2vuyToV210, yuv8.data(), rowBytes8, v210.data(), v210RowBytes},
+            {"v216->v210", DLABKernelV216ToV210, yuv16.data(), rowBytes16, v210.data(), v210RowBytes},
+        };
+
+        for (DLABKernelBackend backend : backends) {
+            if (DLABKernelSetBackend(backend) != backend) continue;
+            for (const auto& c : cases) {
+                double ns = dlabBenchMeasure(iterations, [&](size_t) {
+                    c.func(c.src, c.srcRowBytes, c.dst, c.dstRowBytes, size.width, size.height);
+                });
+                char name[64];
+                snprintf(name, sizeof(name), "%s %s %s", size.name, c.name, DLABKernelBackendName(backend));
+                dlabBenchReport(name, ns, frameBytes);
+            }
+        }
+    }
+    return 0;
+}
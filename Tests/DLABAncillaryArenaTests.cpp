@@ -0,0 +1,140 @@
+//
+//  DLABAncillaryArenaTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABAncillaryArena.h"
+
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testAppend()
+{
+    DLABAncillaryArena arena;
+    DLAB_CHECK_EQ(arena.Count(), 0);
+    DLAB_CHECK_EQ(arena.Length(), 0);
+
+    uint8_t payload[255];
+    dlabTestFill(payload, sizeof(payload), 11);
+    arena.Append(0x61, 0x01, 9, 0, payload, 40);            // CEA-708
+    arena.Append(0x41, 0x05, 10, 1, NULL, 16);              // no payload; length is 0
+    arena.Append(0x60, 0x60, 11, 0, payload + 40, 215);
+    DLAB_CHECK_EQ(arena.Count(), 3);
+    DLAB_CHECK_EQ(arena.Length(), 255);
+
+    const DLABAncillaryArena::Entry* entries = arena.Entries();
+    DLAB_CHECK_EQ(entries[0].did, 0x61);
+    DLAB_CHECK_EQ(entries[0].sdid, 0x01);
+    DLAB_CHECK_EQ(entries[0].lineNumber, 9);
+    DLAB_CHECK_EQ(entries[0].offset, 0);
+    DLAB_CHECK_EQ(entries[0].length, 40);
+    DLAB_CHECK_EQ(entries[1].dataStreamIndex, 1);
+    DLAB_CHECK_EQ(entries[1].offset, 40);
+    DLAB_CHECK_EQ(entries[1].length, 0);
+    DLAB_CHECK_EQ(entries[2].offset, 40);
+    DLAB_CHECK_EQ(entries[2].length, 215);
+    DLAB_CHECK(memcmp(arena.Bytes(), payload, sizeof(payload)) == 0);
+}
+
+static void testResetKeepsCapacity()
+{
+    DLABAncillaryArena arena;
+    arena.Reserve(1024, 8);
+    uint8_t payload[100] = {0};
+    for (int i = 0; i < 8; i++) arena.Append(0x61, 0x01, 9, 0, payload, sizeof(payload));
+    const uint8_t* bytes = arena.Bytes();
+    const DLABAncillaryArena::Entry* entries = arena.Entries();
+
+    // Same storage is reused after Reset
+    arena.Reset();
+    DLAB_CHECK_EQ(arena.Count(), 0);
+    DLAB_CHECK_EQ(arena.Length(), 0);
+    for (int i = 0; i < 8; i++) arena.Append(0x61, 0x01, 9, 0, payload, sizeof(payload));
+    DLAB_CHECK(arena.Bytes() == bytes);
+    DLAB_CHECK(arena.Entries() == entries);
+
+    // Growing beyond reserved capacity keeps every payload
+    for (int i = 0; i < 64; i++) {
+        memset(payload, i, sizeof(payload));
+        arena.Append(0x62, (uint8_t)i, 12, 0, payload, sizeof(payload));
+    }
+    DLAB_CHECK_EQ(arena.Count(), 72);
+    DLAB_CHECK_EQ(arena.Length(), 7200);
+    size_t mismatch = 0;
+    for (int i = 0; i < 64; i++) {
+        const DLABAncillaryArena::Entry& entry = arena.Entries()[8 + i];
+        for (uint32_t b = 0; b < entry.length; b++) mismatch += (arena.Bytes()[entry.offset + b] != i);
+    }
+    DLAB_CHECK_EQ(mismatch, 0);
+}
+
+static void testPoolOverflow()
+{
+    DLABAncillaryArenaPool* pool = new DLABAncillaryArenaPool(2);
+    DLABAncillaryArena* a = pool->Reserve();
+    DLABAncillaryArena* b = pool->Reserve();
+    DLABAncillaryArena* c = pool->Reserve();    // transient
+    DLAB_CHECK(a && b && c && a != b && b != c && a != c);
+    DLAB_CHECK_EQ(pool->HitCount(), 2);
+    DLAB_CHECK_EQ(pool->MissCount(), 1);
+
+    // Recycled arena is empty
+    uint8_t payload[4] = {1, 2, 3, 4};
+    a->Append(0x61, 0x01, 9, 0, payload, sizeof(payload));
+    pool->Recycle(a);
+    DLABAncillaryArena* d = pool->Reserve();
+    DLAB_CHECK(d == a);
+    DLAB_CHECK_EQ(d->Count(), 0);
+    DLAB_CHECK_EQ(d->Length(), 0);
+
+    pool->Recycle(c);
+    pool->Recycle(NULL);
+    pool->Recycle(b);
+
+    // Outstanding arena keeps pool alive after owner releases it
+    DLAB_CHECK_EQ(pool->Release(), 1);
+    d->Append(0x61, 0x01, 9, 0, payload, sizeof(payload));
+    pool->Recycle(d);
+}
+
+static void testPoolConcurrent()
+{
+    DLABAncillaryArenaPool* pool = new DLABAncillaryArenaPool(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.push_back(std::thread([pool, t]() {
+            uint8_t payload[64];
+            dlabTestFill(payload, sizeof(payload), (uint32_t)t);
+            for (int i = 0; i < 2000; i++) {
+                DLABAncillaryArena* arena = pool->Reserve();
+                DLAB_CHECK_EQ(arena->Count(), 0);
+                arena->Append(0x61, 0x01, 9, 0, payload, sizeof(payload));
+                DLAB_CHECK(memcmp(arena->Bytes(), payload, sizeof(payload)) == 0);
+                pool->Recycle(arena);
+            }
+        }));
+    }
+    for (std::thread& thread : threads) thread.join();
+    DLAB_CHECK_EQ(pool->HitCount() + pool->MissCount(), 8000);
+    DLAB_CHECK_EQ(pool->Release(), 0);
+}
+
+int main()
+{
+    DLAB_RUN(testAppend);
+    DLAB_RUN(testResetKeepsCapacity);
+    DLAB_RUN(testPoolOverflow);
+    DLAB_RUN(testPoolConcurrent);
+    return DLAB_TEST_RESULT();
+}
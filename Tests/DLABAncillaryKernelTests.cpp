@@ -0,0 +1,273 @@
+//
+//  DLABAncillaryKernelTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABAncillaryKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Packets serialized with DLABAncLineWritePacket are parsed back with
+ DLABAncLineParse, on every line format and every available backend.
+ Several packets share one line back to back, as the output sink writes
+ packets of VANCPacketHandler and VANCPacketWriteHandler into same line.
+ */
+
+static const size_t kHDWidth = 1920;
+static const size_t kSDWidth = 720;
+static const size_t kMaxPackets = 16;
+
+typedef struct {
+    uint8_t did;
+    uint8_t sdid;
+    DLABAncStream stream;
+    size_t count;
+} PacketSpec;
+
+static bool isSD(DLABAncLineFormat format)
+{
+    return (format == DLABAncLineFormatV210SD || format == DLABAncLineFormat2vuySD);
+}
+
+static bool is10bit(DLABAncLineFormat format)
+{
+    return (format == DLABAncLineFormatV210 || format == DLABAncLineFormatV210SD);
+}
+
+static size_t lineBytes(size_t width, DLABAncLineFormat format)
+{
+    return is10bit(format) ? ((width + 5) / 6) * 16 : width * 2;
+}
+
+static const char* formatName(DLABAncLineFormat format)
+{
+    switch (format) {
+        case DLABAncLineFormatV210:   return "v210";
+        case DLABAncLineFormatV210SD: return "v210SD";
+        case DLABAncLineFormat2vuy:   return "2vuy";
+        case DLABAncLineFormat2vuySD: return "2vuySD";
+    }
+    return "?";
+}
+
+/* =================================================================================== */
+// MARK: - reference
+/* =================================================================================== */
+
+static uint16_t refComponent(const uint8_t* line, size_t index)
+{
+    uint32_t word = 0;
+    memcpy(&word, line + (index / 12) * 16 + ((index % 12) / 3) * 4, sizeof(word));
+    return (uint16_t)((word >> (10 * (index % 3))) & 0x3FF);
+}
+
+static void refSetComponent(uint8_t* line, size_t index, uint16_t value)
+{
+    uint8_t* ptr = line + (index / 12) * 16 + ((index % 12) / 3) * 4;
+    uint32_t shift = (uint32_t)(index % 3) * 10;
+    uint32_t word = 0;
+    memcpy(&word, ptr, sizeof(word));
+    word = (word & ~(0x3FFu << shift)) | ((uint32_t)(value & 0x3FF) << shift);
+    memcpy(ptr, &word, sizeof(word));
+}
+
+// Component index of word at stream position
+static size_t componentIndex(DLABAncLineFormat format, DLABAncStream stream, size_t position)
+{
+    if (isSD(format)) return position;
+    return position * 2 + (stream == DLABAncStreamLuma ? 1 : 0);
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testEncodePacket()
+{
+    const uint8_t udw[] = {0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};   // AFD
+    uint16_t words[DLABAncMaxUserDataCount + 7];
+    size_t length = DLABAncEncodePacket(0x41, 0x05, udw, sizeof(udw), words);
+    DLAB_CHECK_EQ(length, sizeof(udw) + 7);
+    DLAB_CHECK_EQ(words[0], 0x000);
+    DLAB_CHECK_EQ(words[1], 0x3FF);
+    DLAB_CHECK_EQ(words[2], 0x3FF);
+    DLAB_CHECK_EQ(words[3], 0x241);     // even number of 1s: b8 = 0, b9 = 1
+    DLAB_CHECK_EQ(words[4], 0x205);
+    DLAB_CHECK_EQ(words[5], 0x108);     // odd number of 1s: b8 = 1, b9 = 0
+    DLAB_CHECK_EQ(words[6], 0x108);
+
+    uint16_t sum = 0;
+    for (size_t i = 3; i < length - 1; i++) sum = (uint16_t)((sum + (words[i] & 0x1FF)) & 0x1FF);
+    DLAB_CHECK_EQ(words[length - 1] & 0x1FF, sum);
+    DLAB_CHECK_EQ((words[length - 1] >> 9) & 1, ((sum >> 8) & 1) ^ 1);
+
+    DLAB_CHECK_EQ(DLABAncEncodePacket(0x41, 0x05, NULL, 0, words), 7);
+    DLAB_CHECK_EQ(DLABAncEncodePacket(0x41, 0x05, NULL, 1, words), 0);
+    DLAB_CHECK_EQ(DLABAncEncodePacket(0x41, 0x05, udw, 0, NULL), 0);
+}
+
+static void checkRoundTrip(DLABAncLineFormat format)
+{
+    size_t width = isSD(format) ? kSDWidth : kHDWidth;
+    std::vector<uint8_t> line(lineBytes(width, format));
+    DLAB_CHECK(DLABAncLineClear(line.data(), width, format));
+
+    DLABAncPacketInfo infos[kMaxPackets];
+    std::vector<uint8_t> payload(kMaxPackets * DLABAncMaxUserDataCount);
+    DLAB_CHECK_EQ(DLABAncLineParse(line.data(), width, format, infos, kMaxPackets,
+                                   payload.data(), payload.size()), 0);
+
+    // Chroma stream is not available on SD line
+    std::vector<PacketSpec> specs = {
+        {0x41, 0x05, DLABAncStreamLuma, 8},
+        {0x61, 0x01, DLABAncStreamLuma, 0},
+        {0x60, 0x60, DLABAncStreamLuma, DLABAncMaxUserDataCount},
+    };
+    if (!isSD(format)) {
+        specs.push_back({0x45, 0x01, DLABAncStreamChroma, 3});
+        specs.push_back({0x41, 0x06, DLABAncStreamChroma, 32});
+    }
+
+    std::vector<std::vector<uint8_t>> udws;
+    std::vector<size_t> positions;
+    size_t next[2] = {0, 0};
+    for (size_t i = 0; i < specs.size(); i++) {
+        const PacketSpec& spec = specs[i];
+        std::vector<uint8_t> udw(spec.count);
+        dlabTestFill(udw.data(), udw.size(), (uint32_t)(i + 1) * 31);
+        positions.push_back(next[spec.stream]);
+        size_t end = DLABAncLineWritePacket(line.data(), width, format, spec.stream, next[spec.stream],
+                                            spec.did, spec.sdid, udw.data(), udw.size());
+        DLAB_CHECK_EQ(end, next[spec.stream] + spec.count + 7);
+        next[spec.stream] = end;
+        udws.push_back(udw);
+    }
+
+    size_t found = DLABAncLineParse(line.data(), width, format, infos, kMaxPackets,
+                                    payload.data(), payload.size());
+    DLAB_CHECK_EQ(found, specs.size());
+    if (found != specs.size()) return;
+
+    // Parser reports packets in line order; match them by stream and position
+    size_t matched = 0;
+    for (size_t i = 0; i < specs.size(); i++) {
+        for (size_t j = 0; j < found; j++) {
+            const DLABAncPacketInfo& info = infos[j];
+            if (info.stream != specs[i].stream || info.position != positions[i]) continue;
+            DLAB_CHECK_EQ(info.did, specs[i].did);
+            DLAB_CHECK_EQ(info.sdid, specs[i].sdid);
+            DLAB_CHECK_EQ(info.dataCount, specs[i].count);
+            DLAB_CHECK(info.parityValid);
+            DLAB_CHECK(info.checksumValid);
+            DLAB_CHECK(!specs[i].count ||
+                       memcmp(payload.data() + info.payloadOffset, udws[i].data(), specs[i].count) == 0);
+            matched++;
+        }
+    }
+    DLAB_CHECK_EQ(matched, specs.size());
+}
+
+static void checkCorruption(DLABAncLineFormat format)
+{
+    size_t width = isSD(format) ? kSDWidth : kHDWidth;
+    std::vector<uint8_t> line(lineBytes(width, format));
+    const uint8_t udw[] = {1, 2, 3, 4};
+    DLABAncPacketInfo info;
+    uint8_t payload[sizeof(udw)];
+
+    // Broken UDW fails checksum
+    DLAB_CHECK(DLABAncLineClear(line.data(), width, format));
+    DLAB_CHECK(DLABAncLineWritePacket(line.data(), width, format, DLABAncStreamLuma, 10,
+                                      0x41, 0x05, udw, sizeof(udw)));
+    size_t index = componentIndex(format, DLABAncStreamLuma, 10 + 6);
+    if (is10bit(format)) {
+        refSetComponent(line.data(), index, (uint16_t)(refComponent(line.data(), index) ^ 0x001));
+    } else {
+        line[index] ^= 0x01;
+    }
+    DLAB_CHECK_EQ(DLABAncLineParse(line.data(), width, format, &info, 1, payload, sizeof(payload)), 1);
+    DLAB_CHECK(!info.checksumValid);
+
+    // Broken DID parity is detected on 10bit line only
+    if (is10bit(format)) {
+        DLAB_CHECK(DLABAncLineClear(line.data(), width, format));
+        DLAB_CHECK(DLABAncLineWritePacket(line.data(), width, format, DLABAncStreamLuma, 10,
+                                          0x41, 0x05, udw, sizeof(udw)));
+        index = componentIndex(format, DLABAncStreamLuma, 10 + 3);
+        refSetComponent(line.data(), index, (uint16_t)(refComponent(line.data(), index) ^ 0x100));
+        DLAB_CHECK_EQ(DLABAncLineParse(line.data(), width, format, &info, 1, payload, sizeof(payload)), 1);
+        DLAB_CHECK(!info.parityValid);
+    }
+}
+
+static void checkLineFull(DLABAncLineFormat format)
+{
+    size_t width = isSD(format) ? kSDWidth : kHDWidth;
+    size_t streamLength = isSD(format) ? width * 2 : width;
+    std::vector<uint8_t> line(lineBytes(width, format));
+    const uint8_t udw[4] = {0};
+    DLAB_CHECK(DLABAncLineClear(line.data(), width, format));
+
+    size_t last = streamLength - (sizeof(udw) + 7);
+    DLAB_CHECK_EQ(DLABAncLineWritePacket(line.data(), width, format, DLABAncStreamLuma, last,
+                                         0x41, 0x05, udw, sizeof(udw)), streamLength);
+    DLAB_CHECK_EQ(DLABAncLineWritePacket(line.data(), width, format, DLABAncStreamLuma, last + 1,
+                                         0x41, 0x05, udw, sizeof(udw)), 0);
+    if (isSD(format)) {
+        DLAB_CHECK_EQ(DLABAncLineWritePacket(line.data(), width, format, DLABAncStreamChroma, 0,
+                                             0x41, 0x05, udw, sizeof(udw)), 0);
+    }
+}
+
+static void testInvalidParameters()
+{
+    uint8_t line[64] = {0};
+    DLABAncPacketInfo info;
+    uint8_t payload[8];
+    DLAB_CHECK(!DLABAncLineClear(NULL, 12, DLABAncLineFormatV210));
+    DLAB_CHECK(!DLABAncLineClear(line, 11, DLABAncLineFormatV210));
+    DLAB_CHECK_EQ(DLABAncLineParse(line, 0, DLABAncLineFormat2vuy, &info, 1, payload, sizeof(payload)), 0);
+    DLAB_CHECK_EQ(DLABAncLineParse(line, 12, DLABAncLineFormat2vuy, NULL, 1, payload, sizeof(payload)), 0);
+    DLAB_CHECK_EQ(DLABAncLineWritePacket(line, 11, DLABAncLineFormat2vuy, DLABAncStreamLuma, 0,
+                                         0x41, 0x05, NULL, 0), 0);
+}
+
+static void testAllBackends()
+{
+    const DLABKernelBackend backends[] = {
+        DLABKernelBackendScalar, DLABKernelBackendSSE41, DLABKernelBackendAVX2, DLABKernelBackendNEON,
+    };
+    const DLABAncLineFormat formats[] = {
+        DLABAncLineFormatV210, DLABAncLineFormatV210SD, DLABAncLineFormat2vuy, DLABAncLineFormat2vuySD,
+    };
+    DLABKernelBackend original = DLABKernelGetBackend();
+    for (DLABKernelBackend backend : backends) {
+        if (DLABKernelSetBackend(backend) != backend) continue; // not available on this host
+        for (DLABAncLineFormat format : formats) {
+            int before = dlabTestFailures;
+            checkRoundTrip(format);
+            checkCorruption(format);
+            checkLineFull(format);
+            printf("  backend %-8s %-7s %s\n", DLABKernelBackendName(backend), formatName(format),
+                   (dlabTestFailures == before ? "ok" : "FAILED"));
+        }
+    }
+    DLABKernelSetBackend(original);
+}
+
+int main()
+{
+    DLAB_RUN(testEncodePacket);
+    DLAB_RUN(testInvalidParameters);
+    DLAB_RUN(testAllBackends);
+    return DLAB_TEST_RESULT();
+}
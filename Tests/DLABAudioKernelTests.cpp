@@ -0,0 +1,148 @@
+//
+//  DLABAudioKernelTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABAudioKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Every available backend is verified against a scalar reference written here
+ independently of DLABAudioKernel. Source layouts cover both byte shuffle
+ sizes (16/32/48/64 bytes per sample frame) and scalar only sizes. Destination
+ is surrounded by guard bytes, as vector path stores whole 16 byte chunks.
+ */
+
+static const size_t kFrameCounts[] = {0, 1, 2, 3, 7, 64, 1001};
+static const size_t kGuardBytes = 64;
+static const uint8_t kGuard = 0xA5;
+
+typedef struct {
+    size_t srcChannels;
+    size_t dstChannels;
+    const uint8_t* channelMap;      // NULL for first dstChannels channels
+} ExtractCase;
+
+static const uint8_t kMapReverse[] = {7, 6, 5, 4, 3, 2, 1, 0};
+static const uint8_t kMapPair[] = {2, 3};
+static const uint8_t kMapDuplicate[] = {1, 1, 0, 0, 1};
+static const uint8_t kMapSparse[] = {15, 0, 9, 4, 12, 3};
+
+/* =================================================================================== */
+// MARK: - reference
+/* =================================================================================== */
+
+static void refExtract(const uint8_t* src, size_t srcChannels, uint8_t* dst, size_t dstChannels,
+                       const uint8_t* channelMap, size_t bytesPerSample, size_t frameCount)
+{
+    for (size_t f = 0; f < frameCount; f++) {
+        for (size_t ch = 0; ch < dstChannels; ch++) {
+            size_t srcChannel = (channelMap ? channelMap[ch] : ch);
+            memcpy(dst + (f * dstChannels + ch) * bytesPerSample,
+                   src + (f * srcChannels + srcChannel) * bytesPerSample, bytesPerSample);
+        }
+    }
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void checkExtract(const ExtractCase& test, size_t bytesPerSample, size_t frameCount)
+{
+    size_t srcBytes = test.srcChannels * bytesPerSample * frameCount;
+    size_t dstBytes = test.dstChannels * bytesPerSample * frameCount;
+    std::vector<uint8_t> src(srcBytes + 1);
+    dlabTestFill(src.data(), src.size(), (uint32_t)(test.srcChannels * 131 + test.dstChannels * 7 + frameCount));
+
+    std::vector<uint8_t> expected(kGuardBytes + dstBytes + kGuardBytes, kGuard);
+    std::vector<uint8_t> actual(expected.size(), kGuard);
+    refExtract(src.data(), test.srcChannels, expected.data() + kGuardBytes, test.dstChannels,
+               test.channelMap, bytesPerSample, frameCount);
+    DLAB_CHECK(DLABKernelAudioExtract(src.data(), test.srcChannels, actual.data() + kGuardBytes,
+                                      test.dstChannels, test.channelMap, bytesPerSample, frameCount));
+
+    size_t mismatch = 0;
+    for (size_t i = 0; i < actual.size(); i++) {
+        mismatch += (actual[i] != expected[i]);
+    }
+    if (mismatch) {
+        fprintf(stderr, "  %zubit %zuch -> %zuch (%s) %zu frames: %zu bytes differ\n",
+                bytesPerSample * 8, test.srcChannels, test.dstChannels,
+                (test.channelMap ? "map" : "first"), frameCount, mismatch);
+    }
+    DLAB_CHECK_EQ(mismatch, 0);
+}
+
+static void checkAllCases()
+{
+    const ExtractCase cases[] = {
+        {2, 2, NULL},
+        {2, 1, NULL},
+        {6, 2, NULL},                   // scalar only
+        {8, 8, NULL},
+        {8, 2, kMapPair},
+        {8, 8, kMapReverse},
+        {8, 5, kMapDuplicate},
+        {16, 6, kMapSparse},
+        {16, 16, NULL},
+        {24, 8, kMapReverse},
+        {32, 2, kMapPair},
+        {32, 32, NULL},                 // 16bit is 64 bytes, 32bit is scalar only
+    };
+    const size_t sampleSizes[] = {2, 4};
+    for (const ExtractCase& test : cases) {
+        for (size_t bytesPerSample : sampleSizes) {
+            for (size_t frameCount : kFrameCounts) {
+                checkExtract(test, bytesPerSample, frameCount);
+            }
+        }
+    }
+}
+
+static void testInvalidParameters()
+{
+    uint8_t src[64] = {0}, dst[64] = {0};
+    const uint8_t outOfRange[] = {0, 2};
+    DLAB_CHECK(!DLABKernelAudioExtract(NULL, 2, dst, 2, NULL, 2, 4));
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 2, NULL, 2, NULL, 2, 4));
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 0, dst, 2, NULL, 2, 4));
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 2, dst, 0, NULL, 2, 4));
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 2, dst, 2, NULL, 3, 4));         // 24bit
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 2, dst, 4, NULL, 2, 4));         // more than source
+    DLAB_CHECK(!DLABKernelAudioExtract(src, 2, dst, 2, outOfRange, 2, 4));
+    DLAB_CHECK(!DLABKernelAudioExtract(src, DLABKernelAudioMaxChannels + 1, dst, 2, NULL, 2, 0));
+    DLAB_CHECK(DLABKernelAudioExtract(src, 2, dst, 2, NULL, 2, 0));
+}
+
+static void testAllBackends()
+{
+    const DLABKernelBackend backends[] = {
+        DLABKernelBackendScalar, DLABKernelBackendSSE41, DLABKernelBackendAVX2, DLABKernelBackendNEON,
+    };
+    DLABKernelBackend original = DLABKernelGetBackend();
+    for (DLABKernelBackend backend : backends) {
+        if (DLABKernelSetBackend(backend) != backend) continue; // not available on this host
+        int before = dlabTestFailures;
+        checkAllCases();
+        printf("  backend %-8s %s\n", DLABKernelBackendName(backend),
+               (dlabTestFailures == before ? "ok" : "FAILED"));
+    }
+    DLABKernelSetBackend(original);
+}
+
+int main()
+{
+    DLAB_RUN(testInvalidParameters);
+    DLAB_RUN(testAllBackends);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,194 @@
+//
+//  DLABAudioRingTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABAudioRing.h"
+
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ Sample frames are 2ch 32bit (8 bytes); each frame holds its sequence number
+ in both channels, so order and integrity are checked across wrap around.
+ */
+
+static const uint32_t kBytesPerFrame = 8;
+
+static void fillFrames(std::vector<uint32_t>& frames, uint32_t first, uint32_t count)
+{
+    frames.resize((size_t)count * 2);
+    for (uint32_t i = 0; i < count; i++) {
+        frames[i * 2] = first + i;
+        frames[i * 2 + 1] = ~(first + i);
+    }
+}
+
+// Read every readable frame through Peek, and verify sequence starting at expected
+static uint32_t drainFrames(DLABAudioRing* ring, uint32_t expected, uint32_t maxCount, size_t* mismatch)
+{
+    const void* data[2] = {NULL, NULL};
+    uint32_t count[2] = {0, 0};
+    uint32_t total = ring->Peek(&data[0], &count[0], &data[1], &count[1]);
+    if (total != count[0] + count[1]) (*mismatch)++;
+
+    uint32_t consumed = 0;
+    for (int region = 0; region < 2 && consumed < maxCount; region++) {
+        const uint32_t* words = (const uint32_t*)data[region];
+        for (uint32_t i = 0; i < count[region] && consumed < maxCount; i++) {
+            uint32_t value = expected + consumed;
+            if (words[i * 2] != value || words[i * 2 + 1] != ~value) (*mismatch)++;
+            consumed++;
+        }
+    }
+    ring->Consume(consumed);
+    return consumed;
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testCapacity()
+{
+    DLABAudioRing* ring = new DLABAudioRing(1000, kBytesPerFrame);
+    DLAB_CHECK_EQ(ring->Capacity(), 1024);
+    DLAB_CHECK_EQ(ring->BytesPerFrame(), kBytesPerFrame);
+    DLAB_CHECK_EQ(ring->FillLevel(), 0);
+    ring->Release();
+
+    ring = new DLABAudioRing(0, 0);                      // clamped to 1 frame of 1 byte
+    DLAB_CHECK_EQ(ring->Capacity(), 1);
+    DLAB_CHECK_EQ(ring->BytesPerFrame(), 1);
+    ring->Release();
+}
+
+static void testWriteWrapAndOverflow()
+{
+    DLABAudioRing* ring = new DLABAudioRing(16, kBytesPerFrame);
+    std::vector<uint32_t> frames;
+    size_t mismatch = 0;
+
+    fillFrames(frames, 0, 12);
+    DLAB_CHECK_EQ(ring->Write(frames.data(), 12), 12);
+    DLAB_CHECK_EQ(drainFrames(ring, 0, 10, &mismatch), 10);
+    DLAB_CHECK_EQ(ring->FillLevel(), 2);
+
+    // Writes across end of buffer; readable region is split in two
+    fillFrames(frames, 12, 14);
+    DLAB_CHECK_EQ(ring->Write(frames.data(), 14), 14);
+    const void* data[2] = {NULL, NULL};
+    uint32_t count[2] = {0, 0};
+    DLAB_CHECK_EQ(ring->Peek(&data[0], &count[0], &data[1], &count[1]), 16);
+    DLAB_CHECK_EQ(count[0], 6);
+    DLAB_CHECK_EQ(count[1], 10);
+
+    // Full; rest is counted as overflow
+    fillFrames(frames, 26, 5);
+    DLAB_CHECK_EQ(ring->Write(frames.data(), 5), 0);
+    DLAB_CHECK_EQ(ring->OverflowCount(), 5);
+    DLAB_CHECK_EQ(ring->PeakFillLevel(), 16);
+
+    DLAB_CHECK_EQ(drainFrames(ring, 10, 16, &mismatch), 16);
+    DLAB_CHECK_EQ(mismatch, 0);
+    DLAB_CHECK_EQ(ring->WrittenCount(), 26);
+    DLAB_CHECK_EQ(ring->ConsumedCount(), 26);
+
+    // Consume beyond readable frames is clamped
+    ring->Consume(100);
+    DLAB_CHECK_EQ(ring->ConsumedCount(), 26);
+    DLAB_CHECK_EQ(ring->Write(NULL, 1), 0);
+    ring->Release();
+}
+
+static void testDiscardAndReset()
+{
+    DLABAudioRing* ring = new DLABAudioRing(8, kBytesPerFrame);
+    std::vector<uint32_t> frames;
+    fillFrames(frames, 0, 12);
+    ring->Write(frames.data(), 12);
+    ring->CountUnderrun();
+
+    ring->Discard();
+    DLAB_CHECK_EQ(ring->FillLevel(), 0);
+    DLAB_CHECK_EQ(ring->ConsumedCount(), 8);
+
+    ring->Reset();
+    DLAB_CHECK_EQ(ring->WrittenCount(), 0);
+    DLAB_CHECK_EQ(ring->ConsumedCount(), 0);
+    DLAB_CHECK_EQ(ring->OverflowCount(), 0);
+    DLAB_CHECK_EQ(ring->UnderrunCount(), 0);
+    DLAB_CHECK_EQ(ring->PeakFillLevel(), 0);
+
+    size_t mismatch = 0;
+    fillFrames(frames, 100, 3);
+    DLAB_CHECK_EQ(ring->Write(frames.data(), 3), 3);
+    DLAB_CHECK_EQ(drainFrames(ring, 100, 3, &mismatch), 3);
+    DLAB_CHECK_EQ(mismatch, 0);
+    ring->Release();
+}
+
+static void testReferenceCount()
+{
+    // Ring outlives owner while producer still refers it
+    DLABAudioRing* ring = new DLABAudioRing(64, kBytesPerFrame);
+    DLAB_CHECK_EQ(ring->RefCount(), 1);
+    DLAB_CHECK_EQ(ring->AddRef(), 2);
+    DLAB_CHECK_EQ(ring->Release(), 1);              // owner replaced ring
+
+    std::vector<uint32_t> frames;
+    fillFrames(frames, 0, 4);
+    DLAB_CHECK_EQ(ring->Write(frames.data(), 4), 4);
+    DLAB_CHECK_EQ(ring->Release(), 0);              // producer done; deleted
+}
+
+static void testProducerConsumer()
+{
+    const uint32_t total = 1 << 20;
+    DLABAudioRing* ring = new DLABAudioRing(4096, kBytesPerFrame);
+
+    std::thread producer([ring, total]() {
+        std::vector<uint32_t> frames;
+        uint32_t next = 0;
+        uint32_t chunk = 1;
+        while (next < total) {
+            uint32_t count = (chunk < total - next ? chunk : total - next);
+            fillFrames(frames, next, count);
+            next += ring->Write(frames.data(), count);      // partial write is retried
+            chunk = (chunk % 997) + 1;
+        }
+    });
+
+    size_t mismatch = 0;
+    uint32_t expected = 0;
+    uint32_t chunk = 1;
+    while (expected < total) {
+        expected += drainFrames(ring, expected, chunk, &mismatch);
+        chunk = (chunk % 1499) + 1;
+    }
+    producer.join();
+
+    DLAB_CHECK_EQ(mismatch, 0);
+    DLAB_CHECK_EQ(ring->WrittenCount(), total);
+    DLAB_CHECK_EQ(ring->ConsumedCount(), total);
+    DLAB_CHECK(ring->PeakFillLevel() <= ring->Capacity());
+    ring->Release();
+}
+
+int main()
+{
+    DLAB_RUN(testCapacity);
+    DLAB_RUN(testWriteWrapAndOverflow);
+    DLAB_RUN(testDiscardAndReset);
+    DLAB_RUN(testReferenceCount);
+    DLAB_RUN(testProducerConsumer);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,256 @@
+//
+//  DLABCaptureAlignerTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABCaptureAligner.h"
+
+#include <vector>
+
+/*
+ Items are tags (member * 1000 + frame) cast to pointer. Recorder collects
+ delivered bundles and dropped items, so every item is accounted exactly once.
+ Times are in nanoseconds with 40 mSec frame duration (25p).
+ */
+
+static const int64_t kDuration = 40000000;
+static const int64_t kMaxWait = 20000000;
+
+typedef struct {
+    int64_t instant;
+    uint32_t presentCount;
+    bool late;
+    std::vector<intptr_t> items;        // per member, 0 if missing
+} DeliveredBundle;
+
+typedef struct {
+    std::vector<DeliveredBundle> bundles;
+    std::vector<intptr_t> dropped;
+} Recorder;
+
+static void deliverBundle(const DLABCaptureAligner::Bundle& bundle, void* context)
+{
+    Recorder* recorder = (Recorder*)context;
+    DeliveredBundle delivered = {bundle.instant, bundle.presentCount, bundle.late, {}};
+    for (uint32_t m = 0; m < DLABCaptureAligner::kMaxMemberCount; m++) {
+        delivered.items.push_back((intptr_t)bundle.items[m]);
+    }
+    recorder->bundles.push_back(delivered);
+}
+
+static void dropItem(void* item, void* context)
+{
+    Recorder* recorder = (Recorder*)context;
+    recorder->dropped.push_back((intptr_t)item);
+}
+
+static void* tag(uint32_t member, int64_t frame)
+{
+    return (void*)(intptr_t)(member * 1000 + frame + 1);
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testCompleteBundle()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(3, deliverBundle, dropItem, &recorder);
+    aligner.SetMaxWait(kMaxWait);
+
+    // Jitter within half frame is quantized into same instant
+    aligner.Submit(0, 10 * kDuration + 1000000, kDuration, tag(0, 10), 100);
+    aligner.Submit(2, 10 * kDuration - 1000000, kDuration, tag(2, 10), 200);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 0);
+    aligner.Submit(1, 10 * kDuration, kDuration, tag(1, 10), 300);
+
+    DLAB_CHECK_EQ(recorder.bundles.size(), 1);
+    if (recorder.bundles.size() != 1) return;
+    const DeliveredBundle& bundle = recorder.bundles[0];
+    DLAB_CHECK_EQ(bundle.instant, 10);
+    DLAB_CHECK_EQ(bundle.presentCount, 3);
+    DLAB_CHECK(!bundle.late);
+    for (uint32_t m = 0; m < 3; m++) {
+        DLAB_CHECK_EQ(bundle.items[m], (intptr_t)tag(m, 10));
+    }
+    DLAB_CHECK_EQ(aligner.CompleteCount(), 1);
+    DLAB_CHECK_EQ(aligner.PartialCount(), 0);
+    DLAB_CHECK_EQ(aligner.Poll(400), 0);
+
+    DLABLatencyStats::Snapshot skew = aligner.GetSnapshot(DLABCaptureAligner::StatsStageSkew);
+    DLAB_CHECK_EQ(skew.count, 1);
+    DLAB_CHECK(skew.max >= 2000000 / 2 && skew.max <= 2000000 * 2);  // histogram bucket precision
+}
+
+static void testPartialBundleAfterMaxWait()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+    aligner.SetMaxWait(kMaxWait);
+
+    aligner.Submit(0, 5 * kDuration, kDuration, tag(0, 5), 1000);
+    DLAB_CHECK_EQ(aligner.Poll(1000), 1000 + kMaxWait);
+    DLAB_CHECK_EQ(aligner.Poll(1000 + kMaxWait - 1), 1000 + kMaxWait);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 0);
+
+    DLAB_CHECK_EQ(aligner.Poll(1000 + kMaxWait), 0);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 1);
+    if (recorder.bundles.size() != 1) return;
+    DLAB_CHECK_EQ(recorder.bundles[0].presentCount, 1);
+    DLAB_CHECK_EQ(recorder.bundles[0].items[1], 0);
+    DLAB_CHECK_EQ(aligner.PartialCount(), 1);
+}
+
+static void testInstantOrder()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+    aligner.SetMaxWait(kMaxWait);
+
+    // Member 1 skips frame 1; completing frame 2 delivers frame 0 and 1 first
+    aligner.Submit(0, 0 * kDuration, kDuration, tag(0, 0), 0);
+    aligner.Submit(0, 1 * kDuration, kDuration, tag(0, 1), 0);
+    aligner.Submit(0, 2 * kDuration, kDuration, tag(0, 2), 0);
+    aligner.Submit(1, 2 * kDuration, kDuration, tag(1, 2), 0);
+
+    DLAB_CHECK_EQ(recorder.bundles.size(), 3);
+    for (size_t i = 0; i < recorder.bundles.size(); i++) {
+        DLAB_CHECK_EQ(recorder.bundles[i].instant, (int64_t)i);
+    }
+    DLAB_CHECK_EQ(aligner.CompleteCount(), 1);
+    DLAB_CHECK_EQ(aligner.PartialCount(), 2);
+}
+
+static void testLatePolicy()
+{
+    for (int deliverLate = 0; deliverLate < 2; deliverLate++) {
+        Recorder recorder;
+        DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+        aligner.SetMaxWait(kMaxWait);
+        aligner.SetLatePolicy(deliverLate ? DLABCaptureAligner::LatePolicyDeliver
+                                          : DLABCaptureAligner::LatePolicyDrop);
+
+        aligner.Submit(0, 3 * kDuration, kDuration, tag(0, 3), 0);
+        aligner.Flush(0);
+        DLAB_CHECK_EQ(recorder.bundles.size(), 1);
+
+        aligner.Submit(1, 3 * kDuration, kDuration, tag(1, 3), 0);
+        DLAB_CHECK_EQ(aligner.LateCount(), 1);
+        if (deliverLate) {
+            DLAB_CHECK_EQ(recorder.bundles.size(), 2);
+            DLAB_CHECK_EQ(recorder.dropped.size(), 0);
+            if (recorder.bundles.size() == 2) {
+                DLAB_CHECK(recorder.bundles[1].late);
+                DLAB_CHECK_EQ(recorder.bundles[1].items[1], (intptr_t)tag(1, 3));
+            }
+        } else {
+            DLAB_CHECK_EQ(recorder.bundles.size(), 1);
+            DLAB_CHECK_EQ(recorder.dropped.size(), 1);
+            DLAB_CHECK_EQ(aligner.DropCount(), 1);
+        }
+    }
+}
+
+static void testDuplicateAndInvalidMember()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+
+    // Newer one wins
+    aligner.Submit(0, 0, kDuration, tag(0, 0), 0);
+    aligner.Submit(0, 0, kDuration, tag(0, 100), 0);
+    DLAB_CHECK_EQ(recorder.dropped.size(), 1);
+    aligner.Submit(1, 0, kDuration, tag(1, 0), 0);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 1);
+    if (recorder.bundles.size() == 1) {
+        DLAB_CHECK_EQ(recorder.bundles[0].items[0], (intptr_t)tag(0, 100));
+    }
+
+    aligner.Submit(2, 0, kDuration, tag(2, 0), 0);      // out of range
+    aligner.Submit(0, 0, 0, tag(0, 1), 0);              // invalid duration
+    DLAB_CHECK_EQ(recorder.dropped.size(), 3);
+}
+
+static void testPendingOverflow()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+    aligner.SetMaxWait(kMaxWait);
+
+    // Member 1 never arrives; oldest bundle is delivered to make room
+    int64_t total = DLABCaptureAligner::kMaxPendingCount + 3;
+    for (int64_t f = 0; f < total; f++) {
+        aligner.Submit(0, f * kDuration, kDuration, tag(0, f), 0);
+    }
+    DLAB_CHECK_EQ(recorder.bundles.size(), 3);
+    aligner.Flush(0);
+    DLAB_CHECK_EQ(recorder.bundles.size(), (size_t)total);
+    for (size_t i = 0; i < recorder.bundles.size(); i++) {
+        DLAB_CHECK_EQ(recorder.bundles[i].instant, (int64_t)i);
+    }
+}
+
+static void testReset()
+{
+    Recorder recorder;
+    DLABCaptureAligner aligner(2, deliverBundle, dropItem, &recorder);
+    aligner.SetMaxWait(kMaxWait);
+
+    // Restarted stream begins at earlier instant than last delivered one
+    aligner.Submit(0, 50 * kDuration, kDuration, tag(0, 50), 0);
+    aligner.Submit(1, 50 * kDuration, kDuration, tag(1, 50), 0);
+    aligner.Submit(0, 51 * kDuration, kDuration, tag(0, 51), 0);
+    aligner.Flush(0);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 2);
+
+    aligner.Submit(0, 51 * kDuration, kDuration, tag(0, 151), 0);
+    aligner.Reset();
+    DLAB_CHECK_EQ(recorder.dropped.size(), 1);              // late frame before reset
+
+    aligner.Submit(0, 10 * kDuration, kDuration, tag(0, 10), 0);
+    aligner.Submit(1, 10 * kDuration, kDuration, tag(1, 10), 0);
+    DLAB_CHECK_EQ(recorder.bundles.size(), 3);
+    if (recorder.bundles.size() == 3) {
+        DLAB_CHECK_EQ(recorder.bundles[2].instant, 10);
+        DLAB_CHECK(!recorder.bundles[2].late);
+    }
+
+    // Pending items are dropped by Reset
+    aligner.Submit(0, 11 * kDuration, kDuration, tag(0, 11), 0);
+    aligner.Reset();
+    DLAB_CHECK_EQ(recorder.dropped.size(), 2);
+    DLAB_CHECK_EQ(aligner.Poll(0), 0);
+}
+
+static void testDestructorDropsPending()
+{
+    Recorder recorder;
+    {
+        DLABCaptureAligner aligner(3, deliverBundle, dropItem, &recorder);
+        aligner.Submit(0, 0, kDuration, tag(0, 0), 0);
+        aligner.Submit(1, 0, kDuration, tag(1, 0), 0);
+        aligner.Submit(0, kDuration, kDuration, tag(0, 1), 0);
+    }
+    DLAB_CHECK_EQ(recorder.bundles.size(), 0);
+    DLAB_CHECK_EQ(recorder.dropped.size(), 3);
+}
+
+int main()
+{
+    DLAB_RUN(testCompleteBundle);
+    DLAB_RUN(testPartialBundleAfterMaxWait);
+    DLAB_RUN(testInstantOrder);
+    DLAB_RUN(testLatePolicy);
+    DLAB_RUN(testDuplicateAndInvalidMember);
+    DLAB_RUN(testPendingOverflow);
+    DLAB_RUN(testReset);
+    DLAB_RUN(testDestructorDropsPending);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,197 @@
+//
+//  DLABCopyKernelTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABCopyKernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Destination is surrounded by guard bytes, and pre-filled with kSentinel, so
+ every byte outside of the expected copy is checked to be untouched.
+ Destination start is misaligned on purpose, so the non-temporal path has
+ both head and tail.
+ */
+
+static const uint8_t kSentinel = 0xA5;
+static const size_t kGuardBytes = 64;
+static const size_t kDstMisalign = 3;
+
+static const DLABBlitMode kModes[] = {
+    DLABBlitModeCached, DLABBlitModePrefetch, DLABBlitModeStreaming,
+};
+
+static const char* modeName(DLABBlitMode mode)
+{
+    switch (mode) {
+        case DLABBlitModeCached: return "cached";
+        case DLABBlitModePrefetch: return "prefetch";
+        case DLABBlitModeStreaming: return "streaming";
+    }
+    return "?";
+}
+
+// Count bytes which differ from expectation; whole buffer including guards
+static size_t blitMismatch(size_t srcRowBytes, size_t dstRowBytes, size_t rowLength, size_t height,
+                           DLABBlitMode mode)
+{
+    std::vector<uint8_t> src(srcRowBytes * height + rowLength + kGuardBytes);
+    dlabTestFill(src.data(), src.size(), (uint32_t)(srcRowBytes * 31 + height));
+
+    size_t dstBytes = dstRowBytes * (height - 1) + (rowLength > dstRowBytes ? rowLength : dstRowBytes);
+    std::vector<uint8_t> dstBuffer(kGuardBytes + kDstMisalign + dstBytes + kGuardBytes, kSentinel);
+    uint8_t* dst = dstBuffer.data() + kGuardBytes + kDstMisalign;
+
+    if (!DLABBlit2D(src.data(), srcRowBytes, dst, dstRowBytes, rowLength, height, mode)) {
+        return dstBuffer.size();
+    }
+
+    // Same stride copies row padding as well, except after last row
+    bool span = (srcRowBytes == dstRowBytes);
+    size_t mismatch = 0;
+    for (size_t i = 0; i < dstBuffer.size(); i++) {
+        uint8_t expected = kSentinel;
+        if (&dstBuffer[i] >= dst && &dstBuffer[i] < dst + dstBytes) {
+            size_t offset = (size_t)(&dstBuffer[i] - dst);
+            size_t row = offset / dstRowBytes;
+            size_t column = offset % dstRowBytes;
+            bool copied = (span ? offset < dstRowBytes * (height - 1) + rowLength : column < rowLength);
+            if (copied) expected = src[row * srcRowBytes + column];
+        }
+        mismatch += (dstBuffer[i] != expected);
+    }
+    return mismatch;
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testBlitStrideMatrix()
+{
+    // rowLength is not a multiple of 16, so every span has a tail
+    const size_t rowLength = 1000;
+    const struct { const char* name; size_t srcRowBytes; size_t dstRowBytes; } strides[] = {
+        {"src<dst", 1024, 1088},
+        {"src>dst", 1088, 1024},
+        {"equal", 1056, 1056},
+    };
+    const size_t heights[] = {1, 9};
+
+    for (const auto& stride : strides) {
+        for (size_t height : heights) {
+            for (DLABBlitMode mode : kModes) {
+                size_t mismatch = blitMismatch(stride.srcRowBytes, stride.dstRowBytes, rowLength, height, mode);
+                if (mismatch) {
+                    fprintf(stderr, "  %s height %zu %s: %zu bytes differ\n",
+                            stride.name, height, modeName(mode), mismatch);
+                }
+                DLAB_CHECK_EQ(mismatch, 0);
+            }
+        }
+    }
+}
+
+static void testBlitEdgeLengths()
+{
+    // Shorter than one vector, and large enough for prefetch distance
+    const size_t lengths[] = {1, 15, 17, 4096 + 5};
+    for (size_t length : lengths) {
+        for (DLABBlitMode mode : kModes) {
+            DLAB_CHECK_EQ(blitMismatch(length + 16, length + 48, length, 3, mode), 0);
+            DLAB_CHECK_EQ(blitMismatch(length, length, length, 3, mode), 0);
+        }
+    }
+
+    // Single row may be longer than stride
+    for (DLABBlitMode mode : kModes) {
+        DLAB_CHECK_EQ(blitMismatch(64, 64, 200, 1, mode), 0);
+    }
+}
+
+static void testBlitInvalidParameters()
+{
+    uint8_t src[256] = {0};
+    uint8_t dst[256] = {0};
+    DLAB_CHECK(!DLABBlit2D(NULL, 16, dst, 16, 16, 2, DLABBlitModeCached));
+    DLAB_CHECK(!DLABBlit2D(src, 16, NULL, 16, 16, 2, DLABBlitModeCached));
+    DLAB_CHECK(!DLABBlit2D(src, 16, dst, 16, 0, 2, DLABBlitModeCached));
+    DLAB_CHECK(!DLABBlit2D(src, 16, dst, 16, 16, 0, DLABBlitModeCached));
+    DLAB_CHECK(!DLABBlit2D(src, 16, dst, 32, 20, 2, DLABBlitModePrefetch));     // exceeds srcRowBytes
+    DLAB_CHECK(!DLABBlit2D(src, 32, dst, 16, 20, 2, DLABBlitModeStreaming));    // exceeds dstRowBytes
+}
+
+static void testModeSelection()
+{
+    DLAB_CHECK_EQ(DLABBlitModeForSize(0), DLABBlitModeCached);
+    DLAB_CHECK_EQ(DLABBlitModeForSize(DLABBlitLargeFrameBytes - 1), DLABBlitModeCached);
+    DLAB_CHECK_EQ(DLABBlitModeForSize(DLABBlitLargeFrameBytes), DLABBlitModePrefetch);
+    DLAB_CHECK_EQ(DLABBlitModeSelect(true, 16), DLABBlitModeStreaming);
+    DLAB_CHECK_EQ(DLABBlitModeSelect(false, DLABBlitLargeFrameBytes), DLABBlitModePrefetch);
+}
+
+static void testKernelResolve()
+{
+    // 'v210' row unit is 128 bytes per 48 pixels
+    DLABCopyKernel kernel = DLABCopyKernelResolve(0x76323130, 0x76323130, false);
+    DLAB_CHECK(kernel.copy != NULL);
+    DLAB_CHECK_EQ(kernel.pixelSize, 3);
+    DLAB_CHECK_EQ(kernel.dlFormat, 0x76323130);
+    DLAB_CHECK(!kernel.strideEqual);
+
+    // Format pair which requires conversion
+    kernel = DLABCopyKernelResolve(0x32767579, 0x42475241, true);
+    DLAB_CHECK(kernel.copy == NULL);
+    DLAB_CHECK_EQ(kernel.cvFormat, 0x42475241);
+    DLAB_CHECK(kernel.strideEqual);
+}
+
+static void testKernelCopy()
+{
+    // 1280 pixels of 'v210' is 27 row units (3456 bytes); last unit is partially used
+    const size_t width = 1280, height = 5, rowLength = 3456;
+    const size_t srcRowBytes = 3456, dstRowBytes = 3584;
+    for (DLABBlitMode mode : kModes) {
+        DLABCopyKernel kernel = DLABCopyKernelResolve(0x76323130, 0x76323130, false);
+        std::vector<uint8_t> src(srcRowBytes * height);
+        std::vector<uint8_t> dst(dstRowBytes * height, kSentinel);
+        dlabTestFill(src.data(), src.size(), 7);
+        DLAB_CHECK(kernel.copy && kernel.copy(src.data(), srcRowBytes, dst.data(), dstRowBytes, width, height, mode));
+
+        size_t mismatch = 0;
+        for (size_t row = 0; row < height; row++) {
+            mismatch += (memcmp(&dst[row * dstRowBytes], &src[row * srcRowBytes], rowLength) != 0);
+            for (size_t i = rowLength; i < dstRowBytes; i++) mismatch += (dst[row * dstRowBytes + i] != kSentinel);
+        }
+        DLAB_CHECK_EQ(mismatch, 0);
+
+        // Stride shorter than packed row is rejected
+        DLAB_CHECK(!kernel.copy(src.data(), rowLength - 128, dst.data(), dstRowBytes, width, height, mode));
+        DLAB_CHECK(!kernel.copy(src.data(), srcRowBytes, dst.data(), rowLength - 128, width, height, mode));
+
+        // Same stride kernel copies padding too
+        kernel = DLABCopyKernelResolve(0x76323130, 0x76323130, true);
+        std::vector<uint8_t> same(srcRowBytes * height, kSentinel);
+        DLAB_CHECK(kernel.copy && kernel.copy(src.data(), srcRowBytes, same.data(), srcRowBytes, width, height, mode));
+        DLAB_CHECK(same == src);
+    }
+}
+
+int main()
+{
+    DLAB_RUN(testBlitStrideMatrix);
+    DLAB_RUN(testBlitEdgeLengths);
+    DLAB_RUN(testBlitInvalidParameters);
+    DLAB_RUN(testModeSelection);
+    DLAB_RUN(testKernelResolve);
+    DLAB_RUN(testKernelCopy);
+    return DLAB_TEST_RESULT();
+}
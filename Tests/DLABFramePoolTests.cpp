@@ -0,0 +1,107 @@
+//
+//  DLABFramePoolTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABFramePool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+static void countItem(void* item, void* context)
+{
+    (void)item;
+    (*(int*)context)++;
+}
+
+static void testReserveRelease()
+{
+    int items[4];
+    DLABFramePool pool(3);
+    DLAB_CHECK_EQ(pool.Capacity(), 3);
+    DLAB_CHECK(pool.Add(&items[0]));
+    DLAB_CHECK(pool.Add(&items[1]));
+    DLAB_CHECK(pool.Add(&items[2]));
+    DLAB_CHECK(!pool.Add(&items[3]));           // full
+    DLAB_CHECK(!pool.Add(NULL));
+    DLAB_CHECK_EQ(pool.Count(), 3);
+    DLAB_CHECK_EQ(pool.IdleCount(), 3);
+
+    void* a = pool.Reserve();
+    void* b = pool.Reserve();
+    void* c = pool.Reserve();
+    DLAB_CHECK(a && b && c && a != b && b != c && a != c);
+    DLAB_CHECK(pool.Reserve() == NULL);         // exhausted
+    DLAB_CHECK_EQ(pool.IdleCount(), 0);
+
+    DLAB_CHECK(pool.Release(b));
+    DLAB_CHECK(!pool.Release(b));               // already idle
+    DLAB_CHECK(!pool.Release(&items[3]));       // unknown
+    DLAB_CHECK_EQ(pool.IdleCount(), 1);
+    DLAB_CHECK(pool.Reserve() == b);
+
+    DLAB_CHECK(pool.Release(a));
+    DLAB_CHECK(pool.Shrink() == a);             // only idle item is unregistered
+    DLAB_CHECK(pool.Shrink() == NULL);
+    DLAB_CHECK_EQ(pool.Count(), 2);
+    DLAB_CHECK(!pool.Release(a));               // no longer registered
+
+    int removed = 0;
+    pool.RemoveAll(countItem, &removed);        // reserved items are removed too
+    DLAB_CHECK_EQ(removed, 2);
+    DLAB_CHECK_EQ(pool.Count(), 0);
+    DLAB_CHECK(pool.Reserve() == NULL);
+}
+
+static void testCapacityClamp()
+{
+    DLABFramePool pool(DLABFramePool::kMaxCapacity + 10);
+    DLAB_CHECK_EQ(pool.Capacity(), DLABFramePool::kMaxCapacity);
+}
+
+static void testConcurrentOwnership()
+{
+    // Every item is owned by at most one thread at a time
+    const size_t kItems = 8, kThreads = 4, kRounds = 50000;
+    std::atomic<int> owners[kItems];
+    DLABFramePool pool(kItems);
+    for (size_t i = 0; i < kItems; i++) {
+        owners[i].store(0);
+        pool.Add(&owners[i]);
+    }
+
+    std::atomic<size_t> violations(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < kThreads; t++) {
+        threads.emplace_back([&] {
+            for (size_t n = 0; n < kRounds; n++) {
+                std::atomic<int>* owner = (std::atomic<int>*)pool.Reserve();
+                if (!owner) continue;
+                if (owner->fetch_add(1) != 0) violations++;
+                owner->fetch_sub(1);
+                if (!pool.Release(owner)) violations++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    DLAB_CHECK_EQ(violations.load(), 0);
+    DLAB_CHECK_EQ(pool.Count(), kItems);
+    DLAB_CHECK_EQ(pool.IdleCount(), kItems);
+    pool.RemoveAll(NULL, NULL);
+}
+
+int main()
+{
+    DLAB_RUN(testReserveRelease);
+    DLAB_RUN(testCapacityClamp);
+    DLAB_RUN(testConcurrentOwnership);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,148 @@
+//
+//  DLABLatencyStatsTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABLatencyStats.h"
+
+#include <thread>
+#include <vector>
+
+/*
+ Percentiles come from log-linear buckets, so they are checked within the
+ bucket precision (1/32) unless they are clamped to max.
+ */
+
+static bool nearValue(uint64_t actual, uint64_t expected)
+{
+    uint64_t tolerance = expected / 32 + 1;
+    return (actual + tolerance >= expected && actual <= expected + tolerance);
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testEmpty()
+{
+    DLABLatencyStats stats(2);
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 0);
+    DLAB_CHECK_EQ(snapshot.p50, 0);
+    DLAB_CHECK_EQ(snapshot.p99, 0);
+    DLAB_CHECK_EQ(snapshot.max, 0);
+    DLAB_CHECK_EQ(snapshot.mean, 0);
+
+    // Out of range stage is ignored
+    stats.Record(2, 100);
+    DLAB_CHECK_EQ(stats.GetSnapshot(2).count, 0);
+
+    // Stage count is clamped
+    DLABLatencyStats many(DLABLatencyStats::kMaxStageCount + 4);
+    many.Record(DLABLatencyStats::kMaxStageCount, 100);
+    many.Record(DLABLatencyStats::kMaxStageCount - 1, 100);
+    DLAB_CHECK_EQ(many.GetSnapshot(DLABLatencyStats::kMaxStageCount).count, 0);
+    DLAB_CHECK_EQ(many.GetSnapshot(DLABLatencyStats::kMaxStageCount - 1).count, 1);
+}
+
+static void testSingleBucketClampedToMax()
+{
+    // Middle of the bucket of 1000 is above 1000; percentiles are clamped to max
+    DLABLatencyStats stats(1);
+    for (int i = 0; i < 100; i++) stats.Record(0, 1000);
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 100);
+    DLAB_CHECK_EQ(snapshot.p50, 1000);
+    DLAB_CHECK_EQ(snapshot.p99, 1000);
+    DLAB_CHECK_EQ(snapshot.max, 1000);
+    DLAB_CHECK_EQ(snapshot.mean, 1000);
+}
+
+static void testMedianInBucketZero()
+{
+    DLABLatencyStats stats(1);
+    for (int i = 0; i < 60; i++) stats.Record(0, 0);
+    for (int i = 0; i < 40; i++) stats.Record(0, 5000);
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.p50, 0);
+    DLAB_CHECK(nearValue(snapshot.p99, 5000));
+    DLAB_CHECK_EQ(snapshot.max, 5000);
+    DLAB_CHECK_EQ(snapshot.mean, 2000);
+
+    // Every sample is 0
+    stats.Reset();
+    for (int i = 0; i < 10; i++) stats.Record(0, 0);
+    snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 10);
+    DLAB_CHECK_EQ(snapshot.p50, 0);
+    DLAB_CHECK_EQ(snapshot.p99, 0);
+}
+
+static void testPercentiles()
+{
+    // 1..200 uSec, once each
+    DLABLatencyStats stats(1);
+    for (uint64_t i = 1; i <= 200; i++) stats.Record(0, i * 1000);
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 200);
+    DLAB_CHECK(nearValue(snapshot.p50, 100000));
+    DLAB_CHECK(nearValue(snapshot.p99, 198000));
+    DLAB_CHECK_EQ(snapshot.max, 200000);
+    DLAB_CHECK_EQ(snapshot.mean, 100500);
+
+    // Small values are exact (linear buckets)
+    stats.Reset();
+    for (uint64_t i = 0; i < 16; i++) stats.Record(0, i);
+    snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.p50, 7);
+    DLAB_CHECK_EQ(snapshot.p99, 15);
+}
+
+static void testOverflowAndReset()
+{
+    // Beyond last bucket; percentiles never exceed max
+    DLABLatencyStats stats(1);
+    stats.Record(0, 10);
+    stats.Record(0, 1ULL << 50);
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.max, 1ULL << 50);
+    DLAB_CHECK(snapshot.p99 <= snapshot.max);
+    DLAB_CHECK(snapshot.p99 > (1ULL << 39));
+
+    stats.Reset();
+    snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 0);
+    DLAB_CHECK_EQ(snapshot.max, 0);
+}
+
+static void testConcurrentRecord()
+{
+    DLABLatencyStats stats(1);
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&stats, t]() {
+            for (uint64_t i = 0; i < 10000; i++) stats.Record(0, 100 + t);
+        }));
+    }
+    for (std::thread& thread : threads) thread.join();
+    DLABLatencyStats::Snapshot snapshot = stats.GetSnapshot(0);
+    DLAB_CHECK_EQ(snapshot.count, 40000);
+    DLAB_CHECK_EQ(snapshot.max, 103);
+}
+
+int main()
+{
+    DLAB_RUN(testEmpty);
+    DLAB_RUN(testSingleBucketClampedToMax);
+    DLAB_RUN(testMedianInBucketZero);
+    DLAB_RUN(testPercentiles);
+    DLAB_RUN(testOverflowAndReset);
+    DLAB_RUN(testConcurrentRecord);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,253 @@
+//
+//  DLABPlaybackSchedulerTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABPlaybackScheduler.h"
+
+#include <atomic>
+#include <thread>
+
+/*
+ Items are reference counted test frames. Enqueue passes one reference into
+ scheduler, and Next returns one more reference to consumer, as the output
+ path does with CVPixelBuffer. Every test ends with all references released.
+ */
+
+static const int64_t kFrameDuration = 1001;
+
+typedef struct {
+    int id;
+    std::atomic<int> refs;
+} Item;
+
+static void retainItem(void* item)
+{
+    ((Item*)item)->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+static void releaseItem(void* item)
+{
+    ((Item*)item)->refs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+static Item* makeItems(size_t count)
+{
+    Item* items = new Item[count];
+    for (size_t i = 0; i < count; i++) {
+        items[i].id = (int)i;
+        items[i].refs.store(0, std::memory_order_relaxed);
+    }
+    return items;
+}
+
+static bool enqueueItem(DLABPlaybackScheduler& scheduler, Item* item)
+{
+    retainItem(item);
+    if (scheduler.Enqueue(item)) return true;
+    releaseItem(item);
+    return false;
+}
+
+static size_t leakedRefs(Item* items, size_t count)
+{
+    size_t leaked = 0;
+    for (size_t i = 0; i < count; i++) {
+        leaked += (items[i].refs.load(std::memory_order_relaxed) != 0);
+    }
+    return leaked;
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testOrderAndDisplayTime()
+{
+    Item* items = makeItems(4);
+    {
+        DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+        scheduler.Start(kFrameDuration, 3, 10);
+
+        int64_t displayTime = -1;
+        bool repeated = true;
+        DLAB_CHECK(scheduler.Next(&displayTime, &repeated) == NULL);   // nothing yet
+        DLAB_CHECK_EQ(scheduler.FrameIndex(), 10);
+
+        for (int i = 0; i < 3; i++) DLAB_CHECK(enqueueItem(scheduler, &items[i]));
+        DLAB_CHECK_EQ(scheduler.QueuedCount(), 3);
+
+        for (int i = 0; i < 3; i++) {
+            Item* item = (Item*)scheduler.Next(&displayTime, &repeated);
+            DLAB_CHECK(item == &items[i]);
+            DLAB_CHECK_EQ(displayTime, (10 + i) * kFrameDuration);
+            DLAB_CHECK(!repeated);
+            if (item) releaseItem(item);
+        }
+        DLAB_CHECK_EQ(scheduler.QueuedCount(), 0);
+        DLAB_CHECK_EQ(items[0].refs.load(), 0);                         // replaced by newer item
+        DLAB_CHECK_EQ(items[2].refs.load(), 1);                         // kept as last item
+    }
+    DLAB_CHECK_EQ(leakedRefs(items, 4), 0);
+    delete[] items;
+}
+
+static void testRepeatOnStarvation()
+{
+    Item* items = makeItems(2);
+    {
+        DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+        scheduler.Start(kFrameDuration, 2, 0);
+        enqueueItem(scheduler, &items[0]);
+
+        int64_t displayTime = 0;
+        bool repeated = false;
+        Item* item = (Item*)scheduler.Next(&displayTime, &repeated);
+        DLAB_CHECK(item == &items[0] && !repeated);
+        if (item) releaseItem(item);
+
+        // Timeline has no hole; last item is repeated
+        for (int i = 1; i <= 3; i++) {
+            item = (Item*)scheduler.Next(&displayTime, &repeated);
+            DLAB_CHECK(item == &items[0]);
+            DLAB_CHECK(repeated);
+            DLAB_CHECK_EQ(displayTime, i * kFrameDuration);
+            if (item) releaseItem(item);
+        }
+        DLAB_CHECK_EQ(scheduler.RepeatedCount(), 3);
+
+        enqueueItem(scheduler, &items[1]);
+        item = (Item*)scheduler.Next(&displayTime, &repeated);
+        DLAB_CHECK(item == &items[1] && !repeated);
+        DLAB_CHECK_EQ(displayTime, 4 * kFrameDuration);
+        if (item) releaseItem(item);
+    }
+    DLAB_CHECK_EQ(leakedRefs(items, 2), 0);
+    delete[] items;
+}
+
+static void testQueueFullAndStop()
+{
+    const size_t count = DLABPlaybackScheduler::kQueueCapacity + 2;
+    Item* items = makeItems(count);
+    DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+    scheduler.Start(kFrameDuration, 3, 0);
+
+    size_t accepted = 0;
+    for (size_t i = 0; i < count; i++) accepted += enqueueItem(scheduler, &items[i]);
+    DLAB_CHECK_EQ(accepted, DLABPlaybackScheduler::kQueueCapacity);
+    DLAB_CHECK_EQ(scheduler.RejectedCount(), 2);
+    DLAB_CHECK(!scheduler.Enqueue(NULL));
+
+    Item* item = (Item*)scheduler.Next(NULL, NULL);
+    if (item) releaseItem(item);
+
+    // Stop releases queued items and last item
+    scheduler.Stop();
+    DLAB_CHECK_EQ(scheduler.QueuedCount(), 0);
+    DLAB_CHECK_EQ(leakedRefs(items, count), 0);
+    DLAB_CHECK(scheduler.Next(NULL, NULL) == NULL);
+    delete[] items;
+}
+
+static void testCatchUp()
+{
+    Item* items = makeItems(1);
+    {
+        DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+        scheduler.Start(kFrameDuration, 3, 5);
+
+        // Frame on air is still ahead of next display time
+        DLAB_CHECK_EQ(scheduler.CatchUp(4 * kFrameDuration), 0);
+        DLAB_CHECK_EQ(scheduler.CatchUp(-1), 0);
+
+        // Stream time is in frame 9; next frame should be 10
+        DLAB_CHECK_EQ(scheduler.CatchUp(9 * kFrameDuration + 10), 5);
+        DLAB_CHECK_EQ(scheduler.FrameIndex(), 10);
+        DLAB_CHECK_EQ(scheduler.SkippedCount(), 5);
+
+        int64_t displayTime = 0;
+        enqueueItem(scheduler, &items[0]);
+        Item* item = (Item*)scheduler.Next(&displayTime, NULL);
+        DLAB_CHECK_EQ(displayTime, 10 * kFrameDuration);
+        if (item) releaseItem(item);
+    }
+    DLAB_CHECK_EQ(leakedRefs(items, 1), 0);
+    delete[] items;
+}
+
+static void testConfigurationAndStatistics()
+{
+    DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+    scheduler.Start(0, 0, -3);                      // clamped
+    DLAB_CHECK_EQ(scheduler.TargetDepth(), 1);
+    DLAB_CHECK_EQ(scheduler.FrameIndex(), 0);
+    scheduler.SetTargetDepth(4);
+    DLAB_CHECK_EQ(scheduler.TargetDepth(), 4);
+
+    scheduler.RecordCompletion(DLABPlaybackScheduler::CompletionCompleted);
+    scheduler.RecordCompletion(DLABPlaybackScheduler::CompletionCompleted);
+    scheduler.RecordCompletion(DLABPlaybackScheduler::CompletionLate);
+    scheduler.RecordCompletion(DLABPlaybackScheduler::CompletionCount);  // ignored
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionCompleted), 2);
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionLate), 1);
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionDropped), 0);
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionCount), 0);
+
+    scheduler.ResetStatistics();
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionCompleted), 0);
+    DLAB_CHECK_EQ(scheduler.CompletionCountOf(DLABPlaybackScheduler::CompletionLate), 0);
+}
+
+static void testProducerConsumer()
+{
+    const size_t count = 64;
+    const int frames = 20000;
+    Item* items = makeItems(count);
+    {
+        DLABPlaybackScheduler scheduler(retainItem, releaseItem);
+        scheduler.Start(kFrameDuration, 3, 0);
+
+        std::atomic<bool> done(false);
+        std::thread producer([&]() {
+            size_t next = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (enqueueItem(scheduler, &items[next % count])) next++;
+                else std::this_thread::yield();
+            }
+        });
+
+        int64_t lastTime = -1;
+        size_t nonMonotonic = 0;
+        for (int i = 0; i < frames; i++) {
+            int64_t displayTime = 0;
+            Item* item = (Item*)scheduler.Next(&displayTime, NULL);
+            if (!item) continue;
+            nonMonotonic += (displayTime <= lastTime);
+            lastTime = displayTime;
+            releaseItem(item);
+        }
+        done.store(true, std::memory_order_relaxed);
+        producer.join();
+        DLAB_CHECK_EQ(nonMonotonic, 0);
+    }
+    DLAB_CHECK_EQ(leakedRefs(items, count), 0);
+    delete[] items;
+}
+
+int main()
+{
+    DLAB_RUN(testOrderAndDisplayTime);
+    DLAB_RUN(testRepeatOnStarvation);
+    DLAB_RUN(testQueueFullAndStop);
+    DLAB_RUN(testCatchUp);
+    DLAB_RUN(testConfigurationAndStatistics);
+    DLAB_RUN(testProducerConsumer);
+    return DLAB_TEST_RESULT();
+}
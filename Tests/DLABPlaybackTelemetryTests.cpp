@@ -0,0 +1,182 @@
+//
+//  DLABPlaybackTelemetryTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABPlaybackTelemetry.h"
+
+#include <thread>
+#include <vector>
+
+/*
+ Frames are tags cast to pointer. Display time is 29.97p (1001/30000), and
+ hardware clock starts at 1 sec, so frame n is expected on air at
+ kBase + displayNanos(n) plus scheduled offset.
+ */
+
+typedef DLABPlaybackTelemetry Telemetry;
+
+static const int64_t kTimeScale = 30000;
+static const int64_t kDuration = 1001;
+static const int64_t kFrameNanos = 33366666;       // 1001 / 30000 sec, truncated
+static const int64_t kBase = 1000000000;
+static const int64_t kScheduleToAir = 50000000;
+
+static int64_t displayNanos(intptr_t index)
+{
+    return index * kDuration * 1000000000 / kTimeScale;
+}
+
+static const void* frameTag(intptr_t index)
+{
+    return (const void*)(index + 1);
+}
+
+static void schedule(Telemetry& telemetry, intptr_t index)
+{
+    telemetry.RecordScheduled(frameTag(index), index * kDuration, kDuration, kTimeScale,
+                              kBase + displayNanos(index));
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testOnTimeFrames()
+{
+    Telemetry telemetry;
+    for (intptr_t i = 0; i < 4; i++) schedule(telemetry, i);
+
+    for (intptr_t i = 0; i < 4; i++) {
+        Telemetry::Completion completion = {};
+        int64_t completionTime = kBase + displayNanos(i) + kScheduleToAir;
+        DLAB_CHECK(telemetry.Complete(frameTag(i), Telemetry::ResultCompleted, completionTime, &completion));
+        DLAB_CHECK_EQ(completion.displayTime, i * kDuration);
+        DLAB_CHECK_EQ(completion.frameDuration, kDuration);
+        DLAB_CHECK_EQ(completion.timeScale, kTimeScale);
+        DLAB_CHECK_EQ(completion.scheduleToAir, kScheduleToAir);
+        DLAB_CHECK_EQ(completion.timingError, 0);
+    }
+
+    DLABLatencyStats::Snapshot air = telemetry.GetSnapshot(Telemetry::StatsStageScheduleToAir);
+    DLABLatencyStats::Snapshot interval = telemetry.GetSnapshot(Telemetry::StatsStageInterval);
+    DLAB_CHECK_EQ(air.count, 4);
+    DLAB_CHECK_EQ(air.max, (uint64_t)kScheduleToAir);
+    DLAB_CHECK_EQ(telemetry.GetSnapshot(Telemetry::StatsStageTimingError).count, 3);  // first one is anchor
+    DLAB_CHECK_EQ(interval.count, 3);
+    DLAB_CHECK(interval.max >= (uint64_t)kFrameNanos - 1 && interval.max <= (uint64_t)kFrameNanos + 1);
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultCompleted), 4);
+}
+
+static void testTimingErrorAndAnchorReset()
+{
+    Telemetry telemetry;
+    Telemetry::Completion completion = {};
+    for (intptr_t i = 0; i < 3; i++) schedule(telemetry, i);
+
+    telemetry.Complete(frameTag(0), Telemetry::ResultCompleted, kBase + kScheduleToAir, &completion);
+
+    // 2 mSec late, then 1 mSec early
+    telemetry.Complete(frameTag(1), Telemetry::ResultDisplayedLate,
+                       kBase + displayNanos(1) + kScheduleToAir + 2000000, &completion);
+    DLAB_CHECK_EQ(completion.timingError, 2000000);
+    telemetry.Complete(frameTag(2), Telemetry::ResultCompleted,
+                       kBase + displayNanos(2) + kScheduleToAir - 1000000, &completion);
+    DLAB_CHECK_EQ(completion.timingError, -1000000);
+
+    // Display time goes back (playback restarted); new anchor, no error recorded
+    uint64_t errorCount = telemetry.GetSnapshot(Telemetry::StatsStageTimingError).count;
+    telemetry.RecordScheduled(frameTag(10), 0, kDuration, kTimeScale, 5 * kBase);
+    DLAB_CHECK(telemetry.Complete(frameTag(10), Telemetry::ResultCompleted, 5 * kBase + 7, &completion));
+    DLAB_CHECK_EQ(completion.timingError, 0);
+    DLAB_CHECK_EQ(telemetry.GetSnapshot(Telemetry::StatsStageTimingError).count, errorCount);
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultDisplayedLate), 1);
+}
+
+static void testDroppedAndUnknownFrames()
+{
+    Telemetry telemetry;
+    Telemetry::Completion completion = {};
+    schedule(telemetry, 0);
+    schedule(telemetry, 1);
+
+    // Dropped frame is matched, but not measured
+    DLAB_CHECK(telemetry.Complete(frameTag(0), Telemetry::ResultDropped, kBase + kScheduleToAir, &completion));
+    DLAB_CHECK_EQ(completion.displayTime, 0);
+    DLAB_CHECK_EQ(completion.scheduleToAir, 0);
+    DLAB_CHECK_EQ(telemetry.GetSnapshot(Telemetry::StatsStageScheduleToAir).count, 0);
+
+    // Missing completion timestamp
+    DLAB_CHECK(telemetry.Complete(frameTag(1), Telemetry::ResultCompleted, 0, &completion));
+    DLAB_CHECK_EQ(completion.displayTime, kDuration);
+    DLAB_CHECK_EQ(telemetry.GetSnapshot(Telemetry::StatsStageScheduleToAir).count, 0);
+
+    // Slot is released on completion; second completion is not matched but counted
+    DLAB_CHECK(!telemetry.Complete(frameTag(1), Telemetry::ResultFlushed, 0, &completion));
+    DLAB_CHECK_EQ(completion.displayTime, 0);
+    DLAB_CHECK(!telemetry.Complete(NULL, Telemetry::ResultFlushed, 0, NULL));
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultDropped), 1);
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultFlushed), 2);
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultCount), 0);
+
+    telemetry.Reset();
+    DLAB_CHECK_EQ(telemetry.ResultCountOf(Telemetry::ResultFlushed), 0);
+}
+
+static void testSlotReuseAndOverflow()
+{
+    Telemetry telemetry;
+    Telemetry::Completion completion = {};
+
+    // Rescheduled frame reuses its slot with latest values
+    telemetry.RecordScheduled(frameTag(0), 0, kDuration, kTimeScale, kBase);
+    telemetry.RecordScheduled(frameTag(0), 5 * kDuration, kDuration, kTimeScale, kBase);
+    for (intptr_t i = 1; i < (intptr_t)Telemetry::kMaxFrameCount + 1; i++) schedule(telemetry, i);
+
+    DLAB_CHECK(telemetry.Complete(frameTag(0), Telemetry::ResultCompleted, 0, &completion));
+    DLAB_CHECK_EQ(completion.displayTime, 5 * kDuration);
+
+    // Frame scheduled while all slots were in use is not measured
+    intptr_t last = (intptr_t)Telemetry::kMaxFrameCount;
+    DLAB_CHECK(!telemetry.Complete(frameTag(last), Telemetry::ResultCompleted, 0, NULL));
+    for (intptr_t i = 1; i < last; i++) {
+        DLAB_CHECK(telemetry.Complete(frameTag(i), Telemetry::ResultCompleted, 0, NULL));
+    }
+}
+
+static void testConcurrentSchedule()
+{
+    Telemetry telemetry;
+    const intptr_t perThread = Telemetry::kMaxFrameCount / 4;
+    std::vector<std::thread> threads;
+    for (intptr_t t = 0; t < 4; t++) {
+        threads.push_back(std::thread([&telemetry, t, perThread]() {
+            for (intptr_t i = 0; i < perThread; i++) schedule(telemetry, t * perThread + i);
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+
+    size_t matched = 0;
+    for (intptr_t i = 0; i < (intptr_t)Telemetry::kMaxFrameCount; i++) {
+        Telemetry::Completion completion = {};
+        matched += telemetry.Complete(frameTag(i), Telemetry::ResultCompleted, 0, &completion);
+        DLAB_CHECK_EQ(completion.displayTime, i * kDuration);
+    }
+    DLAB_CHECK_EQ(matched, Telemetry::kMaxFrameCount);
+}
+
+int main()
+{
+    DLAB_RUN(testOnTimeFrames);
+    DLAB_RUN(testTimingErrorAndAnchorReset);
+    DLAB_RUN(testDroppedAndUnknownFrames);
+    DLAB_RUN(testSlotReuseAndOverflow);
+    DLAB_RUN(testConcurrentSchedule);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,220 @@
+//
+//  DLABRGBKernelTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABRGBKernel.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Every available backend is verified against the scalar backend, byte for byte
+ including row padding (pre-filled with kGuard). Source images are random, so
+ out of range components, pad bits and negative ARGB16Q12 values are covered.
+ Round trip uses an encoder written here independently of DLABRGBKernel.
+ Widths cover vector body with and without scalar tail, and partial R12B group.
+ */
+
+static const size_t kWidths[] = {1, 2, 3, 7, 8, 9, 15, 16, 17, 33, 720, 1922};
+static const size_t kHeights[] = {1, 3};
+static const size_t kRowPadding = 32;
+static const uint8_t kGuard = 0xA5;
+
+typedef struct {
+    const char* name;
+    uint32_t format;
+    int32_t rangeMin;
+    int32_t rangeMax;
+} RGBFormat;
+
+static const RGBFormat kFormats[] = {
+    {"r210", DLABKernelRGBFormat10BitRGB, 64, 940},
+    {"R10b", DLABKernelRGBFormat10BitRGBX, 64, 940},
+    {"R12B", DLABKernelRGBFormat12BitRGB, 0, 4095},
+};
+
+static size_t packedRowBytes(uint32_t format, size_t width)
+{
+    if (format == DLABKernelRGBFormat12BitRGB) return ((width + 7) / 8) * 36;
+    return width * 4;
+}
+
+/* =================================================================================== */
+// MARK: - reference
+/* =================================================================================== */
+
+// Encode R G B components (width * 3 per row) into BigEndian DeckLink RGB; pad bits are 0
+static void refEncode(const RGBFormat& fmt, const std::vector<uint16_t>& comps,
+                      uint8_t* dst, size_t dstRowBytes, size_t width, size_t height)
+{
+    for (size_t y = 0; y < height; y++) {
+        const uint16_t* row = comps.data() + y * width * 3;
+        uint8_t* out = dst + y * dstRowBytes;
+        if (fmt.format == DLABKernelRGBFormat12BitRGB) {
+            // Little endian 12bit stream per 36 byte group, then each 32bit word is byte swapped
+            for (size_t x = 0; x < width; x += 8) {
+                uint8_t le[36] = {0};
+                for (size_t i = 0; i < 24 && x * 3 + i < width * 3; i++) {
+                    size_t bit = i * 12;
+                    uint32_t v = row[x * 3 + i];
+                    le[bit / 8] |= (uint8_t)(v << (bit % 8));
+                    le[bit / 8 + 1] |= (uint8_t)(v >> (8 - bit % 8));
+                }
+                uint8_t* group = out + (x / 8) * 36;
+                for (size_t k = 0; k < 36; k++) group[k] = le[(k / 4) * 4 + 3 - k % 4];
+            }
+        } else {
+            int shift = (fmt.format == DLABKernelRGBFormat10BitRGBX ? 2 : 0);
+            for (size_t x = 0; x < width; x++) {
+                uint32_t word = ((uint32_t)row[x * 3] << (20 + shift) |
+                                 (uint32_t)row[x * 3 + 1] << (10 + shift) |
+                                 (uint32_t)row[x * 3 + 2] << shift);
+                out[x * 4 + 0] = (uint8_t)(word >> 24);
+                out[x * 4 + 1] = (uint8_t)(word >> 16);
+                out[x * 4 + 2] = (uint8_t)(word >> 8);
+                out[x * 4 + 3] = (uint8_t)(word);
+            }
+        }
+    }
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void checkUnpack(const RGBFormat& fmt, size_t width, size_t height, bool to16U)
+{
+    size_t srcRowBytes = packedRowBytes(fmt.format, width) + kRowPadding;
+    size_t dstRowBytes = width * 8 + kRowPadding;
+    std::vector<uint8_t> src(srcRowBytes * height);
+    dlabTestFill(src.data(), src.size(), (uint32_t)(fmt.format + width * 7 + height));
+
+    std::vector<uint8_t> expected(dstRowBytes * height, kGuard);
+    std::vector<uint8_t> actual(dstRowBytes * height, kGuard);
+    DLABKernelBackend backend = DLABKernelGetBackend();
+    DLABKernelSetBackend(DLABKernelBackendScalar);
+    DLAB_CHECK(DLABKernelRGBUnpack(fmt.format, src.data(), srcRowBytes, expected.data(), dstRowBytes,
+                                   width, height, fmt.rangeMin, fmt.rangeMax, to16U));
+    DLABKernelSetBackend(backend);
+    DLAB_CHECK(DLABKernelRGBUnpack(fmt.format, src.data(), srcRowBytes, actual.data(), dstRowBytes,
+                                   width, height, fmt.rangeMin, fmt.rangeMax, to16U));
+    if (actual != expected) {
+        fprintf(stderr, "  unpack %s %s width %zu height %zu differs from scalar\n",
+                fmt.name, (to16U ? "16U" : "Q12"), width, height);
+    }
+    DLAB_CHECK(actual == expected);
+}
+
+static void checkPack(const RGBFormat& fmt, size_t width, size_t height, bool from16U)
+{
+    size_t srcRowBytes = width * 8 + kRowPadding;
+    size_t dstRowBytes = packedRowBytes(fmt.format, width) + kRowPadding;
+    std::vector<uint8_t> src(srcRowBytes * height);
+    dlabTestFill(src.data(), src.size(), (uint32_t)(fmt.format + width * 13 + height));
+
+    std::vector<uint8_t> expected(dstRowBytes * height, kGuard);
+    std::vector<uint8_t> actual(dstRowBytes * height, kGuard);
+    DLABKernelBackend backend = DLABKernelGetBackend();
+    DLABKernelSetBackend(DLABKernelBackendScalar);
+    DLAB_CHECK(DLABKernelRGBPack(fmt.format, src.data(), srcRowBytes, expected.data(), dstRowBytes,
+                                 width, height, fmt.rangeMin, fmt.rangeMax, from16U));
+    DLABKernelSetBackend(backend);
+    DLAB_CHECK(DLABKernelRGBPack(fmt.format, src.data(), srcRowBytes, actual.data(), dstRowBytes,
+                                 width, height, fmt.rangeMin, fmt.rangeMax, from16U));
+    if (actual != expected) {
+        fprintf(stderr, "  pack %s %s width %zu height %zu differs from scalar\n",
+                fmt.name, (from16U ? "16U" : "Q12"), width, height);
+    }
+    DLAB_CHECK(actual == expected);
+}
+
+static void checkRoundTrip(const RGBFormat& fmt, size_t width, size_t height, bool is16U)
+{
+    // In range components survive unpack => pack, as interim format has finer steps
+    std::vector<uint16_t> comps(width * 3 * height);
+    uint32_t state = (uint32_t)(fmt.format + width + height);
+    uint32_t span = (uint32_t)(fmt.rangeMax - fmt.rangeMin + 1);
+    for (uint16_t& v : comps) v = (uint16_t)(fmt.rangeMin + dlabTestRandom(&state) % span);
+    comps[0] = (uint16_t)fmt.rangeMin;
+    comps[comps.size() - 1] = (uint16_t)fmt.rangeMax;
+
+    size_t packedBytes = packedRowBytes(fmt.format, width);
+    size_t interimRowBytes = width * 8;
+    std::vector<uint8_t> src(packedBytes * height, 0);
+    std::vector<uint8_t> back(packedBytes * height, kGuard);
+    std::vector<uint16_t> interim(width * 4 * height);
+    refEncode(fmt, comps, src.data(), packedBytes, width, height);
+
+    DLAB_CHECK(DLABKernelRGBUnpack(fmt.format, src.data(), packedBytes, interim.data(), interimRowBytes,
+                                   width, height, fmt.rangeMin, fmt.rangeMax, is16U));
+    DLAB_CHECK(DLABKernelRGBPack(fmt.format, interim.data(), interimRowBytes, back.data(), packedBytes,
+                                 width, height, fmt.rangeMin, fmt.rangeMax, is16U));
+    if (back != src) {
+        fprintf(stderr, "  round trip %s %s width %zu height %zu differs\n",
+                fmt.name, (is16U ? "16U" : "Q12"), width, height);
+    }
+    DLAB_CHECK(back == src);
+
+    // Alpha is opaque; range end points map to 0 and full scale
+    uint16_t full = (is16U ? 65535 : 4096);
+    DLAB_CHECK_EQ(interim[0], full);
+    DLAB_CHECK_EQ(interim[1], 0);
+    DLAB_CHECK_EQ(interim[interim.size() - 1], full);
+}
+
+static void testInvalidParameters()
+{
+    uint8_t src[512] = {0}, dst[512] = {0};
+    const uint32_t r210 = DLABKernelRGBFormat10BitRGB, r12b = DLABKernelRGBFormat12BitRGB;
+    DLAB_CHECK(!DLABKernelRGBSupports(0x76323130));                                         // 'v210'
+    DLAB_CHECK(!DLABKernelRGBUnpack(0x76323130, src, 16, dst, 32, 4, 1, 64, 940, true));
+    DLAB_CHECK(!DLABKernelRGBUnpack(r210, NULL, 16, dst, 32, 4, 1, 64, 940, true));
+    DLAB_CHECK(!DLABKernelRGBUnpack(r210, src, 16, dst, 32, 0, 1, 64, 940, true));
+    DLAB_CHECK(!DLABKernelRGBUnpack(r210, src, 15, dst, 32, 4, 1, 64, 940, true));         // short src row
+    DLAB_CHECK(!DLABKernelRGBUnpack(r210, src, 16, dst, 31, 4, 1, 64, 940, true));         // short dst row
+    DLAB_CHECK(!DLABKernelRGBUnpack(r210, src, 16, dst, 32, 4, 1, 940, 940, true));        // empty range
+    DLAB_CHECK(!DLABKernelRGBPack(r12b, src, 72, dst, 35, 9, 1, 0, 4095, false));          // partial group
+    DLAB_CHECK(!DLABKernelRGBPack(r12b, src, 71, dst, 72, 9, 1, 0, 4095, false));
+    DLAB_CHECK(!DLABKernelRGBPack(r12b, src, 72, dst, 72, 9, 0, 0, 4095, false));
+}
+
+static void testAllBackends()
+{
+    const DLABKernelBackend backends[] = {
+        DLABKernelBackendScalar, DLABKernelBackendSSE41, DLABKernelBackendAVX2, DLABKernelBackendNEON,
+    };
+    DLABKernelBackend original = DLABKernelGetBackend();
+    for (DLABKernelBackend backend : backends) {
+        if (DLABKernelSetBackend(backend) != backend) continue; // not available on this host
+        int before = dlabTestFailures;
+        for (const RGBFormat& fmt : kFormats) {
+            for (size_t width : kWidths) {
+                for (size_t height : kHeights) {
+                    for (int is16U = 0; is16U < 2; is16U++) {
+                        checkUnpack(fmt, width, height, is16U);
+                        checkPack(fmt, width, height, is16U);
+                        checkRoundTrip(fmt, width, height, is16U);
+                    }
+                }
+            }
+        }
+        printf("  backend %-8s %s\n", DLABKernelBackendName(backend),
+               (dlabTestFailures == before ? "ok" : "FAILED"));
+    }
+    DLABKernelSetBackend(original);
+}
+
+int main()
+{
+    DLAB_RUN(testInvalidParameters);
+    DLAB_RUN(testAllBackends);
+    return DLAB_TEST_RESULT();
+}
@@ -0,0 +1,276 @@
+//
+//  DLABRawContainerTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABRawRecorder.h"
+#include "DLABRawReplaySource.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ Round trip of DLABRawRecorder container through DLABRawReplaySource.
+ Video frame n is filled with dlabTestFill(seed n + 1), audio packet n with
+ seed 0x10000 + n, so payload, order and index are checked together.
+ Container files are written into a temporary directory, removed at the end.
+ */
+
+typedef DLABRawRecorder Recorder;
+typedef DLABRawReplaySource Replay;
+
+static const uint32_t kRowBytes = 3000;             // chunk is not page multiple
+static const uint32_t kHeight = 6;
+static const uint32_t kBytesPerFrame = 4;           // 2ch 16bit
+static const uint32_t kAudioFrames = 1601;
+static const int64_t kDuration = 1001;
+
+static std::string tempDirectory;
+
+static std::string tempPath(const char* name)
+{
+    return tempDirectory + "/" + name;
+}
+
+static Recorder::VideoFormat videoFormat()
+{
+    Recorder::VideoFormat video = {1000, kHeight, 0x32767579 /* '2vuy' */, kRowBytes, 30000, kDuration};
+    return video;
+}
+
+static Recorder::AudioFormat audioFormat()
+{
+    Recorder::AudioFormat audio = {48000, 2, kBytesPerFrame, 16};
+    return audio;
+}
+
+static std::vector<uint8_t> videoPayload(uint32_t frame)
+{
+    std::vector<uint8_t> data((size_t)kRowBytes * kHeight);
+    dlabTestFill(data.data(), data.size(), frame + 1);
+    return data;
+}
+
+static std::vector<uint8_t> audioPayload(uint32_t packet)
+{
+    std::vector<uint8_t> data((size_t)kBytesPerFrame * kAudioFrames);
+    dlabTestFill(data.data(), data.size(), 0x10000 + packet);
+    return data;
+}
+
+// Record frameCount video frames with one audio packet each
+static int recordFile(const std::string& path, uint32_t frameCount, Recorder* recorder)
+{
+    int error = recorder->Start(path.c_str(), videoFormat(), audioFormat(), 0);
+    if (error) return error;
+    for (uint32_t n = 0; n < frameCount; n++) {
+        std::vector<uint8_t> video = videoPayload(n);
+        std::vector<uint8_t> audio = audioPayload(n);
+        recorder->AppendVideo(video.data(), kRowBytes, kHeight, n * kDuration, kDuration,
+                              0x01000000 + n, n & 1);
+        recorder->AppendAudio(audio.data(), kBytesPerFrame, kAudioFrames, (int64_t)n * kAudioFrames);
+    }
+    return recorder->Stop();
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void testRoundTrip()
+{
+    // Spans several segments (8 MiB each); index grows beyond one segment
+    const uint32_t frameCount = 1200;
+    std::string path = tempPath("roundtrip.dlabraw");
+    Recorder recorder;
+    DLAB_CHECK_EQ(recordFile(path, frameCount, &recorder), 0);
+    DLAB_CHECK_EQ(recorder.VideoCount(), frameCount);
+    DLAB_CHECK_EQ(recorder.AudioFrameCount(), (uint64_t)frameCount * kAudioFrames);
+    DLAB_CHECK_EQ(recorder.DroppedVideoCount(), 0);
+    DLAB_CHECK_EQ(recorder.DroppedAudioCount(), 0);
+    DLAB_CHECK(!recorder.IsRecording());
+
+    Replay* replay = new Replay();
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), 0);
+    const Replay::FileHeader& header = replay->Header();
+    DLAB_CHECK_EQ(header.video.rowBytes, kRowBytes);
+    DLAB_CHECK_EQ(header.video.height, kHeight);
+    DLAB_CHECK_EQ(header.audio.bytesPerFrame, kBytesPerFrame);
+    DLAB_CHECK_EQ(header.videoCount, frameCount);
+    DLAB_CHECK_EQ(header.audioCount, frameCount);
+    DLAB_CHECK_EQ(replay->VideoFrameCount(), frameCount);
+    DLAB_CHECK_EQ(replay->AudioChunkCount(), frameCount);
+
+    size_t mismatch = 0;
+    for (uint32_t n = 0; n < frameCount; n++) {
+        Replay::IndexEntry entry = {};
+        const void* video = replay->VideoFrameAt(n, Replay::kDefaultReadAheadCount, &entry);
+        std::vector<uint8_t> expected = videoPayload(n);
+        if (!video || entry.size != expected.size() ||
+            memcmp(video, expected.data(), expected.size()) != 0) mismatch++;
+        if (entry.offset % Recorder::kPageSize) mismatch++;
+        if (entry.time != n * kDuration || entry.duration != kDuration) mismatch++;
+        if (entry.timecode != 0x01000000 + n || entry.timecodeFlags != (n & 1)) mismatch++;
+
+        const void* audio = replay->AudioChunkAt(n, &entry);
+        expected = audioPayload(n);
+        if (!audio || entry.size != expected.size() ||
+            memcmp(audio, expected.data(), expected.size()) != 0) mismatch++;
+        if (entry.time != (int64_t)n * kAudioFrames || entry.duration != kAudioFrames) mismatch++;
+    }
+    DLAB_CHECK_EQ(mismatch, 0);
+    DLAB_CHECK(replay->VideoFrameAt(frameCount, 0, NULL) == NULL);
+    DLAB_CHECK(replay->AudioChunkAt(frameCount, NULL) == NULL);
+
+    // Mapping outlives owner while consumer retains source
+    replay->AddRef();
+    DLAB_CHECK_EQ(replay->Release(), 1);
+    replay->Release();
+    unlink(path.c_str());
+}
+
+static void testRejectedAppend()
+{
+    std::string path = tempPath("rejected.dlabraw");
+    Recorder recorder;
+    std::vector<uint8_t> video = videoPayload(0);
+    DLAB_CHECK(!recorder.AppendVideo(video.data(), kRowBytes, kHeight, 0, kDuration, 0, 0));  // not started
+
+    DLAB_CHECK_EQ(recorder.Start(path.c_str(), videoFormat(), audioFormat(), 2), 0);
+    DLAB_CHECK_EQ(recorder.Start(path.c_str(), videoFormat(), audioFormat(), 2), EBUSY);
+
+    // Layout should match FileHeader
+    DLAB_CHECK(!recorder.AppendVideo(video.data(), kRowBytes / 2, kHeight, 0, kDuration, 0, 0));
+    DLAB_CHECK(!recorder.AppendAudio(video.data(), kBytesPerFrame * 2, 16, 0));
+    DLAB_CHECK(!recorder.AppendVideo(NULL, kRowBytes, kHeight, 0, kDuration, 0, 0));
+    DLAB_CHECK(recorder.AppendVideo(video.data(), kRowBytes, kHeight, 0, kDuration, 0, 0));
+    DLAB_CHECK_EQ(recorder.DroppedVideoCount(), 2);
+    DLAB_CHECK_EQ(recorder.DroppedAudioCount(), 1);
+    DLAB_CHECK_EQ(recorder.Stop(), 0);
+    DLAB_CHECK_EQ(recorder.Stop(), 0);
+
+    Replay* replay = new Replay();
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), 0);
+    DLAB_CHECK_EQ(replay->VideoFrameCount(), 1);
+    DLAB_CHECK_EQ(replay->AudioChunkCount(), 0);
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), EBUSY);
+    replay->Release();
+    unlink(path.c_str());
+
+    DLAB_CHECK_EQ(recorder.Start(NULL, videoFormat(), audioFormat(), 2), EINVAL);
+}
+
+static void testIncompleteContainer()
+{
+    std::string path = tempPath("incomplete.dlabraw");
+    Recorder recorder;
+    DLAB_CHECK_EQ(recordFile(path, 4, &recorder), 0);
+
+    // Truncated trailer; Footer is gone
+    off_t length = 0;
+    {
+        Replay* replay = new Replay();
+        DLAB_CHECK_EQ(replay->Open(path.c_str()), 0);
+        replay->Release();
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file) {
+            fseek(file, 0, SEEK_END);
+            length = ftell(file);
+            fclose(file);
+        }
+    }
+    DLAB_CHECK_EQ(truncate(path.c_str(), length - Recorder::kPageSize), 0);
+
+    Replay* replay = new Replay();
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), EINVAL);
+    replay->Release();
+    unlink(path.c_str());
+
+    replay = new Replay();
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), ENOENT);
+    replay->Release();
+}
+
+static void testCorruptHeaderCount()
+{
+    // Bogus video/audio count in header should not drive allocation
+    std::string path = tempPath("corrupt.dlabraw");
+    Recorder recorder;
+    DLAB_CHECK_EQ(recordFile(path, 3, &recorder), 0);
+    uint64_t bogus = UINT64_MAX / 2;
+    FILE* file = fopen(path.c_str(), "r+b");
+    DLAB_CHECK(file != NULL);
+    if (file) {
+        fseek(file, (long)offsetof(Recorder::FileHeader, videoCount), SEEK_SET);
+        fwrite(&bogus, sizeof(bogus), 1, file);
+        fseek(file, (long)offsetof(Recorder::FileHeader, audioCount), SEEK_SET);
+        fwrite(&bogus, sizeof(bogus), 1, file);
+        fclose(file);
+    }
+
+    Replay* replay = new Replay();
+    DLAB_CHECK_EQ(replay->Open(path.c_str()), 0);
+    DLAB_CHECK_EQ(replay->VideoFrameCount(), 3);
+    DLAB_CHECK_EQ(replay->AudioChunkCount(), 3);
+    replay->Release();
+    unlink(path.c_str());
+}
+
+static void testConcurrentStartStop()
+{
+    // Start/Stop may be called from any thread; never two I/O threads at a time
+    Recorder recorder;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; t++) {
+        threads.push_back(std::thread([&recorder, t]() {
+            std::string path = tempPath("concurrent") + std::to_string(t);
+            std::vector<uint8_t> video = videoPayload((uint32_t)t);
+            for (int i = 0; i < 30; i++) {
+                int error = recorder.Start(path.c_str(), videoFormat(), audioFormat(), 2);
+                DLAB_CHECK(error == 0 || error == EBUSY);
+                recorder.AppendVideo(video.data(), kRowBytes, kHeight, i * kDuration, kDuration, 0, 0);
+                recorder.Stop();
+            }
+        }));
+    }
+    for (std::thread& thread : threads) thread.join();
+    DLAB_CHECK(!recorder.IsRecording());
+    DLAB_CHECK_EQ(recorder.LastError(), 0);
+    for (int t = 0; t < 3; t++) {
+        unlink((tempPath("concurrent") + std::to_string(t)).c_str());
+    }
+}
+
+int main()
+{
+    const char* base = getenv("TMPDIR");
+    std::string pattern = std::string(base && *base ? base : "/tmp") + "/DLABRawContainerTests.XXXXXX";
+    std::vector<char> buffer(pattern.begin(), pattern.end());
+    buffer.push_back('\0');
+    if (!mkdtemp(buffer.data())) {
+        perror("mkdtemp");
+        return 1;
+    }
+    tempDirectory = buffer.data();
+
+    DLAB_RUN(testRoundTrip);
+    DLAB_RUN(testRejectedAppend);
+    DLAB_RUN(testIncompleteContainer);
+    DLAB_RUN(testCorruptHeaderCount);
+    DLAB_RUN(testConcurrentStartStop);
+
+    rmdir(tempDirectory.c_str());
+    return DLAB_TEST_RESULT();
+}
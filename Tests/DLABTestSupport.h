@@ -0,0 +1,75 @@
+//
+//  DLABTestSupport.h
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#ifndef DLABTestSupport_h
+#define DLABTestSupport_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Minimal check macros for unit tests of plain C++ units (no test framework dependency)
+ *
+ * Each test executable runs its test functions with DLAB_RUN, and returns
+ * DLAB_TEST_RESULT() from main(), so ctest reports any failed check.
+ */
+
+static int dlabTestFailures = 0;
+
+#define DLAB_CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            dlabTestFailures++; \
+        } \
+    } while (0)
+
+#define DLAB_CHECK_EQ(actual, expected) \
+    do { \
+        long long a_ = (long long)(actual); \
+        long long e_ = (long long)(expected); \
+        if (a_ != e_) { \
+            fprintf(stderr, "%s:%d: check failed: %s == %s (%lld != %lld)\n", \
+                    __FILE__, __LINE__, #actual, #expected, a_, e_); \
+            dlabTestFailures++; \
+        } \
+    } while (0)
+
+#define DLAB_RUN(test) \
+    do { \
+        int before_ = dlabTestFailures; \
+        test(); \
+        printf("%s %s\n", (dlabTestFailures == before_ ? "[  OK  ]" : "[ FAIL ]"), #test); \
+    } while (0)
+
+#define DLAB_TEST_RESULT() (dlabTestFailures ? 1 : 0)
+
+// Deterministic pseudo random bytes (xorshift32)
+static inline uint32_t dlabTestRandom(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline void dlabTestFill(void* buffer, size_t size, uint32_t seed)
+{
+    uint32_t state = (seed ? seed : 1);
+    uint8_t* ptr = (uint8_t*)buffer;
+    for (size_t i = 0; i < size; i++) {
+        ptr[i] = (uint8_t)(dlabTestRandom(&state) >> 24);
+    }
+}
+
+#endif /* DLABTestSupport_h */
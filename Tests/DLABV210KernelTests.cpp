@@ -0,0 +1,185 @@
+//
+//  DLABV210KernelTests.cpp
+//  DLABridging
+//
+//  Created by Takashi Mochizuki on 2025/10/18.
+//  Copyright © 2025 MyCometG3. All rights reserved.
+//
+
+/* This software is released under the MIT License, see LICENSE.txt. */
+
+#include "DLABTestSupport.h"
+#include "DLABV210Kernel.h"
+
+#include <string.h>
+#include <vector>
+
+/*
+ Every available backend is verified against a scalar reference written here
+ independently of DLABV210Kernel. Widths cover full blocks only, and partial
+ last block (2 or 4 pixels), with padded row strides.
+ */
+
+static const size_t kWidths[] = {2, 4, 6, 8, 10, 12, 46, 48, 50, 96, 720, 1922};
+static const size_t kHeights[] = {1, 3};
+static const size_t kRowPadding = 32;
+static const uint8_t kGuard = 0xA5;
+
+static size_t v210RowBytes(size_t width)
+{
+    return ((width + 5) / 6) * 16;
+}
+
+/* =================================================================================== */
+// MARK: - reference
+/* =================================================================================== */
+
+static uint16_t refComponent(const uint8_t* row, size_t index)
+{
+    size_t block = index / 12, slot = index % 12;
+    uint32_t word = 0;
+    memcpy(&word, row + block * 16 + (slot / 3) * 4, sizeof(word));
+    return (uint16_t)((word >> (10 * (slot % 3))) & 0x3FF);
+}
+
+static uint8_t refTo8(uint16_t v10)
+{
+    uint16_t v = (uint16_t)((v10 + 2) >> 2);
+    return (uint8_t)(v > 255 ? 255 : v);
+}
+
+static uint16_t refFrom16(uint16_t v16)
+{
+    uint32_t v = ((uint32_t)v16 + 32) >> 6;
+    return (uint16_t)(v > 1023 ? 1023 : v);
+}
+
+/* =================================================================================== */
+// MARK: - tests
+/* =================================================================================== */
+
+static void checkUnpack(size_t width, size_t height)
+{
+    size_t srcRowBytes = v210RowBytes(width) + kRowPadding;
+    std::vector<uint8_t> src(srcRowBytes * height);
+    dlabTestFill(src.data(), src.size(), (uint32_t)(width * 7 + height));
+
+    size_t dst8RowBytes = width * 2 + kRowPadding;
+    size_t dst16RowBytes = width * 4 + kRowPadding;
+    std::vector<uint8_t> dst8(dst8RowBytes * height, kGuard);
+    std::vector<uint8_t> dst16(dst16RowBytes * height, kGuard);
+    DLAB_CHECK(DLABKernelV210To2vuy(src.data(), srcRowBytes, dst8.data(), dst8RowBytes, width, height));
+    DLAB_CHECK(DLABKernelV210ToV216(src.data(), srcRowBytes, dst16.data(), dst16RowBytes, width, height));
+
+    size_t mismatch = 0, overrun = 0;
+    for (size_t y = 0; y < height; y++) {
+        const uint8_t* srcRow = src.data() + srcRowBytes * y;
+        const uint8_t* row8 = dst8.data() + dst8RowBytes * y;
+        const uint8_t* row16 = dst16.data() + dst16RowBytes * y;
+        for (size_t i = 0; i < width * 2; i++) {
+            uint16_t v10 = refComponent(srcRow, i);
+            uint16_t v16 = 0;
+            memcpy(&v16, row16 + i * 2, sizeof(v16));
+            if (row8[i] != refTo8(v10) || v16 != (uint16_t)(v10 << 6)) mismatch++;
+        }
+        for (size_t i = width * 2; i < dst8RowBytes; i++) overrun += (row8[i] != kGuard);
+        for (size_t i = width * 4; i < dst16RowBytes; i++) overrun += (row16[i] != kGuard);
+    }
+    DLAB_CHECK_EQ(mismatch, 0);
+    DLAB_CHECK_EQ(overrun, 0);
+}
+
+static void checkPack(size_t width, size_t height)
+{
+    size_t src8RowBytes = width * 2 + kRowPadding;
+    size_t src16RowBytes = width * 4 + kRowPadding;
+    std::vector<uint8_t> src8(src8RowBytes * height);
+    std::vector<uint8_t> src16(src16RowBytes * height);
+    dlabTestFill(src8.data(), src8.size(), (uint32_t)(width * 13 + height));
+    dlabTestFill(src16.data(), src16.size(), (uint32_t)(width * 17 + height));
+
+    size_t dstRowBytes = v210RowBytes(width) + kRowPadding;
+    std::vector<uint8_t> dstA(dstRowBytes * height, kGuard);
+    std::vector<uint8_t> dstB(dstRowBytes * height, kGuard);
+    DLAB_CHECK(DLABKernel2vuyToV210(src8.data(), src8RowBytes, dstA.data(), dstRowBytes, width, height));
+    DLAB_CHECK(DLABKernelV216ToV210(src16.data(), src16RowBytes, dstB.data(), dstRowBytes, width, height));
+
+    size_t mismatch = 0, overrun = 0;
+    for (size_t y = 0; y < height; y++) {
+        const uint8_t* row8 = src8.data() + src8RowBytes * y;
+        const uint8_t* row16 = src16.data() + src16RowBytes * y;
+        const uint8_t* rowA = dstA.data() + dstRowBytes * y;
+        const uint8_t* rowB = dstB.data() + dstRowBytes * y;
+        for (size_t i = 0; i < width * 2; i++) {
+            uint16_t v16 = 0;
+            memcpy(&v16, row16 + i * 2, sizeof(v16));
+            if (refComponent(rowA, i) != (uint16_t)(row8[i] << 2)) mismatch++;
+            if (refComponent(rowB, i) != refFrom16(v16)) mismatch++;
+        }
+        for (size_t i = v210RowBytes(width); i < dstRowBytes; i++) {
+            overrun += (rowA[i] != kGuard) + (rowB[i] != kGuard);
+        }
+    }
+    DLAB_CHECK_EQ(mismatch, 0);
+    DLAB_CHECK_EQ(overrun, 0);
+}
+
+static void checkRoundTrip(size_t width, size_t height)
+{
+    // 8bit => 10bit => 8bit, and 16bit (10bit significant) => 10bit => 16bit are lossless
+    size_t rowBytes8 = width * 2, rowBytes16 = width * 4, rowBytesV210 = v210RowBytes(width);
+    std::vector<uint8_t> src8(rowBytes8 * height), back8(rowBytes8 * height);
+    std::vector<uint16_t> src16(width * 2 * height), back16(width * 2 * height);
+    std::vector<uint8_t> v210(rowBytesV210 * height);
+    dlabTestFill(src8.data(), src8.size(), (uint32_t)width);
+    dlabTestFill(src16.data(), src16.size() * 2, (uint32_t)height);
+    for (uint16_t& v : src16) v &= 0xFFC0;
+
+    DLAB_CHECK(DLABKernel2vuyToV210(src8.data(), rowBytes8, v210.data(), rowBytesV210, width, height));
+    DLAB_CHECK(DLABKernelV210To2vuy(v210.data(), rowBytesV210, back8.data(), rowBytes8, width, height));
+    DLAB_CHECK(src8 == back8);
+
+    DLAB_CHECK(DLABKernelV216ToV210(src16.data(), rowBytes16, v210.data(), rowBytesV210, width, height));
+    DLAB_CHECK(DLABKernelV210ToV216(v210.data(), rowBytesV210, back16.data(), rowBytes16, width, height));
+    DLAB_CHECK(src16 == back16);
+}
+
+static void testInvalidParameters()
+{
+    uint8_t src[64] = {0}, dst[64] = {0};
+    DLAB_CHECK(!DLABKernelV210To2vuy(NULL, 16, dst, 12, 6, 1));
+    DLAB_CHECK(!DLABKernelV210To2vuy(src, 16, dst, 12, 5, 1));        // odd width
+    DLAB_CHECK(!DLABKernelV210To2vuy(src, 15, dst, 12, 6, 1));        // short v210 row
+    DLAB_CHECK(!DLABKernelV210ToV216(src, 16, dst, 23, 6, 1));        // short v216 row
+    DLAB_CHECK(!DLABKernel2vuyToV210(src, 12, dst, 16, 0, 1));
+    DLAB_CHECK(!DLABKernelV216ToV210(src, 24, dst, 16, 6, 0));
+}
+
+static void testAllBackends()
+{
+    const DLABKernelBackend backends[] = {
+        DLABKernelBackendScalar, DLABKernelBackendSSE41, DLABKernelBackendAVX2, DLABKernelBackendNEON,
+    };
+    DLABKernelBackend original = DLABKernelGetBackend();
+    for (DLABKernelBackend backend : backends) {
+        if (DLABKernelSetBackend(backend) != backend) continue; // not available on this host
+        int before = dlabTestFailures;
+        for (size_t width : kWidths) {
+            for (size_t height : kHeights) {
+                checkUnpack(width, height);
+                checkPack(width, height);
+                checkRoundTrip(width, height);
+            }
+        }
+        printf("  backend %-8s %s\n", DLABKernelBackendName(backend),
+               (dlabTestFailures == before ? "ok" : "FAILED"));
+    }
+    DLABKernelSetBackend(original);
+}
+
+int main()
+{
+    DLAB_RUN(testInvalidParameters);
+    DLAB_RUN(testAllBackends);
+    return DLAB_TEST_RESULT();
+}